@@ -0,0 +1,944 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Microbenchmarks for the hot kernels of the audio processing module.
+//
+// Every kernel is run for each implementation variant that the CPU supports
+// and, where the kernel depends on it, for several channel counts. Results are
+// reported as ns/call and processed samples/s, either as a table or, with
+// --json, as a JSON document suitable for regression tracking.
+//
+// Usage: apm-bench [--json] [--filter=<substring>] [--min-time-ms=<ms>]
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "common_audio/resampler/push_sinc_resampler.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+#include "modules/audio_processing/aec3/adaptive_fir_filter_erl.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/aecm/aecm_core.h"
+#include "modules/audio_processing/aecm/aecm_defines.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/rnn_fc.h"
+#include "modules/audio_processing/ns/ns_fft.h"
+#include "modules/audio_processing/three_band_filter_bank.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "third_party/rnnoise/src/rnn_vad_weights.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kChannelCounts[] = {1, 2, 8};
+
+struct Options {
+  bool json = false;
+  std::string filter;
+  double min_time_ms = 200.0;
+};
+
+struct Result {
+  std::string kernel;
+  std::string variant;
+  size_t num_channels;
+  uint64_t calls;
+  double ns_per_call;
+  double samples_per_second;
+};
+
+// Sink for results that would otherwise be optimized away.
+volatile float g_sink = 0.f;
+
+class Runner {
+ public:
+  explicit Runner(const Options& options) : options_(options) {}
+
+  bool Enabled(const std::string& kernel) const {
+    return options_.filter.empty() ||
+           kernel.find(options_.filter) != std::string::npos;
+  }
+
+  // Times `fn` until at least the minimum measurement time has passed.
+  // `samples_per_call` is the number of audio samples processed by one call
+  // and is used for the throughput figure.
+  template <typename Fn>
+  void Run(const std::string& kernel,
+           const std::string& variant,
+           size_t num_channels,
+           size_t samples_per_call,
+           Fn fn) {
+    using Clock = std::chrono::steady_clock;
+    for (int k = 0; k < 16; ++k) {
+      fn();
+    }
+    uint64_t calls = 0;
+    uint64_t batch = 16;
+    double elapsed_ns = 0.0;
+    const auto start = Clock::now();
+    while (elapsed_ns < options_.min_time_ms * 1e6) {
+      for (uint64_t k = 0; k < batch; ++k) {
+        fn();
+      }
+      calls += batch;
+      batch *= 2;
+      elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                       .count();
+    }
+    Result result;
+    result.kernel = kernel;
+    result.variant = variant;
+    result.num_channels = num_channels;
+    result.calls = calls;
+    result.ns_per_call = elapsed_ns / calls;
+    result.samples_per_second = samples_per_call * 1e9 / result.ns_per_call;
+    if (!options_.json) {
+      printf("%-32s %-6s %3zu ch %12.1f ns/call %14.0f samples/s\n",
+             kernel.c_str(), variant.c_str(), num_channels, result.ns_per_call,
+             result.samples_per_second);
+      fflush(stdout);
+    }
+    results_.push_back(result);
+  }
+
+  void PrintJson() const {
+    printf("{\n  \"benchmarks\": [\n");
+    for (size_t k = 0; k < results_.size(); ++k) {
+      const Result& r = results_[k];
+      printf(
+          "    {\"kernel\": \"%s\", \"variant\": \"%s\", \"channels\": %zu, "
+          "\"calls\": %llu, \"ns_per_call\": %.3f, \"samples_per_second\": "
+          "%.1f}%s\n",
+          r.kernel.c_str(), r.variant.c_str(), r.num_channels,
+          static_cast<unsigned long long>(r.calls), r.ns_per_call,
+          r.samples_per_second, k + 1 < results_.size() ? "," : "");
+    }
+    printf("  ]\n}\n");
+  }
+
+ private:
+  const Options options_;
+  std::vector<Result> results_;
+};
+
+void FillRandom(rtc::ArrayView<float> x, std::mt19937* rng, float scale) {
+  std::uniform_real_distribution<float> dist(-scale, scale);
+  for (float& v : x) {
+    v = dist(*rng);
+  }
+}
+
+void FillRandom(FftData* X, std::mt19937* rng) {
+  FillRandom(X->re, rng, 1.f);
+  FillRandom(X->im, rng, 1.f);
+  X->im[0] = X->im[kFftLengthBy2] = 0.f;
+}
+
+const char* Aec3OptimizationName(Aec3Optimization optimization) {
+  switch (optimization) {
+    case Aec3Optimization::kNone:
+      return "none";
+    case Aec3Optimization::kSse2:
+      return "sse2";
+    case Aec3Optimization::kAvx2:
+      return "avx2";
+    case Aec3Optimization::kAvx512:
+      return "avx512";
+    case Aec3Optimization::kNeon:
+      return "neon";
+  }
+  return "unknown";
+}
+
+// Returns the AEC3 kernel variants that are both compiled in and supported
+// by the CPU.
+std::vector<Aec3Optimization> Aec3Variants() {
+  std::vector<Aec3Optimization> variants = {Aec3Optimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+  if (GetCPUInfo(kSSE2) != 0) {
+    variants.push_back(Aec3Optimization::kSse2);
+  }
+#endif
+  if (GetCPUInfo(kAVX2) != 0) {
+    variants.push_back(Aec3Optimization::kAvx2);
+  }
+#if defined(WEBRTC_ENABLE_AVX512)
+  if (GetCPUInfo(kAVX512) != 0) {
+    variants.push_back(Aec3Optimization::kAvx512);
+  }
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  variants.push_back(Aec3Optimization::kNeon);
+#endif
+  return variants;
+}
+
+// Mirrors the dispatch in AdaptiveFirFilter, so that each kernel can be
+// timed without the surrounding filter bookkeeping.
+void ApplyFilter(Aec3Optimization optimization,
+                 const RenderBuffer& render_buffer,
+                 size_t num_partitions,
+                 const std::vector<std::vector<FftData>>& H,
+                 FftData* S) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+      aec3::ApplyFilter_Sse2(render_buffer, num_partitions, H, S);
+      return;
+#endif
+    case Aec3Optimization::kAvx2:
+      aec3::ApplyFilter_Avx2(render_buffer, num_partitions, H, S);
+      return;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::ApplyFilter_Avx512(render_buffer, num_partitions, H, S);
+      return;
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::ApplyFilter_Neon(render_buffer, num_partitions, H, S);
+      return;
+#endif
+    default:
+      aec3::ApplyFilter(render_buffer, num_partitions, H, S);
+  }
+}
+
+void AdaptPartitions(Aec3Optimization optimization,
+                     const RenderBuffer& render_buffer,
+                     const FftData& G,
+                     size_t num_partitions,
+                     std::vector<std::vector<FftData>>* H) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+      aec3::AdaptPartitions_Sse2(render_buffer, G, num_partitions, H);
+      return;
+#endif
+    case Aec3Optimization::kAvx2:
+      aec3::AdaptPartitions_Avx2(render_buffer, G, num_partitions, H);
+      return;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::AdaptPartitions_Avx512(render_buffer, G, num_partitions, H);
+      return;
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::AdaptPartitions_Neon(render_buffer, G, num_partitions, H);
+      return;
+#endif
+    default:
+      aec3::AdaptPartitions(render_buffer, G, num_partitions, H);
+  }
+}
+
+void ComputeFrequencyResponse(
+    Aec3Optimization optimization,
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+      aec3::ComputeFrequencyResponse_Sse2(num_partitions, H, H2);
+      return;
+#endif
+    case Aec3Optimization::kAvx2:
+      aec3::ComputeFrequencyResponse_Avx2(num_partitions, H, H2);
+      return;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::ComputeFrequencyResponse_Avx512(num_partitions, H, H2);
+      return;
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::ComputeFrequencyResponse_Neon(num_partitions, H, H2);
+      return;
+#endif
+    default:
+      aec3::ComputeFrequencyResponse(num_partitions, H, H2);
+  }
+}
+
+void MatchedFilterCore(Aec3Optimization optimization,
+                       size_t x_start_index,
+                       rtc::ArrayView<const float> x,
+                       rtc::ArrayView<const float> y,
+                       rtc::ArrayView<float> h,
+                       bool compute_accumulated_error,
+                       rtc::ArrayView<float> accumulated_error,
+                       rtc::ArrayView<float> scratch_memory) {
+  // The thresholds match the default matched filter configuration.
+  constexpr float kX2SumThreshold = 16.f * 150.f * 150.f;
+  constexpr float kSmoothing = 0.7f;
+  bool filters_updated = false;
+  float error_sum = 0.f;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+      aec3::MatchedFilterCore_SSE2(x_start_index, kX2SumThreshold, kSmoothing,
+                                   x, y, h, &filters_updated, &error_sum,
+                                   compute_accumulated_error, accumulated_error,
+                                   scratch_memory);
+      break;
+#endif
+    case Aec3Optimization::kAvx2:
+      aec3::MatchedFilterCore_AVX2(x_start_index, kX2SumThreshold, kSmoothing,
+                                   x, y, h, &filters_updated, &error_sum,
+                                   compute_accumulated_error, accumulated_error,
+                                   scratch_memory);
+      break;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::MatchedFilterCore_AVX512(
+          x_start_index, kX2SumThreshold, kSmoothing, x, y, h, &filters_updated,
+          &error_sum, compute_accumulated_error, accumulated_error,
+          scratch_memory);
+      break;
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::MatchedFilterCore_NEON(x_start_index, kX2SumThreshold, kSmoothing,
+                                   x, y, h, &filters_updated, &error_sum,
+                                   compute_accumulated_error, accumulated_error,
+                                   scratch_memory);
+      break;
+#endif
+    default:
+      aec3::MatchedFilterCore(x_start_index, kX2SumThreshold, kSmoothing, x, y,
+                              h, &filters_updated, &error_sum,
+                              compute_accumulated_error, accumulated_error);
+  }
+  g_sink = g_sink + error_sum;
+}
+
+// Creates a render delay buffer filled with noise for `num_channels` render
+// channels.
+std::unique_ptr<RenderDelayBuffer> CreateRenderDelayBuffer(
+    const EchoCanceller3Config& config,
+    size_t num_channels,
+    std::mt19937* rng) {
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, num_channels));
+  Block block(NumBandsForRate(kSampleRateHz), num_channels);
+  for (int k = 0; k < 100; ++k) {
+    for (int band = 0; band < block.NumBands(); ++band) {
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        FillRandom(block.View(band, ch), rng, 10000.f);
+      }
+    }
+    render_delay_buffer->Insert(block);
+    render_delay_buffer->PrepareCaptureProcessing();
+  }
+  return render_delay_buffer;
+}
+
+void BenchmarkAdaptiveFilter(Runner* runner, std::mt19937* rng) {
+  const EchoCanceller3Config config;
+  const size_t num_partitions = config.filter.refined.length_blocks;
+  for (size_t num_channels : kChannelCounts) {
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer =
+        CreateRenderDelayBuffer(config, num_channels, rng);
+    const RenderBuffer& render_buffer =
+        *render_delay_buffer->GetRenderBuffer();
+
+    std::vector<std::vector<FftData>> H(num_partitions,
+                                        std::vector<FftData>(num_channels));
+    for (auto& H_p : H) {
+      for (FftData& H_p_ch : H_p) {
+        FillRandom(&H_p_ch, rng);
+      }
+    }
+    FftData G;
+    FillRandom(&G, rng);
+    for (float& v : G.re) {
+      v *= 1e-9f;
+    }
+    for (float& v : G.im) {
+      v *= 1e-9f;
+    }
+    FftData S;
+    std::vector<std::array<float, kFftLengthBy2Plus1>> H2(num_partitions);
+
+    // One call processes a block for every render channel.
+    const size_t samples_per_call = kBlockSize * num_channels;
+    for (Aec3Optimization optimization : Aec3Variants()) {
+      const std::string variant = Aec3OptimizationName(optimization);
+      if (runner->Enabled("aec3.ApplyFilter")) {
+        runner->Run("aec3.ApplyFilter", variant, num_channels,
+                    samples_per_call, [&] {
+                      ApplyFilter(optimization, render_buffer, num_partitions,
+                                  H, &S);
+                      g_sink = g_sink + S.re[1];
+                    });
+      }
+      if (runner->Enabled("aec3.AdaptPartitions")) {
+        runner->Run("aec3.AdaptPartitions", variant, num_channels,
+                    samples_per_call, [&] {
+                      AdaptPartitions(optimization, render_buffer, G,
+                                      num_partitions, &H);
+                    });
+      }
+      if (runner->Enabled("aec3.ComputeFrequencyResponse")) {
+        runner->Run("aec3.ComputeFrequencyResponse", variant, num_channels,
+                    samples_per_call, [&] {
+                      ComputeFrequencyResponse(optimization, num_partitions, H,
+                                               &H2);
+                      g_sink = g_sink + H2[0][1];
+                    });
+      }
+    }
+  }
+}
+
+void BenchmarkErl(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("aec3.ComputeErl")) {
+    return;
+  }
+  const EchoCanceller3Config config;
+  std::vector<std::array<float, kFftLengthBy2Plus1>> H2(
+      config.filter.refined.length_blocks);
+  for (auto& H2_p : H2) {
+    FillRandom(H2_p, rng, 1.f);
+  }
+  std::array<float, kFftLengthBy2Plus1> erl;
+  for (Aec3Optimization optimization : Aec3Variants()) {
+    runner->Run("aec3.ComputeErl", Aec3OptimizationName(optimization), 1,
+                kBlockSize, [&] {
+                  ComputeErl(optimization, H2, erl);
+                  g_sink = g_sink + erl[1];
+                });
+  }
+}
+
+void BenchmarkMatchedFilter(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("aec3.MatchedFilterCore")) {
+    return;
+  }
+  // Sizes match the default AEC3 configuration: a down-sampling factor of 4
+  // gives 16-sample sub-blocks, and each filter spans 32 sub-blocks.
+  constexpr size_t kSubBlockSize = kBlockSize / 4;
+  constexpr size_t kFilterLength = 32 * kSubBlockSize;
+  std::vector<float> x(4 * kFilterLength);
+  std::vector<float> y(kSubBlockSize);
+  std::vector<float> h(kFilterLength, 0.f);
+  std::vector<float> accumulated_error(kFilterLength / 4);
+  std::vector<float> scratch_memory(kFilterLength);
+  FillRandom(x, rng, 10000.f);
+  FillRandom(y, rng, 10000.f);
+
+  for (bool compute_accumulated_error : {false, true}) {
+    const std::string kernel = compute_accumulated_error
+                                   ? "aec3.MatchedFilterCore.pre_echo"
+                                   : "aec3.MatchedFilterCore";
+    for (Aec3Optimization optimization : Aec3Variants()) {
+      size_t x_start_index = 0;
+      runner->Run(kernel, Aec3OptimizationName(optimization), 1, kSubBlockSize,
+                  [&] {
+                    MatchedFilterCore(optimization, x_start_index, x, y, h,
+                                      compute_accumulated_error,
+                                      accumulated_error, scratch_memory);
+                    x_start_index = (x_start_index + kSubBlockSize) % x.size();
+                  });
+    }
+  }
+}
+
+void BenchmarkOouraFft(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("ooura.Fft128")) {
+    return;
+  }
+  std::vector<std::pair<std::string, bool>> variants = {{"none", false}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2) != 0) {
+    variants.push_back({"sse2", true});
+  }
+#endif
+  std::array<float, 128> x;
+  FillRandom(x, rng, 1.f);
+  for (const auto& [name, sse2] : variants) {
+    const OouraFft fft(sse2);
+    std::array<float, 128> a;
+    runner->Run("ooura.Fft128", name, 1, a.size(), [&] {
+      a = x;
+      fft.Fft(a.data());
+      g_sink = g_sink + a[1];
+    });
+  }
+}
+
+void BenchmarkAec3Fft(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("aec3.Aec3Fft")) {
+    return;
+  }
+  const std::pair<const char*, Aec3Fft::Backend> kBackends[] = {
+      {"ooura", Aec3Fft::Backend::kOoura}, {"pffft", Aec3Fft::Backend::kPffft}};
+  for (size_t num_channels : kChannelCounts) {
+    Block x(/*num_bands=*/1, num_channels);
+    Block x_old(/*num_bands=*/1, num_channels);
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      FillRandom(x.View(/*band=*/0, ch), rng, 10000.f);
+      FillRandom(x_old.View(/*band=*/0, ch), rng, 10000.f);
+    }
+    std::vector<FftData> X(num_channels);
+    for (const auto& [name, backend] : kBackends) {
+      const Aec3Fft fft(backend);
+      if (fft.backend() != backend) {
+        continue;
+      }
+      runner->Run("aec3.Aec3Fft.PaddedFft", name, num_channels,
+                  kBlockSize * num_channels, [&] {
+                    for (size_t ch = 0; ch < num_channels; ++ch) {
+                      fft.PaddedFft(x.View(/*band=*/0, ch),
+                                    x_old.View(/*band=*/0, ch), &X[ch]);
+                    }
+                    g_sink = g_sink + X[0].re[1];
+                  });
+      std::array<float, kFftLength> y;
+      runner->Run("aec3.Aec3Fft.Ifft", name, num_channels,
+                  kFftLength * num_channels, [&] {
+                    for (size_t ch = 0; ch < num_channels; ++ch) {
+                      fft.Ifft(X[ch], &y);
+                    }
+                    g_sink = g_sink + y[1];
+                  });
+    }
+  }
+}
+
+void BenchmarkNrFft(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("ns.NrFft")) {
+    return;
+  }
+  std::vector<std::pair<std::string, NrFft::Implementation>> variants = {
+      {"ooura", NrFft::Implementation::kOoura}};
+  if (Pffft::IsSimdEnabled()) {
+    variants.push_back({"pffft", NrFft::Implementation::kPffft});
+  }
+  std::array<float, kFftSize> x;
+  std::array<float, kFftSize> time_data;
+  std::array<float, kFftSize> real;
+  std::array<float, kFftSize> imag;
+  FillRandom(x, rng, 1.f);
+  for (const auto& [name, implementation] : variants) {
+    NrFft fft(implementation);
+    runner->Run("ns.NrFft.Fft", name, 1, kFftSize, [&] {
+      time_data = x;
+      fft.Fft(time_data, real, imag);
+      g_sink = g_sink + real[1];
+    });
+    runner->Run("ns.NrFft.Ifft", name, 1, kFftSize, [&] {
+      fft.Ifft(real, imag, time_data);
+      g_sink = g_sink + time_data[1];
+    });
+  }
+}
+
+void BenchmarkPffft(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("pffft")) {
+    return;
+  }
+  for (size_t fft_size : {256, 512}) {
+    Pffft fft(fft_size, Pffft::FftType::kReal);
+    std::unique_ptr<Pffft::FloatBuffer> in = fft.CreateBuffer();
+    std::unique_ptr<Pffft::FloatBuffer> out = fft.CreateBuffer();
+    FillRandom(in->GetView(), rng, 1.f);
+    runner->Run("pffft.Real" + std::to_string(fft_size), "auto", 1, fft_size,
+                [&] {
+                  fft.ForwardTransform(*in, out.get(), /*ordered=*/false);
+                  g_sink = g_sink + out->GetConstView()[1];
+                });
+  }
+}
+
+void BenchmarkFullyConnectedLayer(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("rnn_vad.FullyConnectedLayer")) {
+    return;
+  }
+  const AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  std::vector<std::pair<std::string, AvailableCpuFeatures>> variants = {
+      {"none", NoAvailableCpuFeatures()}};
+  if (available.sse2) {
+    variants.push_back({"sse2", AvailableCpuFeatures(true, false, false)});
+  }
+  if (available.avx2) {
+    variants.push_back({"avx2", AvailableCpuFeatures(true, true, false)});
+  }
+  if (available.neon) {
+    variants.push_back({"neon", AvailableCpuFeatures(false, false, true)});
+  }
+  std::array<float, rnnoise::kInputLayerInputSize> input;
+  FillRandom(input, rng, 1.f);
+  for (const auto& [name, cpu_features] : variants) {
+    rnn_vad::FullyConnectedLayer layer(
+        rnnoise::kInputLayerInputSize, rnnoise::kInputLayerOutputSize,
+        rnnoise::kInputDenseBias, rnnoise::kInputDenseWeights,
+        rnn_vad::ActivationFunction::kTansigApproximated, cpu_features,
+        "apm_bench");
+    runner->Run("rnn_vad.FullyConnectedLayer", name, 1, input.size(), [&] {
+      layer.ComputeOutput(input);
+      g_sink = g_sink + layer.data()[0];
+    });
+  }
+}
+
+// Returns the ThreeBandFilterBank kernel variants that are both compiled in and
+// supported by the CPU.
+std::vector<std::pair<const char*, ThreeBandFilterBank::Implementation>>
+ThreeBandFilterBankVariants() {
+  std::vector<std::pair<const char*, ThreeBandFilterBank::Implementation>>
+      variants = {{"none", ThreeBandFilterBank::Implementation::kScalar}};
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (GetCPUInfo(kSSE2) != 0) {
+    variants.push_back({"sse2", ThreeBandFilterBank::Implementation::kSse2});
+  }
+  if (GetCPUInfo(kAVX2) != 0) {
+    variants.push_back({"avx2", ThreeBandFilterBank::Implementation::kAvx2});
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  variants.push_back({"neon", ThreeBandFilterBank::Implementation::kNeon});
+#endif
+  return variants;
+}
+
+void BenchmarkThreeBandFilterBank(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("ThreeBandFilterBank.Analysis")) {
+    return;
+  }
+  for (size_t num_channels : kChannelCounts) {
+    for (const auto& [name, implementation] : ThreeBandFilterBankVariants()) {
+      std::vector<std::unique_ptr<ThreeBandFilterBank>> banks;
+      std::vector<std::array<float, ThreeBandFilterBank::kFullBandSize>> in(
+          num_channels);
+      std::vector<
+          std::array<std::array<float, ThreeBandFilterBank::kSplitBandSize>,
+                     ThreeBandFilterBank::kNumBands>>
+          out(num_channels);
+      std::vector<std::array<rtc::ArrayView<float>,
+                             ThreeBandFilterBank::kNumBands>>
+          out_views(num_channels);
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        banks.push_back(std::make_unique<ThreeBandFilterBank>(implementation));
+        FillRandom(in[ch], rng, 10000.f);
+        for (size_t band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+          out_views[ch][band] = out[ch][band];
+        }
+      }
+      runner->Run("ThreeBandFilterBank.Analysis", name, num_channels,
+                  ThreeBandFilterBank::kFullBandSize * num_channels, [&] {
+                    for (size_t ch = 0; ch < num_channels; ++ch) {
+                      banks[ch]->Analysis(in[ch], out_views[ch]);
+                    }
+                    g_sink = g_sink + out[0][0][1];
+                  });
+    }
+  }
+}
+
+void BenchmarkSincResampler(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("SincResampler")) {
+    return;
+  }
+  // The convolution kernel is selected from the CPU features at runtime and
+  // cannot be overridden, so only the selected variant is measured.
+  constexpr size_t kSourceFrames = 441;
+  constexpr size_t kDestinationFrames = 480;
+  PushSincResampler resampler(kSourceFrames, kDestinationFrames);
+  std::array<float, kSourceFrames> source;
+  std::array<float, kDestinationFrames> destination;
+  FillRandom(source, rng, 10000.f);
+  runner->Run("SincResampler.44100to48000", "auto", 1, kDestinationFrames, [&] {
+    resampler.Resample(source.data(), source.size(), destination.data(),
+                       destination.size());
+    g_sink = g_sink + destination[1];
+  });
+}
+
+// A signal processing library function, called directly instead of through
+// the function pointer selected at runtime.
+template <typename Function>
+struct SplVariant {
+  const char* name;
+  Function function;
+};
+
+// Returns the variants of an SPL function that are both compiled in and
+// supported by the CPU.
+template <typename Function>
+std::vector<SplVariant<Function>> SplVariants(Function c,
+                                              Function sse41,
+                                              Function avx2) {
+  std::vector<SplVariant<Function>> variants = {{"c", c}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE4_1) != 0) {
+    variants.push_back({"sse41", sse41});
+  }
+  if (GetCPUInfo(kAVX2) != 0) {
+    variants.push_back({"avx2", avx2});
+  }
+#endif
+  return variants;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#define SPL_VARIANTS(name)                                         \
+  SplVariants<name>(WebRtcSpl_##name##C, WebRtcSpl_##name##SSE41, \
+                    WebRtcSpl_##name##AVX2)
+#else
+#define SPL_VARIANTS(name) \
+  SplVariants<name>(WebRtcSpl_##name##C, nullptr, nullptr)
+#endif
+
+void BenchmarkSpl(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("spl.")) {
+    return;
+  }
+  // Sizes of the 10 ms frames at 16 kHz processed by AECM and AGC1.
+  constexpr size_t kLength = 160;
+  constexpr size_t kNumCoefficients = 16;
+  constexpr size_t kNumLags = 40;
+  std::uniform_int_distribution<int> dist(-32768, 32767);
+  std::vector<int16_t> x(2 * kLength + kNumCoefficients);
+  std::vector<int16_t> y(2 * kLength + kNumCoefficients);
+  std::vector<int32_t> x32(kLength);
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = static_cast<int16_t>(dist(*rng));
+    y[k] = static_cast<int16_t>(dist(*rng));
+  }
+  for (size_t k = 0; k < x32.size(); ++k) {
+    x32[k] = x[k] * 65536 + y[k];
+  }
+  std::vector<int16_t> coefficients(kNumCoefficients);
+  for (int16_t& c : coefficients) {
+    c = static_cast<int16_t>(dist(*rng) / 16);
+  }
+  std::vector<int16_t> out16(kLength);
+  std::vector<int32_t> out32(kNumLags);
+
+  if (runner->Enabled("spl.MaxAbsValueW16")) {
+    for (const auto& [name, f] : SPL_VARIANTS(MaxAbsValueW16)) {
+      runner->Run("spl.MaxAbsValueW16", name, 1, kLength,
+                  [&] { g_sink = g_sink + f(x.data(), kLength); });
+    }
+  }
+  if (runner->Enabled("spl.MaxAbsValueW32")) {
+    for (const auto& [name, f] : SPL_VARIANTS(MaxAbsValueW32)) {
+      runner->Run("spl.MaxAbsValueW32", name, 1, kLength,
+                  [&] { g_sink = g_sink + f(x32.data(), kLength); });
+    }
+  }
+  if (runner->Enabled("spl.MaxValueW16")) {
+    for (const auto& [name, f] : SPL_VARIANTS(MaxValueW16)) {
+      runner->Run("spl.MaxValueW16", name, 1, kLength,
+                  [&] { g_sink = g_sink + f(x.data(), kLength); });
+    }
+  }
+  if (runner->Enabled("spl.MinValueW16")) {
+    for (const auto& [name, f] : SPL_VARIANTS(MinValueW16)) {
+      runner->Run("spl.MinValueW16", name, 1, kLength,
+                  [&] { g_sink = g_sink + f(x.data(), kLength); });
+    }
+  }
+  if (runner->Enabled("spl.CrossCorrelation")) {
+    for (const auto& [name, f] : SPL_VARIANTS(CrossCorrelation)) {
+      runner->Run("spl.CrossCorrelation", name, 1, kLength * kNumLags, [&] {
+        f(out32.data(), x.data(), y.data(), kLength, kNumLags,
+          /*right_shifts=*/2, /*step_seq2=*/1);
+        g_sink = g_sink + out32[1];
+      });
+    }
+  }
+  if (runner->Enabled("spl.DownsampleFast")) {
+    for (const auto& [name, f] : SPL_VARIANTS(DownsampleFast)) {
+      runner->Run("spl.DownsampleFast", name, 1, 2 * kLength, [&] {
+        f(x.data(), x.size(), out16.data(), kLength, coefficients.data(),
+          kNumCoefficients, /*factor=*/2, /*delay=*/kNumCoefficients - 1);
+        g_sink = g_sink + out16[1];
+      });
+    }
+  }
+  if (runner->Enabled("spl.ScaleAndAddVectorsWithRound")) {
+    for (const auto& [name, f] : SPL_VARIANTS(ScaleAndAddVectorsWithRound)) {
+      runner->Run("spl.ScaleAndAddVectorsWithRound", name, 1, kLength, [&] {
+        f(x.data(), 12345, y.data(), -5432, /*right_shifts=*/14, out16.data(),
+          kLength);
+        g_sink = g_sink + out16[1];
+      });
+    }
+  }
+}
+
+#undef SPL_VARIANTS
+
+// An AECM channel kernel, called directly instead of through the function
+// pointer selected at WebRtcAecm_InitCore() time.
+struct AecmVariant {
+  const char* name;
+  CalcLinearEnergies calc_linear_energies;
+  StoreAdaptiveChannel store_adaptive_channel;
+  ResetAdaptiveChannel reset_adaptive_channel;
+};
+
+// Returns the AECM channel kernel variants that are both compiled in and
+// supported by the CPU.
+std::vector<AecmVariant> AecmVariants() {
+  std::vector<AecmVariant> variants = {
+      {"c", WebRtcAecm_CalcLinearEnergiesC, WebRtcAecm_StoreAdaptiveChannelC,
+       WebRtcAecm_ResetAdaptiveChannelC}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+  if (GetCPUInfo(kSSE2) != 0) {
+    variants.push_back({"sse2", WebRtcAecm_CalcLinearEnergiesSse2,
+                        WebRtcAecm_StoreAdaptiveChannelSse2,
+                        WebRtcAecm_ResetAdaptiveChannelSse2});
+  }
+#endif
+  if (GetCPUInfo(kAVX2) != 0) {
+    variants.push_back({"avx2", WebRtcAecm_CalcLinearEnergiesAvx2,
+                        WebRtcAecm_StoreAdaptiveChannelAvx2,
+                        WebRtcAecm_ResetAdaptiveChannelAvx2});
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  variants.push_back({"neon", WebRtcAecm_CalcLinearEnergiesNeon,
+                      WebRtcAecm_StoreAdaptiveChannelNeon,
+                      WebRtcAecm_ResetAdaptiveChannelNeon});
+#endif
+  return variants;
+}
+
+void BenchmarkAecm(Runner* runner, std::mt19937* rng) {
+  if (!runner->Enabled("aecm.")) {
+    return;
+  }
+  AecmCore* aecm = WebRtcAecm_CreateCore();
+  WebRtcAecm_InitCore(aecm, /*samplingFreq=*/16000);
+  // The channel taps may be negative, which the x86 kernels handle bit-exactly.
+  std::uniform_int_distribution<int> tap_dist(-4096, 4096);
+  std::uniform_int_distribution<int> spectrum_dist(0, 65535);
+  for (size_t k = 0; k < PART_LEN1; ++k) {
+    aecm->channelStored[k] = static_cast<int16_t>(tap_dist(*rng));
+    aecm->channelAdapt16[k] = static_cast<int16_t>(tap_dist(*rng));
+  }
+  std::array<uint16_t, PART_LEN1> far_spectrum;
+  for (uint16_t& v : far_spectrum) {
+    v = static_cast<uint16_t>(spectrum_dist(*rng));
+  }
+  std::array<int32_t, PART_LEN1> echo_est;
+
+  for (const AecmVariant& variant : AecmVariants()) {
+    runner->Run("aecm.CalcLinearEnergies", variant.name, 1, PART_LEN1, [&] {
+      uint32_t far_energy = 0;
+      uint32_t echo_energy_adapt = 0;
+      uint32_t echo_energy_stored = 0;
+      variant.calc_linear_energies(aecm, far_spectrum.data(), echo_est.data(),
+                                   &far_energy, &echo_energy_adapt,
+                                   &echo_energy_stored);
+      g_sink = g_sink + echo_energy_stored;
+    });
+    runner->Run("aecm.StoreAdaptiveChannel", variant.name, 1, PART_LEN1, [&] {
+      variant.store_adaptive_channel(aecm, far_spectrum.data(),
+                                     echo_est.data());
+      g_sink = g_sink + echo_est[1];
+    });
+    runner->Run("aecm.ResetAdaptiveChannel", variant.name, 1, PART_LEN1, [&] {
+      variant.reset_adaptive_channel(aecm);
+      g_sink = g_sink + aecm->channelAdapt32[1];
+    });
+  }
+  WebRtcAecm_FreeCore(aecm);
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int k = 1; k < argc; ++k) {
+    const char* arg = argv[k];
+    if (strcmp(arg, "--json") == 0) {
+      options->json = true;
+    } else if (strncmp(arg, "--filter=", 9) == 0) {
+      options->filter = arg + 9;
+    } else if (strncmp(arg, "--min-time-ms=", 14) == 0) {
+      options->min_time_ms = atof(arg + 14);
+      if (options->min_time_ms <= 0.0) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char** argv) {
+  webrtc::Options options;
+  if (!webrtc::ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "Usage: %s [--json] [--filter=<substring>] [--min-time-ms=<ms>]\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  webrtc::Runner runner(options);
+  std::mt19937 rng(42);
+  webrtc::BenchmarkAdaptiveFilter(&runner, &rng);
+  webrtc::BenchmarkErl(&runner, &rng);
+  webrtc::BenchmarkMatchedFilter(&runner, &rng);
+  webrtc::BenchmarkOouraFft(&runner, &rng);
+  webrtc::BenchmarkAec3Fft(&runner, &rng);
+  webrtc::BenchmarkNrFft(&runner, &rng);
+  webrtc::BenchmarkPffft(&runner, &rng);
+  webrtc::BenchmarkFullyConnectedLayer(&runner, &rng);
+  webrtc::BenchmarkThreeBandFilterBank(&runner, &rng);
+  webrtc::BenchmarkSincResampler(&runner, &rng);
+  webrtc::BenchmarkSpl(&runner, &rng);
+  webrtc::BenchmarkAecm(&runner, &rng);
+
+  if (options.json) {
+    runner.PrintJson();
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,911 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Consistency checks for the processing paths that must give the same output
+// as a reference path, e.g., the parallel AEC3 channel processing against the
+// serial one, or the PFFFT transforms of the noise suppressor against the
+// Ooura ones.
+//
+// Every check runs the path under test and the reference path on the same
+// synthetic input, and compares the outputs, either bit-exactly or within the
+// tolerance documented for the path. Recording checks compare what an AecDump
+// recorded with what was processed. The process exits with a non-zero status
+// if any check fails.
+//
+// Usage: apm-check [--filter=<substring>]
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "api/audio/audio_processing.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump_config.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump_reader.h"
+#include "modules/audio_processing/include/audio_processing_batch.h"
+#include "modules/audio_processing/include/audio_processing_pool.h"
+#include "modules/audio_processing/echo_detector/lagged_covariance_estimator.h"
+#include "modules/audio_processing/echo_detector/normalized_covariance_estimator.h"
+#include "modules/audio_processing/ns/ns_common.h"
+#include "modules/audio_processing/ns/ns_fft.h"
+#include "modules/audio_processing/three_band_filter_bank.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
+#include "rtc_base/system/arch.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kFrameSize = kSampleRateHz / 100;
+constexpr size_t kNumFrames = 500;
+constexpr int kEchoDelayMs = 40;
+
+// Render and capture audio of a synthetic echo scenario: the capture is a
+// delayed and attenuated copy of the render plus near-end noise, with a
+// different echo gain per capture channel.
+struct Scenario {
+  Scenario(size_t num_render_channels,
+           size_t num_capture_channels,
+           int sample_rate_hz = kSampleRateHz,
+           size_t num_frames = kNumFrames,
+           int echo_delay_ms = kEchoDelayMs)
+      : render_config(sample_rate_hz, num_render_channels),
+        capture_config(sample_rate_hz, num_capture_channels),
+        render(num_frames * render_config.num_samples()),
+        capture(num_frames * capture_config.num_samples()) {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> far_end(0.f, 3000.f);
+    std::normal_distribution<float> near_end(0.f, 100.f);
+    std::vector<float> mono(num_frames * render_config.num_frames());
+    for (float& x : mono) {
+      x = far_end(rng);
+    }
+    const size_t echo_delay = echo_delay_ms * sample_rate_hz / 1000;
+    for (size_t k = 0; k < mono.size(); ++k) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        render[k * num_render_channels + ch] = static_cast<int16_t>(mono[k]);
+      }
+      const float echo = k >= echo_delay ? mono[k - echo_delay] : 0.f;
+      for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+        const float gain = 0.5f / (ch + 1);
+        capture[k * num_capture_channels + ch] =
+            static_cast<int16_t>(gain * echo + near_end(rng));
+      }
+    }
+  }
+
+  rtc::ArrayView<const int16_t> RenderFrame(size_t frame) const {
+    const size_t size = render_config.num_samples();
+    return rtc::ArrayView<const int16_t>(&render[frame * size], size);
+  }
+
+  rtc::ArrayView<const int16_t> CaptureFrame(size_t frame) const {
+    const size_t size = capture_config.num_samples();
+    return rtc::ArrayView<const int16_t>(&capture[frame * size], size);
+  }
+
+  const StreamConfig render_config;
+  const StreamConfig capture_config;
+  std::vector<int16_t> render;
+  std::vector<int16_t> capture;
+};
+
+rtc::scoped_refptr<AudioProcessing> CreateApm(
+    const AudioProcessing::Config& config) {
+  rtc::scoped_refptr<AudioProcessing> apm = AudioProcessingBuilder().Create();
+  apm->ApplyConfig(config);
+  return apm;
+}
+
+// Processes the frames [`begin_frame`, `end_frame`) of `scenario` with `apm`
+// and appends the capture output to `output`. Returns false on error.
+bool Process(const Scenario& scenario,
+             size_t begin_frame,
+             size_t end_frame,
+             AudioProcessing& apm,
+             std::vector<int16_t>* output) {
+  std::vector<int16_t> render(scenario.RenderFrame(0).size());
+  std::vector<int16_t> capture(scenario.CaptureFrame(0).size());
+  for (size_t frame = begin_frame; frame < end_frame; ++frame) {
+    const rtc::ArrayView<const int16_t> render_frame =
+        scenario.RenderFrame(frame);
+    const rtc::ArrayView<const int16_t> capture_frame =
+        scenario.CaptureFrame(frame);
+    std::copy(render_frame.begin(), render_frame.end(), render.begin());
+    std::copy(capture_frame.begin(), capture_frame.end(), capture.begin());
+    if (apm.ProcessReverseStream(render.data(), scenario.render_config,
+                                 scenario.render_config, render.data()) !=
+        AudioProcessing::kNoError) {
+      return false;
+    }
+    apm.set_stream_delay_ms(0);
+    if (apm.ProcessStream(capture.data(), scenario.capture_config,
+                          scenario.capture_config, capture.data()) !=
+        AudioProcessing::kNoError) {
+      return false;
+    }
+    output->insert(output->end(), capture.begin(), capture.end());
+  }
+  return true;
+}
+
+// Returns true if `a` and `b` have the same size and differ by at most
+// `tolerance` per sample. Prints the first mismatch otherwise.
+bool Compare(const std::vector<int16_t>& a,
+             const std::vector<int16_t>& b,
+             int tolerance) {
+  if (a.size() != b.size()) {
+    printf("  output sizes differ: %zu vs %zu\n", a.size(), b.size());
+    return false;
+  }
+  for (size_t k = 0; k < a.size(); ++k) {
+    if (std::abs(a[k] - b[k]) > tolerance) {
+      printf("  sample %zu differs: %d vs %d\n", k, a[k], b[k]);
+      return false;
+    }
+  }
+  return true;
+}
+
+AudioProcessing::Config EchoCancellerConfig() {
+  AudioProcessing::Config config;
+  config.echo_canceller.enabled = true;
+  config.high_pass_filter.enabled = true;
+  return config;
+}
+
+// The parallel AEC3 channel processing must be bit-exact with the serial one.
+bool CheckAec3ParallelChannels() {
+  const Scenario scenario(/*num_render_channels=*/2,
+                          /*num_capture_channels=*/4);
+  AudioProcessing::Config config = EchoCancellerConfig();
+  rtc::scoped_refptr<AudioProcessing> serial = CreateApm(config);
+  config.echo_canceller.capture_channel_worker_threads = 3;
+  rtc::scoped_refptr<AudioProcessing> parallel = CreateApm(config);
+
+  std::vector<int16_t> serial_output;
+  std::vector<int16_t> parallel_output;
+  if (!Process(scenario, 0, kNumFrames, *serial, &serial_output) ||
+      !Process(scenario, 0, kNumFrames, *parallel, &parallel_output)) {
+    printf("  processing failed\n");
+    return false;
+  }
+  return Compare(serial_output, parallel_output, /*tolerance=*/0);
+}
+
+// Returns the largest absolute difference between `a` and `b`.
+float MaxDifference(rtc::ArrayView<const float> a,
+                    rtc::ArrayView<const float> b) {
+  float max_difference = 0.f;
+  for (size_t k = 0; k < a.size(); ++k) {
+    max_difference = std::max(max_difference, std::fabs(a[k] - b[k]));
+  }
+  return max_difference;
+}
+
+// Returns the largest magnitude in `x`.
+float MaxMagnitude(rtc::ArrayView<const float> x) {
+  float max_magnitude = 0.f;
+  for (float v : x) {
+    max_magnitude = std::max(max_magnitude, std::fabs(v));
+  }
+  return max_magnitude;
+}
+
+// The PFFFT transforms of the noise suppressor must match the Ooura ones
+// within the tolerance documented for NrFft::Implementation.
+bool CheckNsPffftTransforms() {
+  if (!Pffft::IsSimdEnabled()) {
+    printf("  PFFFT is built without SIMD, nothing to compare\n");
+    return true;
+  }
+  constexpr float kTolerance = 1e-6f;
+  NrFft ooura(NrFft::Implementation::kOoura);
+  NrFft pffft(NrFft::Implementation::kPffft);
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-32768.f, 32767.f);
+  for (int trial = 0; trial < 100; ++trial) {
+    std::array<float, kFftSize> x;
+    for (float& v : x) {
+      v = dist(rng);
+    }
+    std::array<float, kFftSize> time_data = x;
+    std::array<float, kFftSize> real_ooura;
+    std::array<float, kFftSize> imag_ooura;
+    ooura.Fft(time_data, real_ooura, imag_ooura);
+    time_data = x;
+    std::array<float, kFftSize> real_pffft;
+    std::array<float, kFftSize> imag_pffft;
+    pffft.Fft(time_data, real_pffft, imag_pffft);
+
+    const float spectrum_peak =
+        std::max(MaxMagnitude(rtc::ArrayView<const float>(real_ooura.data(),
+                                                          kFftSizeBy2Plus1)),
+                 MaxMagnitude(rtc::ArrayView<const float>(imag_ooura.data(),
+                                                          kFftSizeBy2Plus1)));
+    const float spectrum_difference = std::max(
+        MaxDifference(
+            rtc::ArrayView<const float>(real_ooura.data(), kFftSizeBy2Plus1),
+            rtc::ArrayView<const float>(real_pffft.data(), kFftSizeBy2Plus1)),
+        MaxDifference(
+            rtc::ArrayView<const float>(imag_ooura.data(), kFftSizeBy2Plus1),
+            rtc::ArrayView<const float>(imag_pffft.data(), kFftSizeBy2Plus1)));
+    if (spectrum_difference > kTolerance * spectrum_peak) {
+      printf("  Fft differs by %g relative to the peak\n",
+             spectrum_difference / spectrum_peak);
+      return false;
+    }
+
+    std::array<float, kFftSize> y_ooura;
+    std::array<float, kFftSize> y_pffft;
+    ooura.Ifft(real_ooura, imag_ooura, y_ooura);
+    pffft.Ifft(real_ooura, imag_ooura, y_pffft);
+    const float time_peak = MaxMagnitude(y_ooura);
+    const float time_difference = MaxDifference(y_ooura, y_pffft);
+    if (time_difference > kTolerance * time_peak) {
+      printf("  Ifft differs by %g relative to the peak\n",
+             time_difference / time_peak);
+      return false;
+    }
+  }
+  return true;
+}
+
+// With the PFFFT transforms, the int16 noise suppressor output must stay
+// within one LSB of the output with the Ooura transforms.
+bool CheckNsPffftOutput() {
+  const Scenario scenario(/*num_render_channels=*/1,
+                          /*num_capture_channels=*/2);
+  AudioProcessing::Config config;
+  config.noise_suppression.enabled = true;
+  rtc::scoped_refptr<AudioProcessing> ooura = CreateApm(config);
+  config.noise_suppression.use_pffft = true;
+  rtc::scoped_refptr<AudioProcessing> pffft = CreateApm(config);
+
+  std::vector<int16_t> ooura_output;
+  std::vector<int16_t> pffft_output;
+  if (!Process(scenario, 0, kNumFrames, *ooura, &ooura_output) ||
+      !Process(scenario, 0, kNumFrames, *pffft, &pffft_output)) {
+    printf("  processing failed\n");
+    return false;
+  }
+  return Compare(ooura_output, pffft_output, /*tolerance=*/1);
+}
+
+// Runs analysis and synthesis of random frames through a three-band filter
+// bank with `implementation`, and appends the bands and the resynthesized
+// frames to `output`.
+void RunThreeBandFilterBank(ThreeBandFilterBank::Implementation implementation,
+                            std::vector<float>* output) {
+  constexpr int kNumFrames = 50;
+  ThreeBandFilterBank filter_bank(implementation);
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(-32768.f, 32767.f);
+  std::array<float, ThreeBandFilterBank::kFullBandSize> in;
+  std::array<float, ThreeBandFilterBank::kFullBandSize> out;
+  std::array<std::array<float, ThreeBandFilterBank::kSplitBandSize>,
+             ThreeBandFilterBank::kNumBands>
+      bands;
+  std::array<rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands> band_views;
+  for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+    band_views[band] = bands[band];
+  }
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    for (float& v : in) {
+      v = dist(rng);
+    }
+    filter_bank.Analysis(in, band_views);
+    for (const auto& band : bands) {
+      output->insert(output->end(), band.begin(), band.end());
+    }
+    filter_bank.Synthesis(band_views, out);
+    output->insert(output->end(), out.begin(), out.end());
+  }
+}
+
+// The default three-band filter bank must be bit-exact with the scalar
+// kernels, and the opt-in AVX2 kernels must differ from them by rounding only.
+bool CheckThreeBandFilterBank() {
+  std::vector<float> reference;
+  RunThreeBandFilterBank(ThreeBandFilterBank::Implementation::kScalar,
+                         &reference);
+  const ThreeBandFilterBank::Implementation default_implementation =
+      ThreeBandFilterBank().implementation();
+  if (default_implementation == ThreeBandFilterBank::Implementation::kAvx2) {
+    printf("  the default implementation uses fused multiply-adds\n");
+    return false;
+  }
+  std::vector<float> output;
+  RunThreeBandFilterBank(default_implementation, &output);
+  if (output != reference) {
+    printf("  the default implementation is not bit-exact\n");
+    return false;
+  }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (GetCPUInfo(kAVX2) != 0) {
+    constexpr float kTolerance = 1e-5f;
+    output.clear();
+    RunThreeBandFilterBank(ThreeBandFilterBank::Implementation::kAvx2,
+                           &output);
+    const float difference = MaxDifference(reference, output);
+    const float peak = MaxMagnitude(reference);
+    if (difference > kTolerance * peak) {
+      printf("  AVX2 differs by %g relative to the peak\n",
+             difference / peak);
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+// The default lag covariance sweep of the residual echo detector must be
+// bit-exact with one NormalizedCovarianceEstimator per lag, and the opt-in
+// AVX2 sweep must differ from it by rounding only.
+bool CheckLaggedCovariances() {
+  // Not a multiple of the SIMD widths, so that the tails are covered.
+  constexpr size_t kNumLags = 67;
+  constexpr int kNumUpdates = 2000;
+  std::vector<NormalizedCovarianceEstimator> reference(kNumLags);
+  LaggedCovarianceEstimator lagged(kNumLags);
+  std::unique_ptr<LaggedCovarianceEstimator> lagged_avx2;
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (GetCPUInfo(kAVX2) != 0) {
+    lagged_avx2 = std::make_unique<LaggedCovarianceEstimator>(
+        kNumLags, LaggedCovarianceEstimator::Implementation::kAvx2);
+  }
+#endif
+  if (lagged.implementation() ==
+      LaggedCovarianceEstimator::Implementation::kAvx2) {
+    printf("  the default implementation uses fused multiply-adds\n");
+    return false;
+  }
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(0.f, 1.f);
+  // History of y, its mean and its sigma, with the latest value first.
+  std::vector<std::array<float, 3>> y_history(kNumLags, {0.f, 0.f, 0.f});
+  for (int n = 0; n < kNumUpdates; ++n) {
+    const float x = dist(rng);
+    const float x_mean = 0.5f;
+    const float x_sigma = 0.3f;
+    const std::array<float, 3> y = {dist(rng), 0.4f + 0.2f * dist(rng),
+                                    0.2f + 0.2f * dist(rng)};
+    y_history.pop_back();
+    y_history.insert(y_history.begin(), y);
+
+    float max_normalized_cross_correlation = 0.f;
+    for (size_t k = 0; k < kNumLags; ++k) {
+      reference[k].Update(x, x_mean, x_sigma, y_history[k][0],
+                          y_history[k][1], y_history[k][2]);
+      max_normalized_cross_correlation =
+          std::max(max_normalized_cross_correlation,
+                   reference[k].normalized_cross_correlation());
+    }
+    lagged.Update(x, x_mean, x_sigma, y[0], y[1], y[2]);
+    for (size_t k = 0; k < kNumLags; ++k) {
+      if (lagged.covariance(k) != reference[k].covariance()) {
+        printf("  covariance of lag %zu differs at update %d\n", k, n);
+        return false;
+      }
+    }
+    if (lagged.max_normalized_cross_correlation() !=
+        max_normalized_cross_correlation) {
+      printf("  largest normalized covariance differs at update %d\n", n);
+      return false;
+    }
+
+    if (lagged_avx2) {
+      constexpr float kTolerance = 1e-4f;
+      lagged_avx2->Update(x, x_mean, x_sigma, y[0], y[1], y[2]);
+      if (std::fabs(lagged_avx2->max_normalized_cross_correlation() -
+                    max_normalized_cross_correlation) >
+          kTolerance * std::max(max_normalized_cross_correlation, 1.f)) {
+        printf("  AVX2 largest normalized covariance differs at update %d\n",
+               n);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Creates an empty temporary file and returns its path, or an empty string if
+// that fails.
+std::string CreateTemporaryFile() {
+  char path[] = "/tmp/apm-check-XXXXXX";
+  const int fd = mkstemp(path);
+  if (fd < 0) {
+    printf("  cannot create a temporary file\n");
+    return std::string();
+  }
+  close(fd);
+  return path;
+}
+
+// Returns the contents of the file `path`, and removes it.
+std::vector<uint8_t> ReadAndRemoveFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+  remove(path.c_str());
+  return data;
+}
+
+// Records what `process` does with `apm` with a BinaryAecDump, and appends the
+// layouts of the recorded render frames to `layouts`. Returns false if the
+// processing or the recording fails.
+bool RecordRenderLayouts(AudioProcessing& apm,
+                         const std::function<bool()>& process,
+                         std::vector<binary_aec_dump::AudioLayout>* layouts) {
+  const std::string path = CreateTemporaryFile();
+  if (path.empty()) {
+    return false;
+  }
+  apm.AttachAecDump(std::make_unique<BinaryAecDump>(
+      FileWrapper::OpenWriteOnly(path), /*max_log_size_bytes=*/-1));
+  const bool processed = process();
+  // Writes the queued records and closes the file.
+  apm.DetachAecDump();
+
+  const std::vector<uint8_t> data = ReadAndRemoveFile(path);
+  if (!processed) {
+    printf("  processing failed\n");
+    return false;
+  }
+  BinaryAecDumpReader reader(data);
+  if (!reader.valid()) {
+    printf("  invalid recording\n");
+    return false;
+  }
+  BinaryAecDumpReader::Record record;
+  while (reader.ReadRecord(&record)) {
+    binary_aec_dump::RenderPayload render;
+    rtc::ArrayView<const uint8_t> audio;
+    if (record.type == binary_aec_dump::RecordType::kRender) {
+      if (!BinaryAecDumpReader::ParseRender(record, &render, &audio)) {
+        printf("  malformed render record\n");
+        return false;
+      }
+      layouts->push_back(render.audio);
+    }
+  }
+  return !reader.truncated();
+}
+
+// The int16 render frames must be recorded with the channel count and frame
+// size of the render stream, on the single-session path as well as on the
+// batched and the shared render paths.
+bool CheckAecDumpRenderLayout() {
+  const Scenario scenario(/*num_render_channels=*/2,
+                          /*num_capture_channels=*/1);
+  constexpr size_t kNumRecordedFrames = 10;
+  const StreamConfig& render_config = scenario.render_config;
+  const StreamConfig& capture_config = scenario.capture_config;
+  std::vector<binary_aec_dump::AudioLayout> layouts;
+
+  rtc::scoped_refptr<AudioProcessing> apm = CreateApm(EchoCancellerConfig());
+  std::vector<int16_t> output;
+  if (!RecordRenderLayouts(
+          *apm,
+          [&] {
+            return Process(scenario, 0, kNumRecordedFrames, *apm, &output);
+          },
+          &layouts)) {
+    return false;
+  }
+
+  AudioProcessingBatch batch(EchoCancellerConfig(), render_config,
+                             capture_config, /*num_sessions=*/1);
+  const AudioProcessingBatch::SessionId session_id = batch.session_ids()[0];
+  std::vector<int16_t> render(scenario.RenderFrame(0).size());
+  std::vector<int16_t> capture(scenario.CaptureFrame(0).size());
+  auto process_batch = [&](bool shared_render) {
+    for (size_t frame = 0; frame < kNumRecordedFrames; ++frame) {
+      const rtc::ArrayView<const int16_t> render_frame =
+          scenario.RenderFrame(frame);
+      const rtc::ArrayView<const int16_t> capture_frame =
+          scenario.CaptureFrame(frame);
+      std::copy(render_frame.begin(), render_frame.end(), render.begin());
+      std::copy(capture_frame.begin(), capture_frame.end(), capture.begin());
+      AudioProcessingBatch::Frame frames[1];
+      frames[0].session_id = session_id;
+      frames[0].capture_audio = capture.data();
+      frames[0].stream_delay_ms = 0;
+      int error;
+      if (shared_render) {
+        error = batch.ProcessStreamsWithSharedRender(render.data(), frames);
+      } else {
+        frames[0].render_audio = render.data();
+        error = batch.ProcessStreams(frames);
+      }
+      if (error != AudioProcessing::kNoError) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!RecordRenderLayouts(
+          *batch.session(session_id), [&] { return process_batch(false); },
+          &layouts) ||
+      !RecordRenderLayouts(
+          *batch.session(session_id), [&] { return process_batch(true); },
+          &layouts)) {
+    return false;
+  }
+
+  if (layouts.size() != 3 * kNumRecordedFrames) {
+    printf("  %zu render frames recorded instead of %zu\n", layouts.size(),
+           3 * kNumRecordedFrames);
+    return false;
+  }
+  for (size_t k = 0; k < layouts.size(); ++k) {
+    const binary_aec_dump::AudioLayout& layout = layouts[k];
+    if (layout.format != binary_aec_dump::AudioLayout::kInt16 ||
+        layout.num_channels !=
+            static_cast<int32_t>(render_config.num_channels()) ||
+        layout.samples_per_channel !=
+            static_cast<int32_t>(render_config.num_frames())) {
+      printf("  render frame %zu recorded as %d channels of %d samples\n", k,
+             layout.num_channels, layout.samples_per_channel);
+      return false;
+    }
+  }
+  return true;
+}
+
+// A kDropped record must be written where records are missing, so that the
+// last kDropped record in front of each recorded render frame counts the
+// frames dropped before it.
+bool CheckAecDumpDroppedRecords() {
+  constexpr int kNumRenderFrames = 2000;
+  // Room for about 15 frames, so that bursts of writes in a tight loop outpace
+  // the background writer, which catches up in the pauses between the bursts.
+  constexpr size_t kRingSizeBytes = 16 * 1024;
+  constexpr int kBurstSize = 100;
+  const std::string path = CreateTemporaryFile();
+  if (path.empty()) {
+    return false;
+  }
+  int64_t num_dropped;
+  {
+    BinaryAecDump dump(FileWrapper::OpenWriteOnly(path),
+                       /*max_log_size_bytes=*/-1, kRingSizeBytes);
+    std::vector<int16_t> frame(kFrameSize);
+    for (int k = 0; k < kNumRenderFrames; ++k) {
+      if (k % kBurstSize == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      }
+      frame[0] = static_cast<int16_t>(k);
+      dump.WriteRenderStreamMessage(frame.data(), /*num_channels=*/1,
+                                    kFrameSize);
+    }
+    num_dropped = dump.num_dropped_records();
+  }
+
+  const std::vector<uint8_t> data = ReadAndRemoveFile(path);
+  BinaryAecDumpReader reader(data);
+  if (!reader.valid()) {
+    printf("  invalid recording\n");
+    return false;
+  }
+  int64_t num_recorded = 0;
+  int64_t num_marked_dropped = 0;
+  BinaryAecDumpReader::Record record;
+  while (reader.ReadRecord(&record)) {
+    if (record.type == binary_aec_dump::RecordType::kDropped) {
+      binary_aec_dump::DroppedPayload dropped;
+      if (!BinaryAecDumpReader::ParseDropped(record, &dropped)) {
+        printf("  malformed dropped record\n");
+        return false;
+      }
+      num_marked_dropped = dropped.num_dropped_records;
+      continue;
+    }
+    binary_aec_dump::RenderPayload render;
+    rtc::ArrayView<const uint8_t> audio;
+    if (!BinaryAecDumpReader::ParseRender(record, &render, &audio)) {
+      printf("  malformed render record\n");
+      return false;
+    }
+    int16_t frame_index;
+    memcpy(&frame_index, audio.data(), sizeof(frame_index));
+    if (frame_index != num_recorded + num_marked_dropped) {
+      printf("  frame %d recorded after %lld frames and %lld marked drops\n",
+             frame_index, static_cast<long long>(num_recorded),
+             static_cast<long long>(num_marked_dropped));
+      return false;
+    }
+    ++num_recorded;
+  }
+  if (reader.truncated() || num_recorded + num_dropped != kNumRenderFrames) {
+    printf("  %lld frames recorded and %lld dropped out of %d\n",
+           static_cast<long long>(num_recorded),
+           static_cast<long long>(num_dropped), kNumRenderFrames);
+    return false;
+  }
+  if (num_dropped == 0) {
+    printf("  no frames dropped, nothing to check\n");
+  }
+  return true;
+}
+
+// Every ApplyConfig() must be recorded with the complete configuration, and
+// with the configs given to the built-in echo canceller.
+bool CheckAecDumpConfig() {
+  const Scenario scenario(/*num_render_channels=*/1,
+                          /*num_capture_channels=*/2);
+  AudioProcessing::Config first_config = EchoCancellerConfig();
+  first_config.echo_canceller.capture_channel_worker_threads = 1;
+  first_config.noise_suppression.enabled = true;
+  first_config.noise_suppression.level =
+      AudioProcessing::Config::NoiseSuppression::kVeryHigh;
+  first_config.noise_suppression.use_pffft = true;
+  first_config.gain_controller2.enabled = true;
+  first_config.gain_controller2.adaptive_digital.enabled = true;
+  first_config.gain_controller2.adaptive_digital.headroom_db = 7.5f;
+  // Only changes fields that are not compared to detect config changes.
+  AudioProcessing::Config second_config = first_config;
+  second_config.gain_controller2.fixed_digital.gain_db = 3.f;
+  second_config.high_pass_filter.apply_in_full_band = false;
+
+  const std::string path = CreateTemporaryFile();
+  if (path.empty()) {
+    return false;
+  }
+  rtc::scoped_refptr<AudioProcessing> apm = CreateApm(first_config);
+  apm->AttachAecDump(std::make_unique<BinaryAecDump>(
+      FileWrapper::OpenWriteOnly(path), /*max_log_size_bytes=*/-1));
+  std::vector<int16_t> output;
+  bool processed = Process(scenario, 0, 10, *apm, &output);
+  apm->ApplyConfig(second_config);
+  processed = processed && Process(scenario, 10, 20, *apm, &output);
+  apm->DetachAecDump();
+
+  const std::vector<uint8_t> data = ReadAndRemoveFile(path);
+  if (!processed) {
+    printf("  processing failed\n");
+    return false;
+  }
+  BinaryAecDumpReader reader(data);
+  std::vector<InternalAPMConfig> recorded;
+  BinaryAecDumpReader::Record record;
+  while (reader.valid() && reader.ReadRecord(&record)) {
+    if (record.type == binary_aec_dump::RecordType::kConfig) {
+      recorded.emplace_back();
+      if (!BinaryAecDumpReader::ParseConfig(record, &recorded.back())) {
+        printf("  malformed config record\n");
+        return false;
+      }
+    }
+  }
+  if (recorded.size() != 2) {
+    printf("  %zu config records instead of 2\n", recorded.size());
+    return false;
+  }
+
+  const AudioProcessing::Config* expected[] = {&first_config, &second_config};
+  for (size_t k = 0; k < recorded.size(); ++k) {
+    // Compares all the fields of the configs.
+    InternalAPMConfig recorded_config;
+    InternalAPMConfig expected_config;
+    recorded_config.config = recorded[k].config;
+    expected_config.config = *expected[k];
+    std::vector<uint8_t> recorded_fields;
+    std::vector<uint8_t> expected_fields;
+    binary_aec_dump::WriteFullConfig(recorded_config, &recorded_fields);
+    binary_aec_dump::WriteFullConfig(expected_config, &expected_fields);
+    if (recorded_fields != expected_fields) {
+      printf("  config %zu recorded as %s\n", k,
+             recorded[k].config.ToString().c_str());
+      return false;
+    }
+    if (!recorded[k].echo_canceller3_config ||
+        recorded[k]
+                .echo_canceller3_config->multi_channel
+                .capture_channel_worker_threads != 1) {
+      printf("  config %zu lacks the echo canceller config\n", k);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the energy of `samples`.
+double Energy(const std::vector<int16_t>& samples) {
+  double energy = 0.0;
+  for (int16_t sample : samples) {
+    energy += static_cast<double>(sample) * sample;
+  }
+  return energy;
+}
+
+// An instance restoring the converged state of another instance must leave
+// less echo than a new instance during the first 0.5 s, on the same echo path.
+bool CheckAec3WarmStart() {
+  constexpr size_t kNumConvergenceFrames = 1000;
+  constexpr size_t kNumWarmStartFrames = 50;
+  const Scenario scenario(/*num_render_channels=*/1, /*num_capture_channels=*/1,
+                          /*sample_rate_hz=*/16000,
+                          kNumConvergenceFrames + kNumWarmStartFrames,
+                          /*echo_delay_ms=*/60);
+  const AudioProcessing::Config config = EchoCancellerConfig();
+
+  rtc::scoped_refptr<AudioProcessing> converged = CreateApm(config);
+  std::vector<int16_t> output;
+  if (!Process(scenario, 0, kNumConvergenceFrames, *converged, &output)) {
+    printf("  processing failed\n");
+    return false;
+  }
+  std::vector<uint8_t> state;
+  converged->SaveConvergedState(&state);
+
+  rtc::scoped_refptr<AudioProcessing> restored = CreateApm(config);
+  if (!restored->RestoreConvergedState(state)) {
+    printf("  the state was not restored\n");
+    return false;
+  }
+  rtc::scoped_refptr<AudioProcessing> fresh = CreateApm(config);
+  std::vector<int16_t> restored_output;
+  std::vector<int16_t> fresh_output;
+  if (!Process(scenario, kNumConvergenceFrames,
+               kNumConvergenceFrames + kNumWarmStartFrames, *restored,
+               &restored_output) ||
+      !Process(scenario, kNumConvergenceFrames,
+               kNumConvergenceFrames + kNumWarmStartFrames, *fresh,
+               &fresh_output)) {
+    printf("  processing failed\n");
+    return false;
+  }
+  const double restored_energy = Energy(restored_output);
+  const double fresh_energy = Energy(fresh_output);
+  if (restored_energy >= fresh_energy) {
+    printf("  output energy %.4g after the restore vs %.4g when new\n",
+           restored_energy, fresh_energy);
+    return false;
+  }
+  return true;
+}
+
+// An instance reused by AudioProcessingPool must give the same output as a new
+// instance, whatever its previous user did with it.
+bool CheckPoolReuse() {
+  const Scenario scenario(/*num_render_channels=*/2,
+                          /*num_capture_channels=*/2);
+  AudioProcessing::Config config = EchoCancellerConfig();
+  config.noise_suppression.enabled = true;
+  config.gain_controller1.enabled = true;
+  config.gain_controller1.mode =
+      AudioProcessing::Config::GainController1::kAdaptiveDigital;
+  config.gain_controller1.analog_gain_controller.enabled = false;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  constexpr size_t kNumUsedFrames = 150;
+
+  AudioProcessingPool pool(/*max_pooled_instances_per_key=*/1);
+  rtc::scoped_refptr<AudioProcessing> apm = pool.Acquire(
+      config, scenario.render_config, scenario.capture_config);
+  // Leaves audio, settings and stream parameters behind.
+  std::vector<int16_t> output;
+  if (!Process(scenario, 0, kNumUsedFrames, *apm, &output)) {
+    printf("  processing failed\n");
+    return false;
+  }
+  std::vector<int16_t> render(scenario.RenderFrame(0).size());
+  std::copy(scenario.RenderFrame(0).begin(), scenario.RenderFrame(0).end(),
+            render.begin());
+  if (apm->ProcessReverseStream(render.data(), scenario.render_config,
+                                scenario.render_config, render.data()) !=
+      AudioProcessing::kNoError) {
+    printf("  processing failed\n");
+    return false;
+  }
+  apm->set_stream_delay_ms(120);
+  apm->set_stream_key_pressed(true);
+  apm->set_stream_analog_level(100);
+  apm->SetRuntimeSetting(
+      AudioProcessing::RuntimeSetting::CreatePlayoutVolumeChange(50));
+  apm->SetRuntimeSetting(
+      AudioProcessing::RuntimeSetting::CreateCaptureOutputUsedSetting(false));
+  pool.Release(std::move(apm));
+
+  rtc::scoped_refptr<AudioProcessing> reused = pool.Acquire(
+      config, scenario.render_config, scenario.capture_config);
+  if (pool.GetStats().num_hits != 1) {
+    printf("  the instance was not reused\n");
+    return false;
+  }
+  AudioProcessingPool fresh_pool(/*max_pooled_instances_per_key=*/1);
+  rtc::scoped_refptr<AudioProcessing> fresh = fresh_pool.Acquire(
+      config, scenario.render_config, scenario.capture_config);
+  std::vector<int16_t> reused_output;
+  std::vector<int16_t> fresh_output;
+  if (!Process(scenario, 0, kNumFrames, *reused, &reused_output) ||
+      !Process(scenario, 0, kNumFrames, *fresh, &fresh_output)) {
+    printf("  processing failed\n");
+    return false;
+  }
+  if (!Compare(reused_output, fresh_output, /*tolerance=*/0)) {
+    return false;
+  }
+
+  // Dropping the last reference, without Release(), also gives it back.
+  reused = nullptr;
+  if (pool.GetStats().num_pooled_instances != 1) {
+    printf("  the dropped instance was not pooled\n");
+    return false;
+  }
+  return true;
+}
+
+struct Check {
+  const char* name;
+  std::function<bool()> run;
+};
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::string filter;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else {
+      fprintf(stderr, "Usage: %s [--filter=<substring>]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  const webrtc::Check checks[] = {
+      {"aec3_parallel_channels", webrtc::CheckAec3ParallelChannels},
+      {"ns_pffft_transforms", webrtc::CheckNsPffftTransforms},
+      {"ns_pffft_output", webrtc::CheckNsPffftOutput},
+      {"three_band_filter_bank", webrtc::CheckThreeBandFilterBank},
+      {"echo_detector_covariances", webrtc::CheckLaggedCovariances},
+      {"aec_dump_render_layout", webrtc::CheckAecDumpRenderLayout},
+      {"aec_dump_dropped_records", webrtc::CheckAecDumpDroppedRecords},
+      {"aec_dump_config", webrtc::CheckAecDumpConfig},
+      {"aec3_warm_start", webrtc::CheckAec3WarmStart},
+      {"pool_reuse", webrtc::CheckPoolReuse},
+  };
+  int num_failures = 0;
+  for (const webrtc::Check& check : checks) {
+    if (!filter.empty() && std::string(check.name).find(filter) ==
+                               std::string::npos) {
+      continue;
+    }
+    const bool passed = check.run();
+    printf("%-32s %s\n", check.name, passed ? "PASS" : "FAIL");
+    fflush(stdout);
+    num_failures += passed ? 0 : 1;
+  }
+  return num_failures > 0 ? 1 : 0;
+}
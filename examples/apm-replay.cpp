@@ -0,0 +1,566 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Replays recordings made by BinaryAecDump through AudioProcessing.
+//
+// The recorded configurations, initializations, runtime settings, stream
+// delays, applied input volumes and key presses are applied, and the recorded
+// capture and render frames are processed in their original order, as fast as
+// possible. The recorded AudioProcessing configs are applied as they are, and
+// the echo canceller is built from the recorded echo canceller configs. The
+// processed capture output is compared with the recorded output, so that a
+// corpus of recordings serves as a regression test of the module.
+// The recordings are spread over --jobs worker threads, each with its own
+// AudioProcessing instance per recording, and the realtime factor of each
+// replay is reported.
+//
+// Usage: apm-replay [--jobs=<n>] [--list=<file>] [--verify] [<dump> ...]
+//
+// --list reads the paths of the recordings, one per line, from a file.
+// --verify fails if any processed output differs from the recording.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/audio_processing.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "api/audio/echo_control.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_processing/aec3/echo_canceller3.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump_format.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump_reader.h"
+#include "modules/audio_processing/include/aec_dump.h"
+
+namespace webrtc {
+namespace {
+
+using binary_aec_dump::AudioLayout;
+using binary_aec_dump::RecordType;
+
+struct Options {
+  int num_jobs = 0;
+  bool verify = false;
+  std::vector<std::string> paths;
+};
+
+struct ReplayResult {
+  bool ok = false;
+  std::string error;
+  bool truncated = false;
+  int64_t num_capture_frames = 0;
+  int64_t num_render_frames = 0;
+  int64_t num_dropped_records = 0;
+  double audio_seconds = 0.0;
+  double processing_seconds = 0.0;
+  // Capture frames whose processed output differs from the recorded output,
+  // and the largest difference in units of 16-bit samples.
+  int64_t num_mismatching_frames = 0;
+  double max_abs_difference = 0.0;
+};
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>* data) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  bool ok = fseek(file, 0, SEEK_END) == 0;
+  const long size = ok ? ftell(file) : -1;
+  ok = ok && size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+  if (ok) {
+    data->resize(size);
+    ok = fread(data->data(), 1, data->size(), file) == data->size();
+  }
+  fclose(file);
+  return ok;
+}
+
+StreamConfig ToStreamConfig(const binary_aec_dump::StreamFormat& format) {
+  return StreamConfig(format.sample_rate_hz, format.num_channels);
+}
+
+StreamConfig ToStreamConfig(const AudioLayout& layout) {
+  return StreamConfig(layout.samples_per_channel * 100, layout.num_channels);
+}
+
+// Creates the built-in echo canceller with the configs of a config record, so
+// that it is set up as in the recording.
+class RecordedEchoCanceller3Factory : public EchoControlFactory {
+ public:
+  RecordedEchoCanceller3Factory(
+      const EchoCanceller3Config& config,
+      const std::optional<EchoCanceller3Config>& multichannel_config) {
+    SetConfigs(config, multichannel_config);
+  }
+
+  // Sets the configs of the echo cancellers created from now on.
+  void SetConfigs(
+      const EchoCanceller3Config& config,
+      const std::optional<EchoCanceller3Config>& multichannel_config) {
+    config_ = config;
+    multichannel_config_ = multichannel_config;
+  }
+
+  std::unique_ptr<EchoControl> Create(int sample_rate_hz,
+                                      int num_render_channels,
+                                      int num_capture_channels) override {
+    return std::make_unique<EchoCanceller3>(config_, multichannel_config_,
+                                            sample_rate_hz, num_render_channels,
+                                            num_capture_channels);
+  }
+
+ private:
+  EchoCanceller3Config config_;
+  std::optional<EchoCanceller3Config> multichannel_config_;
+};
+
+// Replays one recording. The buffers are reused across frames and recordings
+// of a worker, so that the replay loop does not allocate.
+class Replayer {
+ public:
+  ReplayResult Replay(const std::string& path) {
+    ReplayResult result;
+    if (!ReadFile(path, &file_data_)) {
+      result.error = "cannot read the file";
+      return result;
+    }
+    BinaryAecDumpReader reader(file_data_);
+    if (!reader.valid()) {
+      result.error = "not a binary aec dump of a supported version";
+      return result;
+    }
+
+    reverse_output_format_ = {0, 0};
+    api_format_.reset();
+    result_ = &result;
+    CreateApm(/*echo_canceller3_factory=*/nullptr);
+
+    const auto start = std::chrono::steady_clock::now();
+    BinaryAecDumpReader::Record record;
+    bool ok = true;
+    while (ok && reader.ReadRecord(&record)) {
+      ok = ReplayRecord(record);
+    }
+    result.processing_seconds = std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+    result.truncated = reader.truncated();
+    result.ok = ok;
+    if (!ok && result.error.empty()) {
+      result.error = "malformed record";
+    }
+    apm_ = nullptr;
+    echo_canceller3_factory_ = nullptr;
+    result_ = nullptr;
+    return result;
+  }
+
+ private:
+  // Creates the AudioProcessing instance, with the echo controller of
+  // `echo_canceller3_factory` if not null, and initializes it with the stream
+  // formats of the last init record.
+  void CreateApm(std::unique_ptr<RecordedEchoCanceller3Factory>
+                     echo_canceller3_factory) {
+    echo_canceller3_factory_ = echo_canceller3_factory.get();
+    AudioProcessingBuilder builder;
+    if (echo_canceller3_factory) {
+      builder.SetEchoControlFactory(std::move(echo_canceller3_factory));
+    }
+    apm_ = builder.Create();
+    if (api_format_) {
+      apm_->Initialize(*api_format_);
+    }
+  }
+
+  void ApplyRecordedConfig(const InternalAPMConfig& recorded) {
+    // The echo controller of a factory is always in use, so the instance is
+    // recreated when the recording turns the built-in echo canceller on or
+    // off. Unlike in the recording, this also resets the other submodules.
+    const std::optional<EchoCanceller3Config>& echo_canceller3_config =
+        recorded.echo_canceller3_config;
+    if (echo_canceller3_config.has_value() !=
+        (echo_canceller3_factory_ != nullptr)) {
+      CreateApm(echo_canceller3_config
+                    ? std::make_unique<RecordedEchoCanceller3Factory>(
+                          *echo_canceller3_config,
+                          recorded.echo_canceller3_multichannel_config)
+                    : nullptr);
+    } else if (echo_canceller3_factory_) {
+      // Used if ApplyConfig() recreates the echo canceller, which it does
+      // when the settings that the echo canceller configs depend on change.
+      echo_canceller3_factory_->SetConfigs(
+          *echo_canceller3_config, recorded.echo_canceller3_multichannel_config);
+    }
+    apm_->ApplyConfig(recorded.config);
+  }
+
+  // Stops the replay with the error code of a failed AudioProcessing call.
+  bool ProcessingFailed(const char* method, int error) {
+    result_->error =
+        std::string(method) + " failed with error " + std::to_string(error);
+    return false;
+  }
+
+  bool ReplayRecord(const BinaryAecDumpReader::Record& record) {
+    switch (record.type) {
+      case RecordType::kInit: {
+        binary_aec_dump::InitPayload init;
+        if (!BinaryAecDumpReader::ParseInit(record, &init)) {
+          return false;
+        }
+        reverse_output_format_ = init.reverse_output;
+        const ProcessingConfig api_format{
+            {ToStreamConfig(init.input), ToStreamConfig(init.output),
+             ToStreamConfig(init.reverse_input),
+             ToStreamConfig(init.reverse_output)}};
+        // A change of the stream formats is recorded when the next stream
+        // call applies it, which may keep the state of the unaffected
+        // submodules. The replayed stream calls apply it in the same way, so
+        // only the initial formats and the reinitializations without a change
+        // of formats are replayed as full initializations.
+        const bool initialize = !api_format_ || *api_format_ == api_format;
+        api_format_ = api_format;
+        if (initialize) {
+          const int error = apm_->Initialize(api_format);
+          if (error != AudioProcessing::kNoError) {
+            return ProcessingFailed("Initialize", error);
+          }
+        }
+        return true;
+      }
+      case RecordType::kCapture:
+        return ReplayCapture(record);
+      case RecordType::kRender:
+        return ReplayRender(record);
+      case RecordType::kRuntimeSetting: {
+        AudioProcessing::RuntimeSetting setting;
+        if (!BinaryAecDumpReader::ParseRuntimeSetting(record, &setting)) {
+          return false;
+        }
+        apm_->SetRuntimeSetting(setting);
+        return true;
+      }
+      case RecordType::kConfig: {
+        InternalAPMConfig recorded;
+        if (!BinaryAecDumpReader::ParseConfig(record, &recorded)) {
+          return false;
+        }
+        ApplyRecordedConfig(recorded);
+        return true;
+      }
+      case RecordType::kDropped: {
+        binary_aec_dump::DroppedPayload dropped;
+        if (!BinaryAecDumpReader::ParseDropped(record, &dropped)) {
+          return false;
+        }
+        result_->num_dropped_records = dropped.num_dropped_records;
+        return true;
+      }
+    }
+    // Records of unknown types are skipped.
+    return true;
+  }
+
+  bool ReplayCapture(const BinaryAecDumpReader::Record& record) {
+    binary_aec_dump::CapturePayload capture;
+    rtc::ArrayView<const uint8_t> input;
+    rtc::ArrayView<const uint8_t> recorded_output;
+    if (!BinaryAecDumpReader::ParseCapture(record, &capture, &input,
+                                           &recorded_output) ||
+        capture.input.format != capture.output.format) {
+      return false;
+    }
+    apm_->set_stream_delay_ms(capture.delay);
+    if (capture.flags &
+        binary_aec_dump::CapturePayload::kHasAppliedInputVolume) {
+      apm_->set_stream_analog_level(capture.applied_input_volume);
+    }
+    apm_->set_stream_key_pressed(capture.flags &
+                                 binary_aec_dump::CapturePayload::kKeypress);
+
+    const StreamConfig input_config = ToStreamConfig(capture.input);
+    const StreamConfig output_config = ToStreamConfig(capture.output);
+    double max_abs_difference = 0.0;
+    if (capture.input.format == AudioLayout::kInt16) {
+      CopyAudio(input, &int16_input_);
+      int16_output_.resize(output_config.num_samples());
+      const int error =
+          apm_->ProcessStream(int16_input_.data(), input_config,
+                              output_config, int16_output_.data());
+      if (error != AudioProcessing::kNoError) {
+        return ProcessingFailed("ProcessStream", error);
+      }
+      CopyAudio(recorded_output, &int16_expected_);
+      for (size_t k = 0; k < int16_output_.size(); ++k) {
+        max_abs_difference = std::max<double>(
+            max_abs_difference, std::abs(int16_output_[k] - int16_expected_[k]));
+      }
+    } else {
+      CopyAudio(input, &float_input_);
+      float_output_.resize(output_config.num_samples());
+      const int error = apm_->ProcessStream(
+          ChannelPointers(&float_input_, capture.input, &input_channels_),
+          input_config, output_config,
+          ChannelPointers(&float_output_, capture.output, &output_channels_));
+      if (error != AudioProcessing::kNoError) {
+        return ProcessingFailed("ProcessStream", error);
+      }
+      CopyAudio(recorded_output, &float_expected_);
+      for (size_t k = 0; k < float_output_.size(); ++k) {
+        max_abs_difference =
+            std::max<double>(max_abs_difference,
+                             32768.0 * std::fabs(float_output_[k] -
+                                                 float_expected_[k]));
+      }
+    }
+
+    ++result_->num_capture_frames;
+    result_->audio_seconds +=
+        static_cast<double>(capture.input.samples_per_channel) /
+        input_config.sample_rate_hz();
+    if (max_abs_difference > 0.0) {
+      ++result_->num_mismatching_frames;
+      result_->max_abs_difference =
+          std::max(result_->max_abs_difference, max_abs_difference);
+    }
+    return true;
+  }
+
+  bool ReplayRender(const BinaryAecDumpReader::Record& record) {
+    binary_aec_dump::RenderPayload render;
+    rtc::ArrayView<const uint8_t> audio;
+    if (!BinaryAecDumpReader::ParseRender(record, &render, &audio)) {
+      return false;
+    }
+    const StreamConfig input_config = ToStreamConfig(render.audio);
+    // The reverse output format is only known from the last initialization,
+    // and follows the input format when that does not apply.
+    AudioLayout output_layout = render.audio;
+    if (reverse_output_format_.sample_rate_hz > 0 &&
+        reverse_output_format_.num_channels > 0) {
+      output_layout.samples_per_channel =
+          reverse_output_format_.sample_rate_hz / 100;
+      output_layout.num_channels = reverse_output_format_.num_channels;
+    }
+    const StreamConfig output_config = ToStreamConfig(output_layout);
+    if (render.audio.format == AudioLayout::kInt16) {
+      CopyAudio(audio, &int16_input_);
+      int16_output_.resize(output_config.num_samples());
+      const int error =
+          apm_->ProcessReverseStream(int16_input_.data(), input_config,
+                                     output_config, int16_output_.data());
+      if (error != AudioProcessing::kNoError) {
+        return ProcessingFailed("ProcessReverseStream", error);
+      }
+    } else {
+      CopyAudio(audio, &float_input_);
+      float_output_.resize(output_config.num_samples());
+      const int error = apm_->ProcessReverseStream(
+          ChannelPointers(&float_input_, render.audio, &input_channels_),
+          input_config, output_config,
+          ChannelPointers(&float_output_, output_layout, &output_channels_));
+      if (error != AudioProcessing::kNoError) {
+        return ProcessingFailed("ProcessReverseStream", error);
+      }
+    }
+    ++result_->num_render_frames;
+    return true;
+  }
+
+  // Copies the recorded audio, which is not necessarily aligned.
+  template <typename T>
+  static void CopyAudio(rtc::ArrayView<const uint8_t> audio,
+                        std::vector<T>* samples) {
+    samples->resize(audio.size() / sizeof(T));
+    memcpy(samples->data(), audio.data(), samples->size() * sizeof(T));
+  }
+
+  static float* const* ChannelPointers(std::vector<float>* samples,
+                                       const AudioLayout& layout,
+                                       std::vector<float*>* channels) {
+    channels->resize(layout.num_channels);
+    for (int ch = 0; ch < layout.num_channels; ++ch) {
+      (*channels)[ch] = samples->data() + ch * layout.samples_per_channel;
+    }
+    return channels->data();
+  }
+
+  std::vector<uint8_t> file_data_;
+  scoped_refptr<AudioProcessing> apm_;
+  // Owned by `apm_`. Null if the recording does not use the built-in echo
+  // canceller.
+  RecordedEchoCanceller3Factory* echo_canceller3_factory_ = nullptr;
+  binary_aec_dump::StreamFormat reverse_output_format_ = {0, 0};
+  // The stream formats of the last init record.
+  std::optional<ProcessingConfig> api_format_;
+  ReplayResult* result_ = nullptr;
+  std::vector<int16_t> int16_input_;
+  std::vector<int16_t> int16_output_;
+  std::vector<int16_t> int16_expected_;
+  std::vector<float> float_input_;
+  std::vector<float> float_output_;
+  std::vector<float> float_expected_;
+  std::vector<float*> input_channels_;
+  std::vector<float*> output_channels_;
+};
+
+bool ReadList(const char* list_path, std::vector<std::string>* paths) {
+  std::ifstream file(list_path);
+  if (!file) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (!line.empty()) {
+      paths->push_back(line);
+    }
+  }
+  return !file.bad();
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int k = 1; k < argc; ++k) {
+    const char* arg = argv[k];
+    if (strncmp(arg, "--jobs=", 7) == 0) {
+      options->num_jobs = atoi(arg + 7);
+      if (options->num_jobs < 1) {
+        return false;
+      }
+    } else if (strncmp(arg, "--list=", 7) == 0) {
+      if (!ReadList(arg + 7, &options->paths)) {
+        fprintf(stderr, "Cannot read %s\n", arg + 7);
+        return false;
+      }
+    } else if (strcmp(arg, "--verify") == 0) {
+      options->verify = true;
+    } else if (strncmp(arg, "--", 2) == 0) {
+      return false;
+    } else {
+      options->paths.push_back(arg);
+    }
+  }
+  return !options->paths.empty();
+}
+
+void PrintResult(const std::string& path, const ReplayResult& result) {
+  if (!result.ok && result.num_capture_frames == 0) {
+    printf("%s: error: %s\n", path.c_str(), result.error.c_str());
+    return;
+  }
+  const double realtime_factor =
+      result.processing_seconds > 0.0
+          ? result.audio_seconds / result.processing_seconds
+          : 0.0;
+  printf("%s: %lld capture / %lld render frames, %.1f s of audio in %.3f s, "
+         "%.1fx realtime",
+         path.c_str(), static_cast<long long>(result.num_capture_frames),
+         static_cast<long long>(result.num_render_frames), result.audio_seconds,
+         result.processing_seconds, realtime_factor);
+  if (result.num_mismatching_frames > 0) {
+    printf(", %lld frames differ (max %.1f)",
+           static_cast<long long>(result.num_mismatching_frames),
+           result.max_abs_difference);
+  } else {
+    printf(", bit-exact");
+  }
+  if (result.num_dropped_records > 0) {
+    printf(", %lld records dropped while recording",
+           static_cast<long long>(result.num_dropped_records));
+  }
+  if (result.truncated) {
+    printf(", truncated");
+  }
+  if (!result.ok) {
+    printf(", error: %s", result.error.c_str());
+  }
+  printf("\n");
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char** argv) {
+  webrtc::Options options;
+  if (!webrtc::ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "Usage: %s [--jobs=<n>] [--list=<file>] [--verify] [<dump> ...]\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+  const std::vector<std::string>& paths = options.paths;
+  int num_jobs = options.num_jobs > 0
+                     ? options.num_jobs
+                     : static_cast<int>(std::thread::hardware_concurrency());
+  num_jobs = std::max(1, std::min<int>(num_jobs, paths.size()));
+
+  // Each worker pulls recordings from a shared index until all have been
+  // replayed, and reports each one as it completes.
+  std::vector<webrtc::ReplayResult> results(paths.size());
+  std::atomic<size_t> next_path(0);
+  std::mutex print_mutex;
+  auto worker = [&]() {
+    webrtc::Replayer replayer;
+    size_t index;
+    while ((index = next_path.fetch_add(1)) < paths.size()) {
+      results[index] = replayer.Replay(paths[index]);
+      std::lock_guard<std::mutex> lock(print_mutex);
+      webrtc::PrintResult(paths[index], results[index]);
+      fflush(stdout);
+    }
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int k = 1; k < num_jobs; ++k) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double elapsed_seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  int num_failed = 0;
+  int num_mismatching = 0;
+  double audio_seconds = 0.0;
+  for (const webrtc::ReplayResult& result : results) {
+    num_failed += result.ok ? 0 : 1;
+    num_mismatching += result.num_mismatching_frames > 0 ? 1 : 0;
+    audio_seconds += result.audio_seconds;
+  }
+  printf("Replayed %zu recordings (%.1f s of audio) in %.2f s with %d jobs, "
+         "%.1fx realtime overall; %d failed, %d not bit-exact\n",
+         paths.size(), audio_seconds, elapsed_seconds, num_jobs,
+         elapsed_seconds > 0.0 ? audio_seconds / elapsed_seconds : 0.0,
+         num_failed, num_mismatching);
+
+  const bool ok = num_failed == 0 && (!options.verify || num_mismatching == 0);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
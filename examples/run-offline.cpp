@@ -1,67 +1,41 @@
 #include "api/scoped_refptr.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <webrtc/modules/audio_processing/include/audio_processing.h>
-#include "wav_io.h"
+#include "wav_stream.h"
 
 #define DEFAULT_BLOCK_MS 10
 #define DEFAULT_RATE 16000
 #define DEFAULT_CHANNELS 1
 
-int main(int argc, char **argv) {
-    if (argc != 4) {
-	std::cerr << "Usage: " << argv[0] << " <farend_file.wav> <nearend_file.wav> <out_file.wav>" << std::endl;
-	return EXIT_FAILURE;
-    }
-
-    std::ifstream play_file(argv[1], std::ios::binary);
-    std::ifstream rec_file(argv[2], std::ios::binary);
-    std::ofstream aec_file(argv[3], std::ios::binary);
-
-    if (!play_file.is_open()) {
-        std::cerr << "Error: Cannot open play file " << argv[1] << std::endl;
-        return EXIT_FAILURE;
-    }
-    
-    if (!rec_file.is_open()) {
-        std::cerr << "Error: Cannot open rec file " << argv[2] << std::endl;
-        return EXIT_FAILURE;
-    }
-    
-    if (!aec_file.is_open()) {
-        std::cerr << "Error: Cannot open output file " << argv[3] << std::endl;
-        return EXIT_FAILURE;
-    }
+namespace {
 
-    // Read WAV headers
-    WavHeader play_header, rec_header;
-    uint32_t play_sample_rate, rec_sample_rate;
-    uint16_t play_channels, rec_channels;
-    
-    if (!readWavHeader(play_file, play_header, play_sample_rate, play_channels)) {
-        std::cerr << "Error: Cannot read play file WAV header" << std::endl;
-        return EXIT_FAILURE;
-    }
-    
-    if (!readWavHeader(rec_file, rec_header, rec_sample_rate, rec_channels)) {
-        std::cerr << "Error: Cannot read rec file WAV header" << std::endl;
-        return EXIT_FAILURE;
-    }
-    
-    // Use the parameters from the input files (prefer rec file parameters for output)
-    uint32_t sample_rate = rec_sample_rate;
-    uint16_t channels = rec_channels;
-    
-    std::cout << "Play file: " << play_sample_rate << "Hz, " << play_channels << " channels" << std::endl;
-    std::cout << "Rec file: " << rec_sample_rate << "Hz, " << rec_channels << " channels" << std::endl;
+struct Job {
+    std::string play_path;
+    std::string rec_path;
+    std::string out_path;
+};
 
-    rtc::scoped_refptr<webrtc::AudioProcessing> apm = webrtc::AudioProcessingBuilder().Create();
+struct JobResult {
+    bool ok = false;
+    uint64_t frames = 0;
+    uint32_t sample_rate = 0;
+    uint16_t channels = 0;
+};
 
+webrtc::AudioProcessing::Config makeConfig() {
     webrtc::AudioProcessing::Config config;
     config.echo_canceller.enabled = true;
-    
+
     // AGC1
     config.gain_controller1.enabled = false;
     config.gain_controller1.mode = webrtc::AudioProcessing::Config::GainController1::kAdaptiveDigital;
@@ -69,7 +43,7 @@ int main(int argc, char **argv) {
     // AGC2
     config.gain_controller2.enabled = false;
     config.gain_controller2.adaptive_digital.enabled = false;
-    
+
     // high pass
     config.high_pass_filter.enabled = false;
 
@@ -77,56 +51,147 @@ int main(int argc, char **argv) {
     config.noise_suppression.enabled = false;
     config.noise_suppression.level = webrtc::AudioProcessing::Config::NoiseSuppression::kHigh;
 
-    apm->ApplyConfig(config);
-
-    webrtc::StreamConfig play_stream_config(play_sample_rate, play_channels);
-    webrtc::StreamConfig rec_stream_config(rec_sample_rate, rec_channels);
-    
-    // Write WAV header for output file (we'll update data size later)
-    std::streampos header_pos = aec_file.tellp();
-    writeWavHeader(aec_file, sample_rate, channels, 0);
-    uint32_t total_data_size = 0;
-
-    while (!play_file.eof() && !rec_file.eof()) {
-        // Calculate frame size based on actual file parameters
-        size_t play_frame_size = play_sample_rate * DEFAULT_BLOCK_MS / 1000 * play_channels;
-        size_t rec_frame_size = rec_sample_rate * DEFAULT_BLOCK_MS / 1000 * rec_channels;
-        
-        int16_t* play_frame = new int16_t[play_frame_size];
-        int16_t* rec_frame = new int16_t[rec_frame_size];
-
-        size_t play_bytes_read = play_file.read(reinterpret_cast<char *>(play_frame), play_frame_size * sizeof(int16_t)).gcount();
-        size_t rec_bytes_read = rec_file.read(reinterpret_cast<char *>(rec_frame), rec_frame_size * sizeof(int16_t)).gcount();
-
-        // Check if we have enough data for processing
-        if (play_bytes_read < play_frame_size * sizeof(int16_t) || rec_bytes_read < rec_frame_size * sizeof(int16_t)) {
-            delete[] play_frame;
-            delete[] rec_frame;
-            break;
+    return config;
+}
+
+// Returns true if the APM can process 10 ms frames of the given format. A
+// rate below 100 Hz or zero channels would give empty frames.
+bool isSupportedFormat(const MappedWavReader& wav, const std::string& path) {
+    if (wav.sampleRate() < 8000 || wav.sampleRate() % 100 != 0 || wav.channels() == 0) {
+        std::cerr << "Error: Unsupported format in " << path << ": " << wav.sampleRate() << " Hz, " << wav.channels() << " channels" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Processes one far-end/near-end file pair. The input files are mapped and
+// fed to the APM frame by frame without copying; the only per-frame buffers
+// are allocated once up front, and the output goes through one large staging
+// buffer.
+JobResult processFiles(webrtc::AudioProcessing* apm, const Job& job, std::vector<int16_t>& play_out, std::vector<int16_t>& rec_out, BufferedWavWriter& writer) {
+    JobResult result;
+    MappedWavReader play;
+    MappedWavReader rec;
+    if (!play.open(job.play_path) || !rec.open(job.rec_path)) {
+        return result;
+    }
+    if (!isSupportedFormat(play, job.play_path) || !isSupportedFormat(rec, job.rec_path)) {
+        return result;
+    }
+
+    // Use the parameters from the input files (prefer rec file parameters for output)
+    result.sample_rate = rec.sampleRate();
+    result.channels = rec.channels();
+
+    const size_t play_frame_size = play.sampleRate() * DEFAULT_BLOCK_MS / 1000 * play.channels();
+    const size_t rec_frame_size = rec.sampleRate() * DEFAULT_BLOCK_MS / 1000 * rec.channels();
+    const size_t num_frames = std::min(play.numSamples() / play_frame_size, rec.numSamples() / rec_frame_size);
+    play_out.resize(play_frame_size);
+    rec_out.resize(rec_frame_size);
+
+    webrtc::StreamConfig play_stream_config(play.sampleRate(), play.channels());
+    webrtc::StreamConfig rec_stream_config(rec.sampleRate(), rec.channels());
+
+    if (!writer.open(job.out_path, rec.sampleRate(), rec.channels())) {
+        return result;
+    }
+
+    const int16_t* play_frame = play.samples();
+    const int16_t* rec_frame = rec.samples();
+    for (size_t i = 0; i < num_frames; ++i) {
+        apm->ProcessReverseStream(play_frame, play_stream_config, play_stream_config, play_out.data());
+        apm->ProcessStream(rec_frame, rec_stream_config, rec_stream_config, rec_out.data());
+        if (!writer.write(rec_out.data(), rec_frame_size)) {
+            std::cerr << "Error: Cannot write " << job.out_path << std::endl;
+            writer.close();
+            return result;
         }
+        play_frame += play_frame_size;
+        rec_frame += rec_frame_size;
+    }
+
+    result.ok = writer.close();
+    result.frames = num_frames;
+    return result;
+}
+
+void printUsage(const char* name) {
+    std::cerr << "Usage: " << name << " [--jobs N] <farend_file.wav> <nearend_file.wav> <out_file.wav> [<farend_file.wav> <nearend_file.wav> <out_file.wav> ...]" << std::endl;
+}
 
-        apm->ProcessReverseStream(play_frame, play_stream_config, play_stream_config, play_frame);
-        apm->ProcessStream(rec_frame, rec_stream_config, rec_stream_config, rec_frame);
+} // namespace
 
-        aec_file.write(reinterpret_cast<char *>(rec_frame), rec_frame_size * sizeof(int16_t));
-        total_data_size += rec_frame_size * sizeof(int16_t);
-        
-        delete[] play_frame;
-        delete[] rec_frame;
+int main(int argc, char **argv) {
+    int num_jobs = 1;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            num_jobs = atoi(argv[++i]);
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0) {
+            num_jobs = atoi(argv[i] + 7);
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty() || paths.size() % 3 != 0 || num_jobs < 1) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
     }
 
-    // Update WAV header with correct data size
-    std::streampos current_pos = aec_file.tellp();
-    aec_file.seekp(header_pos);
-    writeWavHeader(aec_file, sample_rate, channels, total_data_size);
-    aec_file.seekp(current_pos);
+    std::vector<Job> jobs;
+    for (size_t i = 0; i < paths.size(); i += 3) {
+        jobs.push_back({paths[i], paths[i + 1], paths[i + 2]});
+    }
+    num_jobs = std::min<int>(num_jobs, jobs.size());
+
+    // Each worker owns one APM and its frame buffers, and pulls file pairs
+    // from a shared index until all have been processed.
+    const webrtc::AudioProcessing::Config config = makeConfig();
+    std::vector<JobResult> results(jobs.size());
+    std::atomic<size_t> next_job(0);
+    std::mutex log_mutex;
+    auto worker = [&]() {
+        std::vector<int16_t> play_out;
+        std::vector<int16_t> rec_out;
+        BufferedWavWriter writer;
+        size_t index;
+        while ((index = next_job.fetch_add(1)) < jobs.size()) {
+            rtc::scoped_refptr<webrtc::AudioProcessing> apm = webrtc::AudioProcessingBuilder().Create();
+            apm->ApplyConfig(config);
+            results[index] = processFiles(apm.get(), jobs[index], play_out, rec_out, writer);
+            if (results[index].ok && jobs.size() > 1) {
+                std::lock_guard<std::mutex> lock(log_mutex);
+                std::cout << "Processed " << jobs[index].out_path << std::endl;
+            }
+        }
+    };
 
-    play_file.close();
-    rec_file.close();
-    aec_file.close();
-    
-    std::cout << "Processing complete. Output written to " << argv[3] << std::endl;
-    std::cout << "Processed " << total_data_size / (channels * sizeof(int16_t)) << " samples" << std::endl;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool all_ok = true;
+    double audio_s = 0.0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const JobResult& r = results[i];
+        all_ok = all_ok && r.ok;
+        audio_s += r.frames * DEFAULT_BLOCK_MS / 1000.0;
+        if (jobs.size() == 1 && r.ok) {
+            std::cout << "Rec file: " << r.sample_rate << "Hz, " << r.channels << " channels" << std::endl;
+            std::cout << "Processing complete. Output written to " << jobs[i].out_path << std::endl;
+            std::cout << "Processed " << r.frames * r.sample_rate * DEFAULT_BLOCK_MS / 1000 << " samples" << std::endl;
+        }
+    }
+    if (jobs.size() > 1) {
+        std::cout << "Processed " << jobs.size() << " file pairs (" << audio_s << " s of audio) in " << elapsed_s << " s with " << num_jobs << " jobs" << std::endl;
+    }
 
-    return EXIT_SUCCESS;
+    return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -67,9 +67,7 @@ bool skipToDataChunk(std::ifstream& file) {
     return false;
 }
 
-void writeWavHeader(std::ofstream& file, uint32_t sample_rate, uint16_t channels, uint32_t data_size) {
-    WavHeader header;
-    
+void fillWavHeader(WavHeader& header, uint32_t sample_rate, uint16_t channels, uint32_t data_size) {
     strncpy(header.riff, "RIFF", 4);
     header.file_size = 36 + data_size;
     strncpy(header.wave, "WAVE", 4);
@@ -83,6 +81,10 @@ void writeWavHeader(std::ofstream& file, uint32_t sample_rate, uint16_t channels
     header.block_align = channels * header.bits_per_sample / 8;
     strncpy(header.data, "data", 4);
     header.data_size = data_size;
-    
+}
+
+void writeWavHeader(std::ofstream& file, uint32_t sample_rate, uint16_t channels, uint32_t data_size) {
+    WavHeader header;
+    fillWavHeader(header, sample_rate, channels, data_size);
     file.write(reinterpret_cast<char*>(&header), sizeof(header));
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ struct WavHeader {
 };
 
 bool readWavHeader(std::ifstream& file, WavHeader& header, uint32_t& sample_rate, uint16_t& channels);
+void fillWavHeader(WavHeader& header, uint32_t sample_rate, uint16_t channels, uint32_t data_size);
 void writeWavHeader(std::ofstream& file, uint32_t sample_rate, uint16_t channels, uint32_t data_size);
 bool skipToDataChunk(std::ifstream& file);
 
@@ -0,0 +1,201 @@
+#include "wav_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "wav_io.h"
+
+namespace {
+
+uint32_t readLe32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t readLe16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+} // namespace
+
+MappedWavReader::~MappedWavReader() {
+    close();
+}
+
+bool MappedWavReader::open(const std::string& path) {
+    close();
+#if defined(WEBRTC_POSIX)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        std::cerr << "Error: Cannot stat " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+    mapping_size_ = static_cast<size_t>(st.st_size);
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        std::cerr << "Error: Cannot map " << path << std::endl;
+        mapping_ = nullptr;
+        return false;
+    }
+    // The file is consumed front to back exactly once.
+    madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+    return parse(static_cast<const uint8_t*>(mapping_), mapping_size_, path);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    const size_t size = static_cast<size_t>(file.tellg());
+    std::vector<uint8_t> bytes(size);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), size);
+    if (!parse(bytes.data(), size, path)) {
+        return false;
+    }
+    // Copy out the samples so that they are properly aligned.
+    const size_t offset = reinterpret_cast<const uint8_t*>(samples_) - bytes.data();
+    fallback_.resize(num_samples_);
+    memcpy(fallback_.data(), bytes.data() + offset, num_samples_ * sizeof(int16_t));
+    samples_ = fallback_.data();
+    return true;
+#endif
+}
+
+void MappedWavReader::close() {
+#if defined(WEBRTC_POSIX)
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    fallback_.clear();
+    samples_ = nullptr;
+    num_samples_ = 0;
+    sample_rate_ = 0;
+    channels_ = 0;
+}
+
+bool MappedWavReader::parse(const uint8_t* data, size_t size, const std::string& path) {
+    if (size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) {
+        std::cerr << "Error: " << path << " is not a valid WAVE file" << std::endl;
+        return false;
+    }
+
+    bool have_fmt = false;
+    size_t pos = 12;
+    while (pos + 8 <= size) {
+        const uint8_t* chunk = data + pos;
+        const uint32_t chunk_size = readLe32(chunk + 4);
+        const uint8_t* body = chunk + 8;
+        const size_t available = size - pos - 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunk_size < 16 || available < 16) {
+                break;
+            }
+            if (readLe16(body) != 1 || readLe16(body + 14) != 16) {
+                std::cerr << "Error: " << path << " is not 16-bit PCM" << std::endl;
+                return false;
+            }
+            channels_ = readLe16(body + 2);
+            sample_rate_ = readLe32(body + 4);
+            have_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt) {
+                break;
+            }
+            // Tolerate truncated files and streaming writers that left the
+            // data size unset.
+            const size_t data_bytes = chunk_size < available ? chunk_size : available;
+            samples_ = reinterpret_cast<const int16_t*>(body);
+            num_samples_ = data_bytes / sizeof(int16_t);
+            return channels_ > 0 && sample_rate_ > 0;
+        }
+        // Chunks are padded to an even size.
+        pos += 8 + static_cast<size_t>(chunk_size) + (chunk_size & 1);
+    }
+
+    std::cerr << "Error: " << path << " has no fmt/data chunk" << std::endl;
+    return false;
+}
+
+BufferedWavWriter::BufferedWavWriter(size_t buffer_bytes) : buffer_(buffer_bytes) {}
+
+BufferedWavWriter::~BufferedWavWriter() {
+    close();
+}
+
+bool BufferedWavWriter::open(const std::string& path, uint32_t sample_rate, uint16_t channels) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "Error: Cannot open output file " << path << std::endl;
+        return false;
+    }
+    // All buffering is done here, avoid a second copy through stdio.
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+    data_bytes_ = 0;
+    buffered_ = 0;
+
+    WavHeader header;
+    fillWavHeader(header, sample_rate_, channels_, 0);
+    return std::fwrite(&header, sizeof(header), 1, file_) == 1;
+}
+
+bool BufferedWavWriter::write(const int16_t* samples, size_t num_samples) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(samples);
+    size_t remaining = num_samples * sizeof(int16_t);
+    data_bytes_ += static_cast<uint32_t>(remaining);
+    while (remaining > 0) {
+        const size_t n = std::min(remaining, buffer_.size() - buffered_);
+        memcpy(buffer_.data() + buffered_, bytes, n);
+        buffered_ += n;
+        bytes += n;
+        remaining -= n;
+        if (buffered_ == buffer_.size() && !flush()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BufferedWavWriter::flush() {
+    if (buffered_ > 0 && std::fwrite(buffer_.data(), 1, buffered_, file_) != buffered_) {
+        return false;
+    }
+    buffered_ = 0;
+    return true;
+}
+
+bool BufferedWavWriter::close() {
+    if (!file_) {
+        return true;
+    }
+    bool ok = flush();
+    WavHeader header;
+    fillWavHeader(header, sample_rate_, channels_, data_bytes_);
+    ok = ok && std::fseek(file_, 0, SEEK_SET) == 0 &&
+         std::fwrite(&header, sizeof(header), 1, file_) == 1;
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = nullptr;
+    return ok;
+}
@@ -0,0 +1,70 @@
+#ifndef WAV_STREAM_H
+#define WAV_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Read-only view of the 16-bit PCM samples of a WAV file. On POSIX systems the
+// file is memory-mapped, so that reading frames costs no copies or syscalls;
+// elsewhere the samples are read into memory once when the file is opened.
+class MappedWavReader {
+public:
+    MappedWavReader() = default;
+    ~MappedWavReader();
+    MappedWavReader(const MappedWavReader&) = delete;
+    MappedWavReader& operator=(const MappedWavReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    uint32_t sampleRate() const { return sample_rate_; }
+    uint16_t channels() const { return channels_; }
+    // Number of interleaved samples, i.e. frames times channels.
+    size_t numSamples() const { return num_samples_; }
+    const int16_t* samples() const { return samples_; }
+
+private:
+    bool parse(const uint8_t* data, size_t size, const std::string& path);
+
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    std::vector<int16_t> fallback_;
+    const int16_t* samples_ = nullptr;
+    size_t num_samples_ = 0;
+    uint32_t sample_rate_ = 0;
+    uint16_t channels_ = 0;
+};
+
+// Writes a 16-bit PCM WAV file through a large staging buffer, so that the
+// per-frame cost is a memcpy and the file sees few, large writes. The header is
+// written up front and patched with the final data size by close().
+class BufferedWavWriter {
+public:
+    static constexpr size_t kDefaultBufferBytes = 1 << 20;
+
+    explicit BufferedWavWriter(size_t buffer_bytes = kDefaultBufferBytes);
+    ~BufferedWavWriter();
+    BufferedWavWriter(const BufferedWavWriter&) = delete;
+    BufferedWavWriter& operator=(const BufferedWavWriter&) = delete;
+
+    bool open(const std::string& path, uint32_t sample_rate, uint16_t channels);
+    bool write(const int16_t* samples, size_t num_samples);
+    bool close();
+
+    uint32_t dataBytes() const { return data_bytes_; }
+
+private:
+    bool flush();
+
+    std::FILE* file_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    size_t buffered_ = 0;
+    uint32_t data_bytes_ = 0;
+    uint32_t sample_rate_ = 0;
+    uint16_t channels_ = 0;
+};
+
+#endif // WAV_STREAM_H
@@ -104,7 +104,9 @@ bool Agc2Config::operator==(const Agc2Config& rhs) const {
   return enabled == rhs.enabled &&
          fixed_digital.gain_db == rhs.fixed_digital.gain_db &&
          adaptive_digital == rhs.adaptive_digital &&
-         input_volume_controller == rhs.input_volume_controller;
+         input_volume_controller == rhs.input_volume_controller &&
+         quantized_vad == rhs.quantized_vad &&
+         batched_vad == rhs.batched_vad;
 }
 
 bool AudioProcessing::Config::CaptureLevelAdjustment::operator==(
@@ -120,6 +122,51 @@ operator==(const AudioProcessing::Config::CaptureLevelAdjustment::
   return enabled == rhs.enabled && initial_level == rhs.initial_level;
 }
 
+bool AudioProcessing::Config::operator==(
+    const AudioProcessing::Config& rhs) const {
+  return pipeline.maximum_internal_processing_rate ==
+             rhs.pipeline.maximum_internal_processing_rate &&
+         pipeline.multi_channel_render == rhs.pipeline.multi_channel_render &&
+         pipeline.multi_channel_capture ==
+             rhs.pipeline.multi_channel_capture &&
+         pipeline.capture_downmix_method ==
+             rhs.pipeline.capture_downmix_method &&
+         pipeline.float_two_band_splitting ==
+             rhs.pipeline.float_two_band_splitting &&
+         pipeline.fma_three_band_splitting ==
+             rhs.pipeline.fma_three_band_splitting &&
+         pre_amplifier.enabled == rhs.pre_amplifier.enabled &&
+         pre_amplifier.fixed_gain_factor ==
+             rhs.pre_amplifier.fixed_gain_factor &&
+         capture_level_adjustment == rhs.capture_level_adjustment &&
+         high_pass_filter.enabled == rhs.high_pass_filter.enabled &&
+         high_pass_filter.apply_in_full_band ==
+             rhs.high_pass_filter.apply_in_full_band &&
+         echo_canceller.enabled == rhs.echo_canceller.enabled &&
+         echo_canceller.mobile_mode == rhs.echo_canceller.mobile_mode &&
+         echo_canceller.export_linear_aec_output ==
+             rhs.echo_canceller.export_linear_aec_output &&
+         echo_canceller.enforce_high_pass_filtering ==
+             rhs.echo_canceller.enforce_high_pass_filtering &&
+         echo_canceller.capture_channel_worker_threads ==
+             rhs.echo_canceller.capture_channel_worker_threads &&
+         echo_canceller.use_pffft == rhs.echo_canceller.use_pffft &&
+         noise_suppression.enabled == rhs.noise_suppression.enabled &&
+         noise_suppression.level == rhs.noise_suppression.level &&
+         noise_suppression.analyze_linear_aec_output_when_available ==
+             rhs.noise_suppression.analyze_linear_aec_output_when_available &&
+         noise_suppression.use_pffft == rhs.noise_suppression.use_pffft &&
+         transient_suppression.enabled == rhs.transient_suppression.enabled &&
+         gain_controller1 == rhs.gain_controller1 &&
+         // Not compared by `Agc1Config::operator==()`.
+         gain_controller1.analog_gain_controller.clipping_predictor.enabled ==
+             rhs.gain_controller1.analog_gain_controller.clipping_predictor
+                 .enabled &&
+         gain_controller2 == rhs.gain_controller2 &&
+         stage_timing.enabled == rhs.stage_timing.enabled &&
+         stage_timing.report_histograms == rhs.stage_timing.report_histograms;
+}
+
 std::string AudioProcessing::Config::ToString() const {
   char buf[2048];
   rtc::SimpleStringBuilder builder(buf);
@@ -129,6 +176,8 @@ std::string AudioProcessing::Config::ToString() const {
           << pipeline.maximum_internal_processing_rate
           << ", multi_channel_render: " << pipeline.multi_channel_render
           << ", multi_channel_capture: " << pipeline.multi_channel_capture
+          << ", float_two_band_splitting: " << pipeline.float_two_band_splitting
+          << ", fma_three_band_splitting: " << pipeline.fma_three_band_splitting
           << " }, pre_amplifier: { enabled: " << pre_amplifier.enabled
           << ", fixed_gain_factor: " << pre_amplifier.fixed_gain_factor
           << " },capture_level_adjustment: { enabled: "
@@ -144,9 +193,13 @@ std::string AudioProcessing::Config::ToString() const {
           << ", mobile_mode: " << echo_canceller.mobile_mode
           << ", enforce_high_pass_filtering: "
           << echo_canceller.enforce_high_pass_filtering
+          << ", capture_channel_worker_threads: "
+          << echo_canceller.capture_channel_worker_threads
+          << ", use_pffft: " << echo_canceller.use_pffft
           << " }, noise_suppression: { enabled: " << noise_suppression.enabled
           << ", level: "
           << NoiseSuppressionLevelToString(noise_suppression.level)
+          << ", use_pffft: " << noise_suppression.use_pffft
           << " }, transient_suppression: { enabled: "
           << transient_suppression.enabled
           << " }, gain_controller1: { enabled: " << gain_controller1.enabled
@@ -204,7 +257,11 @@ std::string AudioProcessing::Config::ToString() const {
           << ", max_output_noise_level_dbfs: "
           << gain_controller2.adaptive_digital.max_output_noise_level_dbfs
           << " }, input_volume_control : { enabled "
-          << gain_controller2.input_volume_controller.enabled << "}}";
+          << gain_controller2.input_volume_controller.enabled
+          << "}, quantized_vad: " << gain_controller2.quantized_vad
+          << ", batched_vad: " << gain_controller2.batched_vad
+          << " }, stage_timing: { enabled: " << stage_timing.enabled
+          << ", report_histograms: " << stage_timing.report_histograms << " }}";
   return builder.str();
 }
 
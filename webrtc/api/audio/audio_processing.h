@@ -27,6 +27,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/nullability.h"
 #include "absl/strings/string_view.h"
@@ -162,6 +163,14 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       // Indicates how to downmix multi-channel capture audio to mono (when
       // needed).
       DownmixMethod capture_downmix_method = DownmixMethod::kAverageChannels;
+      // Use a floating point filter bank, rather than the fixed-point one, to
+      // split 32 kHz audio into two frequency bands. Avoids quantizing the
+      // audio to 16 bits and is faster, but is not bit-exact with the default.
+      bool float_two_band_splitting = false;
+      // Allow the filter bank that splits 48 kHz audio into three frequency
+      // bands to use fused multiply-adds, when AVX2 is available. Faster, but
+      // not bit-exact with the default.
+      bool fma_three_band_splitting = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
@@ -209,6 +218,13 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       // Enforce the highpass filter to be on (has no effect for the mobile
       // mode).
       bool enforce_high_pass_filtering = true;
+      // Number of additional threads used by AEC3 for processing the capture
+      // channels in parallel. Zero disables the parallel processing. The
+      // output is the same regardless of this setting.
+      int capture_channel_worker_threads = 0;
+      // Computes the AEC3 transforms with the SIMD optimized PFFFT library
+      // instead of the Ooura FFT. The output differs by rounding errors only.
+      bool use_pffft = false;
     } echo_canceller;
 
     // Enables background noise suppression.
@@ -217,6 +233,10 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       enum Level { kLow, kModerate, kHigh, kVeryHigh };
       Level level = kModerate;
       bool analyze_linear_aec_output_when_available = false;
+      // Computes the noise suppressor transforms with the SIMD optimized PFFFT
+      // library instead of the Ooura FFT. The output differs by rounding
+      // errors only.
+      bool use_pffft = false;
     } noise_suppression;
 
     // TODO(bugs.webrtc.org/357281131): Deprecated. Stop using and remove.
@@ -378,8 +398,34 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
         // turned into a compressor that first applies a fixed gain.
         float gain_db = 0.0f;
       } fixed_digital;
+
+      // Runs the voice activity detector with 8-bit integer weights and
+      // activations. It needs less memory and is faster, but the speech
+      // probabilities slightly differ from those of the default detector.
+      bool quantized_vad = false;
+
+      // When the APM is a session of an AudioProcessingBatch, evaluates the
+      // voice activity detectors of all the sessions of the batch together,
+      // once per tick. The speech probabilities are then one frame late.
+      // Takes precedence over `quantized_vad`, and is ignored outside of an
+      // AudioProcessingBatch.
+      bool batched_vad = false;
     } gain_controller2;
 
+    // Measures the execution time of the processing stages, and reports it
+    // through AudioProcessingStats::stage_timings. The measurement costs two
+    // clock reads per stage and frame.
+    struct StageTiming {
+      bool enabled = false;
+      // Also exports the mean and the 99th percentile of each stage as UMA
+      // histograms named WebRTC.Audio.Apm.StageTime.<Stage>.{MeanUs,P99Us}.
+      bool report_histograms = false;
+    } stage_timing;
+
+    // Compares all the settings; the floating point ones must be equal.
+    bool operator==(const Config& rhs) const;
+    bool operator!=(const Config& rhs) const { return !(*this == rhs); }
+
     std::string ToString() const;
   };
 
@@ -668,6 +714,24 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   // Returns the last applied configuration.
   virtual AudioProcessing::Config GetConfig() const = 0;
 
+  // Saves the converged state of the echo canceller, the noise suppressor and
+  // the adaptive digital gain controller to `state` as a versioned binary blob
+  // of a few tens of kB. Restoring the state into a new instance with the same
+  // configuration, e.g., when a call is reconnected, lets the submodules
+  // resume from their converged state instead of converging from scratch. The
+  // blob uses the byte order of the machine, and is only restored on machines
+  // with the same byte order.
+  virtual void SaveConvergedState(std::vector<uint8_t>* state) = 0;
+
+  // Restores a state saved by `SaveConvergedState()`. The state of each
+  // submodule is restored if the submodule is enabled and its format and
+  // configuration match the saved one; the state of disabled submodules is
+  // ignored. Returns false if `state` is malformed or of another version, in
+  // which case nothing is restored. Also returns false if the state of an
+  // enabled submodule is missing, in which case that submodule is left as is,
+  // or cannot be restored, in which case that submodule is reset.
+  virtual bool RestoreConvergedState(rtc::ArrayView<const uint8_t> state) = 0;
+
   enum Error {
     // Fatal errors.
     kNoError = 0,
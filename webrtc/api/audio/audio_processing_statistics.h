@@ -11,8 +11,10 @@
 #ifndef API_AUDIO_AUDIO_PROCESSING_STATISTICS_H_
 #define API_AUDIO_AUDIO_PROCESSING_STATISTICS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <array>
 #include <optional>
 
 #include "rtc_base/system/rtc_export.h"
@@ -21,6 +23,35 @@ namespace webrtc {
 // This version of the stats uses Optionals, it will replace the regular
 // AudioProcessingStatistics struct.
 struct RTC_EXPORT AudioProcessingStats {
+  // Processing stages whose execution time is measured when stage timing is
+  // enabled in AudioProcessing::Config.
+  enum class Stage {
+    kCapture,  // All of the capture processing.
+    kHighPassFilter,
+    kCaptureLevelsAdjuster,
+    kBandSplitting,
+    kEchoControllerAnalyze,  // AEC3 capture analysis.
+    kEchoControllerProcess,  // AEC3 or AECM capture processing.
+    kNoiseSuppressorAnalyze,
+    kNoiseSuppressorProcess,
+    kGainController1,
+    kGainController2,
+    kBandMerging,
+    kRender,  // All of the render processing.
+    kNumStages
+  };
+  static constexpr size_t kNumStages = static_cast<size_t>(Stage::kNumStages);
+
+  // Execution time of a stage per processed 10 ms frame, in nanoseconds.
+  struct StageTiming {
+    // Number of frames the statistics are computed over.
+    int num_frames = 0;
+    int64_t min_ns = 0;
+    int64_t mean_ns = 0;
+    // The resolution of the 99th percentile is about 20%.
+    int64_t p99_ns = 0;
+  };
+
   AudioProcessingStats();
   AudioProcessingStats(const AudioProcessingStats& other);
   ~AudioProcessingStats();
@@ -61,6 +92,20 @@ struct RTC_EXPORT AudioProcessingStats {
   // milliseconds and the value is the instantaneous value at the time of the
   // call to `GetStatistics()`.
   std::optional<int32_t> delay_ms;
+
+  // Number of render frames that were dropped since the creation of the APM,
+  // because the capture side did not consume the render audio fast enough.
+  // The dropped frames are not seen by the capture-side submodules that
+  // analyze the render signal (AECM, AGC1 and the residual echo detector).
+  // Only reported while one of these submodules queues render audio.
+  std::optional<int64_t> render_queue_overruns;
+
+  // Per-stage execution times, indexed by Stage. The statistics of a stage are
+  // computed over intervals of 1000 frames in which the stage was active, and
+  // are those of the most recent completed interval. Stages that have not yet
+  // completed an interval have `num_frames` set to zero. Only reported if
+  // stage timing is enabled in AudioProcessing::Config.
+  std::optional<std::array<StageTiming, kNumStages>> stage_timings;
 };
 
 }  // namespace webrtc
@@ -60,6 +60,16 @@ struct RTC_EXPORT EchoCanceller3Config {
     AlignmentMixing render_alignment_mixing = {false, true, 10000.f, true};
     AlignmentMixing capture_alignment_mixing = {false, true, 10000.f, false};
     bool detect_pre_echo = true;
+    // Estimates the delay by cross-correlating the capture and the render in
+    // the frequency domain instead of with time-domain matched filters. The
+    // cost grows much more slowly with `num_filters`, which makes it suited to
+    // long echo paths.
+    bool use_fft_matched_filter = false;
+    // Once a delay has been found, only the matched filters around it are
+    // updated, and a cheap matched filter at a lower rate watches the whole
+    // delay range to resume the full search when the delay moves. Only applies
+    // to the time-domain matched filters.
+    bool hierarchical_search = false;
   } delay;
 
   struct Filter {
@@ -243,7 +253,17 @@ struct RTC_EXPORT EchoCanceller3Config {
     float stereo_detection_threshold = 0.0f;
     int stereo_detection_timeout_threshold_seconds = 300;
     float stereo_detection_hysteresis_seconds = 2.0f;
+    // Number of additional threads used for processing the capture channels
+    // in parallel. Zero processes all channels on the calling thread. The
+    // output does not depend on this setting.
+    size_t capture_channel_worker_threads = 0;
   } multi_channel;
+
+  struct Fft {
+    // Computes the 128 point transforms with the SIMD optimized PFFFT library
+    // instead of the Ooura FFT. The output differs by rounding errors only.
+    bool use_pffft = false;
+  } fft;
 };
 }  // namespace webrtc
 
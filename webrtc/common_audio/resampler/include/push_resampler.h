@@ -38,6 +38,9 @@ class PushResampler final {
   // deinterleaved operation.
   int Resample(MonoView<const T> src, MonoView<T> dst);
 
+  // Flushes the buffered samples of all the channels, as in a new resampler.
+  void Reset();
+
  private:
   // Ensures that source and destination buffers for deinterleaving are
   // correctly configured prior to resampling that requires deinterleaving.
@@ -42,6 +42,13 @@ PushResampler<T>::PushResampler(size_t src_samples_per_channel,
 template <typename T>
 PushResampler<T>::~PushResampler() = default;
 
+template <typename T>
+void PushResampler<T>::Reset() {
+  for (auto& resampler : resamplers_) {
+    resampler->Reset();
+  }
+}
+
 template <typename T>
 void PushResampler<T>::EnsureInitialized(size_t src_samples_per_channel,
                                          size_t dst_samples_per_channel,
@@ -56,6 +56,9 @@ class PushSincResampler : public SincResamplerCallback {
                   float* destination,
                   size_t destination_capacity);
 
+  // Flushes the buffered samples, as in a new resampler.
+  void Reset();
+
   // Delay due to the filter kernel. Essentially, the time after which an input
   // sample will appear in the resampled output.
   static float AlgorithmicDelaySeconds(int source_rate_hz) {
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the sum of the products of `seq1` and `seq2`, each shifted right by
+// `right_shifts`. The sum wraps around like the C version.
+static int32_t DotProductWithShift(const int16_t* seq1,
+                                   const int16_t* seq2,
+                                   size_t dim_seq,
+                                   int right_shifts) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  __m256i sum256 = _mm256_setzero_si256();
+  __m128i sum;
+  size_t j = 0;
+  int32_t corr = 0;
+
+  if (right_shifts == 0) {
+    for (; j + 16 <= dim_seq; j += 16) {
+      const __m256i a = _mm256_loadu_si256((const __m256i*)&seq1[j]);
+      const __m256i b = _mm256_loadu_si256((const __m256i*)&seq2[j]);
+      sum256 = _mm256_add_epi32(sum256, _mm256_madd_epi16(a, b));
+    }
+  } else {
+    for (; j + 16 <= dim_seq; j += 16) {
+      const __m256i a = _mm256_loadu_si256((const __m256i*)&seq1[j]);
+      const __m256i b = _mm256_loadu_si256((const __m256i*)&seq2[j]);
+      const __m256i low = _mm256_mullo_epi16(a, b);
+      const __m256i high = _mm256_mulhi_epi16(a, b);
+      sum256 = _mm256_add_epi32(
+          sum256, _mm256_sra_epi32(_mm256_unpacklo_epi16(low, high), shift));
+      sum256 = _mm256_add_epi32(
+          sum256, _mm256_sra_epi32(_mm256_unpackhi_epi16(low, high), shift));
+    }
+  }
+  sum = _mm_add_epi32(_mm256_castsi256_si128(sum256),
+                      _mm256_extracti128_si256(sum256, 1));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  corr = _mm_cvtsi128_si32(sum);
+
+  for (; j < dim_seq; j++)
+    corr += (seq1[j] * seq2[j]) >> right_shifts;
+  return corr;
+}
+
+// AVX2 version of WebRtcSpl_CrossCorrelation(), bit-exact with the C version.
+void WebRtcSpl_CrossCorrelationAVX2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithShift(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
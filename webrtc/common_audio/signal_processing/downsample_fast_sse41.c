@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>
+#include <stddef.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// SSE4.1 version of WebRtcSpl_DownsampleFast(), bit-exact with the C version.
+// Each output sample is the dot product of the coefficients with the reversed
+// input, which is reversed in registers eight samples at a time.
+int WebRtcSpl_DownsampleFastSSE41(const int16_t* data_in,
+                                  size_t data_in_length,
+                                  int16_t* data_out,
+                                  size_t data_out_length,
+                                  const int16_t* __restrict coefficients,
+                                  size_t coefficients_length,
+                                  int factor,
+                                  size_t delay) {
+  const __m128i reverse = _mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4,
+                                        5, 2, 3, 0, 1);
+  size_t i = 0;
+  size_t j = 0;
+  int32_t out_s32 = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+
+  for (i = delay; i < endpos; i += factor) {
+    __m128i sum = _mm_setzero_si128();
+    // Negative indices are permitted here, as in the C version.
+    const int16_t* in = &data_in[i];
+
+    for (j = 0; j + 8 <= coefficients_length; j += 8) {
+      const __m128i c = _mm_loadu_si128((const __m128i*)&coefficients[j]);
+      const __m128i x = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i*)(in - (ptrdiff_t)j - 7)), reverse);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(c, x));
+    }
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+    out_s32 = 2048 + _mm_cvtsi128_si32(sum);  // Round value, 0.5 in Q12.
+
+    for (; j < coefficients_length; j++) {
+      out_s32 += coefficients[j] * in[-(ptrdiff_t)j];
+    }
+
+    out_s32 >>= 12;  // Q0.
+
+    // Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32);
+  }
+
+  return 0;
+}
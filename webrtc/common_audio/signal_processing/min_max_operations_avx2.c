@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// AVX2 versions of the minimum and maximum functions of
+// min_max_operations.c. They are bit-exact with the C versions.
+
+#include <limits.h>
+#include <immintrin.h>
+#include <stdlib.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/checks.h"
+
+static int HorizontalMaxU16(__m256i v256) {
+  __m128i v = _mm_max_epu16(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_max_epu16(v, _mm_srli_si128(v, 8));
+  v = _mm_max_epu16(v, _mm_srli_si128(v, 4));
+  v = _mm_max_epu16(v, _mm_srli_si128(v, 2));
+  return _mm_extract_epi16(v, 0);
+}
+
+static int16_t HorizontalMaxS16(__m256i v256) {
+  __m128i v = _mm_max_epi16(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_max_epi16(v, _mm_srli_si128(v, 8));
+  v = _mm_max_epi16(v, _mm_srli_si128(v, 4));
+  v = _mm_max_epi16(v, _mm_srli_si128(v, 2));
+  return (int16_t)_mm_extract_epi16(v, 0);
+}
+
+static int16_t HorizontalMinS16(__m256i v256) {
+  __m128i v = _mm_min_epi16(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_min_epi16(v, _mm_srli_si128(v, 8));
+  v = _mm_min_epi16(v, _mm_srli_si128(v, 4));
+  v = _mm_min_epi16(v, _mm_srli_si128(v, 2));
+  return (int16_t)_mm_extract_epi16(v, 0);
+}
+
+static uint32_t HorizontalMaxU32(__m256i v256) {
+  __m128i v = _mm_max_epu32(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_max_epu32(v, _mm_srli_si128(v, 8));
+  v = _mm_max_epu32(v, _mm_srli_si128(v, 4));
+  return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+static int32_t HorizontalMaxS32(__m256i v256) {
+  __m128i v = _mm_max_epi32(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_max_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_max_epi32(v, _mm_srli_si128(v, 4));
+  return _mm_cvtsi128_si32(v);
+}
+
+static int32_t HorizontalMinS32(__m256i v256) {
+  __m128i v = _mm_min_epi32(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_min_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_min_epi32(v, _mm_srli_si128(v, 4));
+  return _mm_cvtsi128_si32(v);
+}
+
+int16_t WebRtcSpl_MaxAbsValueW16AVX2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int absolute = 0, maximum = 0;
+  __m256i max_v = _mm256_setzero_si256();
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 16 <= length; i += 16) {
+    // The absolute value of -32768 stays 0x8000, which is kept as 32768 by
+    // the unsigned comparison.
+    const __m256i v = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    max_v = _mm256_max_epu16(max_v, _mm256_abs_epi16(v));
+  }
+  maximum = HorizontalMaxU16(max_v);
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
+
+int32_t WebRtcSpl_MaxAbsValueW32AVX2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  uint32_t absolute = 0, maximum = 0;
+  __m256i max_v = _mm256_setzero_si256();
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    // As above, the absolute value of INT_MIN is kept as 0x80000000.
+    const __m256i v = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    max_v = _mm256_max_epu32(max_v, _mm256_abs_epi32(v));
+  }
+  maximum = HorizontalMaxU32(max_v);
+
+  for (; i < length; i++) {
+    absolute =
+        (vector[i] != INT_MIN) ? abs((int)vector[i]) : INT_MAX + (uint32_t)1;
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  maximum = WEBRTC_SPL_MIN(maximum, WEBRTC_SPL_WORD32_MAX);
+
+  return (int32_t)maximum;
+}
+
+int16_t WebRtcSpl_MaxValueW16AVX2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  __m256i max_v = _mm256_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 16 <= length; i += 16) {
+    max_v = _mm256_max_epi16(max_v,
+                             _mm256_loadu_si256((const __m256i*)&vector[i]));
+  }
+  maximum = HorizontalMaxS16(max_v);
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+int32_t WebRtcSpl_MaxValueW32AVX2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  int32_t maximum = WEBRTC_SPL_WORD32_MIN;
+  __m256i max_v = _mm256_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    max_v = _mm256_max_epi32(max_v,
+                             _mm256_loadu_si256((const __m256i*)&vector[i]));
+  }
+  maximum = HorizontalMaxS32(max_v);
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+int16_t WebRtcSpl_MinValueW16AVX2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+  __m256i min_v = _mm256_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 16 <= length; i += 16) {
+    min_v = _mm256_min_epi16(min_v,
+                             _mm256_loadu_si256((const __m256i*)&vector[i]));
+  }
+  minimum = HorizontalMinS16(min_v);
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
+
+int32_t WebRtcSpl_MinValueW32AVX2(const int32_t* vector, size_t length) {
+  size_t i = 0;
+  int32_t minimum = WEBRTC_SPL_WORD32_MAX;
+  __m256i min_v = _mm256_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    min_v = _mm256_min_epi32(min_v,
+                             _mm256_loadu_si256((const __m256i*)&vector[i]));
+  }
+  minimum = HorizontalMinS32(min_v);
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
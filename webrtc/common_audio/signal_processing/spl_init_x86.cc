@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runtime selection of the x86 implementations of the signal processing
+// library functions that are called through function pointers. The pointers
+// are set during static initialization, so they must not be used by the
+// static initializers of other translation units.
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace {
+
+// Returns the fastest of the implementations supported by the CPU. All of them
+// are bit-exact with the C version.
+template <typename Function>
+Function Select(Function c, Function sse41, Function avx2) {
+  if (webrtc::GetCPUInfo(webrtc::kAVX2) != 0) {
+    return avx2;
+  }
+  if (webrtc::GetCPUInfo(webrtc::kSSE4_1) != 0) {
+    return sse41;
+  }
+  return c;
+}
+
+}  // namespace
+
+const MaxAbsValueW16 WebRtcSpl_MaxAbsValueW16 =
+    Select<MaxAbsValueW16>(WebRtcSpl_MaxAbsValueW16C,
+                           WebRtcSpl_MaxAbsValueW16SSE41,
+                           WebRtcSpl_MaxAbsValueW16AVX2);
+const MaxAbsValueW32 WebRtcSpl_MaxAbsValueW32 =
+    Select<MaxAbsValueW32>(WebRtcSpl_MaxAbsValueW32C,
+                           WebRtcSpl_MaxAbsValueW32SSE41,
+                           WebRtcSpl_MaxAbsValueW32AVX2);
+const MaxValueW16 WebRtcSpl_MaxValueW16 =
+    Select<MaxValueW16>(WebRtcSpl_MaxValueW16C,
+                        WebRtcSpl_MaxValueW16SSE41,
+                        WebRtcSpl_MaxValueW16AVX2);
+const MaxValueW32 WebRtcSpl_MaxValueW32 =
+    Select<MaxValueW32>(WebRtcSpl_MaxValueW32C,
+                        WebRtcSpl_MaxValueW32SSE41,
+                        WebRtcSpl_MaxValueW32AVX2);
+const MinValueW16 WebRtcSpl_MinValueW16 =
+    Select<MinValueW16>(WebRtcSpl_MinValueW16C,
+                        WebRtcSpl_MinValueW16SSE41,
+                        WebRtcSpl_MinValueW16AVX2);
+const MinValueW32 WebRtcSpl_MinValueW32 =
+    Select<MinValueW32>(WebRtcSpl_MinValueW32C,
+                        WebRtcSpl_MinValueW32SSE41,
+                        WebRtcSpl_MinValueW32AVX2);
+const CrossCorrelation WebRtcSpl_CrossCorrelation =
+    Select<CrossCorrelation>(WebRtcSpl_CrossCorrelationC,
+                             WebRtcSpl_CrossCorrelationSSE41,
+                             WebRtcSpl_CrossCorrelationAVX2);
+const DownsampleFast WebRtcSpl_DownsampleFast =
+    Select<DownsampleFast>(WebRtcSpl_DownsampleFastC,
+                           WebRtcSpl_DownsampleFastSSE41,
+                           WebRtcSpl_DownsampleFastAVX2);
+const ScaleAndAddVectorsWithRound WebRtcSpl_ScaleAndAddVectorsWithRound =
+    Select<ScaleAndAddVectorsWithRound>(
+        WebRtcSpl_ScaleAndAddVectorsWithRoundC,
+        WebRtcSpl_ScaleAndAddVectorsWithRoundSSE41,
+        WebRtcSpl_ScaleAndAddVectorsWithRoundAVX2);
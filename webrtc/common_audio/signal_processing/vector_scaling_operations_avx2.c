@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the 32-bit values of `low` and `high` truncated to their low 16
+// bits, like the cast to int16_t of the C version. The packing works within
+// each 128-bit half, so the halves of the inputs must have been unpacked the
+// same way.
+static __m256i TruncateToW16(__m256i low, __m256i high) {
+  low = _mm256_srai_epi32(_mm256_slli_epi32(low, 16), 16);
+  high = _mm256_srai_epi32(_mm256_slli_epi32(high, 16), 16);
+  return _mm256_packs_epi32(low, high);
+}
+
+// AVX2 version of WebRtcSpl_ScaleAndAddVectorsWithRound(), bit-exact with the
+// C version. Both products and their sum are computed by one multiply-add on
+// the interleaved inputs.
+int WebRtcSpl_ScaleAndAddVectorsWithRoundAVX2(const int16_t* in_vector1,
+                                              int16_t in_vector1_scale,
+                                              const int16_t* in_vector2,
+                                              int16_t in_vector2_scale,
+                                              int right_shifts,
+                                              int16_t* out_vector,
+                                              size_t length) {
+  size_t i = 0;
+  int round_value = (1 << right_shifts) >> 1;
+
+  if (in_vector1 == NULL || in_vector2 == NULL || out_vector == NULL ||
+      length == 0 || right_shifts < 0) {
+    return -1;
+  }
+
+  const __m256i scales = _mm256_set1_epi32(
+      (int32_t)(((uint32_t)(uint16_t)in_vector2_scale << 16) |
+                (uint16_t)in_vector1_scale));
+  const __m256i round = _mm256_set1_epi32(round_value);
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  for (; i + 16 <= length; i += 16) {
+    const __m256i v1 = _mm256_loadu_si256((const __m256i*)&in_vector1[i]);
+    const __m256i v2 = _mm256_loadu_si256((const __m256i*)&in_vector2[i]);
+    __m256i low = _mm256_madd_epi16(_mm256_unpacklo_epi16(v1, v2), scales);
+    __m256i high = _mm256_madd_epi16(_mm256_unpackhi_epi16(v1, v2), scales);
+    low = _mm256_sra_epi32(_mm256_add_epi32(low, round), shift);
+    high = _mm256_sra_epi32(_mm256_add_epi32(high, round), shift);
+    _mm256_storeu_si256((__m256i*)&out_vector[i], TruncateToW16(low, high));
+  }
+
+  for (; i < length; i++) {
+    out_vector[i] = (int16_t)((
+        in_vector1[i] * in_vector1_scale + in_vector2[i] * in_vector2_scale +
+        round_value) >> right_shifts);
+  }
+
+  return 0;
+}
@@ -477,9 +477,10 @@ AdaptiveFirFilter::AdaptiveFirFilter(size_t max_size_partitions,
                                      size_t size_change_duration_blocks,
                                      size_t num_render_channels,
                                      Aec3Optimization optimization,
+                                     Aec3Fft::Backend fft_backend,
                                      ApmDataDumper* data_dumper)
     : data_dumper_(data_dumper),
-      fft_(),
+      fft_(fft_backend),
       optimization_(optimization),
       num_render_channels_(num_render_channels),
       max_size_partitions_(max_size_partitions),
@@ -507,6 +508,12 @@ void AdaptiveFirFilter::HandleEchoPathChange() {
   ZeroFilter(current_size_partitions_, max_size_partitions_, &H_);
 }
 
+void AdaptiveFirFilter::Reset(size_t size_partitions) {
+  ZeroFilter(0, max_size_partitions_, &H_);
+  partition_to_constrain_ = 0;
+  SetSizePartitions(size_partitions, /*immediate_effect=*/true);
+}
+
 void AdaptiveFirFilter::SetSizePartitions(size_t size, bool immediate_effect) {
   RTC_DCHECK_EQ(max_size_partitions_, H_.capacity());
   RTC_DCHECK_LE(size, max_size_partitions_);
@@ -565,6 +572,11 @@ void AdaptiveFirFilter::Filter(const RenderBuffer& render_buffer,
     case Aec3Optimization::kAvx2:
       aec3::ApplyFilter_Avx2(render_buffer, current_size_partitions_, H_, S);
       break;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::ApplyFilter_Avx512(render_buffer, current_size_partitions_, H_, S);
+      break;
+#endif
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -611,6 +623,11 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
     case Aec3Optimization::kAvx2:
       aec3::ComputeFrequencyResponse_Avx2(current_size_partitions_, H_, H2);
       break;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::ComputeFrequencyResponse_Avx512(current_size_partitions_, H_, H2);
+      break;
+#endif
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -640,6 +657,12 @@ void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
       aec3::AdaptPartitions_Avx2(render_buffer, G, current_size_partitions_,
                                  &H_);
       break;
+#if defined(WEBRTC_ENABLE_AVX512)
+    case Aec3Optimization::kAvx512:
+      aec3::AdaptPartitions_Avx512(render_buffer, G, current_size_partitions_,
+                                   &H_);
+      break;
+#endif
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -747,4 +770,36 @@ void AdaptiveFirFilter::SetFilter(size_t num_partitions,
   }
 }
 
+void AdaptiveFirFilter::SaveState(StateWriter* writer) const {
+  writer->WriteSize(max_size_partitions_);
+  writer->WriteSize(num_render_channels_);
+  writer->WriteSize(current_size_partitions_);
+  for (size_t p = 0; p < current_size_partitions_; ++p) {
+    for (size_t ch = 0; ch < num_render_channels_; ++ch) {
+      writer->WriteFloats(H_[p][ch].re);
+      writer->WriteFloats(H_[p][ch].im);
+    }
+  }
+}
+
+bool AdaptiveFirFilter::RestoreState(StateReader* reader) {
+  size_t size_partitions;
+  if (!reader->ReadExpectedSize(max_size_partitions_) ||
+      !reader->ReadExpectedSize(num_render_channels_) ||
+      !reader->ReadSize(&size_partitions, max_size_partitions_) ||
+      size_partitions == 0) {
+    return false;
+  }
+  SetSizePartitions(size_partitions, /*immediate_effect=*/true);
+  for (size_t p = 0; p < current_size_partitions_; ++p) {
+    for (size_t ch = 0; ch < num_render_channels_; ++ch) {
+      if (!reader->ReadFloats(H_[p][ch].re) ||
+          !reader->ReadFloats(H_[p][ch].im)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace webrtc
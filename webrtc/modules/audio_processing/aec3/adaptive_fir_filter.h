@@ -23,6 +23,7 @@
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
@@ -48,6 +49,11 @@ void ComputeFrequencyResponse_Avx2(
     size_t num_partitions,
     const std::vector<std::vector<FftData>>& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+
+void ComputeFrequencyResponse_Avx512(
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
 
 // Adapts the filter partitions.
@@ -71,6 +77,11 @@ void AdaptPartitions_Avx2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
                           std::vector<std::vector<FftData>>* H);
+
+void AdaptPartitions_Avx512(const RenderBuffer& render_buffer,
+                            const FftData& G,
+                            size_t num_partitions,
+                            std::vector<std::vector<FftData>>* H);
 #endif
 
 // Produces the filter output.
@@ -94,6 +105,11 @@ void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
                       size_t num_partitions,
                       const std::vector<std::vector<FftData>>& H,
                       FftData* S);
+
+void ApplyFilter_Avx512(const RenderBuffer& render_buffer,
+                        size_t num_partitions,
+                        const std::vector<std::vector<FftData>>& H,
+                        FftData* S);
 #endif
 
 }  // namespace aec3
@@ -106,6 +122,7 @@ class AdaptiveFirFilter {
                     size_t size_change_duration_blocks,
                     size_t num_render_channels,
                     Aec3Optimization optimization,
+                    Aec3Fft::Backend fft_backend,
                     ApmDataDumper* data_dumper);
 
   ~AdaptiveFirFilter();
@@ -129,6 +146,10 @@ class AdaptiveFirFilter {
   // the filter adaptation accordingly.
   void HandleEchoPathChange();
 
+  // Zeroes the filter and sets its size, as in a new filter with the initial
+  // size `size_partitions`.
+  void Reset(size_t size_partitions);
+
   // Returns the filter size.
   size_t SizePartitions() const { return current_size_partitions_; }
 
@@ -159,6 +180,11 @@ class AdaptiveFirFilter {
   // Gets the filter coefficients.
   const std::vector<std::vector<FftData>>& GetFilter() const { return H_; }
 
+  // Saves the size and the coefficients of the filter, and restores them into
+  // a filter with the same maximum size and number of render channels.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   // Adapts the filter and updates the filter size.
   void AdaptAndUpdateSize(const RenderBuffer& render_buffer, const FftData& G);
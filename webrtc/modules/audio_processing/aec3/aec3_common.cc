@@ -20,6 +20,11 @@ namespace webrtc {
 
 Aec3Optimization DetectOptimization() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ENABLE_AVX512)
+  if (GetCPUInfo(kAVX512) != 0) {
+    return Aec3Optimization::kAvx512;
+  }
+#endif
   if (GetCPUInfo(kAVX2) != 0) {
     return Aec3Optimization::kAvx2;
   } else if (GetCPUInfo(kSSE2) != 0) {
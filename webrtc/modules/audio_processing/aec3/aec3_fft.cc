@@ -11,11 +11,14 @@
 #include "modules/audio_processing/aec3/aec3_fft.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
+#include "third_party/pffft/src/pffft.h"
 
 namespace webrtc {
 
@@ -71,6 +74,9 @@ const float kSqrtHanning128[kFftLength] = {
     0.19509032201613f, 0.17096188876030f, 0.14673047445536f, 0.12241067519922f,
     0.09801714032956f, 0.07356456359967f, 0.04906767432742f, 0.02454122852291f};
 
+// PFFFT requires its buffers to be aligned to the SIMD vector size.
+constexpr size_t kPffftAlignment = 16;
+
 bool IsSse2Available() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
   return GetCPUInfo(kSSE2) != 0;
@@ -79,9 +85,78 @@ bool IsSse2Available() {
 #endif
 }
 
+bool IsPffftAligned(const float* p) {
+  return reinterpret_cast<uintptr_t>(p) % kPffftAlignment == 0;
+}
+
+PFFFT_Setup* CreatePffftSetup(Aec3Fft::Backend backend) {
+  // Without SIMD support, PFFFT is slower than the Ooura FFT.
+  if (backend != Aec3Fft::Backend::kPffft || !Pffft::IsSimdEnabled()) {
+    return nullptr;
+  }
+  RTC_DCHECK(Pffft::IsValidFftSize(kFftLength, Pffft::FftType::kReal));
+  return pffft_new_setup(kFftLength, PFFFT_REAL);
+}
+
 }  // namespace
 
-Aec3Fft::Aec3Fft() : ooura_fft_(IsSse2Available()) {}
+Aec3Fft::Aec3Fft() : Aec3Fft(Backend::kOoura) {}
+
+Aec3Fft::Aec3Fft(Backend backend)
+    : ooura_fft_(IsSse2Available()), pffft_setup_(CreatePffftSetup(backend)) {}
+
+Aec3Fft::~Aec3Fft() {
+  if (pffft_setup_) {
+    pffft_destroy_setup(pffft_setup_);
+  }
+}
+
+Aec3Fft::Backend Aec3Fft::SelectBackend(const EchoCanceller3Config& config) {
+  return config.fft.use_pffft ? Backend::kPffft : Backend::kOoura;
+}
+
+// The setup is only read by the transforms, and all the buffers are local, so
+// that the PFFFT backend is as thread safe as the Ooura backend.
+void Aec3Fft::PffftFft(std::array<float, kFftLength>* x, FftData* X) const {
+  alignas(kPffftAlignment) std::array<float, kFftLength> aligned;
+  alignas(kPffftAlignment) std::array<float, kFftLength> work;
+  float* data = x->data();
+  if (!IsPffftAligned(data)) {
+    std::copy(x->begin(), x->end(), aligned.begin());
+    data = aligned.data();
+  }
+  pffft_transform_ordered(pffft_setup_, data, data, work.data(),
+                          PFFFT_FORWARD);
+
+  // The ordered output is packed as in the Ooura FFT, but PFFFT uses the
+  // opposite sign convention for the imaginary part.
+  X->re[0] = data[0];
+  X->re[kFftLengthBy2] = data[1];
+  X->im[0] = X->im[kFftLengthBy2] = 0.f;
+  for (size_t k = 1, j = 2; k < kFftLengthBy2; ++k, j += 2) {
+    X->re[k] = data[j];
+    X->im[k] = -data[j + 1];
+  }
+}
+
+void Aec3Fft::PffftIfft(const FftData& X,
+                        std::array<float, kFftLength>* x) const {
+  alignas(kPffftAlignment) std::array<float, kFftLength> packed;
+  alignas(kPffftAlignment) std::array<float, kFftLength> work;
+  packed[0] = X.re[0];
+  packed[1] = X.re[kFftLengthBy2];
+  for (size_t k = 1, j = 2; k < kFftLengthBy2; ++k, j += 2) {
+    packed[j] = X.re[k];
+    packed[j + 1] = -X.im[k];
+  }
+  pffft_transform_ordered(pffft_setup_, packed.data(), packed.data(),
+                          work.data(), PFFFT_BACKWARD);
+
+  // The unnormalized PFFFT inverse is scaled by kFftLength, while the Ooura
+  // inverse is scaled by kFftLengthBy2. The scaling by a power of two is exact.
+  std::transform(packed.begin(), packed.end(), x->begin(),
+                 [](float a) { return 0.5f * a; });
+}
 
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
@@ -89,7 +164,7 @@ void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
                             FftData* X) const {
   RTC_DCHECK(X);
   RTC_DCHECK_EQ(kFftLengthBy2, x.size());
-  std::array<float, kFftLength> fft;
+  alignas(kPffftAlignment) std::array<float, kFftLength> fft;
   std::fill(fft.begin(), fft.begin() + kFftLengthBy2, 0.f);
   switch (window) {
     case Window::kRectangular:
@@ -117,7 +192,7 @@ void Aec3Fft::PaddedFft(rtc::ArrayView<const float> x,
   RTC_DCHECK(X);
   RTC_DCHECK_EQ(kFftLengthBy2, x.size());
   RTC_DCHECK_EQ(kFftLengthBy2, x_old.size());
-  std::array<float, kFftLength> fft;
+  alignas(kPffftAlignment) std::array<float, kFftLength> fft;
 
   switch (window) {
     case Window::kRectangular:
@@ -14,11 +14,15 @@
 #include <array>
 
 #include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
 #include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
 
+// Forward declaration.
+struct PFFFT_Setup;
+
 namespace webrtc {
 
 // Wrapper class that provides 128 point real valued FFT functionality with the
@@ -26,22 +30,44 @@ namespace webrtc {
 class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
+  // Transform implementation. kPffft uses the SIMD optimized PFFFT library,
+  // and falls back to kOoura when PFFFT is built without SIMD support. The
+  // results of the two backends only differ by rounding errors.
+  enum class Backend { kOoura, kPffft };
 
   Aec3Fft();
+  explicit Aec3Fft(Backend backend);
+  ~Aec3Fft();
 
   Aec3Fft(const Aec3Fft&) = delete;
   Aec3Fft& operator=(const Aec3Fft&) = delete;
 
+  // Returns the backend requested by `config`.
+  static Backend SelectBackend(const EchoCanceller3Config& config);
+
+  // Returns the backend in use.
+  Backend backend() const {
+    return pffft_setup_ ? Backend::kPffft : Backend::kOoura;
+  }
+
   // Computes the FFT. Note that both the input and output are modified.
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
+    if (pffft_setup_) {
+      PffftFft(x, X);
+      return;
+    }
     ooura_fft_.Fft(x->data());
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
+    if (pffft_setup_) {
+      PffftIfft(X, x);
+      return;
+    }
     X.CopyToPackedArray(x);
     ooura_fft_.InverseFft(x->data());
   }
@@ -67,7 +93,11 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
+  void PffftFft(std::array<float, kFftLength>* x, FftData* X) const;
+  void PffftIfft(const FftData& X, std::array<float, kFftLength>* x) const;
+
   const OouraFft ooura_fft_;
+  PFFFT_Setup* const pffft_setup_;
 };
 
 }  // namespace webrtc
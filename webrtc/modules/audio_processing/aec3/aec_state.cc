@@ -13,6 +13,7 @@
 #include <math.h>
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
 #include <optional>
 #include <vector>
@@ -169,6 +170,47 @@ void AecState::HandleEchoPathChange(
   }
 }
 
+void AecState::Reset() {
+  initial_state_.Reset();
+  delay_state_.Reset();
+  if (transparent_state_) {
+    transparent_state_->ResetForReuse();
+  }
+  filter_quality_state_.ResetForReuse();
+  saturation_detector_ = SaturationDetector();
+  erl_estimator_.ResetForReuse();
+  erle_estimator_.Reset(true);
+  strong_not_saturated_render_blocks_ = 0;
+  blocks_with_active_render_ = 0;
+  capture_signal_saturation_ = false;
+  filter_analyzer_.ResetForReuse();
+  echo_audibility_.Reset();
+  reverb_model_estimator_.Reset();
+  avg_render_reverb_.Reset();
+  subtractor_output_analyzer_.HandleEchoPathChange();
+}
+
+void AecState::SaveState(StateWriter* writer) const {
+  initial_state_.SaveState(writer);
+  filter_quality_state_.SaveState(writer);
+  writer->WriteSize(strong_not_saturated_render_blocks_);
+  writer->WriteSize(blocks_with_active_render_);
+  erl_estimator_.SaveState(writer);
+  erle_estimator_.SaveState(writer);
+  reverb_model_estimator_.SaveState(writer);
+}
+
+bool AecState::RestoreState(StateReader* reader) {
+  constexpr size_t kMaxBlocks = std::numeric_limits<int32_t>::max();
+  return initial_state_.RestoreState(reader) &&
+         filter_quality_state_.RestoreState(reader) &&
+         reader->ReadSize(&strong_not_saturated_render_blocks_, kMaxBlocks) &&
+         reader->ReadSize(&blocks_with_active_render_, kMaxBlocks) &&
+         erl_estimator_.RestoreState(reader) &&
+         erle_estimator_.RestoreState(reader) &&
+         reverb_model_estimator_.RestoreState(reader);
+}
+
 void AecState::Update(
     const std::optional<DelayEstimate>& external_delay,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
@@ -351,12 +393,32 @@ void AecState::InitialState::InitialState::Update(bool active_render,
   transition_triggered_ = !initial_state_ && prev_initial_state;
 }
 
+void AecState::InitialState::SaveState(StateWriter* writer) const {
+  writer->WriteBool(initial_state_);
+  writer->WriteSize(strong_not_saturated_render_blocks_);
+}
+
+bool AecState::InitialState::RestoreState(StateReader* reader) {
+  transition_triggered_ = false;
+  return reader->ReadBool(&initial_state_) &&
+         reader->ReadSize(&strong_not_saturated_render_blocks_,
+                          std::numeric_limits<int32_t>::max());
+}
+
 AecState::FilterDelay::FilterDelay(const EchoCanceller3Config& config,
                                    size_t num_capture_channels)
     : delay_headroom_blocks_(config.delay.delay_headroom_samples / kBlockSize),
       filter_delays_blocks_(num_capture_channels, delay_headroom_blocks_),
       min_filter_delay_(delay_headroom_blocks_) {}
 
+void AecState::FilterDelay::Reset() {
+  external_delay_reported_ = false;
+  std::fill(filter_delays_blocks_.begin(), filter_delays_blocks_.end(),
+            delay_headroom_blocks_);
+  min_filter_delay_ = delay_headroom_blocks_;
+  external_delay_ = std::nullopt;
+}
+
 void AecState::FilterDelay::Update(
     rtc::ArrayView<const int> analyzer_filter_delay_estimates_blocks,
     const std::optional<DelayEstimate>& external_delay,
@@ -401,6 +463,27 @@ void AecState::FilteringQualityAnalyzer::Reset() {
   filter_update_blocks_since_reset_ = 0;
 }
 
+void AecState::FilteringQualityAnalyzer::ResetForReuse() {
+  Reset();
+  filter_update_blocks_since_start_ = 0;
+  convergence_seen_ = false;
+}
+
+void AecState::FilteringQualityAnalyzer::SaveState(
+    StateWriter* writer) const {
+  writer->WriteSize(filter_update_blocks_since_start_);
+  writer->WriteBool(convergence_seen_);
+}
+
+bool AecState::FilteringQualityAnalyzer::RestoreState(StateReader* reader) {
+  // The render buffer restarts empty, so the restored filters are used once
+  // there has been enough render since, as after an in-call reset.
+  Reset();
+  constexpr size_t kMaxBlocks = std::numeric_limits<int32_t>::max();
+  return reader->ReadSize(&filter_update_blocks_since_start_, kMaxBlocks) &&
+         reader->ReadBool(&convergence_seen_);
+}
+
 void AecState::FilteringQualityAnalyzer::Update(
     bool active_render,
     bool transparent_mode,
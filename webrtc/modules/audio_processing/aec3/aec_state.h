@@ -33,6 +33,7 @@
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/aec3/subtractor_output_analyzer.h"
 #include "modules/audio_processing/aec3/transparent_mode.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -117,6 +118,9 @@ class AecState {
   // Takes appropriate action at an echo path change.
   void HandleEchoPathChange(const EchoPathVariability& echo_path_variability);
 
+  // Resets all the estimates, as in a new AecState.
+  void Reset();
+
   // Returns the decay factor for the echo reverberation. The parameter `mild`
   // indicates which exponential decay to return. The default one or a milder
   // one that can be used during nearend regions.
@@ -135,6 +139,11 @@ class AecState {
     return initial_state_.TransitionTriggered();
   }
 
+  // Returns whether the initial state is active.
+  bool InitialStateActive() const {
+    return initial_state_.InitialStateActive();
+  }
+
   // Updates the aec state.
   // TODO(bugs.webrtc.org/10913): Compute multi-channel ERL.
   void Update(
@@ -154,6 +163,13 @@ class AecState {
     return filter_analyzer_.FilterLengthBlocks();
   }
 
+  // Saves and restores the converged estimates: the progress out of the
+  // initial state, the filter quality analysis, and the ERL, ERLE and reverb
+  // model estimates. The remaining state is derived from the signals and the
+  // filters within a few blocks.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
@@ -180,6 +196,9 @@ class AecState {
     // Returns that the transition from the initial state has was started.
     bool TransitionTriggered() const { return transition_triggered_; }
 
+    void SaveState(StateWriter* writer) const;
+    bool RestoreState(StateReader* reader);
+
    private:
     const bool conservative_initial_phase_;
     const float initial_state_seconds_;
@@ -210,6 +229,9 @@ class AecState {
     // beginning of the filter
     int MinDirectPathFilterDelay() const { return min_filter_delay_; }
 
+    // Resets the delays to the headroom.
+    void Reset();
+
     // Updates the delay estimates based on new data.
     void Update(
         rtc::ArrayView<const int> analyzer_filter_delay_estimates_blocks,
@@ -249,6 +271,12 @@ class AecState {
     // Resets the state of the analyzer.
     void Reset();
 
+    // Resets the state since the start as well, as in a new analyzer.
+    void ResetForReuse();
+
+    void SaveState(StateWriter* writer) const;
+    bool RestoreState(StateReader* reader);
+
     // Updates the analysis based on new data.
     void Update(bool active_render,
                 bool transparent_mode,
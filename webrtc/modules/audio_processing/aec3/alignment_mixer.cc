@@ -57,10 +57,18 @@ AlignmentMixer::AlignmentMixer(size_t num_channels,
       selection_variant_(
           ChooseMixingVariant(downmix, adaptive_selection, num_channels_)) {
   if (selection_variant_ == MixingVariant::kAdaptive) {
-    std::fill(strong_block_counters_.begin(), strong_block_counters_.end(), 0);
     cumulative_energies_.resize(num_channels_);
+  }
+  Reset();
+}
+
+void AlignmentMixer::Reset() {
+  if (selection_variant_ == MixingVariant::kAdaptive) {
+    std::fill(strong_block_counters_.begin(), strong_block_counters_.end(), 0);
     std::fill(cumulative_energies_.begin(), cumulative_energies_.end(), 0.f);
   }
+  selected_channel_ = 0;
+  block_counter_ = 0;
 }
 
 void AlignmentMixer::ProduceOutput(const Block& x,
@@ -36,6 +36,9 @@ class AlignmentMixer {
 
   void ProduceOutput(const Block& x, rtc::ArrayView<float, kBlockSize> y);
 
+  // Resets the channel selection to that of a new mixer.
+  void Reset();
+
   enum class MixingVariant { kDownmix, kAdaptive, kFixed };
 
  private:
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_ANALYZED_RENDER_BLOCK_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_ANALYZED_RENDER_BLOCK_H_
+
+#include <array>
+#include <vector>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+
+namespace webrtc {
+
+// Render block together with the products that RenderDelayBuffer derives from
+// it when it is inserted, computed once by a SharedRenderAnalyzer.
+struct AnalyzedRenderBlock {
+  AnalyzedRenderBlock(int num_bands, int num_channels)
+      : block(num_bands, num_channels),
+        fft(num_channels),
+        spectrum(num_channels) {}
+
+  void SetNumChannels(int num_channels) {
+    block.SetNumChannels(num_channels);
+    fft.resize(num_channels);
+    spectrum.resize(num_channels);
+  }
+
+  // Render block as extracted from the frame blocker, before the render gain
+  // is applied.
+  Block block;
+  // Decimated alignment mix of the block, in time order. Only the first
+  // kBlockSize / down_sampling_factor samples are set.
+  std::array<float, kBlockSize> downsampled;
+  // Padded FFT of the lowest band of each channel, with the previous block,
+  // and its power spectrum. The render gain is applied.
+  std::vector<FftData> fft;
+  std::vector<std::array<float, kFftLengthBy2Plus1>> spectrum;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_ANALYZED_RENDER_BLOCK_H_
@@ -9,6 +9,8 @@
  */
 #include "modules/audio_processing/aec3/block_delay_buffer.h"
 
+#include <algorithm>
+
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
 
@@ -26,6 +28,15 @@ BlockDelayBuffer::BlockDelayBuffer(size_t num_channels,
 
 BlockDelayBuffer::~BlockDelayBuffer() = default;
 
+void BlockDelayBuffer::Reset() {
+  for (auto& channel : buf_) {
+    for (auto& band : channel) {
+      std::fill(band.begin(), band.end(), 0.f);
+    }
+  }
+  last_insert_ = 0;
+}
+
 void BlockDelayBuffer::DelaySignal(AudioBuffer* frame) {
   RTC_DCHECK_EQ(buf_.size(), frame->num_channels());
   if (delay_ == 0) {
@@ -32,6 +32,9 @@ class BlockDelayBuffer {
   // Delays the samples by the specified delay.
   void DelaySignal(AudioBuffer* frame);
 
+  // Zeroes the delayed samples.
+  void Reset();
+
  private:
   const size_t frame_length_;
   const size_t delay_;
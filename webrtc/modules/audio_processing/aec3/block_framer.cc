@@ -30,6 +30,14 @@ BlockFramer::BlockFramer(size_t num_bands, size_t num_channels)
 
 BlockFramer::~BlockFramer() = default;
 
+void BlockFramer::Reset() {
+  for (auto& band : buffer_) {
+    for (auto& channel : band) {
+      channel.assign(kBlockSize, 0.f);
+    }
+  }
+}
+
 // All the constants are chosen so that the buffer is either empty or has enough
 // samples for InsertBlockAndExtractSubFrame to produce a frame. In order to
 // achieve this, the InsertBlockAndExtractSubFrame and InsertBlock methods need
@@ -38,6 +38,8 @@ class BlockFramer {
   void InsertBlockAndExtractSubFrame(
       const Block& block,
       std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame);
+  // Restores the buffered samples of a new framer.
+  void Reset();
 
  private:
   const size_t num_bands_;
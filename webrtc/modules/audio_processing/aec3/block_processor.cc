@@ -55,6 +55,7 @@ class BlockProcessorImpl final : public BlockProcessor {
                       Block* capture_block) override;
 
   void BufferRender(const Block& block) override;
+  void BufferAnalyzedRender(const AnalyzedRenderBlock& block) override;
 
   void UpdateEchoLeakageStatus(bool leakage_detected) override;
 
@@ -63,7 +64,15 @@ class BlockProcessorImpl final : public BlockProcessor {
   void SetAudioBufferDelay(int delay_ms) override;
   void SetCaptureOutputUsage(bool capture_output_used) override;
 
+  void SaveState(StateWriter* writer) const override;
+  bool RestoreState(StateReader* reader) override;
+
+  void Reset() override;
+
  private:
+  // Updates the metrics and the render state after a render block is buffered.
+  void OnRenderBuffered();
+
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const EchoCanceller3Config config_;
@@ -77,6 +86,8 @@ class BlockProcessorImpl final : public BlockProcessor {
   RenderDelayBuffer::BufferingEvent render_event_;
   size_t capture_call_counter_ = 0;
   std::optional<DelayEstimate> estimated_delay_;
+  std::optional<DelayEstimate> restored_delay_;
+  size_t blocks_since_restore_ = 0;
 };
 
 std::atomic<int> BlockProcessorImpl::instance_count_(0);
@@ -168,7 +179,17 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
         render_buffer_->GetDownsampledRenderBuffer(), render_buffer_->Delay(),
         *capture_block);
 
-    if (estimated_delay_) {
+    if (restored_delay_ && !estimated_delay_) {
+      // Until the delay estimator finds the delay, use the restored delay once
+      // the restarted render buffer holds enough render for it, and realign
+      // the render buffer with it after every underrun. This is not flagged as
+      // a delay change, which would reset the restored filters.
+      if (++blocks_since_restore_ > restored_delay_->delay) {
+        estimated_delay_ = restored_delay_;
+        render_buffer_->AlignFromDelay(estimated_delay_->delay);
+      }
+    } else if (estimated_delay_) {
+      restored_delay_ = std::nullopt;
       bool delay_change =
           render_buffer_->AlignFromDelay(estimated_delay_->delay);
       if (delay_change) {
@@ -183,8 +204,12 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
     }
 
     echo_path_variability.clock_drift = delay_controller_->HasClockdrift();
+    if (echo_path_variability.AudioPathChanged()) {
+      delay_controller_->ResumeFullDelaySearch();
+    }
 
   } else {
+    restored_delay_ = std::nullopt;
     render_buffer_->AlignFromExternalDelay();
   }
 
@@ -207,7 +232,20 @@ void BlockProcessorImpl::BufferRender(const Block& block) {
                         block.View(/*band=*/0, /*channel=*/0), 16000, 1);
 
   render_event_ = render_buffer_->Insert(block);
+  OnRenderBuffered();
+}
+
+void BlockProcessorImpl::BufferAnalyzedRender(
+    const AnalyzedRenderBlock& block) {
+  RTC_DCHECK_EQ(NumBandsForRate(sample_rate_hz_), block.block.NumBands());
+  data_dumper_->DumpRaw("aec3_processblock_call_order",
+                        static_cast<int>(BlockProcessorApiCall::kRender));
+
+  render_event_ = render_buffer_->InsertAnalyzed(block);
+  OnRenderBuffered();
+}
 
+void BlockProcessorImpl::OnRenderBuffered() {
   metrics_.UpdateRender(render_event_ !=
                         RenderDelayBuffer::BufferingEvent::kNone);
 
@@ -235,12 +273,75 @@ void BlockProcessorImpl::SetCaptureOutputUsage(bool capture_output_used) {
   echo_remover_->SetCaptureOutputUsage(capture_output_used);
 }
 
+void BlockProcessorImpl::SaveState(StateWriter* writer) const {
+  const std::optional<DelayEstimate>& delay =
+      restored_delay_ ? restored_delay_ : estimated_delay_;
+  writer->WriteBool(delay.has_value());
+  if (delay) {
+    writer->WriteSize(delay->delay);
+    writer->WriteBool(delay->quality == DelayEstimate::Quality::kRefined);
+  }
+  echo_remover_->SaveState(writer);
+}
+
+bool BlockProcessorImpl::RestoreState(StateReader* reader) {
+  bool has_delay;
+  if (!reader->ReadBool(&has_delay)) {
+    return false;
+  }
+  restored_delay_ = std::nullopt;
+  blocks_since_restore_ = 0;
+  if (has_delay) {
+    size_t delay;
+    bool refined;
+    if (!reader->ReadSize(&delay, render_buffer_->MaxDelay()) ||
+        !reader->ReadBool(&refined)) {
+      return false;
+    }
+    restored_delay_ = DelayEstimate(refined ? DelayEstimate::Quality::kRefined
+                                            : DelayEstimate::Quality::kCoarse,
+                                    delay);
+  }
+  // The delay is searched for from scratch, as in a new echo canceller: the
+  // next capture block resets the render buffer and the delay controller, as
+  // when the capture processing first starts. The saved delay is relative to
+  // the render buffer latency, so it remains valid after the reset, and it is
+  // used until the delay estimator finds a delay.
+  estimated_delay_ = std::nullopt;
+  capture_properly_started_ = false;
+  return echo_remover_->RestoreState(reader);
+}
+
+void BlockProcessorImpl::Reset() {
+  render_buffer_->ResetForReuse();
+  if (delay_controller_) {
+    delay_controller_->ResetForReuse();
+  }
+  echo_remover_->Reset();
+  capture_properly_started_ = false;
+  render_properly_started_ = false;
+  render_event_ = RenderDelayBuffer::BufferingEvent::kNone;
+  capture_call_counter_ = 0;
+  estimated_delay_ = std::nullopt;
+  restored_delay_ = std::nullopt;
+  blocks_since_restore_ = 0;
+}
+
 }  // namespace
 
 BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
                                        int sample_rate_hz,
                                        size_t num_render_channels,
                                        size_t num_capture_channels) {
+  return Create(config, sample_rate_hz, num_render_channels,
+                num_capture_channels, /*channel_worker_pool=*/nullptr);
+}
+
+BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
+                                       int sample_rate_hz,
+                                       size_t num_render_channels,
+                                       size_t num_capture_channels,
+                                       ChannelWorkerPool* channel_worker_pool) {
   std::unique_ptr<RenderDelayBuffer> render_buffer(
       RenderDelayBuffer::Create(config, sample_rate_hz, num_render_channels));
   std::unique_ptr<RenderDelayController> delay_controller;
@@ -248,8 +349,9 @@ BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
     delay_controller.reset(RenderDelayController::Create(config, sample_rate_hz,
                                                          num_capture_channels));
   }
-  std::unique_ptr<EchoRemover> echo_remover(EchoRemover::Create(
-      config, sample_rate_hz, num_render_channels, num_capture_channels));
+  std::unique_ptr<EchoRemover> echo_remover(
+      EchoRemover::Create(config, sample_rate_hz, num_render_channels,
+                          num_capture_channels, channel_worker_pool));
   return Create(config, sample_rate_hz, num_render_channels,
                 num_capture_channels, std::move(render_buffer),
                 std::move(delay_controller), std::move(echo_remover));
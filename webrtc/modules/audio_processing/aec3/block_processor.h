@@ -18,10 +18,13 @@
 
 #include "api/audio/echo_canceller3_config.h"
 #include "api/audio/echo_control.h"
+#include "modules/audio_processing/aec3/analyzed_render_block.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -32,6 +35,13 @@ class BlockProcessor {
                                 int sample_rate_hz,
                                 size_t num_render_channels,
                                 size_t num_capture_channels);
+  // Processes the capture channels in parallel on `channel_worker_pool` if it
+  // is non-null. The pool must outlive the returned object.
+  static BlockProcessor* Create(const EchoCanceller3Config& config,
+                                int sample_rate_hz,
+                                size_t num_render_channels,
+                                size_t num_capture_channels,
+                                ChannelWorkerPool* channel_worker_pool);
   // Only used for testing purposes.
   static BlockProcessor* Create(
       const EchoCanceller3Config& config,
@@ -65,6 +75,11 @@ class BlockProcessor {
   // Buffers a block of render data supplied by a FrameBlocker object.
   virtual void BufferRender(const Block& render_block) = 0;
 
+  // Buffers a block of render data together with its render products, as
+  // supplied by a SharedRenderAnalyzer.
+  virtual void BufferAnalyzedRender(
+      const AnalyzedRenderBlock& render_block) = 0;
+
   // Reports whether echo leakage has been detected in the echo canceller
   // output.
   virtual void UpdateEchoLeakageStatus(bool leakage_detected) = 0;
@@ -74,6 +89,18 @@ class BlockProcessor {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Saves and restores the estimated delay and the converged state of the echo
+  // remover. Restoring a state resets the render buffer and the delay
+  // estimation at the next capture block, as when the capture processing
+  // starts. A restored delay is used once the render buffer holds that much
+  // render, until the delay estimator finds a delay.
+  virtual void SaveState(StateWriter* writer) const = 0;
+  virtual bool RestoreState(StateReader* reader) = 0;
+
+  // Resets the render buffer, the delay estimation and the echo remover to the
+  // state of a new block processor. The metrics are kept.
+  virtual void Reset() = 0;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ChannelWorkerPool::ChannelWorkerPool(size_t num_worker_threads) {
+  workers_.reserve(num_worker_threads);
+  for (size_t i = 0; i < num_worker_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    Worker* worker = workers_.back().get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker] { RunWorker(worker); }, "aec3_channel_worker");
+  }
+}
+
+ChannelWorkerPool::~ChannelWorkerPool() {
+  quit_.store(true);
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+    worker->thread.Finalize();
+  }
+}
+
+void ChannelWorkerPool::ParallelFor(size_t num_channels,
+                                    rtc::FunctionView<void(size_t)> task) {
+  const size_t num_workers_to_wake =
+      std::min(workers_.size(), num_channels > 0 ? num_channels - 1 : 0);
+  if (num_workers_to_wake == 0) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      task(ch);
+    }
+    return;
+  }
+
+  RTC_DCHECK_EQ(num_active_workers_.load(), 0);
+  task_ = task;
+  num_channels_ = num_channels;
+  next_channel_.store(0);
+  num_active_workers_.store(num_workers_to_wake);
+  for (size_t i = 0; i < num_workers_to_wake; ++i) {
+    workers_[i]->wake_up.Set();
+  }
+
+  RunTasks();
+
+  // Join with every woken worker, not only with the completion of the last
+  // task, so that no worker still reads the shared state when the next call
+  // overwrites it.
+  all_workers_done_.Wait(rtc::Event::kForever, rtc::Event::kForever);
+  task_ = nullptr;
+}
+
+void ChannelWorkerPool::RunWorker(Worker* worker) {
+  while (true) {
+    worker->wake_up.Wait(rtc::Event::kForever, rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    RunTasks();
+    if (num_active_workers_.fetch_sub(1) == 1) {
+      all_workers_done_.Set();
+    }
+  }
+}
+
+void ChannelWorkerPool::RunTasks() {
+  for (size_t ch = next_channel_.fetch_add(1); ch < num_channels_;
+       ch = next_channel_.fetch_add(1)) {
+    task_(ch);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_CHANNEL_WORKER_POOL_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_CHANNEL_WORKER_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+// Small pool of worker threads for running independent per-channel tasks of
+// the capture processing in parallel. The calling thread takes part in the
+// work, and idle participants claim the next unprocessed channel from a shared
+// counter, so that the load balances itself when channels differ in cost.
+//
+// Since every channel is processed by exactly one task that only touches
+// state belonging to that channel, the results are identical to those of a
+// serial loop over the channels, regardless of the number of workers.
+class ChannelWorkerPool {
+ public:
+  // Creates a pool with `num_worker_threads` threads in addition to the
+  // calling thread.
+  explicit ChannelWorkerPool(size_t num_worker_threads);
+  ~ChannelWorkerPool();
+  ChannelWorkerPool(const ChannelWorkerPool&) = delete;
+  ChannelWorkerPool& operator=(const ChannelWorkerPool&) = delete;
+
+  // Calls `task(ch)` once for every ch in [0, num_channels) and returns when
+  // all calls have completed. Must not be called concurrently or recursively.
+  void ParallelFor(size_t num_channels, rtc::FunctionView<void(size_t)> task);
+
+  size_t num_worker_threads() const { return workers_.size(); }
+
+ private:
+  struct Worker {
+    rtc::Event wake_up;
+    rtc::PlatformThread thread;
+  };
+
+  void RunWorker(Worker* worker);
+  void RunTasks();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  rtc::Event all_workers_done_;
+  std::atomic<bool> quit_{false};
+
+  // State of the ongoing ParallelFor() call. Written by the calling thread
+  // before any worker is woken up.
+  rtc::FunctionView<void(size_t)> task_;
+  size_t num_channels_ = 0;
+  std::atomic<size_t> next_channel_{0};
+  std::atomic<size_t> num_active_workers_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_CHANNEL_WORKER_POOL_H_
@@ -11,13 +11,18 @@
 
 namespace webrtc {
 
-ClockdriftDetector::ClockdriftDetector()
-    : level_(Level::kNone), stability_counter_(0) {
-  delay_history_.fill(0);
+ClockdriftDetector::ClockdriftDetector() {
+  Reset();
 }
 
 ClockdriftDetector::~ClockdriftDetector() = default;
 
+void ClockdriftDetector::Reset() {
+  delay_history_.fill(0);
+  level_ = Level::kNone;
+  stability_counter_ = 0;
+}
+
 void ClockdriftDetector::Update(int delay_estimate) {
   if (delay_estimate == delay_history_[0]) {
     // Reset clockdrift level if delay estimate is stable for 7500 blocks (30
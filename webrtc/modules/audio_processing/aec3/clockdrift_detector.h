@@ -28,6 +28,8 @@ class ClockdriftDetector {
   ClockdriftDetector();
   ~ClockdriftDetector();
   void Update(int delay_estimate);
+  // Resets the detector to the state of a new one.
+  void Reset();
   Level ClockdriftLevel() const { return level_; }
 
  private:
@@ -32,6 +32,13 @@ void CoarseFilterUpdateGain::HandleEchoPathChange() {
   call_counter_ = 0;
 }
 
+void CoarseFilterUpdateGain::Reset(
+    const EchoCanceller3Config::Filter::CoarseConfiguration& config) {
+  SetConfig(config, true);
+  poor_signal_excitation_counter_ = 0;
+  call_counter_ = 0;
+}
+
 void CoarseFilterUpdateGain::Compute(
     const std::array<float, kFftLengthBy2Plus1>& render_power,
     const RenderSignalAnalyzer& render_signal_analyzer,
@@ -32,6 +32,9 @@ class CoarseFilterUpdateGain {
   // Takes action in the case of a known echo path change.
   void HandleEchoPathChange();
 
+  // Resets the gain to the state of a new one with the config `config`.
+  void Reset(const EchoCanceller3Config::Filter::CoarseConfiguration& config);
+
   // Computes the gain.
   void Compute(const std::array<float, kFftLengthBy2Plus1>& render_power,
                const RenderSignalAnalyzer& render_signal_analyzer,
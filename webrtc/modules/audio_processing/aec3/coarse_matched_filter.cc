@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/audio_processing/aec3/coarse_matched_filter.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Number of decimated samples per block.
+constexpr size_t kDecimatedBlockSize = 4;
+constexpr size_t kCoarseSubBlockSize = CoarseMatchedFilter::kSubBlockSize;
+constexpr size_t kBlocksPerUpdate = kCoarseSubBlockSize / kDecimatedBlockSize;
+
+// Window and shift of the filters, in sub-blocks, such that they cover the
+// same lags as the matched filters of EchoPathDelayEstimator.
+constexpr size_t kWindowSizeSubBlocks =
+    kMatchedFilterWindowSizeSubBlocks / kBlocksPerUpdate;
+constexpr size_t kAlignmentShiftSizeSubBlocks =
+    kMatchedFilterAlignmentShiftSizeSubBlocks / kBlocksPerUpdate;
+
+// The downsampled signals mostly hold the 1 kHz to 2 kHz band. Before the
+// decimation, a band is isolated that folds without overlap onto the band of
+// the decimated signal: [fs/4, 3fs/8] when decimating by 4, and [fs/4, fs/2]
+// when decimating by 2, where fs is the downsampled rate.
+// Two sections with zeros at DC and fs/2, and poles at radius 0.7 and angle
+// 2 * pi * 5/16, normalized to unit gain at the center of the band.
+const std::vector<CascadedBiQuadFilter::BiQuadParam> GetBandPassFilterBy4() {
+  return std::vector<CascadedBiQuadFilter::BiQuadParam>{
+      {{1.f, 0.f}, {-0.26787840f, 0.64671567f}, 0.25568034f, true},
+      {{1.f, 0.f}, {-0.26787840f, 0.64671567f}, 0.25568034f, true}};
+}
+
+// Same as above with poles at angle 2 * pi * 3/8.
+const std::vector<CascadedBiQuadFilter::BiQuadParam> GetBandPassFilterBy2() {
+  return std::vector<CascadedBiQuadFilter::BiQuadParam>{
+      {{1.f, 0.f}, {-0.49497475f, 0.49497475f}, 0.25894015f, true},
+      {{1.f, 0.f}, {-0.49497475f, 0.49497475f}, 0.25894015f, true}};
+}
+
+const std::vector<CascadedBiQuadFilter::BiQuadParam> GetBandPassFilter(
+    size_t decimation_factor) {
+  return decimation_factor == 4 ? GetBandPassFilterBy4()
+                                : GetBandPassFilterBy2();
+}
+
+float ExcitationLimit(const EchoCanceller3Config& config) {
+  return config.delay.down_sampling_factor == 8
+             ? config.render_levels.poor_excitation_render_limit_ds8
+             : config.render_levels.poor_excitation_render_limit;
+}
+
+}  // namespace
+
+std::atomic<int> CoarseMatchedFilter::instance_count_(0);
+
+CoarseMatchedFilter::CoarseMatchedFilter(const EchoCanceller3Config& config,
+                                         size_t sub_block_size)
+    : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
+      sub_block_size_(sub_block_size),
+      decimation_factor_(sub_block_size / kDecimatedBlockSize),
+      render_filter_(GetBandPassFilter(decimation_factor_)),
+      capture_filter_(GetBandPassFilter(decimation_factor_)),
+      render_(kCoarseSubBlockSize *
+              (kAlignmentShiftSizeSubBlocks * config.delay.num_filters +
+               kWindowSizeSubBlocks + 1)),
+      matched_filter_(data_dumper_.get(),
+                      DetectOptimization(),
+                      kCoarseSubBlockSize,
+                      kWindowSizeSubBlocks,
+                      config.delay.num_filters,
+                      kAlignmentShiftSizeSubBlocks,
+                      ExcitationLimit(config),
+                      config.delay.delay_estimate_smoothing,
+                      config.delay.delay_estimate_smoothing_delay_found,
+                      config.delay.delay_candidate_detection_threshold,
+                      /*detect_pre_echo=*/false) {
+  RTC_DCHECK(decimation_factor_ == 2 || decimation_factor_ == 4);
+}
+
+CoarseMatchedFilter::~CoarseMatchedFilter() = default;
+
+void CoarseMatchedFilter::Reset() {
+  render_filter_.Reset();
+  capture_filter_.Reset();
+  std::fill(render_.buffer.begin(), render_.buffer.end(), 0.f);
+  last_render_read_ = std::nullopt;
+  num_captured_ = 0;
+  lag_estimate_ = std::nullopt;
+  matched_filter_.Reset(/*full_reset=*/true);
+}
+
+void CoarseMatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
+                                 rtc::ArrayView<const float> capture) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  const int size = static_cast<int>(render_buffer.buffer.size());
+  const int read = render_buffer.read;
+
+  // The decimated render history is only continuous if the read index has
+  // moved by one sub-block since the last call.
+  if (last_render_read_ &&
+      *last_render_read_ != (read + static_cast<int>(sub_block_size_)) % size) {
+    Reset();
+  }
+  last_render_read_ = read;
+
+  // The newest sample of the downsampled render is at the lowest index.
+  std::array<float, kBlockSize> x;
+  rtc::ArrayView<float> x_view(x.data(), sub_block_size_);
+  for (size_t k = 0; k < sub_block_size_; ++k) {
+    x[k] = render_buffer.buffer[(read + sub_block_size_ - 1 - k) % size];
+  }
+  render_filter_.Process(x_view);
+  render_.UpdateWriteIndex(-static_cast<int>(kDecimatedBlockSize));
+  for (size_t k = 0; k < kDecimatedBlockSize; ++k) {
+    render_.buffer[render_.OffsetIndex(
+        render_.write, static_cast<int>(kDecimatedBlockSize - 1 - k))] =
+        x[k * decimation_factor_];
+  }
+
+  std::array<float, kBlockSize> y;
+  rtc::ArrayView<float> y_view(y.data(), sub_block_size_);
+  std::copy(capture.begin(), capture.end(), y.begin());
+  capture_filter_.Process(y_view);
+  for (size_t k = 0; k < kDecimatedBlockSize; ++k) {
+    capture_sub_block_[num_captured_ + k] = y[k * decimation_factor_];
+  }
+  num_captured_ += kDecimatedBlockSize;
+
+  // The filter is updated once per sub-block of decimated capture, which
+  // spreads its fixed cost over several blocks.
+  lag_estimate_ = std::nullopt;
+  if (num_captured_ < kCoarseSubBlockSize) {
+    return;
+  }
+  num_captured_ = 0;
+  render_.read = render_.write;
+  matched_filter_.Update(render_, capture_sub_block_,
+                         /*use_slow_smoothing=*/false);
+  const auto lag_estimate = matched_filter_.GetBestLagEstimate();
+  if (lag_estimate) {
+    lag_estimate_ = lag_estimate->lag * decimation_factor_;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_COARSE_MATCHED_FILTER_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_COARSE_MATCHED_FILTER_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+
+namespace webrtc {
+
+class ApmDataDumper;
+struct EchoCanceller3Config;
+
+// Cheap matched filter that covers the same lags as the matched filters of
+// EchoPathDelayEstimator at a lower resolution. The downsampled render and
+// capture are band-pass filtered and decimated further to 1 kHz, so that the
+// filters are four times shorter and see four times fewer samples than at the
+// 4 kHz of the default configuration. The filters are updated every fourth
+// block with the decimated samples of the four blocks.
+class CoarseMatchedFilter {
+ public:
+  // Number of decimated samples per update of the filter.
+  static constexpr size_t kSubBlockSize = 16;
+
+  CoarseMatchedFilter(const EchoCanceller3Config& config,
+                      size_t sub_block_size);
+  ~CoarseMatchedFilter();
+
+  CoarseMatchedFilter(const CoarseMatchedFilter&) = delete;
+  CoarseMatchedFilter& operator=(const CoarseMatchedFilter&) = delete;
+
+  // Resets the filter and the decimated render history.
+  void Reset();
+
+  // Adds the render sub-block at the read index of `render_buffer` and the
+  // `capture` sub-block, and updates the filter.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              rtc::ArrayView<const float> capture);
+
+  // Returns the lag estimate, in samples of the downsampled render buffer, if
+  // the filter was updated in the last call to Update().
+  std::optional<size_t> GetLagEstimate() const { return lag_estimate_; }
+
+ private:
+  static std::atomic<int> instance_count_;
+  const std::unique_ptr<ApmDataDumper> data_dumper_;
+  const size_t sub_block_size_;
+  const size_t decimation_factor_;
+  CascadedBiQuadFilter render_filter_;
+  CascadedBiQuadFilter capture_filter_;
+  DownsampledRenderBuffer render_;
+  std::optional<int> last_render_read_;
+  std::array<float, kSubBlockSize> capture_sub_block_;
+  size_t num_captured_ = 0;
+  std::optional<size_t> lag_estimate_;
+  MatchedFilter matched_filter_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_COARSE_MATCHED_FILTER_H_
@@ -106,20 +106,25 @@ ComfortNoiseGenerator::ComfortNoiseGenerator(const EchoCanceller3Config& config,
       seed_(42),
       num_capture_channels_(num_capture_channels),
       noise_floor_(GetNoiseFloorFactor(config.comfort_noise.noise_floor_dbfs)),
-      N2_initial_(
-          std::make_unique<std::vector<std::array<float, kFftLengthBy2Plus1>>>(
-              num_capture_channels_)),
+      N2_initial_(num_capture_channels_),
       Y2_smoothed_(num_capture_channels_),
       N2_(num_capture_channels_) {
+  Reset();
+}
+
+ComfortNoiseGenerator::~ComfortNoiseGenerator() = default;
+
+void ComfortNoiseGenerator::Reset() {
+  seed_ = 42;
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-    (*N2_initial_)[ch].fill(0.f);
+    N2_initial_[ch].fill(0.f);
     Y2_smoothed_[ch].fill(0.f);
     N2_[ch].fill(1.0e6f);
   }
+  N2_initial_active_ = true;
+  N2_counter_ = 0;
 }
 
-ComfortNoiseGenerator::~ComfortNoiseGenerator() = default;
-
 void ComfortNoiseGenerator::Compute(
     bool saturated_capture,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
@@ -147,14 +152,14 @@ void ComfortNoiseGenerator::Compute(
       }
     }
 
-    if (N2_initial_) {
+    if (N2_initial_active_) {
       if (++N2_counter_ == 1000) {
-        N2_initial_.reset();
+        N2_initial_active_ = false;
       } else {
         // Compute the N2_initial from N2.
         for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
           std::transform(N2_[ch].begin(), N2_[ch].end(),
-                         (*N2_initial_)[ch].begin(), (*N2_initial_)[ch].begin(),
+                         N2_initial_[ch].begin(), N2_initial_[ch].begin(),
                          [](float a, float b) {
                            return a > b ? b + 0.001f * (a - b) : a;
                          });
@@ -166,8 +171,8 @@ void ComfortNoiseGenerator::Compute(
       for (auto& n : N2_[ch]) {
         n = std::max(n, noise_floor_);
       }
-      if (N2_initial_) {
-        for (auto& n : (*N2_initial_)[ch]) {
+      if (N2_initial_active_) {
+        for (auto& n : N2_initial_[ch]) {
           n = std::max(n, noise_floor_);
         }
       }
@@ -175,7 +180,7 @@ void ComfortNoiseGenerator::Compute(
   }
 
   // Choose N2 estimate to use.
-  const auto& N2 = N2_initial_ ? (*N2_initial_) : N2_;
+  const auto& N2 = N2_initial_active_ ? N2_initial_ : N2_;
 
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     GenerateComfortNoise(optimization_, N2[ch], &seed_, &lower_band_noise[ch],
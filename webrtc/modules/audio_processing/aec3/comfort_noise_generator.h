@@ -54,6 +54,9 @@ class ComfortNoiseGenerator {
                rtc::ArrayView<FftData> lower_band_noise,
                rtc::ArrayView<FftData> upper_band_noise);
 
+  // Resets the generator to the state of a new one.
+  void Reset();
+
   // Returns the estimate of the background noise spectrum.
   rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> NoiseSpectrum()
       const {
@@ -65,8 +68,10 @@ class ComfortNoiseGenerator {
   uint32_t seed_;
   const size_t num_capture_channels_;
   const float noise_floor_;
-  std::unique_ptr<std::vector<std::array<float, kFftLengthBy2Plus1>>>
-      N2_initial_;
+  // Noise estimate used during the first blocks. It is kept allocated after
+  // that, so that Reset() does not allocate.
+  std::vector<std::array<float, kFftLengthBy2Plus1>> N2_initial_;
+  bool N2_initial_active_ = true;
   std::vector<std::array<float, kFftLengthBy2Plus1>> Y2_smoothed_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> N2_;
   int N2_counter_ = 0;
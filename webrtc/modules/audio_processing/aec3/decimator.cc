@@ -69,6 +69,11 @@ Decimator::Decimator(size_t down_sampling_factor)
              down_sampling_factor_ == 8);
 }
 
+void Decimator::Reset() {
+  anti_aliasing_filter_.Reset();
+  noise_reduction_filter_.Reset();
+}
+
 void Decimator::Decimate(rtc::ArrayView<const float> in,
                          rtc::ArrayView<float> out) {
   RTC_DCHECK_EQ(kBlockSize, in.size());
@@ -31,6 +31,9 @@ class Decimator {
   // Downsamples the signal.
   void Decimate(rtc::ArrayView<const float> in, rtc::ArrayView<float> out);
 
+  // Resets the filter states.
+  void Reset();
+
  private:
   const size_t down_sampling_factor_;
   CascadedBiQuadFilter anti_aliasing_filter_;
@@ -10,6 +10,7 @@
 
 #include "modules/audio_processing/aec3/dominant_nearend_detector.h"
 
+#include <algorithm>
 #include <numeric>
 
 namespace webrtc {
@@ -26,6 +27,12 @@ DominantNearendDetector::DominantNearendDetector(
       trigger_counters_(num_capture_channels_),
       hold_counters_(num_capture_channels_) {}
 
+void DominantNearendDetector::Reset() {
+  nearend_state_ = false;
+  std::fill(trigger_counters_.begin(), trigger_counters_.end(), 0);
+  std::fill(hold_counters_.begin(), hold_counters_.end(), 0);
+}
+
 void DominantNearendDetector::Update(
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
         nearend_spectrum,
@@ -37,6 +37,8 @@ class DominantNearendDetector : public NearendDetector {
                   comfort_noise_spectrum,
               bool initial_state) override;
 
+  void Reset() override;
+
  private:
   const float enr_threshold_;
   const float enr_exit_threshold_;
@@ -55,10 +55,10 @@ class EchoAudibility {
     return render_stationarity_.IsBlockStationary();
   }
 
- private:
   // Reset the EchoAudibility class.
   void Reset();
 
+ private:
   // Updates the render stationarity flags for the current frame.
   void UpdateRenderStationarityFlags(const RenderBuffer& render_buffer,
                                      rtc::ArrayView<const float> average_reverb,
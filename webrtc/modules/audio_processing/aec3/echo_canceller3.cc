@@ -658,6 +658,7 @@ class EchoCanceller3::RenderWriter {
 
   ~RenderWriter();
   void Insert(const AudioBuffer& input);
+  void Reset();
 
  private:
   ApmDataDumper* data_dumper_;
@@ -714,6 +715,12 @@ void EchoCanceller3::RenderWriter::Insert(const AudioBuffer& input) {
   static_cast<void>(render_transfer_queue_->Insert(&render_queue_input_frame_));
 }
 
+void EchoCanceller3::RenderWriter::Reset() {
+  if (high_pass_filter_) {
+    high_pass_filter_->Reset();
+  }
+}
+
 std::atomic<int> EchoCanceller3::instance_count_(0);
 
 EchoCanceller3::EchoCanceller3(
@@ -770,6 +777,13 @@ EchoCanceller3::EchoCanceller3(
         config_.delay.fixed_capture_delay_samples));
   }
 
+  const size_t num_channel_worker_threads =
+      config_.multi_channel.capture_channel_worker_threads;
+  if (num_channel_worker_threads > 0 && num_capture_channels_ > 1) {
+    channel_worker_pool_ = std::make_unique<ChannelWorkerPool>(
+        std::min(num_channel_worker_threads, num_capture_channels_ - 1));
+  }
+
   render_writer_.reset(new RenderWriter(
       data_dumper_.get(), config_selector_.active_config(),
       &render_transfer_queue_, num_bands_, num_render_input_channels_));
@@ -799,13 +813,11 @@ EchoCanceller3::~EchoCanceller3() = default;
 void EchoCanceller3::Initialize() {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
 
-  num_render_channels_to_aec_ =
-      multichannel_content_detector_.IsProperMultiChannelContentDetected()
-          ? num_render_input_channels_
-          : 1;
+  num_render_channels_to_aec_ = IsProperMultiChannelContentDetected()
+                                    ? num_render_input_channels_
+                                    : 1;
 
-  config_selector_.Update(
-      multichannel_content_detector_.IsProperMultiChannelContentDetected());
+  config_selector_.Update(IsProperMultiChannelContentDetected());
 
   render_block_.SetNumChannels(num_render_channels_to_aec_);
 
@@ -814,7 +826,8 @@ void EchoCanceller3::Initialize() {
 
   block_processor_.reset(BlockProcessor::Create(
       config_selector_.active_config(), sample_rate_hz_,
-      num_render_channels_to_aec_, num_capture_channels_));
+      num_render_channels_to_aec_, num_capture_channels_,
+      channel_worker_pool_.get()));
 
   render_sub_frame_view_ = std::vector<std::vector<rtc::ArrayView<float>>>(
       num_bands_,
@@ -886,23 +899,22 @@ void EchoCanceller3::ProcessCapture(AudioBuffer* capture,
 
   ProcessCaptureFrameContent(
       linear_output, capture, level_change,
-      multichannel_content_detector_.IsTemporaryMultiChannelContentDetected(),
-      saturated_microphone_signal_, 0, &capture_blocker_,
-      linear_output_framer_.get(), &output_framer_, block_processor_.get(),
-      linear_output_block_.get(), &linear_output_sub_frame_view_,
-      &capture_block_, &capture_sub_frame_view_);
+      IsTemporaryMultiChannelContentDetected(), saturated_microphone_signal_,
+      0, &capture_blocker_, linear_output_framer_.get(), &output_framer_,
+      block_processor_.get(), linear_output_block_.get(),
+      &linear_output_sub_frame_view_, &capture_block_,
+      &capture_sub_frame_view_);
 
   ProcessCaptureFrameContent(
       linear_output, capture, level_change,
-      multichannel_content_detector_.IsTemporaryMultiChannelContentDetected(),
-      saturated_microphone_signal_, 1, &capture_blocker_,
-      linear_output_framer_.get(), &output_framer_, block_processor_.get(),
-      linear_output_block_.get(), &linear_output_sub_frame_view_,
-      &capture_block_, &capture_sub_frame_view_);
+      IsTemporaryMultiChannelContentDetected(), saturated_microphone_signal_,
+      1, &capture_blocker_, linear_output_framer_.get(), &output_framer_,
+      block_processor_.get(), linear_output_block_.get(),
+      &linear_output_sub_frame_view_, &capture_block_,
+      &capture_sub_frame_view_);
 
   ProcessRemainingCaptureFrameContent(
-      level_change,
-      multichannel_content_detector_.IsTemporaryMultiChannelContentDetected(),
+      level_change, IsTemporaryMultiChannelContentDetected(),
       saturated_microphone_signal_, &capture_blocker_,
       linear_output_framer_.get(), &output_framer_, block_processor_.get(),
       linear_output_block_.get(), &capture_block_);
@@ -928,6 +940,50 @@ void EchoCanceller3::SetCaptureOutputUsage(bool capture_output_used) {
   block_processor_->SetCaptureOutputUsage(capture_output_used);
 }
 
+void EchoCanceller3::SaveState(StateWriter* writer) const {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  writer->WriteInt(sample_rate_hz_);
+  writer->WriteSize(num_render_channels_to_aec_);
+  writer->WriteSize(num_capture_channels_);
+  block_processor_->SaveState(writer);
+}
+
+bool EchoCanceller3::RestoreState(StateReader* reader) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  int sample_rate_hz;
+  return reader->ReadInt(&sample_rate_hz) &&
+         sample_rate_hz == sample_rate_hz_ &&
+         reader->ReadExpectedSize(num_render_channels_to_aec_) &&
+         reader->ReadExpectedSize(num_capture_channels_) &&
+         block_processor_->RestoreState(reader);
+}
+
+void EchoCanceller3::Reset() {
+  {
+    RTC_DCHECK_RUNS_SERIALIZED(&render_race_checker_);
+    render_writer_->Reset();
+  }
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  render_transfer_queue_.Clear();
+  if (multichannel_content_detector_.Reset() && !shared_render_analyzer_) {
+    // Initialize() creates a new render blocker and block processor for the
+    // restarted multichannel content detection.
+    Initialize();
+  } else {
+    render_blocker_->Reset();
+    block_processor_->Reset();
+  }
+  capture_blocker_.Reset();
+  output_framer_.Reset();
+  if (linear_output_framer_) {
+    linear_output_framer_->Reset();
+  }
+  if (block_delay_buffer_) {
+    block_delay_buffer_->Reset();
+  }
+  saturated_microphone_signal_ = false;
+}
+
 bool EchoCanceller3::ActiveProcessing() const {
   return true;
 }
@@ -954,8 +1010,61 @@ void EchoCanceller3::SetBlockProcessorForTesting(
   block_processor_ = std::move(block_processor);
 }
 
+void EchoCanceller3::SetSharedRenderAnalyzer(
+    rtc::scoped_refptr<SharedRenderAnalyzer> analyzer) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  RTC_DCHECK(analyzer);
+  shared_render_analyzer_ = std::move(analyzer);
+  next_shared_render_frame_ = shared_render_analyzer_->NextFrameIndex();
+  shared_proper_multichannel_content_ =
+      shared_render_analyzer_->IsProperMultiChannelContentDetected();
+  shared_temporary_multichannel_content_ = false;
+  render_transfer_queue_.Clear();
+  Initialize();
+}
+
+bool EchoCanceller3::IsProperMultiChannelContentDetected() const {
+  return shared_render_analyzer_
+             ? shared_proper_multichannel_content_
+             : multichannel_content_detector_
+                   .IsProperMultiChannelContentDetected();
+}
+
+bool EchoCanceller3::IsTemporaryMultiChannelContentDetected() const {
+  return shared_render_analyzer_
+             ? shared_temporary_multichannel_content_
+             : multichannel_content_detector_
+                   .IsTemporaryMultiChannelContentDetected();
+}
+
+void EchoCanceller3::ReadSharedRender() {
+  while (rtc::scoped_refptr<const SharedRenderAnalyzer::Frame> frame =
+             shared_render_analyzer_->ReadFrame(&next_shared_render_frame_)) {
+    // Report render call in the metrics.
+    api_call_metrics_.ReportRenderCall();
+
+    shared_temporary_multichannel_content_ =
+        frame->temporary_multichannel_content;
+    if (frame->proper_multichannel_content !=
+        shared_proper_multichannel_content_) {
+      // Reinitialize the AEC when proper stereo is detected, on the same frame
+      // as the analyzer.
+      shared_proper_multichannel_content_ = frame->proper_multichannel_content;
+      Initialize();
+    }
+
+    for (int k = 0; k < frame->num_blocks; ++k) {
+      block_processor_->BufferAnalyzedRender(frame->blocks[k]);
+    }
+  }
+}
+
 void EchoCanceller3::EmptyRenderQueue() {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  if (shared_render_analyzer_) {
+    ReadSharedRender();
+    return;
+  }
   bool frame_to_buffer =
       render_transfer_queue_.Remove(&render_queue_output_frame_);
   while (frame_to_buffer) {
@@ -21,15 +21,19 @@
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "api/audio/echo_control.h"
+#include "api/scoped_refptr.h"
 #include "modules/audio_processing/aec3/api_call_jitter_metrics.h"
 #include "modules/audio_processing/aec3/block_delay_buffer.h"
 #include "modules/audio_processing/aec3/block_framer.h"
 #include "modules/audio_processing/aec3/block_processor.h"
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
 #include "modules/audio_processing/aec3/config_selector.h"
 #include "modules/audio_processing/aec3/frame_blocker.h"
 #include "modules/audio_processing/aec3/multi_channel_content_detector.h"
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/swap_queue.h"
@@ -138,6 +142,28 @@ class EchoCanceller3 : public EchoControl {
   // Produces a default configuration for multichannel.
   static EchoCanceller3Config CreateDefaultMultichannelConfig();
 
+  // Makes the echo canceller read its render signal, starting from the next
+  // analyzed frame, from `analyzer` instead of analyzing it itself.
+  // AnalyzeRender() must not be called afterwards. The analyzer must be
+  // compatible with the config of the echo canceller.
+  void SetSharedRenderAnalyzer(
+      rtc::scoped_refptr<SharedRenderAnalyzer> analyzer);
+
+  // Saves the converged state of the echo canceller, and restores a state
+  // saved by an echo canceller with the same sample rate and number of
+  // channels. A state saved while proper multichannel render content was
+  // detected can only be restored after the same detection. Returns false if
+  // the state does not match, in which case the echo canceller may be left
+  // partially restored.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
+  // Resets the echo canceller to the state of a new one: the buffered render
+  // and capture audio, the render queue, the multichannel content detection,
+  // the delay estimation and the echo remover. The metrics are kept. Must be
+  // called with neither the render nor the capture side running.
+  void Reset();
+
  private:
   friend class EchoCanceller3Tester;
   FRIEND_TEST_ALL_PREFIXES(EchoCanceller3, DetectionOfProperStereo);
@@ -168,8 +194,15 @@ class EchoCanceller3 : public EchoControl {
     return config_selector_.active_config();
   }
 
-  // Empties the render SwapQueue.
+  // Empties the render SwapQueue, or reads the published frames of the shared
+  // render analyzer.
   void EmptyRenderQueue();
+  void ReadSharedRender();
+
+  // Multichannel content state of the render signal, as detected by the
+  // shared render analyzer if any.
+  bool IsProperMultiChannelContentDetected() const;
+  bool IsTemporaryMultiChannelContentDetected() const;
 
   // Analyzes and stores an internal copy of the split-band domain render
   // signal.
@@ -204,6 +237,8 @@ class EchoCanceller3 : public EchoControl {
   SwapQueue<std::vector<std::vector<std::vector<float>>>,
             Aec3RenderQueueItemVerifier>
       render_transfer_queue_;
+  // Declared before `block_processor_`, which refers to it.
+  std::unique_ptr<ChannelWorkerPool> channel_worker_pool_;
   std::unique_ptr<BlockProcessor> block_processor_
       RTC_GUARDED_BY(capture_race_checker_);
   std::vector<std::vector<std::vector<float>>> render_queue_output_frame_
@@ -223,6 +258,13 @@ class EchoCanceller3 : public EchoControl {
   std::unique_ptr<BlockDelayBuffer> block_delay_buffer_
       RTC_GUARDED_BY(capture_race_checker_);
   ApiCallJitterMetrics api_call_metrics_ RTC_GUARDED_BY(capture_race_checker_);
+  rtc::scoped_refptr<SharedRenderAnalyzer> shared_render_analyzer_
+      RTC_GUARDED_BY(capture_race_checker_);
+  int64_t next_shared_render_frame_ RTC_GUARDED_BY(capture_race_checker_) = 0;
+  bool shared_proper_multichannel_content_
+      RTC_GUARDED_BY(capture_race_checker_) = false;
+  bool shared_temporary_multichannel_content_
+      RTC_GUARDED_BY(capture_race_checker_) = false;
 };
 }  // namespace webrtc
 
@@ -13,11 +13,49 @@
 
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+// Half width, in sub-blocks, of the lag range searched by the matched filters
+// once a delay has been found in the hierarchical search.
+constexpr size_t kFineSearchMarginSubBlocks =
+    kMatchedFilterWindowSizeSubBlocks / 4;
+
+// Number of consecutive coarse lag estimates outside of the fine search range
+// that resume the full search.
+constexpr int kNumCoarseMismatchesForFullSearch = 4;
+
+float ExcitationLimit(const EchoCanceller3Config& config) {
+  return config.delay.down_sampling_factor == 8
+             ? config.render_levels.poor_excitation_render_limit_ds8
+             : config.render_levels.poor_excitation_render_limit;
+}
+
+// The FFT matched filter reads the same span of the render buffer as the
+// time-domain matched filters.
+std::unique_ptr<FftMatchedFilter> CreateFftMatchedFilter(
+    ApmDataDumper* data_dumper,
+    const EchoCanceller3Config& config,
+    size_t sub_block_size) {
+  if (!config.delay.use_fft_matched_filter) {
+    return nullptr;
+  }
+  RTC_DCHECK_LT(0, config.delay.num_filters);
+  const size_t span_sub_blocks =
+      kMatchedFilterAlignmentShiftSizeSubBlocks *
+          (config.delay.num_filters - 1) +
+      kMatchedFilterWindowSizeSubBlocks;
+  return std::make_unique<FftMatchedFilter>(
+      data_dumper, Aec3Fft::SelectBackend(config), sub_block_size,
+      span_sub_blocks, ExcitationLimit(config));
+}
+
+}  // namespace
 
 EchoPathDelayEstimator::EchoPathDelayEstimator(
     ApmDataDumper* data_dumper,
@@ -38,16 +76,25 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
           kMatchedFilterWindowSizeSubBlocks,
           config.delay.num_filters,
           kMatchedFilterAlignmentShiftSizeSubBlocks,
-          config.delay.down_sampling_factor == 8
-              ? config.render_levels.poor_excitation_render_limit_ds8
-              : config.render_levels.poor_excitation_render_limit,
+          ExcitationLimit(config),
           config.delay.delay_estimate_smoothing,
           config.delay.delay_estimate_smoothing_delay_found,
           config.delay.delay_candidate_detection_threshold,
           config.delay.detect_pre_echo),
-      matched_filter_lag_aggregator_(data_dumper_,
-                                     matched_filter_.GetMaxFilterLag(),
-                                     config.delay) {
+      fft_matched_filter_(
+          CreateFftMatchedFilter(data_dumper_, config, sub_block_size_)),
+      matched_filter_lag_aggregator_(
+          data_dumper_,
+          fft_matched_filter_ ? fft_matched_filter_->GetMaxFilterLag()
+                              : matched_filter_.GetMaxFilterLag(),
+          config.delay),
+      delay_headroom_(config.delay.delay_headroom_samples /
+                      down_sampling_factor_),
+      coarse_matched_filter_(config.delay.hierarchical_search &&
+                                     !fft_matched_filter_
+                                 ? std::make_unique<CoarseMatchedFilter>(
+                                       config, sub_block_size_)
+                                 : nullptr) {
   RTC_DCHECK(data_dumper);
   RTC_DCHECK(down_sampling_factor_ > 0);
 }
@@ -58,6 +105,17 @@ void EchoPathDelayEstimator::Reset(bool reset_delay_confidence) {
   Reset(true, reset_delay_confidence);
 }
 
+void EchoPathDelayEstimator::ResetForReuse() {
+  Reset(/*reset_lag_aggregator=*/true, /*reset_delay_confidence=*/true);
+  capture_mixer_.Reset();
+  capture_decimator_.Reset();
+  matched_filter_.ResetForReuse();
+  matched_filter_lag_aggregator_.ResetForReuse();
+  clockdrift_detector_.Reset();
+  fine_search_lag_ = std::nullopt;
+  coarse_mismatch_counter_ = 0;
+}
+
 std::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
     const DownsampledRenderBuffer& render_buffer,
     const Block& capture) {
@@ -71,12 +129,23 @@ std::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   data_dumper_->DumpWav("aec3_capture_decimator_output",
                         downsampled_capture.size(), downsampled_capture.data(),
                         16000 / down_sampling_factor_, 1);
-  matched_filter_.Update(render_buffer, downsampled_capture,
-                         matched_filter_lag_aggregator_.ReliableDelayFound());
+  std::optional<MatchedFilter::LagEstimate> lag_estimate;
+  if (fft_matched_filter_) {
+    fft_matched_filter_->Update(
+        render_buffer, downsampled_capture,
+        matched_filter_lag_aggregator_.ReliableDelayFound());
+    lag_estimate = fft_matched_filter_->GetBestLagEstimate();
+  } else {
+    matched_filter_.Update(render_buffer, downsampled_capture,
+                           matched_filter_lag_aggregator_.ReliableDelayFound());
+    lag_estimate = matched_filter_.GetBestLagEstimate();
+    if (coarse_matched_filter_) {
+      UpdateCoarseSearch(render_buffer, downsampled_capture);
+    }
+  }
 
   std::optional<DelayEstimate> aggregated_matched_filter_lag =
-      matched_filter_lag_aggregator_.Aggregate(
-          matched_filter_.GetBestLagEstimate());
+      matched_filter_lag_aggregator_.Aggregate(lag_estimate);
 
   // Run clockdrift detection.
   if (aggregated_matched_filter_lag &&
@@ -110,6 +179,13 @@ std::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   constexpr size_t kNumBlocksPerSecondBy2 = kNumBlocksPerSecond / 2;
   if (consistent_estimate_counter_ > kNumBlocksPerSecondBy2) {
     Reset(false, false);
+    if (coarse_matched_filter_ && aggregated_matched_filter_lag &&
+        aggregated_matched_filter_lag->quality ==
+            DelayEstimate::Quality::kRefined &&
+        clockdrift_detector_.ClockdriftLevel() ==
+            ClockdriftDetector::Level::kNone) {
+      StartFineSearch();
+    }
   }
 
   return aggregated_matched_filter_lag;
@@ -121,7 +197,71 @@ void EchoPathDelayEstimator::Reset(bool reset_lag_aggregator,
     matched_filter_lag_aggregator_.Reset(reset_delay_confidence);
   }
   matched_filter_.Reset(/*full_reset=*/reset_lag_aggregator);
+  if (fft_matched_filter_) {
+    fft_matched_filter_->Reset(/*full_reset=*/reset_lag_aggregator);
+  }
   old_aggregated_lag_ = std::nullopt;
   consistent_estimate_counter_ = 0;
+  if (coarse_matched_filter_ && reset_lag_aggregator) {
+    coarse_matched_filter_->Reset();
+    ResumeFullSearch();
+  }
+}
+
+void EchoPathDelayEstimator::ResumeFullSearch() {
+  if (!fine_search_lag_) {
+    return;
+  }
+  fine_search_lag_ = std::nullopt;
+  coarse_mismatch_counter_ = 0;
+  matched_filter_.ClearLagRange();
+  // The filters outside of the fine search range have not followed the
+  // render and are restarted.
+  matched_filter_.Reset(/*full_reset=*/false);
+}
+
+void EchoPathDelayEstimator::StartFineSearch() {
+  const size_t margin = kFineSearchMarginSubBlocks * sub_block_size_;
+  const size_t lag =
+      matched_filter_lag_aggregator_.GetDelayAtHighestPeak() + delay_headroom_;
+  fine_search_lag_ = lag;
+  coarse_mismatch_counter_ = 0;
+  matched_filter_.SetLagRange(lag > margin ? lag - margin : 0, lag + margin);
+}
+
+void EchoPathDelayEstimator::UpdateCoarseSearch(
+    const DownsampledRenderBuffer& render_buffer,
+    rtc::ArrayView<const float> capture) {
+  coarse_matched_filter_->Update(render_buffer, capture);
+  const std::optional<size_t> coarse_lag =
+      coarse_matched_filter_->GetLagEstimate();
+  if (!fine_search_lag_) {
+    return;
+  }
+  // The fine search range does not follow a drifting delay.
+  if (clockdrift_detector_.ClockdriftLevel() !=
+      ClockdriftDetector::Level::kNone) {
+    ResumeFullSearch();
+    return;
+  }
+  if (!coarse_lag) {
+    return;
+  }
+  const size_t margin = kFineSearchMarginSubBlocks * sub_block_size_;
+  const size_t distance = *coarse_lag > *fine_search_lag_
+                              ? *coarse_lag - *fine_search_lag_
+                              : *fine_search_lag_ - *coarse_lag;
+  coarse_mismatch_counter_ =
+      distance > margin ? coarse_mismatch_counter_ + 1 : 0;
+  data_dumper_->DumpRaw("aec3_echo_path_delay_estimator_coarse_lag",
+                        static_cast<int>(*coarse_lag));
+  if (coarse_mismatch_counter_ >= kNumCoarseMismatchesForFullSearch) {
+    // The delay has moved. The lags aggregated at the old delay would delay
+    // the report of the new one and are dropped.
+    ResumeFullSearch();
+    matched_filter_lag_aggregator_.Reset(/*hard_reset=*/false);
+    old_aggregated_lag_ = std::nullopt;
+    consistent_estimate_counter_ = 0;
+  }
 }
 }  // namespace webrtc
@@ -13,14 +13,17 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <optional>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/alignment_mixer.h"
 #include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/clockdrift_detector.h"
+#include "modules/audio_processing/aec3/coarse_matched_filter.h"
 #include "modules/audio_processing/aec3/decimator.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
+#include "modules/audio_processing/aec3/fft_matched_filter.h"
 #include "modules/audio_processing/aec3/matched_filter.h"
 #include "modules/audio_processing/aec3/matched_filter_lag_aggregator.h"
 
@@ -45,13 +48,25 @@ class EchoPathDelayEstimator {
   // is as if the call is restarted.
   void Reset(bool reset_delay_confidence);
 
+  // Resets the estimator to the state of a new one.
+  void ResetForReuse();
+
   // Produce a delay estimate if such is avaliable.
   std::optional<DelayEstimate> EstimateDelay(
       const DownsampledRenderBuffer& render_buffer,
       const Block& capture);
 
+  // Updates all the matched filters again when the search is restricted to the
+  // lags around the found delay.
+  void ResumeFullSearch();
+
   // Log delay estimator properties.
   void LogDelayEstimationProperties(int sample_rate_hz, size_t shift) const {
+    if (fft_matched_filter_) {
+      fft_matched_filter_->LogFilterProperties(sample_rate_hz, shift,
+                                               down_sampling_factor_);
+      return;
+    }
     matched_filter_.LogFilterProperties(sample_rate_hz, shift,
                                         down_sampling_factor_);
   }
@@ -68,10 +83,27 @@ class EchoPathDelayEstimator {
   AlignmentMixer capture_mixer_;
   Decimator capture_decimator_;
   MatchedFilter matched_filter_;
+  // Used instead of `matched_filter_` when the config asks for it.
+  const std::unique_ptr<FftMatchedFilter> fft_matched_filter_;
   MatchedFilterLagAggregator matched_filter_lag_aggregator_;
   std::optional<DelayEstimate> old_aggregated_lag_;
   size_t consistent_estimate_counter_ = 0;
   ClockdriftDetector clockdrift_detector_;
+  // Hierarchical search: once a delay has been found, `matched_filter_` only
+  // updates the filters around `fine_search_lag_` while
+  // `coarse_matched_filter_` covers the full range.
+  const size_t delay_headroom_;
+  const std::unique_ptr<CoarseMatchedFilter> coarse_matched_filter_;
+  std::optional<size_t> fine_search_lag_;
+  int coarse_mismatch_counter_ = 0;
+
+  // Restricts the search to the lags around the delay at the highest peak of
+  // the lag aggregator.
+  void StartFineSearch();
+  // Tracks the coarse lag estimate and resumes the full search when it leaves
+  // the restricted range.
+  void UpdateCoarseSearch(const DownsampledRenderBuffer& render_buffer,
+                          rtc::ArrayView<const float> capture);
 
   // Internal reset method with more granularity.
   void Reset(bool reset_lag_aggregator, bool reset_delay_confidence);
@@ -108,7 +108,8 @@ class EchoRemoverImpl final : public EchoRemover {
   EchoRemoverImpl(const EchoCanceller3Config& config,
                   int sample_rate_hz,
                   size_t num_render_channels,
-                  size_t num_capture_channels);
+                  size_t num_capture_channels,
+                  ChannelWorkerPool* channel_worker_pool);
   ~EchoRemoverImpl() override;
   EchoRemoverImpl(const EchoRemoverImpl&) = delete;
   EchoRemoverImpl& operator=(const EchoRemoverImpl&) = delete;
@@ -135,6 +136,11 @@ class EchoRemoverImpl final : public EchoRemover {
     capture_output_used_ = capture_output_used;
   }
 
+  void SaveState(StateWriter* writer) const override;
+  bool RestoreState(StateReader* reader) override;
+
+  void Reset() override;
+
  private:
   // Selects which of the coarse and refined linear filter outputs that is most
   // appropriate to pass to the suppressor and forms the linear filter output by
@@ -151,6 +157,7 @@ class EchoRemoverImpl final : public EchoRemover {
   const size_t num_render_channels_;
   const size_t num_capture_channels_;
   const bool use_coarse_filter_output_;
+  ChannelWorkerPool* const channel_worker_pool_;
   Subtractor subtractor_;
   SuppressionGain suppression_gain_;
   ComfortNoiseGenerator cng_;
@@ -185,9 +192,10 @@ std::atomic<int> EchoRemoverImpl::instance_count_(0);
 EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
                                  int sample_rate_hz,
                                  size_t num_render_channels,
-                                 size_t num_capture_channels)
+                                 size_t num_capture_channels,
+                                 ChannelWorkerPool* channel_worker_pool)
     : config_(config),
-      fft_(),
+      fft_(Aec3Fft::SelectBackend(config)),
       data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       optimization_(DetectOptimization()),
       sample_rate_hz_(sample_rate_hz),
@@ -195,11 +203,13 @@ EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
       num_capture_channels_(num_capture_channels),
       use_coarse_filter_output_(
           config_.filter.enable_coarse_filter_output_usage),
+      channel_worker_pool_(channel_worker_pool),
       subtractor_(config,
                   num_render_channels_,
                   num_capture_channels_,
                   data_dumper_.get(),
-                  optimization_),
+                  optimization_,
+                  channel_worker_pool_),
       suppression_gain_(config_,
                         optimization_,
                         sample_rate_hz,
@@ -207,7 +217,8 @@ EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
       cng_(config_, optimization_, num_capture_channels_),
       suppression_filter_(optimization_,
                           sample_rate_hz_,
-                          num_capture_channels_),
+                          num_capture_channels_,
+                          fft_.backend()),
       render_signal_analyzer_(config_),
       residual_echo_estimator_(config_, num_render_channels),
       aec_state_(config_, num_capture_channels_),
@@ -236,6 +247,41 @@ void EchoRemoverImpl::GetMetrics(EchoControl::Metrics* metrics) const {
       Log2TodB(aec_state_.FullBandErleLog2());
 }
 
+void EchoRemoverImpl::SaveState(StateWriter* writer) const {
+  aec_state_.SaveState(writer);
+  subtractor_.SaveState(writer);
+}
+
+bool EchoRemoverImpl::RestoreState(StateReader* reader) {
+  if (!aec_state_.RestoreState(reader) ||
+      !subtractor_.RestoreState(reader, aec_state_.InitialStateActive())) {
+    return false;
+  }
+  suppression_gain_.SetInitialState(aec_state_.InitialStateActive());
+  return true;
+}
+
+void EchoRemoverImpl::Reset() {
+  subtractor_.Reset();
+  suppression_gain_.Reset();
+  cng_.Reset();
+  suppression_filter_.Reset();
+  render_signal_analyzer_.Reset();
+  residual_echo_estimator_.Reset();
+  echo_leakage_detected_ = false;
+  capture_output_used_ = true;
+  aec_state_.Reset();
+  for (auto& e_old_ch : e_old_) {
+    e_old_ch.fill(0.f);
+  }
+  for (auto& y_old_ch : y_old_) {
+    y_old_ch.fill(0.f);
+  }
+  block_counter_ = 0;
+  gain_change_hangover_ = 0;
+  refined_filter_output_last_selected_ = true;
+}
+
 void EchoRemoverImpl::ProcessCapture(
     EchoPathVariability echo_path_variability,
     bool capture_signal_saturation,
@@ -369,14 +415,24 @@ void EchoRemoverImpl::ProcessCapture(
   subtractor_.Process(*render_buffer, *y, render_signal_analyzer_, aec_state_,
                       subtractor_output);
 
-  // Compute spectra.
+  // Compute spectra. The linear filter output selection carries state across
+  // channels and is therefore formed before the per-channel transforms.
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     FormLinearFilterOutput(subtractor_output[ch], e[ch]);
+  }
+  auto compute_spectra = [&](size_t ch) {
     WindowedPaddedFft(fft_, y->View(/*band=*/0, ch), y_old_[ch], &Y[ch]);
     WindowedPaddedFft(fft_, e[ch], e_old_[ch], &E[ch]);
     LinearEchoPower(E[ch], Y[ch], &S2_linear[ch]);
     Y[ch].Spectrum(optimization_, Y2[ch]);
     E[ch].Spectrum(optimization_, E2[ch]);
+  };
+  if (channel_worker_pool_) {
+    channel_worker_pool_->ParallelFor(num_capture_channels_, compute_spectra);
+  } else {
+    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+      compute_spectra(ch);
+    }
   }
 
   // Optionally return the linear filter output.
@@ -389,7 +445,11 @@ void EchoRemoverImpl::ProcessCapture(
     }
   }
 
-  // Update the AEC state information.
+  // Update the AEC state information. The per-channel ERLE estimation here,
+  // like the suppression gain below, is not run on the channel worker pool:
+  // each costs around 1.5 us per channel and block at 48 kHz, which is less
+  // than waking up the pool, while the linear filtering costs about five times
+  // more.
   aec_state_.Update(external_delay, subtractor_.FilterFrequencyResponses(),
                     subtractor_.FilterImpulseResponses(), *render_buffer, E2,
                     Y2, subtractor_output);
@@ -514,8 +574,17 @@ EchoRemover* EchoRemover::Create(const EchoCanceller3Config& config,
                                  int sample_rate_hz,
                                  size_t num_render_channels,
                                  size_t num_capture_channels) {
+  return Create(config, sample_rate_hz, num_render_channels,
+                num_capture_channels, /*channel_worker_pool=*/nullptr);
+}
+
+EchoRemover* EchoRemover::Create(const EchoCanceller3Config& config,
+                                 int sample_rate_hz,
+                                 size_t num_render_channels,
+                                 size_t num_capture_channels,
+                                 ChannelWorkerPool* channel_worker_pool) {
   return new EchoRemoverImpl(config, sample_rate_hz, num_render_channels,
-                             num_capture_channels);
+                             num_capture_channels, channel_worker_pool);
 }
 
 }  // namespace webrtc
@@ -17,9 +17,11 @@
 #include "api/audio/echo_canceller3_config.h"
 #include "api/audio/echo_control.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -30,6 +32,14 @@ class EchoRemover {
                              int sample_rate_hz,
                              size_t num_render_channels,
                              size_t num_capture_channels);
+  // Runs the per-channel linear filtering and capture spectra in parallel on
+  // `channel_worker_pool` if it is non-null. The ERLE estimation and the
+  // suppression gain stay serial. The pool must outlive the returned object.
+  static EchoRemover* Create(const EchoCanceller3Config& config,
+                             int sample_rate_hz,
+                             size_t num_render_channels,
+                             size_t num_capture_channels,
+                             ChannelWorkerPool* channel_worker_pool);
   virtual ~EchoRemover() = default;
 
   // Get current metrics.
@@ -55,6 +65,14 @@ class EchoRemover {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Saves and restores the converged state of the linear filters and of the
+  // echo estimates. A failed restore may leave the state partially restored.
+  virtual void SaveState(StateWriter* writer) const = 0;
+  virtual bool RestoreState(StateReader* reader) = 0;
+
+  // Resets the echo remover to the state of a new one. The metrics are kept.
+  virtual void Reset() = 0;
 };
 
 }  // namespace webrtc
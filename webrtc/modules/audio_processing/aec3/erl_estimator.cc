@@ -11,6 +11,7 @@
 #include "modules/audio_processing/aec3/erl_estimator.h"
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
 
 #include "rtc_base/checks.h"
@@ -26,10 +27,7 @@ constexpr float kMaxErl = 1000.f;
 
 ErlEstimator::ErlEstimator(size_t startup_phase_length_blocks_)
     : startup_phase_length_blocks__(startup_phase_length_blocks_) {
-  erl_.fill(kMaxErl);
-  hold_counters_.fill(0);
-  erl_time_domain_ = kMaxErl;
-  hold_counter_time_domain_ = 0;
+  ResetForReuse();
 }
 
 ErlEstimator::~ErlEstimator() = default;
@@ -38,6 +36,14 @@ void ErlEstimator::Reset() {
   blocks_since_reset_ = 0;
 }
 
+void ErlEstimator::ResetForReuse() {
+  Reset();
+  erl_.fill(kMaxErl);
+  hold_counters_.fill(0);
+  erl_time_domain_ = kMaxErl;
+  hold_counter_time_domain_ = 0;
+}
+
 void ErlEstimator::Update(
     const std::vector<bool>& converged_filters,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> render_spectra,
@@ -143,4 +149,16 @@ void ErlEstimator::Update(
                          : std::min(kMaxErl, 2.f * erl_time_domain_);
 }
 
+void ErlEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteFloats(erl_);
+  writer->WriteFloat(erl_time_domain_);
+  writer->WriteSize(blocks_since_reset_);
+}
+
+bool ErlEstimator::RestoreState(StateReader* reader) {
+  return reader->ReadFloats(erl_) && reader->ReadFloat(&erl_time_domain_) &&
+         reader->ReadSize(&blocks_since_reset_,
+                          std::numeric_limits<int32_t>::max());
+}
+
 }  // namespace webrtc
@@ -18,6 +18,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -33,6 +34,9 @@ class ErlEstimator {
   // Resets the ERL estimation.
   void Reset();
 
+  // Resets the ERL estimates as well, as in a new estimator.
+  void ResetForReuse();
+
   // Updates the ERL estimate.
   void Update(const std::vector<bool>& converged_filters,
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
@@ -44,6 +48,10 @@ class ErlEstimator {
   const std::array<float, kFftLengthBy2Plus1>& Erl() const { return erl_; }
   float ErlTimeDomain() const { return erl_time_domain_; }
 
+  // Saves and restores the ERL estimates.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   const size_t startup_phase_length_blocks__;
   std::array<float, kFftLengthBy2Plus1> erl_;
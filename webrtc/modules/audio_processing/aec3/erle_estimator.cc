@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/aec3/erle_estimator.h"
 
+#include <limits>
+
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "rtc_base/checks.h"
 
@@ -77,6 +79,19 @@ void ErleEstimator::Update(
   fullband_erle_estimator_.Update(X2_reverb, Y2, E2, converged_filters);
 }
 
+void ErleEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteSize(blocks_since_reset_);
+  fullband_erle_estimator_.SaveState(writer);
+  subband_erle_estimator_.SaveState(writer);
+}
+
+bool ErleEstimator::RestoreState(StateReader* reader) {
+  return reader->ReadSize(&blocks_since_reset_,
+                          std::numeric_limits<int32_t>::max()) &&
+         fullband_erle_estimator_.RestoreState(reader) &&
+         subband_erle_estimator_.RestoreState(reader);
+}
+
 void ErleEstimator::Dump(
     const std::unique_ptr<ApmDataDumper>& data_dumper) const {
   fullband_erle_estimator_.Dump(data_dumper);
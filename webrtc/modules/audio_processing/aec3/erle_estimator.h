@@ -26,6 +26,7 @@
 #include "modules/audio_processing/aec3/signal_dependent_erle_estimator.h"
 #include "modules/audio_processing/aec3/subband_erle_estimator.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -98,6 +99,12 @@ class ErleEstimator {
 
   void Dump(const std::unique_ptr<ApmDataDumper>& data_dumper) const;
 
+  // Saves and restores the fullband and subband ERLE estimates. The signal
+  // dependent ERLE estimates are not saved, and restart from their initial
+  // values.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   const size_t startup_phase_length_blocks_;
   FullBandErleEstimator fullband_erle_estimator_;
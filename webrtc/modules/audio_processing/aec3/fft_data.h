@@ -65,6 +65,7 @@ struct FftData {
                                         im[kFftLengthBy2] * im[kFftLengthBy2];
       } break;
 #endif
+      case Aec3Optimization::kAvx512:
       case Aec3Optimization::kAvx2:
         SpectrumAVX2(power_spectrum);
         break;
@@ -0,0 +1,288 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/audio_processing/aec3/fft_matched_filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// Smoothing factors of the cross-spectra per frame, before and after a
+// reliable delay has been found.
+constexpr float kSmoothingFast = 0.2f;
+constexpr float kSmoothingSlow = 0.05f;
+
+// Minimum ratio between the squared correlation peak and the mean squared
+// correlation over all the lags for the peak to be reported.
+constexpr float kPeakThreshold = 150.f;
+
+// Number of frames of correlation needed before a peak is reported.
+constexpr int kMinUpdates = 8;
+
+// Bounds the weights of the bins without power.
+constexpr float kMinWeightedPower = 1.f;
+
+size_t NumPartitions(size_t sub_block_size, size_t span_sub_blocks) {
+  const size_t span_partitions =
+      span_sub_blocks * sub_block_size / kFftLengthBy2;
+  RTC_DCHECK_LT(1, span_partitions);
+  return span_partitions - 1;
+}
+
+}  // namespace
+
+FftMatchedFilter::FftMatchedFilter(ApmDataDumper* data_dumper,
+                                   Aec3Fft::Backend fft_backend,
+                                   size_t sub_block_size,
+                                   size_t span_sub_blocks,
+                                   float excitation_limit)
+    : data_dumper_(data_dumper),
+      fft_(fft_backend),
+      sub_block_size_(sub_block_size),
+      num_partitions_(NumPartitions(sub_block_size, span_sub_blocks)),
+      render_energy_threshold_(kFftLength * excitation_limit *
+                               excitation_limit),
+      render_spectra_(num_partitions_),
+      render_energies_(num_partitions_, 0.f),
+      cross_spectra_(num_partitions_),
+      partition_energies_(num_partitions_, 0.f) {
+  RTC_DCHECK(data_dumper);
+  RTC_DCHECK_EQ(kFftLengthBy2 % sub_block_size_, 0);
+  Reset(/*full_reset=*/true);
+}
+
+FftMatchedFilter::~FftMatchedFilter() = default;
+
+void FftMatchedFilter::Reset(bool full_reset) {
+  if (full_reset) {
+    render_spectra_read_ = std::nullopt;
+  }
+  num_captured_ = 0;
+  num_updates_ = 0;
+  previous_peak_lag_ = std::nullopt;
+  for (auto& cross_spectrum : cross_spectra_) {
+    cross_spectrum.Clear();
+  }
+  capture_power_.fill(0.f);
+  render_power_.fill(0.f);
+  reported_lag_estimate_ = std::nullopt;
+}
+
+void FftMatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
+                              rtc::ArrayView<const float> capture,
+                              bool use_slow_smoothing) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  std::copy(capture.begin(), capture.end(),
+            capture_frame_.begin() + num_captured_);
+  num_captured_ += sub_block_size_;
+  if (num_captured_ == kFftLengthBy2) {
+    ProcessFrame(render_buffer, use_slow_smoothing);
+    num_captured_ = 0;
+  }
+}
+
+void FftMatchedFilter::UpdateRenderSpectra(
+    const DownsampledRenderBuffer& render_buffer) {
+  const int size = static_cast<int>(render_buffer.buffer.size());
+  const int read = render_buffer.read;
+
+  // The newest render sample is at the lowest index. Segment p holds, in time
+  // order, the kFftLength samples that end kFftLengthBy2 * p samples before
+  // the newest sample of the frame.
+  auto compute_partition = [&](size_t p, size_t slot) {
+    std::array<float, kFftLength> segment;
+    int index = (read + static_cast<int>((p + 2) * kFftLengthBy2) - 1) % size;
+    float energy = 0.f;
+    for (float& x : segment) {
+      x = render_buffer.buffer[index];
+      energy += x * x;
+      index = index > 0 ? index - 1 : size - 1;
+    }
+    render_energies_[slot] = energy;
+    fft_.Fft(&segment, &render_spectra_[slot]);
+  };
+
+  // When the read index has moved by exactly one frame, the segment of each
+  // partition is the previous segment of the partition before it, and only
+  // the segment of partition 0 is new.
+  if (render_spectra_read_ &&
+      *render_spectra_read_ ==
+          (read + static_cast<int>(kFftLengthBy2)) % size) {
+    render_spectra_start_ =
+        (render_spectra_start_ + num_partitions_ - 1) % num_partitions_;
+    compute_partition(0, render_spectra_start_);
+  } else {
+    for (size_t p = 0; p < num_partitions_; ++p) {
+      compute_partition(p, (render_spectra_start_ + p) % num_partitions_);
+    }
+  }
+  render_spectra_read_ = read;
+}
+
+void FftMatchedFilter::ProcessFrame(
+    const DownsampledRenderBuffer& render_buffer,
+    bool use_slow_smoothing) {
+  UpdateRenderSpectra(render_buffer);
+  reported_lag_estimate_ = std::nullopt;
+
+  // The capture frame is zero padded, so that the correlation with the
+  // render segments is linear for the kFftLengthBy2 lags of a partition.
+  std::array<float, kFftLength> y;
+  std::copy(capture_frame_.begin(), capture_frame_.end(), y.begin());
+  std::fill(y.begin() + kFftLengthBy2, y.end(), 0.f);
+  const bool saturation =
+      std::any_of(capture_frame_.begin(), capture_frame_.end(),
+                  [](float v) { return v >= 32000.f || v <= -32000.f; });
+  if (saturation) {
+    return;
+  }
+  FftData Y;
+  fft_.Fft(&y, &Y);
+
+  // Until the smoothing has converged, the cross-spectra are the mean of the
+  // frames since the last reset.
+  const float smoothing =
+      std::max(use_slow_smoothing ? kSmoothingSlow : kSmoothingFast,
+               1.f / (num_updates_ + 1));
+
+  bool updated = false;
+  for (size_t p = 0; p < num_partitions_; ++p) {
+    const size_t slot = (render_spectra_start_ + p) % num_partitions_;
+    if (render_energies_[slot] < render_energy_threshold_) {
+      continue;
+    }
+    const FftData& X = render_spectra_[slot];
+    FftData& C = cross_spectra_[p];
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      const float re = Y.re[k] * X.re[k] + Y.im[k] * X.im[k];
+      const float im = Y.re[k] * X.im[k] - Y.im[k] * X.re[k];
+      C.re[k] += smoothing * (re - C.re[k]);
+      C.im[k] += smoothing * (im - C.im[k]);
+    }
+    updated = true;
+  }
+  if (!updated) {
+    return;
+  }
+  ++num_updates_;
+
+  const FftData& X0 = render_spectra_[render_spectra_start_];
+  const bool update_render_power =
+      render_energies_[render_spectra_start_] >= render_energy_threshold_;
+  std::array<float, kFftLengthBy2Plus1> weights;
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    capture_power_[k] +=
+        smoothing * (Y.re[k] * Y.re[k] + Y.im[k] * Y.im[k] - capture_power_[k]);
+    if (update_render_power) {
+      render_power_[k] += smoothing * (X0.re[k] * X0.re[k] +
+                                       X0.im[k] * X0.im[k] - render_power_[k]);
+    }
+    weights[k] = 1.f / std::max(std::sqrt(capture_power_[k]) *
+                                    std::sqrt(render_power_[k]),
+                                kMinWeightedPower);
+  }
+
+  // By Parseval's relation, the energy of the correlation of each partition
+  // follows from its weighted cross-spectrum. Only the partition with the most
+  // energy and its neighbours, which hold the correlation of the lags next to
+  // it, are transformed back to find the peak.
+  float total_energy = 0.f;
+  size_t best_partition = 0;
+  FftData weighted;
+  for (size_t p = 0; p < num_partitions_; ++p) {
+    const FftData& C = cross_spectra_[p];
+    float energy = 0.f;
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      const float w2 = weights[k] * weights[k];
+      energy += w2 * (C.re[k] * C.re[k] + C.im[k] * C.im[k]);
+    }
+    // The bins other than DC and Nyquist count twice in the real transform.
+    energy = 2.f * energy - weights[0] * weights[0] *
+                                (C.re[0] * C.re[0] + C.im[0] * C.im[0]) -
+             weights[kFftLengthBy2] * weights[kFftLengthBy2] *
+                 (C.re[kFftLengthBy2] * C.re[kFftLengthBy2] +
+                  C.im[kFftLengthBy2] * C.im[kFftLengthBy2]);
+    partition_energies_[p] = energy;
+    total_energy += energy;
+    if (energy > partition_energies_[best_partition]) {
+      best_partition = p;
+    }
+  }
+  if (total_energy <= 0.f) {
+    return;
+  }
+
+  // Sample kFftLengthBy2 - d of the inverse transform of partition p is the
+  // correlation at lag kFftLengthBy2 * p + d.
+  const size_t first = best_partition > 0 ? best_partition - 1 : 0;
+  const size_t last = std::min(best_partition + 2, num_partitions_);
+  float peak = 0.f;
+  size_t peak_lag = 0;
+  float searched_energy = 0.f;
+  float searched_correlation_energy = 0.f;
+  std::array<float, kFftLength> r;
+  for (size_t p = first; p < last; ++p) {
+    const FftData& C = cross_spectra_[p];
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      weighted.re[k] = C.re[k] * weights[k];
+      weighted.im[k] = C.im[k] * weights[k];
+    }
+    fft_.Ifft(weighted, &r);
+    searched_energy += partition_energies_[p];
+    for (float v : r) {
+      searched_correlation_energy += v * v;
+    }
+    for (size_t d = 0; d < kFftLengthBy2; ++d) {
+      const float c2 = r[kFftLengthBy2 - d] * r[kFftLengthBy2 - d];
+      if (c2 > peak) {
+        peak = c2;
+        peak_lag = p * kFftLengthBy2 + d;
+      }
+    }
+  }
+
+  // The mean squared correlation over all the lags, in the scale of the
+  // inverse transform.
+  const float mean = total_energy * searched_correlation_energy /
+                     (searched_energy * num_partitions_ * kFftLength);
+  const bool stable = previous_peak_lag_ == peak_lag;
+  previous_peak_lag_ = peak_lag;
+  if (num_updates_ >= kMinUpdates && stable && peak > kPeakThreshold * mean) {
+    reported_lag_estimate_ =
+        MatchedFilter::LagEstimate(peak_lag, /*pre_echo_lag=*/peak_lag);
+  }
+
+  if (ApmDataDumper::IsAvailable()) {
+    data_dumper_->DumpRaw("aec3_fft_correlator_energies", partition_energies_);
+    data_dumper_->DumpRaw("aec3_fft_correlator_lag", peak_lag);
+    data_dumper_->DumpRaw("aec3_fft_correlator_peak_to_mean", peak / mean);
+  }
+}
+
+void FftMatchedFilter::LogFilterProperties(int sample_rate_hz,
+                                           size_t shift,
+                                           size_t downsampling_factor) const {
+  constexpr int kFsBy1000 = 16;
+  const int end = static_cast<int>(GetMaxFilterLag() * downsampling_factor);
+  RTC_LOG(LS_VERBOSE) << "FFT matched filter: " << num_partitions_
+                      << " partitions, start: "
+                      << -static_cast<int>(shift) / kFsBy1000
+                      << " ms, end: " << (end - static_cast<int>(shift)) /
+                                             kFsBy1000
+                      << " ms.";
+}
+
+}  // namespace webrtc
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_FFT_MATCHED_FILTER_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_FFT_MATCHED_FILTER_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+
+namespace webrtc {
+
+class ApmDataDumper;
+struct DownsampledRenderBuffer;
+
+// Alternative to MatchedFilter that estimates the lag by cross-correlating the
+// capture with the downsampled render in the frequency domain. The capture is
+// gathered in frames of kFftLengthBy2 samples, and the lags are split in
+// partitions of kFftLengthBy2 lags. For each partition, a smoothed
+// cross-spectrum of the capture frames and the render is kept, and the
+// correlation over the lags of the partition is obtained with one inverse FFT.
+// The render spectra move one partition per frame and are only computed once,
+// so the cost per lag grows with the log of the partition size instead of with
+// the filter length, which allows long delay ranges.
+//
+// The cross-spectra are weighted by the inverse of the geometric mean of the
+// capture and render power spectra, which sharpens the correlation peak of
+// colored signals like speech. The reported pre-echo lag is the lag itself.
+class FftMatchedFilter {
+ public:
+  // Covers the lags of a render span of `span_sub_blocks` sub-blocks, which is
+  // one partition less than the span.
+  FftMatchedFilter(ApmDataDumper* data_dumper,
+                   Aec3Fft::Backend fft_backend,
+                   size_t sub_block_size,
+                   size_t span_sub_blocks,
+                   float excitation_limit);
+
+  FftMatchedFilter() = delete;
+  FftMatchedFilter(const FftMatchedFilter&) = delete;
+  FftMatchedFilter& operator=(const FftMatchedFilter&) = delete;
+
+  ~FftMatchedFilter();
+
+  // Adds the capture sub-block, and updates the correlation once a frame of
+  // capture has been gathered.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              rtc::ArrayView<const float> capture,
+              bool use_slow_smoothing);
+
+  // Resets the correlation. The render spectra are kept unless `full_reset`
+  // is set.
+  void Reset(bool full_reset);
+
+  // Returns the lag estimate of the last frame. It is reported for all the
+  // sub-blocks of the next frame.
+  std::optional<const MatchedFilter::LagEstimate> GetBestLagEstimate() const {
+    return reported_lag_estimate_;
+  }
+
+  // Returns the maximum lag.
+  size_t GetMaxFilterLag() const {
+    return num_partitions_ * kFftLengthBy2;
+  }
+
+  // Log filter properties.
+  void LogFilterProperties(int sample_rate_hz,
+                           size_t shift,
+                           size_t downsampling_factor) const;
+
+ private:
+  // Updates the render spectra for the frame that ends at the read index of
+  // `render_buffer`.
+  void UpdateRenderSpectra(const DownsampledRenderBuffer& render_buffer);
+  void ProcessFrame(const DownsampledRenderBuffer& render_buffer,
+                    bool use_slow_smoothing);
+
+  ApmDataDumper* const data_dumper_;
+  const Aec3Fft fft_;
+  const size_t sub_block_size_;
+  const size_t num_partitions_;
+  const float render_energy_threshold_;
+
+  std::array<float, kFftLengthBy2> capture_frame_;
+  size_t num_captured_ = 0;
+
+  // Ring of the render spectra of the partitions, partition 0 at
+  // `render_spectra_start_`, and the energies of the render segments.
+  std::vector<FftData> render_spectra_;
+  std::vector<float> render_energies_;
+  size_t render_spectra_start_ = 0;
+  std::optional<int> render_spectra_read_;
+
+  // Number of frames the cross-spectra have been updated with since the last
+  // reset.
+  int num_updates_ = 0;
+  std::vector<FftData> cross_spectra_;
+  std::array<float, kFftLengthBy2Plus1> capture_power_;
+  std::array<float, kFftLengthBy2Plus1> render_power_;
+  std::vector<float> partition_energies_;
+  // Lag of the correlation peak of the previous frame. A peak is only reported
+  // when it has the same lag in two frames in a row.
+  std::optional<size_t> previous_peak_lag_;
+
+  std::optional<MatchedFilter::LagEstimate> reported_lag_estimate_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_FFT_MATCHED_FILTER_H_
@@ -72,6 +72,17 @@ void FilterAnalyzer::Reset() {
   std::fill(filter_delays_blocks_.begin(), filter_delays_blocks_.end(), 0);
 }
 
+void FilterAnalyzer::ResetForReuse() {
+  Reset();
+  for (auto& h : h_highpass_) {
+    std::fill(h.begin(), h.end(), 0.f);
+  }
+  for (auto& state : filter_analysis_states_) {
+    state.consistent_estimate = false;
+  }
+  min_filter_delay_blocks_ = 0;
+}
+
 void FilterAnalyzer::Update(
     rtc::ArrayView<const std::vector<float>> filters_time_domain,
     const RenderBuffer& render_buffer,
@@ -41,6 +41,9 @@ class FilterAnalyzer {
   // Resets the analysis.
   void Reset();
 
+  // Resets the analysis and the analyzed filters, as in a new analyzer.
+  void ResetForReuse();
+
   // Updates the estimates with new input data.
   void Update(rtc::ArrayView<const std::vector<float>> filters_time_domain,
               const RenderBuffer& render_buffer,
@@ -31,6 +31,14 @@ FrameBlocker::FrameBlocker(size_t num_bands, size_t num_channels)
 
 FrameBlocker::~FrameBlocker() = default;
 
+void FrameBlocker::Reset() {
+  for (auto& band : buffer_) {
+    for (auto& channel : band) {
+      channel.clear();
+    }
+  }
+}
+
 void FrameBlocker::InsertSubFrameAndExtractBlock(
     const std::vector<std::vector<rtc::ArrayView<float>>>& sub_frame,
     Block* block) {
@@ -40,6 +40,8 @@ class FrameBlocker {
   bool IsBlockAvailable() const;
   // Extracts a multiband block of 64 samples.
   void ExtractBlock(Block* block);
+  // Discards the buffered samples.
+  void Reset();
 
  private:
   const size_t num_bands_;
@@ -89,6 +89,16 @@ void FullBandErleEstimator::Update(
   UpdateQualityEstimates();
 }
 
+void FullBandErleEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteSize(erle_time_domain_log2_.size());
+  writer->WriteFloats(erle_time_domain_log2_);
+}
+
+bool FullBandErleEstimator::RestoreState(StateReader* reader) {
+  return reader->ReadExpectedSize(erle_time_domain_log2_.size()) &&
+         reader->ReadFloats(erle_time_domain_log2_);
+}
+
 void FullBandErleEstimator::Dump(
     const std::unique_ptr<ApmDataDumper>& data_dumper) const {
   data_dumper->DumpRaw("aec3_fullband_erle_log2", FullbandErleLog2());
@@ -19,6 +19,7 @@
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -56,6 +57,10 @@ class FullBandErleEstimator {
 
   void Dump(const std::unique_ptr<ApmDataDumper>& data_dumper) const;
 
+  // Saves and restores the fullband ERLE estimates.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   void UpdateQualityEstimates();
 
@@ -614,6 +614,7 @@ MatchedFilter::MatchedFilter(ApmDataDumper* data_dumper,
           num_matched_filters,
           std::vector<float>(window_size_sub_blocks * sub_block_size_, 0.f)),
       filters_offsets_(num_matched_filters, 0),
+      last_active_filter_(num_matched_filters - 1),
       excitation_limit_(excitation_limit),
       smoothing_fast_(smoothing_fast),
       smoothing_slow_(smoothing_slow),
@@ -657,6 +658,31 @@ void MatchedFilter::Reset(bool full_reset) {
   }
 }
 
+void MatchedFilter::ResetForReuse() {
+  Reset(/*full_reset=*/true);
+  ClearLagRange();
+  last_detected_best_lag_filter_ = -1;
+}
+
+void MatchedFilter::SetLagRange(size_t min_lag, size_t max_lag) {
+  RTC_DCHECK_LE(min_lag, max_lag);
+  // Filter n covers the lags [n * filter_intra_lag_shift_,
+  // n * filter_intra_lag_shift_ + filters_[n].size()).
+  const size_t filter_size = filters_[0].size();
+  first_active_filter_ =
+      min_lag < filter_size
+          ? 0
+          : (min_lag - filter_size) / filter_intra_lag_shift_ + 1;
+  last_active_filter_ = std::min(max_lag / filter_intra_lag_shift_,
+                                 filters_.size() - 1);
+  first_active_filter_ = std::min(first_active_filter_, last_active_filter_);
+}
+
+void MatchedFilter::ClearLagRange() {
+  first_active_filter_ = 0;
+  last_active_filter_ = filters_.size() - 1;
+}
+
 void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
                            rtc::ArrayView<const float> capture,
                            bool use_slow_smoothing) {
@@ -684,6 +710,12 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
   const int num_filters = static_cast<int>(filters_.size());
   int winner_index = -1;
   for (int n = 0; n < num_filters; ++n) {
+    if (n < static_cast<int>(first_active_filter_) ||
+        n > static_cast<int>(last_active_filter_)) {
+      previous_lag_estimate = std::nullopt;
+      alignment_shift += filter_intra_lag_shift_;
+      continue;
+    }
     float error_sum = 0.f;
     bool filters_updated = false;
     const bool compute_pre_echo =
@@ -702,6 +734,19 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
             filters_[n], &filters_updated, &error_sum, compute_pre_echo,
             instantaneous_accumulated_error_, scratch_memory_);
         break;
+#endif
+#if defined(WEBRTC_ENABLE_AVX512)
+      case Aec3Optimization::kAvx512:
+        // The AVX-512 core works on 16 coefficients at a time, shorter
+        // alignments are left to the AVX2 core.
+        if (filters_[n].size() % 16 == 0) {
+          aec3::MatchedFilterCore_AVX512(
+              x_start_index, x2_sum_threshold, smoothing, render_buffer.buffer,
+              y, filters_[n], &filters_updated, &error_sum, compute_pre_echo,
+              instantaneous_accumulated_error_, scratch_memory_);
+          break;
+        }
+        [[fallthrough]];
 #endif
       case Aec3Optimization::kAvx2:
         aec3::MatchedFilterCore_AVX2(
@@ -801,7 +846,7 @@ void MatchedFilter::LogFilterProperties(int sample_rate_hz,
 }
 
 void MatchedFilter::Dump() {
-  for (size_t n = 0; n < filters_.size(); ++n) {
+  for (size_t n = first_active_filter_; n <= last_active_filter_; ++n) {
     const size_t lag_estimate = aec3::MaxSquarePeakIndex(filters_[n]);
     std::string dumper_filter = "aec3_correlator_" + std::to_string(n) + "_h";
     data_dumper_->DumpRaw(dumper_filter.c_str(), filters_[n]);
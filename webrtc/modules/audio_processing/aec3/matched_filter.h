@@ -73,6 +73,19 @@ void MatchedFilterCore_AVX2(size_t x_start_index,
                             rtc::ArrayView<float> accumulated_error,
                             rtc::ArrayView<float> scratch_memory);
 
+// Filter core for the matched filter that is optimized for AVX-512.
+void MatchedFilterCore_AVX512(size_t x_start_index,
+                              float x2_sum_threshold,
+                              float smoothing,
+                              rtc::ArrayView<const float> x,
+                              rtc::ArrayView<const float> y,
+                              rtc::ArrayView<float> h,
+                              bool* filters_updated,
+                              float* error_sum,
+                              bool compute_accumulated_error,
+                              rtc::ArrayView<float> accumulated_error,
+                              rtc::ArrayView<float> scratch_memory);
+
 #endif
 
 // Filter core for the matched filter.
@@ -132,6 +145,17 @@ class MatchedFilter {
   // Resets the matched filter.
   void Reset(bool full_reset);
 
+  // Resets the matched filter to the state of a new one.
+  void ResetForReuse();
+
+  // Restricts the updates to the filters that overlap the lags in
+  // [`min_lag`, `max_lag`]. The other filters are left untouched and do not
+  // produce lag estimates.
+  void SetLagRange(size_t min_lag, size_t max_lag);
+
+  // Updates all the filters again.
+  void ClearLagRange();
+
   // Returns the current lag estimates.
   std::optional<const MatchedFilter::LagEstimate> GetBestLagEstimate() const {
     return reported_lag_estimate_;
@@ -162,6 +186,8 @@ class MatchedFilter {
   std::optional<size_t> winner_lag_;
   int last_detected_best_lag_filter_ = -1;
   std::vector<size_t> filters_offsets_;
+  size_t first_active_filter_ = 0;
+  size_t last_active_filter_;
   int number_pre_echo_updates_ = 0;
   const float excitation_limit_;
   const float smoothing_fast_;
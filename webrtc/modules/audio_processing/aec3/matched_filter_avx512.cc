@@ -0,0 +1,261 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// The zero-masked permutes and extracts below are used instead of the
+// unmasked ones and of the 512 bit casts, since the latter pass an undefined
+// vector as merge source and trigger -Wmaybe-uninitialized with GCC.
+constexpr __mmask16 kAllLanes = 0xFFFF;
+
+// Returns the 256 bit half `index` of `a`.
+inline __m256 ExtractHalf(__m512 a, int index) {
+  return _mm256_castpd_ps(
+      _mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(a), index));
+}
+
+// Returns the sum of the elements of `a`.
+inline float ReduceAdd(__m512 a) {
+  const __m256 s8 = _mm256_add_ps(ExtractHalf(a, 0), ExtractHalf(a, 1));
+  __m128 s = _mm_add_ps(_mm256_castps256_ps128(s8),
+                        _mm256_extractf128_ps(s8, 1));
+  s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+  s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(s);
+}
+
+// Returns the running sums of the four groups of four consecutive elements of
+// `a`, i.e., the sums of the 128 bit lanes accumulated from the lowest lane.
+inline __m128 GroupPrefixSums(__m512 a) {
+  a = _mm512_add_ps(a, _mm512_maskz_permute_ps(kAllLanes, a,
+                                               _MM_SHUFFLE(2, 3, 0, 1)));
+  a = _mm512_add_ps(a, _mm512_maskz_permute_ps(kAllLanes, a,
+                                               _MM_SHUFFLE(1, 0, 3, 2)));
+  // Gather the lane sums from elements 0, 4, 8 and 12 into the low 128 bits.
+  const __m512i kIndices =
+      _mm512_set_epi32(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 12, 8, 4, 0);
+  __m128 s = _mm512_maskz_extractf32x4_ps(
+      0xF, _mm512_maskz_permutexvar_ps(kAllLanes, kIndices, a), 0);
+  s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 4)));
+  return _mm_add_ps(s,
+                    _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 8)));
+}
+
+void MatchedFilterCore_AccumulatedError_AVX512(
+    size_t x_start_index,
+    float x2_sum_threshold,
+    float smoothing,
+    rtc::ArrayView<const float> x,
+    rtc::ArrayView<const float> y,
+    rtc::ArrayView<float> h,
+    bool* filters_updated,
+    float* error_sum,
+    rtc::ArrayView<float> accumulated_error,
+    rtc::ArrayView<float> scratch_memory) {
+  const int h_size = static_cast<int>(h.size());
+  const int x_size = static_cast<int>(x.size());
+  RTC_DCHECK_EQ(0, h_size % 16);
+  std::fill(accumulated_error.begin(), accumulated_error.end(), 0.0f);
+
+  // Process for all samples in the sub-block.
+  for (size_t i = 0; i < y.size(); ++i) {
+    // Apply the matched filter as filter * x, and compute x * x.
+    RTC_DCHECK_GT(x_size, x_start_index);
+    const int chunk1 =
+        std::min(h_size, static_cast<int>(x_size - x_start_index));
+    if (chunk1 != h_size) {
+      const int chunk2 = h_size - chunk1;
+      std::copy(x.begin() + x_start_index, x.end(), scratch_memory.begin());
+      std::copy(x.begin(), x.begin() + chunk2, scratch_memory.begin() + chunk1);
+    }
+    const float* x_p =
+        chunk1 != h_size ? scratch_memory.data() : &x[x_start_index];
+    const float* h_p = &h[0];
+    float* a_p = &accumulated_error[0];
+    __m512 x2_sum_512 = _mm512_set1_ps(0);
+    // The running sum h * x is kept broadcast to all lanes, so that the only
+    // dependency between the iterations is one vector addition.
+    __m128 s_acum_128 = _mm_set1_ps(0);
+    const __m128 y_128 = _mm_set1_ps(y[i]);
+    const int limit_by_16 = h_size >> 4;
+    for (int k = limit_by_16; k > 0; --k, h_p += 16, x_p += 16, a_p += 4) {
+      // Load the data into 512 bit vectors.
+      const __m512 x_k = _mm512_loadu_ps(x_p);
+      const __m512 h_k = _mm512_loadu_ps(h_p);
+      // Compute and accumulate x * x and h * x.
+      x2_sum_512 = _mm512_fmadd_ps(x_k, x_k, x2_sum_512);
+      const __m128 s_inst = GroupPrefixSums(_mm512_mul_ps(h_k, x_k));
+
+      // Form the errors of the partial filters ending at each group of four
+      // coefficients.
+      const __m128 s_partial = _mm_add_ps(s_acum_128, s_inst);
+      const __m128 e_128 = _mm_sub_ps(s_partial, y_128);
+      s_acum_128 =
+          _mm_shuffle_ps(s_partial, s_partial, _MM_SHUFFLE(3, 3, 3, 3));
+
+      __m128 accumulated_error = _mm_loadu_ps(a_p);
+      accumulated_error = _mm_fmadd_ps(e_128, e_128, accumulated_error);
+      _mm_storeu_ps(a_p, accumulated_error);
+    }
+    const float s_acum = _mm_cvtss_f32(s_acum_128);
+    const float x2_sum = ReduceAdd(x2_sum_512);
+
+    // Compute the matched filter error.
+    float e = y[i] - s_acum;
+    const bool saturation = y[i] >= 32000.f || y[i] <= -32000.f;
+    (*error_sum) += e * e;
+
+    // Update the matched filter estimate in an NLMS manner.
+    if (x2_sum > x2_sum_threshold && !saturation) {
+      RTC_DCHECK_LT(0.f, x2_sum);
+      const float alpha = smoothing * e / x2_sum;
+      const __m512 alpha_512 = _mm512_set1_ps(alpha);
+
+      // filter = filter + smoothing * (y - filter * x) * x / x * x.
+      float* h_p = &h[0];
+      const float* x_p =
+          chunk1 != h_size ? scratch_memory.data() : &x[x_start_index];
+      for (int k = limit_by_16; k > 0; --k, h_p += 16, x_p += 16) {
+        __m512 h_k = _mm512_loadu_ps(h_p);
+        const __m512 x_k = _mm512_loadu_ps(x_p);
+        // Compute h = h + alpha * x.
+        h_k = _mm512_fmadd_ps(x_k, alpha_512, h_k);
+        _mm512_storeu_ps(h_p, h_k);
+      }
+      *filters_updated = true;
+    }
+
+    x_start_index = x_start_index > 0 ? x_start_index - 1 : x_size - 1;
+  }
+}
+
+void MatchedFilterCore_AVX512(size_t x_start_index,
+                              float x2_sum_threshold,
+                              float smoothing,
+                              rtc::ArrayView<const float> x,
+                              rtc::ArrayView<const float> y,
+                              rtc::ArrayView<float> h,
+                              bool* filters_updated,
+                              float* error_sum,
+                              bool compute_accumulated_error,
+                              rtc::ArrayView<float> accumulated_error,
+                              rtc::ArrayView<float> scratch_memory) {
+  if (compute_accumulated_error) {
+    return MatchedFilterCore_AccumulatedError_AVX512(
+        x_start_index, x2_sum_threshold, smoothing, x, y, h, filters_updated,
+        error_sum, accumulated_error, scratch_memory);
+  }
+  const int h_size = static_cast<int>(h.size());
+  const int x_size = static_cast<int>(x.size());
+  RTC_DCHECK_EQ(0, h_size % 16);
+
+  // Process for all samples in the sub-block.
+  for (size_t i = 0; i < y.size(); ++i) {
+    // Apply the matched filter as filter * x, and compute x * x.
+
+    RTC_DCHECK_GT(x_size, x_start_index);
+    const float* x_p = &x[x_start_index];
+    const float* h_p = &h[0];
+
+    // Initialize values for the accumulation.
+    __m512 s_512 = _mm512_set1_ps(0);
+    __m512 s_512_16 = _mm512_set1_ps(0);
+    __m512 x2_sum_512 = _mm512_set1_ps(0);
+    __m512 x2_sum_512_16 = _mm512_set1_ps(0);
+    float x2_sum = 0.f;
+    float s = 0;
+
+    // Compute loop chunk sizes until, and after, the wraparound of the circular
+    // buffer for x.
+    const int chunk1 =
+        std::min(h_size, static_cast<int>(x_size - x_start_index));
+
+    // Perform the loop in two chunks.
+    const int chunk2 = h_size - chunk1;
+    for (int limit : {chunk1, chunk2}) {
+      // Perform 512 bit vector operations, two vectors at a time to hide the
+      // latency of the fused multiply-adds.
+      const int limit_by_32 = limit >> 5;
+      for (int k = limit_by_32; k > 0; --k, h_p += 32, x_p += 32) {
+        const __m512 x_k = _mm512_loadu_ps(x_p);
+        const __m512 h_k = _mm512_loadu_ps(h_p);
+        const __m512 x_k_16 = _mm512_loadu_ps(x_p + 16);
+        const __m512 h_k_16 = _mm512_loadu_ps(h_p + 16);
+        // Compute and accumulate x * x and h * x.
+        x2_sum_512 = _mm512_fmadd_ps(x_k, x_k, x2_sum_512);
+        x2_sum_512_16 = _mm512_fmadd_ps(x_k_16, x_k_16, x2_sum_512_16);
+        s_512 = _mm512_fmadd_ps(h_k, x_k, s_512);
+        s_512_16 = _mm512_fmadd_ps(h_k_16, x_k_16, s_512_16);
+      }
+
+      // Perform non-vector operations for any remaining items.
+      for (int k = limit - limit_by_32 * 32; k > 0; --k, ++h_p, ++x_p) {
+        const float x_k = *x_p;
+        x2_sum += x_k * x_k;
+        s += *h_p * x_k;
+      }
+
+      x_p = &x[0];
+    }
+
+    // Sum components together.
+    x2_sum += ReduceAdd(_mm512_add_ps(x2_sum_512, x2_sum_512_16));
+    s += ReduceAdd(_mm512_add_ps(s_512, s_512_16));
+
+    // Compute the matched filter error.
+    float e = y[i] - s;
+    const bool saturation = y[i] >= 32000.f || y[i] <= -32000.f;
+    (*error_sum) += e * e;
+
+    // Update the matched filter estimate in an NLMS manner.
+    if (x2_sum > x2_sum_threshold && !saturation) {
+      RTC_DCHECK_LT(0.f, x2_sum);
+      const float alpha = smoothing * e / x2_sum;
+      const __m512 alpha_512 = _mm512_set1_ps(alpha);
+
+      // filter = filter + smoothing * (y - filter * x) * x / x * x.
+      float* h_p = &h[0];
+      x_p = &x[x_start_index];
+
+      // Perform the loop in two chunks.
+      for (int limit : {chunk1, chunk2}) {
+        // Perform 512 bit vector operations.
+        const int limit_by_16 = limit >> 4;
+        for (int k = limit_by_16; k > 0; --k, h_p += 16, x_p += 16) {
+          __m512 h_k = _mm512_loadu_ps(h_p);
+          const __m512 x_k = _mm512_loadu_ps(x_p);
+          // Compute h = h + alpha * x.
+          h_k = _mm512_fmadd_ps(x_k, alpha_512, h_k);
+          _mm512_storeu_ps(h_p, h_k);
+        }
+
+        // Perform non-vector operations for any remaining items.
+        for (int k = limit - limit_by_16 * 16; k > 0; --k, ++h_p, ++x_p) {
+          *h_p += alpha * *x_p;
+        }
+
+        x_p = &x[0];
+      }
+
+      *filters_updated = true;
+    }
+
+    x_start_index = x_start_index > 0 ? x_start_index - 1 : x_size - 1;
+  }
+}
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -62,6 +62,14 @@ void MatchedFilterLagAggregator::Reset(bool hard_reset) {
   }
 }
 
+void MatchedFilterLagAggregator::ResetForReuse() {
+  highest_peak_aggregator_.ResetForReuse();
+  if (pre_echo_lag_aggregator_ != nullptr) {
+    pre_echo_lag_aggregator_->ResetForReuse();
+  }
+  significant_candidate_found_ = false;
+}
+
 std::optional<DelayEstimate> MatchedFilterLagAggregator::Aggregate(
     const std::optional<const MatchedFilter::LagEstimate>& lag_estimate) {
   if (lag_estimate && pre_echo_lag_aggregator_) {
@@ -105,6 +113,11 @@ void MatchedFilterLagAggregator::HighestPeakAggregator::Reset() {
   histogram_data_index_ = 0;
 }
 
+void MatchedFilterLagAggregator::HighestPeakAggregator::ResetForReuse() {
+  Reset();
+  candidate_ = -1;
+}
+
 void MatchedFilterLagAggregator::HighestPeakAggregator::Aggregate(int lag) {
   RTC_DCHECK_GT(histogram_.size(), histogram_data_[histogram_data_index_]);
   RTC_DCHECK_LE(0, histogram_data_[histogram_data_index_]);
@@ -136,6 +149,11 @@ void MatchedFilterLagAggregator::PreEchoLagAggregator::Reset() {
   pre_echo_candidate_ = 0;
 }
 
+void MatchedFilterLagAggregator::PreEchoLagAggregator::ResetForReuse() {
+  Reset();
+  number_updates_ = 0;
+}
+
 void MatchedFilterLagAggregator::PreEchoLagAggregator::Aggregate(
     int pre_echo_lag) {
   int pre_echo_block_size = pre_echo_lag >> block_size_log2_;
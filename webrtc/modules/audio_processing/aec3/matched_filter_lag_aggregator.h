@@ -40,6 +40,9 @@ class MatchedFilterLagAggregator {
   // Resets the aggregator.
   void Reset(bool hard_reset);
 
+  // Resets the aggregator to the state of a new one.
+  void ResetForReuse();
+
   // Aggregates the provided lag estimates.
   std::optional<DelayEstimate> Aggregate(
       const std::optional<const MatchedFilter::LagEstimate>& lag_estimate);
@@ -58,6 +61,7 @@ class MatchedFilterLagAggregator {
    public:
     PreEchoLagAggregator(size_t max_filter_lag, size_t down_sampling_factor);
     void Reset();
+    void ResetForReuse();
     void Aggregate(int pre_echo_lag);
     int pre_echo_candidate() const { return pre_echo_candidate_; }
     void Dump(ApmDataDumper* const data_dumper);
@@ -75,6 +79,7 @@ class MatchedFilterLagAggregator {
    public:
     explicit HighestPeakAggregator(size_t max_filter_lag);
     void Reset();
+    void ResetForReuse();
     void Aggregate(int lag);
     int candidate() const { return candidate_; }
     rtc::ArrayView<const int> histogram() const { return histogram_; }
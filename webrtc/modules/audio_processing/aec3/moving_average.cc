@@ -31,6 +31,11 @@ MovingAverage::MovingAverage(size_t num_elem, size_t mem_len)
 
 MovingAverage::~MovingAverage() = default;
 
+void MovingAverage::Reset() {
+  std::fill(memory_.begin(), memory_.end(), 0.f);
+  mem_index_ = 0;
+}
+
 void MovingAverage::Average(rtc::ArrayView<const float> input,
                             rtc::ArrayView<float> output) {
   RTC_DCHECK(input.size() == num_elem_);
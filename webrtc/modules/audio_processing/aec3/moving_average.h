@@ -31,6 +31,9 @@ class MovingAverage {
   // result in output.
   void Average(rtc::ArrayView<const float> input, rtc::ArrayView<float> output);
 
+  // Clears the previous inputs.
+  void Reset();
+
  private:
   const size_t num_elem_;
   const size_t mem_len_;
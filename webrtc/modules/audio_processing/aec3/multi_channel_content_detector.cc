@@ -102,8 +102,10 @@ MultiChannelContentDetector::MultiChannelContentDetector(
       metrics_logger_((detect_stereo_content && num_render_input_channels > 1)
                           ? std::make_unique<MetricsLogger>()
                           : nullptr),
+      initial_persistent_multichannel_content_detected_(
+          !detect_stereo_content && num_render_input_channels > 1),
       persistent_multichannel_content_detected_(
-          !detect_stereo_content && num_render_input_channels > 1) {}
+          initial_persistent_multichannel_content_detected_) {}
 
 bool MultiChannelContentDetector::UpdateDetection(
     const std::vector<std::vector<std::vector<float>>>& frame) {
@@ -145,4 +147,16 @@ bool MultiChannelContentDetector::UpdateDetection(
          persistent_multichannel_content_detected_;
 }
 
+bool MultiChannelContentDetector::Reset() {
+  const bool previous_persistent_multichannel_content_detected =
+      persistent_multichannel_content_detected_;
+  persistent_multichannel_content_detected_ =
+      initial_persistent_multichannel_content_detected_;
+  temporary_multichannel_content_detected_ = false;
+  frames_since_stereo_detected_last_ = 0;
+  consecutive_frames_with_stereo_ = 0;
+  return previous_persistent_multichannel_content_detected !=
+         persistent_multichannel_content_detected_;
+}
+
 }  // namespace webrtc
@@ -51,6 +51,11 @@ class MultiChannelContentDetector {
     return temporary_multichannel_content_detected_;
   }
 
+  // Restarts the detection as in a new detector. Returns a bool indicating
+  // whether this changed the proper multichannel content detection. The
+  // metrics are kept.
+  bool Reset();
+
  private:
   // Tracks and logs metrics for the amount of multichannel content detected.
   class MetricsLogger {
@@ -84,6 +89,7 @@ class MultiChannelContentDetector {
   // |detect_stereo_content_| is true.
   const std::unique_ptr<MetricsLogger> metrics_logger_;
 
+  const bool initial_persistent_multichannel_content_detected_;
   bool persistent_multichannel_content_detected_;
   bool temporary_multichannel_content_detected_ = false;
   int64_t frames_since_stereo_detected_last_ = 0;
@@ -35,6 +35,9 @@ class NearendDetector {
       rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
           comfort_noise_spectrum,
       bool initial_state) = 0;
+
+  // Resets the detector to the state of a new one.
+  virtual void Reset() = 0;
 };
 
 }  // namespace webrtc
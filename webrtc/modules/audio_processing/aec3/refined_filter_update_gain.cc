@@ -64,6 +64,14 @@ void RefinedFilterUpdateGain::HandleEchoPathChange(
   }
 }
 
+void RefinedFilterUpdateGain::Reset(
+    const EchoCanceller3Config::Filter::RefinedConfiguration& config) {
+  SetConfig(config, true);
+  H_error_.fill(kHErrorInitial);
+  poor_excitation_counter_ = kPoorExcitationCounterInitial;
+  call_counter_ = 0;
+}
+
 void RefinedFilterUpdateGain::Compute(
     const std::array<float, kFftLengthBy2Plus1>& render_power,
     const RenderSignalAnalyzer& render_signal_analyzer,
@@ -20,6 +20,7 @@
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -42,9 +43,18 @@ class RefinedFilterUpdateGain {
   RefinedFilterUpdateGain(const RefinedFilterUpdateGain&) = delete;
   RefinedFilterUpdateGain& operator=(const RefinedFilterUpdateGain&) = delete;
 
+  // Saves and restores the estimate of the filter error.
+  void SaveState(StateWriter* writer) const { writer->WriteFloats(H_error_); }
+  bool RestoreState(StateReader* reader) {
+    return reader->ReadFloats(H_error_);
+  }
+
   // Takes action in the case of a known echo path change.
   void HandleEchoPathChange(const EchoPathVariability& echo_path_variability);
 
+  // Resets the gain to the state of a new one with the config `config`.
+  void Reset(const EchoCanceller3Config::Filter::RefinedConfiguration& config);
+
   // Computes the gain.
   void Compute(const std::array<float, kFftLengthBy2Plus1>& render_power,
                const RenderSignalAnalyzer& render_signal_analyzer,
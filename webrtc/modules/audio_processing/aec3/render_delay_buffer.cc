@@ -25,6 +25,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/alignment_mixer.h"
+#include "modules/audio_processing/aec3/analyzed_render_block.h"
 #include "modules/audio_processing/aec3/block_buffer.h"
 #include "modules/audio_processing/aec3/decimator.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
@@ -49,7 +50,13 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   ~RenderDelayBufferImpl() override;
 
   void Reset() override;
-  BufferingEvent Insert(const Block& block) override;
+  void ResetForReuse() override;
+  BufferingEvent Insert(const Block& block) override {
+    return Insert(block, /*analyzed=*/nullptr);
+  }
+  BufferingEvent InsertAnalyzed(const AnalyzedRenderBlock& block) override {
+    return Insert(block.block, &block);
+  }
   BufferingEvent PrepareCaptureProcessing() override;
   void HandleSkippedCaptureProcessing() override;
   bool AlignFromDelay(size_t delay) override;
@@ -103,7 +110,11 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   int MapDelayToTotalDelay(size_t delay) const;
   int ComputeDelay() const;
   void ApplyTotalDelay(int delay);
+  BufferingEvent Insert(const Block& block,
+                        const AnalyzedRenderBlock* analyzed);
+  void CopyBlock(const Block& block);
   void InsertBlock(const Block& block, int previous_write);
+  void InsertAnalyzedBlock(const AnalyzedRenderBlock& analyzed);
   bool DetectActiveRender(rtc::ArrayView<const float> x) const;
   bool DetectExcessRenderBlocks();
   void IncrementWriteIndices();
@@ -143,7 +154,7 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
                                          config.delay.num_filters)),
       render_mixer_(num_render_channels, config.delay.render_alignment_mixing),
       render_decimator_(down_sampling_factor_),
-      fft_(),
+      fft_(Aec3Fft::SelectBackend(config)),
       render_ds_(sub_block_size_, 0.f),
       buffer_headroom_(config.filter.refined.length_blocks) {
   RTC_DCHECK_EQ(blocks_.buffer.size(), ffts_.buffer.size());
@@ -197,9 +208,48 @@ void RenderDelayBufferImpl::Reset() {
   }
 }
 
-// Inserts a new block into the render buffers.
+void RenderDelayBufferImpl::ResetForReuse() {
+  for (Block& block : blocks_.buffer) {
+    for (int band = 0; band < block.NumBands(); ++band) {
+      for (int ch = 0; ch < block.NumChannels(); ++ch) {
+        std::fill(block.begin(band, ch), block.end(band, ch), 0.f);
+      }
+    }
+  }
+  for (auto& spectra : spectra_.buffer) {
+    for (auto& channel_spectrum : spectra) {
+      channel_spectrum.fill(0.f);
+    }
+  }
+  for (auto& ffts : ffts_.buffer) {
+    for (FftData& channel_fft : ffts) {
+      channel_fft.Clear();
+    }
+  }
+  std::fill(low_rate_.buffer.begin(), low_rate_.buffer.end(), 0.f);
+  blocks_.write = 0;
+  spectra_.write = 0;
+  ffts_.write = 0;
+  low_rate_.write = 0;
+  echo_remover_buffer_.SetRenderActivity(false);
+  render_mixer_.Reset();
+  render_decimator_.Reset();
+  std::fill(render_ds_.begin(), render_ds_.end(), 0.f);
+  max_observed_jitter_ = 1;
+  capture_call_counter_ = 0;
+  render_call_counter_ = 0;
+  render_activity_ = false;
+  render_activity_counter_ = 0;
+  external_audio_buffer_delay_ = std::nullopt;
+  external_audio_buffer_delay_verified_after_reset_ = false;
+  Reset();
+}
+
+// Inserts a new block into the render buffers. The render products are copied
+// from `analyzed` if set.
 RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
-    const Block& block) {
+    const Block& block,
+    const AnalyzedRenderBlock* analyzed) {
   ++render_call_counter_;
   if (delay_) {
     if (!last_call_was_render_) {
@@ -233,7 +283,11 @@ RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
   }
 
   // Insert the new render block into the specified position.
-  InsertBlock(block, previous_write);
+  if (analyzed) {
+    InsertAnalyzedBlock(*analyzed);
+  } else {
+    InsertBlock(block, previous_write);
+  }
 
   if (event != BufferingEvent::kNone) {
     Reset();
@@ -380,14 +434,9 @@ void RenderDelayBufferImpl::AlignFromExternalDelay() {
   }
 }
 
-// Inserts a block into the render buffers.
-void RenderDelayBufferImpl::InsertBlock(const Block& block,
-                                        int previous_write) {
+// Copies a block into the block buffer and applies the render gain.
+void RenderDelayBufferImpl::CopyBlock(const Block& block) {
   auto& b = blocks_;
-  auto& lr = low_rate_;
-  auto& ds = render_ds_;
-  auto& f = ffts_;
-  auto& s = spectra_;
   const size_t num_bands = b.buffer[b.write].NumBands();
   const size_t num_render_channels = b.buffer[b.write].NumChannels();
   RTC_DCHECK_EQ(block.NumBands(), num_bands);
@@ -410,6 +459,17 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
       }
     }
   }
+}
+
+// Inserts a block into the render buffers.
+void RenderDelayBufferImpl::InsertBlock(const Block& block,
+                                        int previous_write) {
+  auto& b = blocks_;
+  auto& lr = low_rate_;
+  auto& ds = render_ds_;
+  auto& f = ffts_;
+  auto& s = spectra_;
+  CopyBlock(block);
 
   std::array<float, kBlockSize> downmixed_render;
   render_mixer_.ProduceOutput(b.buffer[b.write], downmixed_render);
@@ -426,6 +486,23 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
   }
 }
 
+// Inserts a block and its render products into the render buffers.
+void RenderDelayBufferImpl::InsertAnalyzedBlock(
+    const AnalyzedRenderBlock& analyzed) {
+  auto& lr = low_rate_;
+  auto& f = ffts_;
+  auto& s = spectra_;
+  CopyBlock(analyzed.block);
+
+  RTC_DCHECK_EQ(analyzed.fft.size(), f.buffer[f.write].size());
+  std::copy(analyzed.downsampled.rend() - sub_block_size_,
+            analyzed.downsampled.rend(), lr.buffer.begin() + lr.write);
+  std::copy(analyzed.fft.begin(), analyzed.fft.end(),
+            f.buffer[f.write].begin());
+  std::copy(analyzed.spectrum.begin(), analyzed.spectrum.end(),
+            s.buffer[s.write].begin());
+}
+
 bool RenderDelayBufferImpl::DetectActiveRender(
     rtc::ArrayView<const float> x) const {
   const float x_energy = std::inner_product(x.begin(), x.end(), x.begin(), 0.f);
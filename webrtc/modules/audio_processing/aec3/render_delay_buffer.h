@@ -17,6 +17,7 @@
 
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/analyzed_render_block.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 
@@ -41,9 +42,17 @@ class RenderDelayBuffer {
   // Resets the buffer alignment.
   virtual void Reset() = 0;
 
+  // Clears the buffered render signal and resets the buffer to the state of a
+  // new one.
+  virtual void ResetForReuse() = 0;
+
   // Inserts a block into the buffer.
   virtual BufferingEvent Insert(const Block& block) = 0;
 
+  // As Insert(), but copies the render products of the block instead of
+  // computing them.
+  virtual BufferingEvent InsertAnalyzed(const AnalyzedRenderBlock& block) = 0;
+
   // Updates the buffers one step based on the specified buffer delay. Returns
   // an enum indicating whether there was a special event that occurred.
   virtual BufferingEvent PrepareCaptureProcessing() = 0;
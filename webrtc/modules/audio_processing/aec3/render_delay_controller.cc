@@ -43,12 +43,14 @@ class RenderDelayControllerImpl final : public RenderDelayController {
 
   ~RenderDelayControllerImpl() override;
   void Reset(bool reset_delay_confidence) override;
+  void ResetForReuse() override;
   void LogRenderCall() override;
   std::optional<DelayEstimate> GetDelay(
       const DownsampledRenderBuffer& render_buffer,
       size_t render_delay_buffer_delay,
       const Block& capture) override;
   bool HasClockdrift() const override;
+  void ResumeFullDelaySearch() override;
 
  private:
   static std::atomic<int> instance_count_;
@@ -109,6 +111,12 @@ void RenderDelayControllerImpl::Reset(bool reset_delay_confidence) {
   }
 }
 
+void RenderDelayControllerImpl::ResetForReuse() {
+  Reset(/*reset_delay_confidence=*/true);
+  delay_estimator_.ResetForReuse();
+  capture_call_counter_ = 0;
+}
+
 void RenderDelayControllerImpl::LogRenderCall() {}
 
 std::optional<DelayEstimate> RenderDelayControllerImpl::GetDelay(
@@ -172,6 +180,10 @@ bool RenderDelayControllerImpl::HasClockdrift() const {
   return delay_estimator_.Clockdrift() != ClockdriftDetector::Level::kNone;
 }
 
+void RenderDelayControllerImpl::ResumeFullDelaySearch() {
+  delay_estimator_.ResumeFullSearch();
+}
+
 }  // namespace
 
 RenderDelayController* RenderDelayController::Create(
@@ -35,6 +35,9 @@ class RenderDelayController {
   // behavior is as if the call is restarted.
   virtual void Reset(bool reset_delay_confidence) = 0;
 
+  // Resets the delay controller to the state of a new one.
+  virtual void ResetForReuse() = 0;
+
   // Logs a render call.
   virtual void LogRenderCall() = 0;
 
@@ -46,6 +49,10 @@ class RenderDelayController {
 
   // Returns true if clockdrift has been detected.
   virtual bool HasClockdrift() const = 0;
+
+  // Searches the full delay range again after a change of the echo path, when
+  // the delay search has been restricted to the lags around the found delay.
+  virtual void ResumeFullDelaySearch() = 0;
 };
 }  // namespace webrtc
 
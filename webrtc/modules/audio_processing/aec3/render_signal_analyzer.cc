@@ -123,6 +123,12 @@ RenderSignalAnalyzer::RenderSignalAnalyzer(const EchoCanceller3Config& config)
 }
 RenderSignalAnalyzer::~RenderSignalAnalyzer() = default;
 
+void RenderSignalAnalyzer::Reset() {
+  narrow_band_counters_.fill(0);
+  narrow_peak_band_ = std::nullopt;
+  narrow_peak_counter_ = 0;
+}
+
 void RenderSignalAnalyzer::Update(
     const RenderBuffer& render_buffer,
     const std::optional<size_t>& delay_partitions) {
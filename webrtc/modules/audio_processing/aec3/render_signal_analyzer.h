@@ -50,6 +50,9 @@ class RenderSignalAnalyzer {
 
   std::optional<int> NarrowPeakBand() const { return narrow_peak_band_; }
 
+  // Resets the analysis to that of a new analyzer.
+  void Reset();
+
  private:
   const int strong_peak_freeze_duration_;
   std::array<size_t, kFftLengthBy2 - 1> narrow_band_counters_;
@@ -43,12 +43,12 @@ class ResidualEchoEstimator {
       rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> R2,
       rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> R2_unbounded);
 
- private:
-  enum class ReverbType { kLinear, kNonLinear };
-
   // Resets the state.
   void Reset();
 
+ private:
+  enum class ReverbType { kLinear, kNonLinear };
+
   // Updates estimate for the power of the stationary noise component in the
   // render signal.
   void UpdateRenderNoisePower(const RenderBuffer& render_buffer);
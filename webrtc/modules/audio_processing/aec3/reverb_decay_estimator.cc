@@ -93,7 +93,8 @@ ReverbDecayEstimator::ReverbDecayEstimator(const EchoCanceller3Config& config)
       late_reverb_start_(kEarlyReverbMinSizeBlocks),
       late_reverb_end_(kEarlyReverbMinSizeBlocks),
       previous_gains_(config.filter.refined.length_blocks, 0.f),
-      decay_(std::fabs(config.ep_strength.default_len)),
+      initial_decay_(std::fabs(config.ep_strength.default_len)),
+      decay_(initial_decay_),
       mild_decay_(std::fabs(config.ep_strength.nearend_len)) {
   RTC_DCHECK_GT(config.filter.refined.length_blocks,
                 static_cast<size_t>(kEarlyReverbMinSizeBlocks));
@@ -262,6 +263,31 @@ void ReverbDecayEstimator::AnalyzeFilter(rtc::ArrayView<const float> filter) {
   }
 }
 
+void ReverbDecayEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteFloat(decay_);
+}
+
+bool ReverbDecayEstimator::RestoreState(StateReader* reader) {
+  float decay;
+  if (!reader->ReadFloat(&decay) || decay < 0.f || decay > 1.f) {
+    return false;
+  }
+  if (use_adaptive_echo_decay_) {
+    decay_ = decay;
+  }
+  return true;
+}
+
+void ReverbDecayEstimator::Reset() {
+  ResetDecayEstimation();
+  early_reverb_estimator_.ResetForReuse();
+  late_reverb_start_ = kEarlyReverbMinSizeBlocks;
+  late_reverb_end_ = kEarlyReverbMinSizeBlocks;
+  std::fill(previous_gains_.begin(), previous_gains_.end(), 0.f);
+  decay_ = initial_decay_;
+  tail_gain_ = 0.f;
+}
+
 void ReverbDecayEstimator::Dump(ApmDataDumper* data_dumper) const {
   data_dumper->DumpRaw("aec3_reverb_decay", decay_);
   data_dumper->DumpRaw("aec3_reverb_tail_energy", tail_gain_);
@@ -319,6 +345,12 @@ void ReverbDecayEstimator::EarlyReverbLengthEstimator::Reset() {
   block_counter_ = 0;
 }
 
+void ReverbDecayEstimator::EarlyReverbLengthEstimator::ResetForReuse() {
+  Reset();
+  std::fill(numerators_smooth_.begin(), numerators_smooth_.end(), 0.f);
+  n_sections_ = 0;
+}
+
 void ReverbDecayEstimator::EarlyReverbLengthEstimator::Accumulate(
     float value,
     float smoothing) {
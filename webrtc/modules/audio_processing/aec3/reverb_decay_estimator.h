@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"  // kMaxAdaptiveFilter...
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -46,6 +47,14 @@ class ReverbDecayEstimator {
   // Dumps debug data.
   void Dump(ApmDataDumper* data_dumper) const;
 
+  // Saves and restores the decay estimate. The analysis of the filter restarts
+  // from the beginning after a restore.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
+  // Resets the decay estimate and the filter analysis, as in a new estimator.
+  void Reset();
+
  private:
   void EstimateDecay(rtc::ArrayView<const float> filter, int peak_block);
   void AnalyzeFilter(rtc::ArrayView<const float> filter);
@@ -83,6 +92,8 @@ class ReverbDecayEstimator {
 
     // Resets the estimator.
     void Reset();
+    // As Reset(), but also forgets the smoothed numerators.
+    void ResetForReuse();
     // Accumulates estimation data.
     void Accumulate(float value, float smoothing);
     // Estimates the size in blocks of the early reverb.
@@ -109,6 +120,7 @@ class ReverbDecayEstimator {
   int estimation_region_candidate_size_ = 0;
   bool estimation_region_identified_ = false;
   std::vector<float> previous_gains_;
+  const float initial_decay_;
   float decay_;
   float mild_decay_;
   float tail_gain_ = 0.f;
@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -39,6 +40,22 @@ class ReverbFrequencyResponse {
     return tail_response_;
   }
 
+  // Resets the frequency response estimate, as in a new estimator.
+  void Reset() {
+    average_decay_ = 0.f;
+    tail_response_.fill(0.f);
+  }
+
+  // Saves and restores the frequency response estimate.
+  void SaveState(StateWriter* writer) const {
+    writer->WriteFloat(average_decay_);
+    writer->WriteFloats(tail_response_);
+  }
+  bool RestoreState(StateReader* reader) {
+    return reader->ReadFloat(&average_decay_) &&
+           reader->ReadFloats(tail_response_);
+  }
+
  private:
   void Update(const std::vector<std::array<float, kFftLengthBy2Plus1>>&
                   frequency_response,
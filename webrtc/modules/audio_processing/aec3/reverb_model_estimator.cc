@@ -54,4 +54,32 @@ void ReverbModelEstimator::Update(
   }
 }
 
+void ReverbModelEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteSize(reverb_decay_estimators_.size());
+  for (size_t ch = 0; ch < reverb_decay_estimators_.size(); ++ch) {
+    reverb_decay_estimators_[ch]->SaveState(writer);
+    reverb_frequency_responses_[ch].SaveState(writer);
+  }
+}
+
+bool ReverbModelEstimator::RestoreState(StateReader* reader) {
+  if (!reader->ReadExpectedSize(reverb_decay_estimators_.size())) {
+    return false;
+  }
+  for (size_t ch = 0; ch < reverb_decay_estimators_.size(); ++ch) {
+    if (!reverb_decay_estimators_[ch]->RestoreState(reader) ||
+        !reverb_frequency_responses_[ch].RestoreState(reader)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ReverbModelEstimator::Reset() {
+  for (size_t ch = 0; ch < reverb_decay_estimators_.size(); ++ch) {
+    reverb_decay_estimators_[ch]->Reset();
+    reverb_frequency_responses_[ch].Reset();
+  }
+}
+
 }  // namespace webrtc
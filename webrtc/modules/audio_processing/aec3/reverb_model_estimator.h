@@ -21,6 +21,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"  // kFftLengthBy2Plus1
 #include "modules/audio_processing/aec3/reverb_decay_estimator.h"
 #include "modules/audio_processing/aec3/reverb_frequency_response.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -62,6 +63,13 @@ class ReverbModelEstimator {
     reverb_decay_estimators_[0]->Dump(data_dumper);
   }
 
+  // Saves and restores the reverb model of each capture channel.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
+  // Resets the reverb model of each capture channel, as in a new estimator.
+  void Reset();
+
  private:
   std::vector<std::unique_ptr<ReverbDecayEstimator>> reverb_decay_estimators_;
   std::vector<ReverbFrequencyResponse> reverb_frequency_responses_;
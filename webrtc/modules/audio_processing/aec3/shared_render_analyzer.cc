@@ -0,0 +1,304 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "modules/audio_processing/aec3/echo_canceller3.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Maximum number of blocks completed by a 10 ms frame.
+constexpr int kMaxBlocksPerFrame = 3;
+
+// Validates that echo cancellers with the two configs compute the same render
+// products.
+bool CompatibleRenderConfigs(const EchoCanceller3Config& a,
+                             const EchoCanceller3Config& b) {
+  const auto& mixing_a = a.delay.render_alignment_mixing;
+  const auto& mixing_b = b.delay.render_alignment_mixing;
+  return a.delay.down_sampling_factor == b.delay.down_sampling_factor &&
+         mixing_a.downmix == mixing_b.downmix &&
+         mixing_a.adaptive_selection == mixing_b.adaptive_selection &&
+         mixing_a.activity_power_threshold ==
+             mixing_b.activity_power_threshold &&
+         mixing_a.prefer_first_two_channels ==
+             mixing_b.prefer_first_two_channels &&
+         a.render_levels.render_power_gain_db ==
+             b.render_levels.render_power_gain_db &&
+         a.fft.use_pffft == b.fft.use_pffft &&
+         a.filter.high_pass_filter_echo_reference ==
+             b.filter.high_pass_filter_echo_reference &&
+         a.multi_channel.detect_stereo_content ==
+             b.multi_channel.detect_stereo_content &&
+         a.multi_channel.stereo_detection_threshold ==
+             b.multi_channel.stereo_detection_threshold &&
+         a.multi_channel.stereo_detection_timeout_threshold_seconds ==
+             b.multi_channel.stereo_detection_timeout_threshold_seconds &&
+         a.multi_channel.stereo_detection_hysteresis_seconds ==
+             b.multi_channel.stereo_detection_hysteresis_seconds;
+}
+
+// Sets up `sub_frame_view` for the sub-frame of `frame`, downmixing the frame
+// in the same way as EchoCanceller3 when it has more channels than the view.
+void FillSubFrameView(
+    bool proper_downmix_needed,
+    std::vector<std::vector<std::vector<float>>>* frame,
+    size_t sub_frame_index,
+    std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame_view) {
+  RTC_DCHECK_GE(1, sub_frame_index);
+  RTC_DCHECK_EQ(frame->size(), sub_frame_view->size());
+  const size_t offset = sub_frame_index * kSubFrameLength;
+  const size_t frame_num_channels = (*frame)[0].size();
+  const size_t sub_frame_num_channels = (*sub_frame_view)[0].size();
+  for (size_t band = 0; band < frame->size(); ++band) {
+    auto& band_frame = (*frame)[band];
+    if (frame_num_channels > sub_frame_num_channels && proper_downmix_needed) {
+      for (size_t ch = 1; ch < frame_num_channels; ++ch) {
+        for (size_t k = 0; k < kSubFrameLength; ++k) {
+          band_frame[0][offset + k] += band_frame[ch][offset + k];
+        }
+      }
+      const float one_by_num_channels = 1.0f / frame_num_channels;
+      for (size_t k = 0; k < kSubFrameLength; ++k) {
+        band_frame[0][offset + k] *= one_by_num_channels;
+      }
+    }
+    for (size_t ch = 0; ch < sub_frame_num_channels; ++ch) {
+      (*sub_frame_view)[band][ch] =
+          rtc::ArrayView<float>(&band_frame[ch][offset], kSubFrameLength);
+    }
+  }
+}
+
+}  // namespace
+
+SharedRenderAnalyzer::Frame::Frame(int num_bands, int num_channels)
+    : blocks(kMaxBlocksPerFrame,
+             AnalyzedRenderBlock(num_bands, num_channels)) {}
+
+SharedRenderAnalyzer::SharedRenderAnalyzer(
+    const EchoCanceller3Config& config,
+    const std::optional<EchoCanceller3Config>& multichannel_config,
+    int sample_rate_hz,
+    size_t num_render_channels)
+    : sample_rate_hz_(sample_rate_hz),
+      num_bands_(NumBandsForRate(sample_rate_hz)),
+      num_render_input_channels_(num_render_channels),
+      config_(AdjustConfig(config)),
+      multichannel_config_(multichannel_config),
+      optimization_(DetectOptimization()),
+      config_selector_(config_,
+                       multichannel_config_,
+                       num_render_input_channels_),
+      multichannel_content_detector_(
+          config_selector_.active_config().multi_channel.detect_stereo_content,
+          num_render_input_channels_,
+          config_selector_.active_config()
+              .multi_channel.stereo_detection_threshold,
+          config_selector_.active_config()
+              .multi_channel.stereo_detection_timeout_threshold_seconds,
+          config_selector_.active_config()
+              .multi_channel.stereo_detection_hysteresis_seconds),
+      render_frame_(num_bands_,
+                    std::vector<std::vector<float>>(
+                        num_render_input_channels_,
+                        std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
+      block_(num_bands_, num_render_input_channels_),
+      x_(num_bands_, num_render_input_channels_),
+      x_old_(num_bands_, num_render_input_channels_),
+      analyzed_frame_(rtc::make_ref_counted<Frame>(num_bands_,
+                                                   num_render_input_channels_)),
+      frames_(kRenderTransferQueueSizeFrames) {
+  for (auto& frame : frames_) {
+    frame =
+        rtc::make_ref_counted<Frame>(num_bands_, num_render_input_channels_);
+  }
+  if (config_selector_.active_config().filter.high_pass_filter_echo_reference) {
+    high_pass_filter_ =
+        std::make_unique<HighPassFilter>(16000, num_render_input_channels_);
+  }
+  Initialize();
+  MutexLock lock(&mutex_);
+  proper_multichannel_content_ =
+      multichannel_content_detector_.IsProperMultiChannelContentDetected();
+}
+
+SharedRenderAnalyzer::~SharedRenderAnalyzer() = default;
+
+bool SharedRenderAnalyzer::IsCompatible(
+    const EchoCanceller3Config& config,
+    const std::optional<EchoCanceller3Config>& multichannel_config,
+    int sample_rate_hz,
+    size_t num_render_channels) const {
+  if (sample_rate_hz != sample_rate_hz_ ||
+      num_render_channels != num_render_input_channels_ ||
+      multichannel_config.has_value() != multichannel_config_.has_value()) {
+    return false;
+  }
+  if (multichannel_config &&
+      !CompatibleRenderConfigs(*multichannel_config, *multichannel_config_)) {
+    return false;
+  }
+  return CompatibleRenderConfigs(AdjustConfig(config), config_);
+}
+
+void SharedRenderAnalyzer::Initialize() {
+  RTC_DCHECK_RUNS_SERIALIZED(&analysis_race_checker_);
+  const bool proper_multichannel_content =
+      multichannel_content_detector_.IsProperMultiChannelContentDetected();
+  config_selector_.Update(proper_multichannel_content);
+  const EchoCanceller3Config& config = config_selector_.active_config();
+  const int num_channels = proper_multichannel_content
+                               ? static_cast<int>(num_render_input_channels_)
+                               : 1;
+
+  // Restart the analysis like a newly created RenderDelayBuffer, which the
+  // echo cancellers create on the same frame.
+  render_blocker_ = std::make_unique<FrameBlocker>(num_bands_, num_channels);
+  sub_frame_view_ = std::vector<std::vector<rtc::ArrayView<float>>>(
+      num_bands_, std::vector<rtc::ArrayView<float>>(num_channels));
+  render_mixer_ = std::make_unique<AlignmentMixer>(
+      num_channels, config.delay.render_alignment_mixing);
+  const size_t down_sampling_factor = config.delay.down_sampling_factor;
+  sub_block_size_ = down_sampling_factor > 0
+                        ? kBlockSize / down_sampling_factor
+                        : kBlockSize;
+  render_decimator_ = std::make_unique<Decimator>(down_sampling_factor);
+  fft_ = std::make_unique<Aec3Fft>(Aec3Fft::SelectBackend(config));
+  render_linear_amplitude_gain_ =
+      std::pow(10.0f, config.render_levels.render_power_gain_db / 20.f);
+  block_.SetNumChannels(num_channels);
+  x_.SetNumChannels(num_channels);
+  x_old_.SetNumChannels(num_channels);
+}
+
+void SharedRenderAnalyzer::AnalyzeRender(const AudioBuffer& render) {
+  RTC_DCHECK_RUNS_SERIALIZED(&analysis_race_checker_);
+  RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, render.num_frames_per_band());
+  RTC_DCHECK_EQ(num_bands_, render.num_bands());
+  RTC_DCHECK_EQ(num_render_input_channels_, render.num_channels());
+  if (static_cast<size_t>(num_bands_) != render.num_bands()) {
+    return;
+  }
+
+  for (int band = 0; band < num_bands_; ++band) {
+    for (size_t channel = 0; channel < num_render_input_channels_; ++channel) {
+      const float* band_data = &render.split_bands_const(channel)[band][0];
+      std::copy(band_data, band_data + AudioBuffer::kSplitBandSize,
+                render_frame_[band][channel].begin());
+    }
+  }
+  if (high_pass_filter_) {
+    high_pass_filter_->Process(&render_frame_[0]);
+  }
+
+  if (multichannel_content_detector_.UpdateDetection(render_frame_)) {
+    Initialize();
+  }
+  const bool temporary_multichannel_content =
+      multichannel_content_detector_.IsTemporaryMultiChannelContentDetected();
+
+  // The frame that last left the ring is reused, unless a reader still holds
+  // it, which only happens if a reader lags by the whole ring.
+  if (!analyzed_frame_->HasOneRef()) {
+    analyzed_frame_ =
+        rtc::make_ref_counted<Frame>(num_bands_, num_render_input_channels_);
+  }
+  Frame& analyzed_frame = *analyzed_frame_;
+  int num_blocks = 0;
+  for (size_t sub_frame_index = 0; sub_frame_index < 2; ++sub_frame_index) {
+    FillSubFrameView(temporary_multichannel_content, &render_frame_,
+                     sub_frame_index, &sub_frame_view_);
+    render_blocker_->InsertSubFrameAndExtractBlock(sub_frame_view_, &block_);
+    AnalyzeBlock(block_, &analyzed_frame.blocks[num_blocks++]);
+  }
+  if (render_blocker_->IsBlockAvailable()) {
+    render_blocker_->ExtractBlock(&block_);
+    AnalyzeBlock(block_, &analyzed_frame.blocks[num_blocks++]);
+  }
+  const bool proper_multichannel_content =
+      multichannel_content_detector_.IsProperMultiChannelContentDetected();
+  analyzed_frame.num_blocks = num_blocks;
+  analyzed_frame.proper_multichannel_content = proper_multichannel_content;
+  analyzed_frame.temporary_multichannel_content =
+      temporary_multichannel_content;
+
+  MutexLock lock(&mutex_);
+  std::swap(frames_[num_published_frames_ % frames_.size()], analyzed_frame_);
+  ++num_published_frames_;
+  proper_multichannel_content_ = proper_multichannel_content;
+}
+
+// Computes the same products as RenderDelayBuffer::Insert().
+void SharedRenderAnalyzer::AnalyzeBlock(const Block& block,
+                                        AnalyzedRenderBlock* analyzed) {
+  // The published frames that are recycled may have another number of
+  // channels.
+  if (analyzed->fft.size() != static_cast<size_t>(block.NumChannels())) {
+    analyzed->SetNumChannels(block.NumChannels());
+  }
+  analyzed->block = block;
+  x_ = block;
+  if (render_linear_amplitude_gain_ != 1.f) {
+    for (int band = 0; band < x_.NumBands(); ++band) {
+      for (int ch = 0; ch < x_.NumChannels(); ++ch) {
+        for (float& sample : x_.View(band, ch)) {
+          sample *= render_linear_amplitude_gain_;
+        }
+      }
+    }
+  }
+
+  std::array<float, kBlockSize> downmixed_render;
+  render_mixer_->ProduceOutput(x_, downmixed_render);
+  render_decimator_->Decimate(
+      downmixed_render,
+      rtc::ArrayView<float>(analyzed->downsampled.data(), sub_block_size_));
+  for (int ch = 0; ch < x_.NumChannels(); ++ch) {
+    fft_->PaddedFft(x_.View(/*band=*/0, ch), x_old_.View(/*band=*/0, ch),
+                    &analyzed->fft[ch]);
+    analyzed->fft[ch].Spectrum(optimization_, analyzed->spectrum[ch]);
+  }
+  x_old_.Swap(x_);
+}
+
+int64_t SharedRenderAnalyzer::NextFrameIndex() const {
+  MutexLock lock(&mutex_);
+  return num_published_frames_;
+}
+
+bool SharedRenderAnalyzer::IsProperMultiChannelContentDetected() const {
+  MutexLock lock(&mutex_);
+  return proper_multichannel_content_;
+}
+
+rtc::scoped_refptr<const SharedRenderAnalyzer::Frame>
+SharedRenderAnalyzer::ReadFrame(int64_t* next_frame) const {
+  RTC_DCHECK(next_frame);
+  MutexLock lock(&mutex_);
+  if (*next_frame >= num_published_frames_) {
+    return nullptr;
+  }
+  const int64_t num_frames = static_cast<int64_t>(frames_.size());
+  *next_frame = std::max(*next_frame, num_published_frames_ - num_frames);
+  rtc::scoped_refptr<const Frame> frame = frames_[*next_frame % num_frames];
+  ++*next_frame;
+  return frame;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_SHARED_RENDER_ANALYZER_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_SHARED_RENDER_ANALYZER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/alignment_mixer.h"
+#include "modules/audio_processing/aec3/analyzed_render_block.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/config_selector.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/frame_blocker.h"
+#include "modules/audio_processing/aec3/multi_channel_content_detector.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/high_pass_filter.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Analyzes one render signal on behalf of many EchoCanceller3 instances, e.g.,
+// those of the sessions of an AudioProcessingBatch that share the same far-end
+// mix. The high-pass filtering of the echo reference, the multichannel content
+// detection, the framing into blocks, the render gain, the decimation for the
+// delay estimation and the render FFTs are done once per 10 ms frame, and the
+// results are published to the attached echo cancellers, which only copy them
+// into their render buffers. The products are the same as those the echo
+// cancellers compute themselves, as long as their render-side settings match
+// those of the analyzer (see IsCompatible()).
+//
+// The published frames are immutable and shared by reference with the readers,
+// so that the analyzer lock is only held to hand out a reference.
+//
+// AnalyzeRender() must be called from one thread at a time. ReadFrame() is
+// thread-safe and may be called concurrently by the readers.
+class SharedRenderAnalyzer
+    : public rtc::RefCountedNonVirtual<SharedRenderAnalyzer> {
+ public:
+  // Render products of one 10 ms frame.
+  struct Frame : public rtc::RefCountedNonVirtual<Frame> {
+    Frame(int num_bands, int num_channels);
+
+    // Whether no reader holds the frame, so that it can be reused.
+    using rtc::RefCountedNonVirtual<Frame>::HasOneRef;
+
+    bool proper_multichannel_content = false;
+    bool temporary_multichannel_content = false;
+    // Number of blocks, between 1 and 3, that the frame completed.
+    int num_blocks = 0;
+    std::vector<AnalyzedRenderBlock> blocks;
+  };
+
+  SharedRenderAnalyzer(
+      const EchoCanceller3Config& config,
+      const std::optional<EchoCanceller3Config>& multichannel_config,
+      int sample_rate_hz,
+      size_t num_render_channels);
+  SharedRenderAnalyzer(const SharedRenderAnalyzer&) = delete;
+  SharedRenderAnalyzer& operator=(const SharedRenderAnalyzer&) = delete;
+  ~SharedRenderAnalyzer();
+
+  // Returns whether an echo canceller created with the given arguments
+  // computes the same render products as the analyzer.
+  bool IsCompatible(
+      const EchoCanceller3Config& config,
+      const std::optional<EchoCanceller3Config>& multichannel_config,
+      int sample_rate_hz,
+      size_t num_render_channels) const;
+
+  // Analyzes and publishes the split-band domain render frame.
+  void AnalyzeRender(const AudioBuffer& render);
+
+  // Index of the next frame to be published, and multichannel content state
+  // of the last published frame. Used by a reader to start reading.
+  int64_t NextFrameIndex() const;
+  bool IsProperMultiChannelContentDetected() const;
+
+  // Returns the frame with index `*next_frame` and increments `*next_frame`.
+  // Returns null if the frame has not been published yet. If the reader has
+  // fallen behind by more than the number of frames kept, the oldest kept
+  // frame is returned instead. The reader releases the frame once it has
+  // buffered its products, so that the analyzer can recycle it.
+  rtc::scoped_refptr<const Frame> ReadFrame(int64_t* next_frame) const;
+
+ private:
+  // (Re-)Initializes the analysis for the current multichannel content state.
+  void Initialize();
+  void AnalyzeBlock(const Block& block, AnalyzedRenderBlock* analyzed);
+
+  const int sample_rate_hz_;
+  const int num_bands_;
+  const size_t num_render_input_channels_;
+  const EchoCanceller3Config config_;
+  const std::optional<EchoCanceller3Config> multichannel_config_;
+  const Aec3Optimization optimization_;
+
+  rtc::RaceChecker analysis_race_checker_;
+  ConfigSelector config_selector_ RTC_GUARDED_BY(analysis_race_checker_);
+  MultiChannelContentDetector multichannel_content_detector_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::unique_ptr<HighPassFilter> high_pass_filter_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::vector<std::vector<std::vector<float>>> render_frame_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::vector<std::vector<rtc::ArrayView<float>>> sub_frame_view_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::unique_ptr<FrameBlocker> render_blocker_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::unique_ptr<AlignmentMixer> render_mixer_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::unique_ptr<Decimator> render_decimator_
+      RTC_GUARDED_BY(analysis_race_checker_);
+  std::unique_ptr<Aec3Fft> fft_ RTC_GUARDED_BY(analysis_race_checker_);
+  size_t sub_block_size_ RTC_GUARDED_BY(analysis_race_checker_);
+  float render_linear_amplitude_gain_ RTC_GUARDED_BY(analysis_race_checker_);
+  Block block_ RTC_GUARDED_BY(analysis_race_checker_);
+  // Gained current and previous blocks.
+  Block x_ RTC_GUARDED_BY(analysis_race_checker_);
+  Block x_old_ RTC_GUARDED_BY(analysis_race_checker_);
+  // Frame being analyzed, swapped into `frames_` when it is published.
+  rtc::scoped_refptr<Frame> analyzed_frame_
+      RTC_GUARDED_BY(analysis_race_checker_);
+
+  mutable Mutex mutex_;
+  // Ring of the last kRenderTransferQueueSizeFrames published frames, which
+  // are not modified until they have left the ring and no reader holds them.
+  std::vector<rtc::scoped_refptr<Frame>> frames_ RTC_GUARDED_BY(mutex_);
+  int64_t num_published_frames_ RTC_GUARDED_BY(mutex_) = 0;
+  bool proper_multichannel_content_ RTC_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_SHARED_RENDER_ANALYZER_H_
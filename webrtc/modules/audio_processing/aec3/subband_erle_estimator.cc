@@ -99,6 +99,31 @@ void SubbandErleEstimator::Update(
   }
 }
 
+void SubbandErleEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteSize(erle_.size());
+  for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    writer->WriteFloats(erle_[ch]);
+    writer->WriteFloats(erle_onset_compensated_[ch]);
+    writer->WriteFloats(erle_unbounded_[ch]);
+    writer->WriteFloats(erle_during_onsets_[ch]);
+  }
+}
+
+bool SubbandErleEstimator::RestoreState(StateReader* reader) {
+  if (!reader->ReadExpectedSize(erle_.size())) {
+    return false;
+  }
+  for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    if (!reader->ReadFloats(erle_[ch]) ||
+        !reader->ReadFloats(erle_onset_compensated_[ch]) ||
+        !reader->ReadFloats(erle_unbounded_[ch]) ||
+        !reader->ReadFloats(erle_during_onsets_[ch])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void SubbandErleEstimator::Dump(
     const std::unique_ptr<ApmDataDumper>& data_dumper) const {
   data_dumper->DumpRaw("aec3_erle_onset", ErleDuringOnsets()[0]);
@@ -26,6 +26,13 @@ SubbandNearendDetector::SubbandNearendDetector(
       one_over_subband_length2_(
           1.f / (config_.subband2.high - config_.subband2.low + 1)) {}
 
+void SubbandNearendDetector::Reset() {
+  nearend_state_ = false;
+  for (aec3::MovingAverage& smoother : nearend_smoothers_) {
+    smoother.Reset();
+  }
+}
+
 void SubbandNearendDetector::Update(
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
         nearend_spectrum,
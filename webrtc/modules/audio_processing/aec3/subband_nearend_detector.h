@@ -38,6 +38,8 @@ class SubbandNearendDetector : public NearendDetector {
                   comfort_noise_spectrum,
               bool initial_state) override;
 
+  void Reset() override;
+
  private:
   const EchoCanceller3Config::Suppressor::SubbandNearendDetection config_;
   const size_t num_capture_channels_;
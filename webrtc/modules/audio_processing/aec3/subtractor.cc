@@ -66,13 +66,15 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
                        size_t num_render_channels,
                        size_t num_capture_channels,
                        ApmDataDumper* data_dumper,
-                       Aec3Optimization optimization)
-    : fft_(),
+                       Aec3Optimization optimization,
+                       ChannelWorkerPool* channel_worker_pool)
+    : fft_(Aec3Fft::SelectBackend(config)),
       data_dumper_(data_dumper),
       optimization_(optimization),
       config_(config),
       num_capture_channels_(num_capture_channels),
       use_coarse_filter_reset_hangover_(UseCoarseFilterResetHangover()),
+      channel_worker_pool_(channel_worker_pool),
       refined_filters_(num_capture_channels_),
       coarse_filter_(num_capture_channels_),
       refined_gains_(num_capture_channels_),
@@ -110,13 +112,13 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
         config_.filter.refined.length_blocks,
         config_.filter.refined_initial.length_blocks,
         config.filter.config_change_duration_blocks, num_render_channels,
-        optimization, data_dumper_);
+        optimization, fft_.backend(), data_dumper_);
 
     coarse_filter_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.coarse.length_blocks,
         config_.filter.coarse_initial.length_blocks,
         config.filter.config_change_duration_blocks, num_render_channels,
-        optimization, data_dumper_);
+        optimization, fft_.backend(), data_dumper_);
     refined_gains_[ch] = std::make_unique<RefinedFilterUpdateGain>(
         config_.filter.refined_initial,
         config_.filter.config_change_duration_blocks);
@@ -175,6 +177,79 @@ void Subtractor::ExitInitialState() {
   }
 }
 
+void Subtractor::Reset() {
+  const size_t impulse_response_size = GetTimeDomainLength(
+      std::max(config_.filter.refined_initial.length_blocks,
+               config_.filter.refined.length_blocks));
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    refined_filters_[ch]->Reset(config_.filter.refined_initial.length_blocks);
+    coarse_filter_[ch]->Reset(config_.filter.coarse_initial.length_blocks);
+    refined_gains_[ch]->Reset(config_.filter.refined_initial);
+    coarse_gains_[ch]->Reset(config_.filter.coarse_initial);
+    filter_misadjustment_estimators_[ch].Reset();
+    poor_coarse_filter_counters_[ch] = 0;
+    coarse_filter_reset_hangover_[ch] = 0;
+    for (auto& H2_k : refined_frequency_responses_[ch]) {
+      H2_k.fill(0.f);
+    }
+    refined_impulse_responses_[ch].assign(impulse_response_size, 0.f);
+  }
+  for (std::vector<float>& impulse_response : coarse_impulse_responses_) {
+    std::fill(impulse_response.begin(), impulse_response.end(), 0.f);
+  }
+}
+
+void Subtractor::SaveState(StateWriter* writer) const {
+  writer->WriteSize(num_capture_channels_);
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    refined_filters_[ch]->SaveState(writer);
+    writer->WriteSize(refined_impulse_responses_[ch].size());
+    writer->WriteFloats(refined_impulse_responses_[ch]);
+    refined_gains_[ch]->SaveState(writer);
+    coarse_filter_[ch]->SaveState(writer);
+  }
+}
+
+bool Subtractor::RestoreState(StateReader* reader, bool initial_state) {
+  if (!reader->ReadExpectedSize(num_capture_channels_)) {
+    return false;
+  }
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    if (initial_state) {
+      refined_gains_[ch]->SetConfig(config_.filter.refined_initial, true);
+      coarse_gains_[ch]->SetConfig(config_.filter.coarse_initial, true);
+    } else {
+      refined_gains_[ch]->SetConfig(config_.filter.refined, true);
+      coarse_gains_[ch]->SetConfig(config_.filter.coarse, true);
+    }
+    // The impulse response follows the length of the refined filter, which
+    // differs between the initial and the regular filter configs.
+    std::vector<float>& impulse_response = refined_impulse_responses_[ch];
+    size_t impulse_response_size;
+    if (!refined_filters_[ch]->RestoreState(reader) ||
+        !reader->ReadSize(&impulse_response_size,
+                          GetTimeDomainLength(std::max(
+                              config_.filter.refined_initial.length_blocks,
+                              config_.filter.refined.length_blocks)))) {
+      return false;
+    }
+    impulse_response.resize(impulse_response_size);
+    if (!reader->ReadFloats(impulse_response) ||
+        !refined_gains_[ch]->RestoreState(reader) ||
+        !coarse_filter_[ch]->RestoreState(reader)) {
+      return false;
+    }
+    if (!initial_state) {
+      // Resume any growth of the filters to their full length.
+      refined_filters_[ch]->SetSizePartitions(
+          config_.filter.refined.length_blocks, false);
+      coarse_filter_[ch]->SetSizePartitions(
+          config_.filter.coarse.length_blocks, false);
+    }
+  }
+  return true;
+}
+
 void Subtractor::Process(const RenderBuffer& render_buffer,
                          const Block& capture,
                          const RenderSignalAnalyzer& render_signal_analyzer,
@@ -202,8 +277,9 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_coarse);
   }
 
-  // Process all capture channels
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+  // Process all capture channels. Each channel only touches its own filters
+  // and output, so the channels may be processed in any order.
+  auto process_channel = [&](size_t ch) {
     SubtractorOutput& output = outputs[ch];
     rtc::ArrayView<const float> y = capture.View(/*band=*/0, ch);
     FftData& E_refined = output.E_refined;
@@ -270,9 +346,8 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     refined_filters_[ch]->ComputeFrequencyResponse(
         &refined_frequency_responses_[ch]);
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
+    if (ApmDataDumper::IsAvailable() && ch == 0) {
+      G_refined_ch0_ = G;
     }
 
     // Update the coarse filter.
@@ -305,23 +380,33 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
       coarse_filter_[ch]->Adapt(render_buffer, G);
     }
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
-      filter_misadjustment_estimators_[ch].Dump(data_dumper_);
-      DumpFilters();
+    if (ApmDataDumper::IsAvailable() && ch == 0) {
+      G_coarse_ch0_ = G;
     }
 
     std::for_each(e_refined.begin(), e_refined.end(),
                   [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
-
-    if (ch == 0) {
-      data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
-                            &e_refined[0], 16000, 1);
-      data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
-                            &e_coarse[0], 16000, 1);
+  };
+  if (channel_worker_pool_) {
+    channel_worker_pool_->ParallelFor(num_capture_channels_, process_channel);
+  } else {
+    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+      process_channel(ch);
     }
   }
+
+  // The data dumper is not thread-safe, so the first channel is dumped once
+  // all the channels have been processed.
+  data_dumper_->DumpRaw("aec3_subtractor_G_refined", G_refined_ch0_.re);
+  data_dumper_->DumpRaw("aec3_subtractor_G_refined", G_refined_ch0_.im);
+  data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G_coarse_ch0_.re);
+  data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G_coarse_ch0_.im);
+  filter_misadjustment_estimators_[0].Dump(data_dumper_);
+  DumpFilters();
+  data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
+                        &outputs[0].e_refined[0], 16000, 1);
+  data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
+                        &outputs[0].e_coarse[0], 16000, 1);
 }
 
 void Subtractor::FilterMisadjustmentEstimator::Update(
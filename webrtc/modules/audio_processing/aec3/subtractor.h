@@ -24,13 +24,16 @@
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/aec_state.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
 #include "modules/audio_processing/aec3/coarse_filter_update_gain.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
+#include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/refined_filter_update_gain.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -42,7 +45,8 @@ class Subtractor {
              size_t num_render_channels,
              size_t num_capture_channels,
              ApmDataDumper* data_dumper,
-             Aec3Optimization optimization);
+             Aec3Optimization optimization,
+             ChannelWorkerPool* channel_worker_pool);
   ~Subtractor();
   Subtractor(const Subtractor&) = delete;
   Subtractor& operator=(const Subtractor&) = delete;
@@ -59,6 +63,15 @@ class Subtractor {
   // Exits the initial state.
   void ExitInitialState();
 
+  // Resets the filters and their gains to the state of a new subtractor.
+  void Reset();
+
+  // Saves and restores the adaptive filters and the refined filter gain
+  // states. `initial_state` tells whether the restored echo canceller is in
+  // its initial state, which determines the filter adaptation configs.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader, bool initial_state);
+
   // Returns the block-wise frequency responses for the refined adaptive
   // filters.
   const std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>&
@@ -131,6 +144,7 @@ class Subtractor {
   const EchoCanceller3Config config_;
   const size_t num_capture_channels_;
   const bool use_coarse_filter_reset_hangover_;
+  ChannelWorkerPool* const channel_worker_pool_;
 
   std::vector<std::unique_ptr<AdaptiveFirFilter>> refined_filters_;
   std::vector<std::unique_ptr<AdaptiveFirFilter>> coarse_filter_;
@@ -143,6 +157,9 @@ class Subtractor {
       refined_frequency_responses_;
   std::vector<std::vector<float>> refined_impulse_responses_;
   std::vector<std::vector<float>> coarse_impulse_responses_;
+  // Filter gains of the first channel, kept for the debug dump.
+  FftData G_refined_ch0_;
+  FftData G_coarse_ch0_;
 };
 
 }  // namespace webrtc
@@ -62,15 +62,22 @@ const float kSqrtHanning[kFftLength] = {
 
 SuppressionFilter::SuppressionFilter(Aec3Optimization optimization,
                                      int sample_rate_hz,
-                                     size_t num_capture_channels)
+                                     size_t num_capture_channels,
+                                     Aec3Fft::Backend fft_backend)
     : optimization_(optimization),
       sample_rate_hz_(sample_rate_hz),
       num_capture_channels_(num_capture_channels),
-      fft_(),
+      fft_(fft_backend),
       e_output_old_(NumBandsForRate(sample_rate_hz_),
                     std::vector<std::array<float, kFftLengthBy2>>(
                         num_capture_channels_)) {
   RTC_DCHECK(ValidFullBandRate(sample_rate_hz_));
+  Reset();
+}
+
+SuppressionFilter::~SuppressionFilter() = default;
+
+void SuppressionFilter::Reset() {
   for (size_t b = 0; b < e_output_old_.size(); ++b) {
     for (size_t ch = 0; ch < e_output_old_[b].size(); ++ch) {
       e_output_old_[b][ch].fill(0.f);
@@ -78,8 +85,6 @@ SuppressionFilter::SuppressionFilter(Aec3Optimization optimization,
   }
 }
 
-SuppressionFilter::~SuppressionFilter() = default;
-
 void SuppressionFilter::ApplyGain(
     rtc::ArrayView<const FftData> comfort_noise,
     rtc::ArrayView<const FftData> comfort_noise_high_band,
@@ -25,7 +25,8 @@ class SuppressionFilter {
  public:
   SuppressionFilter(Aec3Optimization optimization,
                     int sample_rate_hz,
-                    size_t num_capture_channels_);
+                    size_t num_capture_channels_,
+                    Aec3Fft::Backend fft_backend);
   ~SuppressionFilter();
 
   SuppressionFilter(const SuppressionFilter&) = delete;
@@ -38,6 +39,9 @@ class SuppressionFilter {
                  rtc::ArrayView<const FftData> E_lowest_band,
                  Block* e);
 
+  // Zeroes the overlap memories, as in a new filter.
+  void Reset();
+
  private:
   const Aec3Optimization optimization_;
   const int sample_rate_hz_;
@@ -405,6 +405,19 @@ void SuppressionGain::GetGain(
                         dominant_nearend_detector_->IsNearendState());
 }
 
+void SuppressionGain::Reset() {
+  last_gain_.fill(1.f);
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    last_nearend_[ch].fill(0.f);
+    last_echo_[ch].fill(0.f);
+    nearend_smoothers_[ch].Reset();
+  }
+  low_render_detector_ = LowNoiseRenderDetector();
+  initial_state_ = true;
+  initial_state_change_counter_ = 0;
+  dominant_nearend_detector_->Reset();
+}
+
 void SuppressionGain::SetInitialState(bool state) {
   initial_state_ = state;
   if (state) {
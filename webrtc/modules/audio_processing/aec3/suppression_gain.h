@@ -64,6 +64,9 @@ class SuppressionGain {
   // Toggles the usage of the initial state.
   void SetInitialState(bool state);
 
+  // Resets the gain to the state of a new one.
+  void Reset();
+
  private:
   // Computes the gain to apply for the bands beyond the first band.
   float UpperBandsGain(
@@ -45,6 +45,8 @@ class TransparentModeImpl : public TransparentMode {
     prob_transparent_state_ = kInitialTransparentStateProbability;
   }
 
+  void ResetForReuse() override { Reset(); }
+
   void Update(int filter_delay_blocks,
               bool any_filter_consistent,
               bool any_filter_converged,
@@ -142,6 +144,18 @@ class LegacyTransparentModeImpl : public TransparentMode {
     }
   }
 
+  void ResetForReuse() override {
+    Reset();
+    capture_block_counter_ = 0;
+    transparency_activated_ = false;
+    active_blocks_since_sane_filter_ = kBlocksSinceConsistentEstimateInit;
+    sane_filter_observed_ = false;
+    finite_erl_recently_detected_ = false;
+    active_non_converged_sequence_size_ = 0;
+    num_converged_blocks_ = 0;
+    recent_convergence_during_activity_ = false;
+  }
+
   void Update(int filter_delay_blocks,
               bool any_filter_consistent,
               bool any_filter_converged,
@@ -33,6 +33,9 @@ class TransparentMode {
   // Resets the state of the detector.
   virtual void Reset() = 0;
 
+  // Resets the detector to the state of a new one.
+  virtual void ResetForReuse() = 0;
+
   // Updates the detection decision based on new data.
   virtual void Update(int filter_delay_blocks,
                       bool any_filter_consistent,
@@ -59,6 +59,7 @@ class VectorMath {
           x[j] = sqrtf(x[j]);
         }
       } break;
+      case Aec3Optimization::kAvx512:
       case Aec3Optimization::kAvx2:
         SqrtAVX2(x);
         break;
@@ -140,6 +141,7 @@ class VectorMath {
           z[j] = x[j] * y[j];
         }
       } break;
+      case Aec3Optimization::kAvx512:
       case Aec3Optimization::kAvx2:
         MultiplyAVX2(x, y, z);
         break;
@@ -192,6 +194,7 @@ class VectorMath {
         }
       } break;
 #endif
+      case Aec3Optimization::kAvx512:
       case Aec3Optimization::kAvx2:
         AccumulateAVX2(x, z);
         break;
@@ -0,0 +1,440 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/binary_aec_dump.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/base/nullability.h"
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump_config.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+using binary_aec_dump::AudioLayout;
+using binary_aec_dump::RecordHeader;
+using binary_aec_dump::RecordType;
+
+// Size above which the records are written to the file, which sets the size of
+// the batches in which the file is written.
+constexpr size_t kFileBatchSize = 1 << 18;
+
+// Interval at which the background thread looks for queued records.
+constexpr TimeDelta kPollInterval = TimeDelta::Millis(10);
+
+binary_aec_dump::StreamFormat ToStreamFormat(const StreamConfig& config) {
+  return {config.sample_rate_hz(), static_cast<int32_t>(config.num_channels())};
+}
+
+void CopyAudio(const AudioFrameView<const float>& src,
+               AudioLayout* layout,
+               std::vector<uint8_t>* buffer) {
+  *layout = {AudioLayout::kFloat, src.num_channels(),
+             src.samples_per_channel()};
+  buffer->resize(layout->num_bytes());
+  const size_t channel_size = src.samples_per_channel() * sizeof(float);
+  for (int ch = 0; ch < src.num_channels(); ++ch) {
+    memcpy(buffer->data() + ch * channel_size, src.channel(ch).data(),
+           channel_size);
+  }
+}
+
+void CopyAudio(const int16_t* data,
+               int num_channels,
+               int samples_per_channel,
+               AudioLayout* layout,
+               std::vector<uint8_t>* buffer) {
+  *layout = {AudioLayout::kInt16, num_channels, samples_per_channel};
+  buffer->resize(layout->num_bytes());
+  memcpy(buffer->data(), data, buffer->size());
+}
+
+}  // namespace
+
+BinaryAecDump::BinaryAecDump(FileWrapper file,
+                             int64_t max_log_size_bytes,
+                             size_t ring_size_bytes)
+    : ring_(ring_size_bytes),
+      capture_payload_(),
+      file_(std::move(file)),
+      max_log_size_bytes_(max_log_size_bytes) {
+  RTC_DCHECK(file_.is_open());
+  file_buffer_.reserve(2 * kFileBatchSize);
+
+  binary_aec_dump::FileHeader header = {};
+  memcpy(header.magic, binary_aec_dump::kMagic, sizeof(header.magic));
+  header.version = binary_aec_dump::kVersion;
+  header.byte_order = binary_aec_dump::kByteOrderMark;
+  if (max_log_size_bytes_ != -1 &&
+      static_cast<int64_t>(sizeof(header)) > max_log_size_bytes_) {
+    recording_stopped_.store(true);
+  } else if (!file_.Write(&header, sizeof(header))) {
+    RTC_LOG(LS_ERROR) << "Cannot write the AecDump file header.";
+    recording_stopped_.store(true);
+  } else {
+    log_size_bytes_ = sizeof(header);
+  }
+
+  // The writer only has to keep up on average, so it should not preempt the
+  // audio threads.
+  thread_ = rtc::PlatformThread::SpawnJoinable(
+      [this] { Run(); }, "aec_dump_writer",
+      rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kLow));
+}
+
+BinaryAecDump::~BinaryAecDump() {
+  stop_.store(true);
+  wake_up_.Set();
+  thread_.Finalize();
+}
+
+void BinaryAecDump::WriteInitMessage(const ProcessingConfig& api_format,
+                                     int64_t time_now_ms) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  // Make room for the capture audio, so that the capture stream records are
+  // assembled without allocations.
+  const auto max_num_bytes = [](const StreamConfig& config) {
+    return config.num_samples() * sizeof(float);
+  };
+  capture_input_.reserve(max_num_bytes(api_format.input_stream()));
+  capture_output_.reserve(max_num_bytes(api_format.output_stream()));
+
+  binary_aec_dump::InitPayload payload;
+  payload.time_ms = time_now_ms;
+  payload.input = ToStreamFormat(api_format.input_stream());
+  payload.output = ToStreamFormat(api_format.output_stream());
+  payload.reverse_input = ToStreamFormat(api_format.reverse_input_stream());
+  payload.reverse_output = ToStreamFormat(api_format.reverse_output_stream());
+  WriteRecord(RecordType::kInit, &payload, sizeof(payload));
+}
+
+void BinaryAecDump::AddCaptureStreamInput(
+    const AudioFrameView<const float>& src) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  CopyAudio(src, &capture_payload_.input, &capture_input_);
+}
+
+void BinaryAecDump::AddCaptureStreamOutput(
+    const AudioFrameView<const float>& src) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  CopyAudio(src, &capture_payload_.output, &capture_output_);
+}
+
+void BinaryAecDump::AddCaptureStreamInput(const int16_t* const data,
+                                          int num_channels,
+                                          int samples_per_channel) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  CopyAudio(data, num_channels, samples_per_channel, &capture_payload_.input,
+            &capture_input_);
+}
+
+void BinaryAecDump::AddCaptureStreamOutput(const int16_t* const data,
+                                           int num_channels,
+                                           int samples_per_channel) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  CopyAudio(data, num_channels, samples_per_channel, &capture_payload_.output,
+            &capture_output_);
+}
+
+void BinaryAecDump::AddAudioProcessingState(
+    const AudioProcessingState& state) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  capture_payload_.delay = state.delay;
+  capture_payload_.drift = state.drift;
+  capture_payload_.applied_input_volume = state.applied_input_volume.value_or(0);
+  capture_payload_.flags =
+      (state.keypress ? binary_aec_dump::CapturePayload::kKeypress : 0) |
+      (state.applied_input_volume
+           ? binary_aec_dump::CapturePayload::kHasAppliedInputVolume
+           : 0);
+}
+
+void BinaryAecDump::WriteCaptureStreamMessage() {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  RTC_DCHECK_EQ(capture_payload_.input.num_bytes(), capture_input_.size());
+  RTC_DCHECK_EQ(capture_payload_.output.num_bytes(), capture_output_.size());
+  RecordRing::Reservation reservation;
+  if (ReserveRecord(RecordType::kCapture,
+                    sizeof(capture_payload_) + capture_input_.size() +
+                        capture_output_.size(),
+                    &reservation)) {
+    ring_.Copy(&capture_payload_, sizeof(capture_payload_), &reservation);
+    ring_.Copy(capture_input_.data(), capture_input_.size(), &reservation);
+    ring_.Copy(capture_output_.data(), capture_output_.size(), &reservation);
+    ring_.Commit(reservation);
+  }
+  capture_payload_ = binary_aec_dump::CapturePayload();
+  capture_input_.clear();
+  capture_output_.clear();
+}
+
+void BinaryAecDump::WriteRenderStreamMessage(const int16_t* const data,
+                                             int num_channels,
+                                             int samples_per_channel) {
+  binary_aec_dump::RenderPayload payload;
+  payload.audio = {AudioLayout::kInt16, num_channels, samples_per_channel};
+  RecordRing::Reservation reservation;
+  if (ReserveRecord(RecordType::kRender,
+                    sizeof(payload) + payload.audio.num_bytes(),
+                    &reservation)) {
+    ring_.Copy(&payload, sizeof(payload), &reservation);
+    ring_.Copy(data, payload.audio.num_bytes(), &reservation);
+    ring_.Commit(reservation);
+  }
+}
+
+void BinaryAecDump::WriteRenderStreamMessage(
+    const AudioFrameView<const float>& src) {
+  binary_aec_dump::RenderPayload payload;
+  payload.audio = {AudioLayout::kFloat, src.num_channels(),
+                   src.samples_per_channel()};
+  RecordRing::Reservation reservation;
+  if (ReserveRecord(RecordType::kRender,
+                    sizeof(payload) + payload.audio.num_bytes(),
+                    &reservation)) {
+    ring_.Copy(&payload, sizeof(payload), &reservation);
+    for (int ch = 0; ch < src.num_channels(); ++ch) {
+      ring_.Copy(src.channel(ch).data(),
+                   src.samples_per_channel() * sizeof(float), &reservation);
+    }
+    ring_.Commit(reservation);
+  }
+}
+
+void BinaryAecDump::WriteRuntimeSetting(
+    const AudioProcessing::RuntimeSetting& runtime_setting) {
+  using Type = AudioProcessing::RuntimeSetting::Type;
+  binary_aec_dump::RuntimeSettingPayload payload = {};
+  payload.type = static_cast<int32_t>(runtime_setting.type());
+  switch (runtime_setting.type()) {
+    case Type::kCapturePreGain:
+    case Type::kCaptureCompressionGain:
+    case Type::kCaptureFixedPostGain:
+    case Type::kCustomRenderProcessingRuntimeSetting:
+    case Type::kCapturePostGain:
+      runtime_setting.GetFloat(&payload.float_value);
+      break;
+    case Type::kPlayoutVolumeChange: {
+      int value;
+      runtime_setting.GetInt(&value);
+      payload.int_value = value;
+      break;
+    }
+    case Type::kPlayoutAudioDeviceChange: {
+      AudioProcessing::RuntimeSetting::PlayoutAudioDeviceInfo info;
+      runtime_setting.GetPlayoutAudioDeviceInfo(&info);
+      payload.int_value = info.id;
+      payload.max_volume = info.max_volume;
+      break;
+    }
+    case Type::kCaptureOutputUsed: {
+      bool value;
+      runtime_setting.GetBool(&value);
+      payload.int_value = value ? 1 : 0;
+      break;
+    }
+    case Type::kNotSpecified:
+      RTC_DCHECK_NOTREACHED();
+      return;
+  }
+  WriteRecord(RecordType::kRuntimeSetting, &payload, sizeof(payload));
+}
+
+void BinaryAecDump::WriteConfig(const InternalAPMConfig& config) {
+  binary_aec_dump::ConfigPayload payload = {};
+  payload.aec_enabled = config.aec_enabled;
+  payload.aec_delay_agnostic_enabled = config.aec_delay_agnostic_enabled;
+  payload.aec_drift_compensation_enabled =
+      config.aec_drift_compensation_enabled;
+  payload.aec_extended_filter_enabled = config.aec_extended_filter_enabled;
+  payload.aec_suppression_level = config.aec_suppression_level;
+  payload.aecm_enabled = config.aecm_enabled;
+  payload.aecm_comfort_noise_enabled = config.aecm_comfort_noise_enabled;
+  payload.aecm_routing_mode = config.aecm_routing_mode;
+  payload.agc_enabled = config.agc_enabled;
+  payload.agc_mode = config.agc_mode;
+  payload.agc_limiter_enabled = config.agc_limiter_enabled;
+  payload.hpf_enabled = config.hpf_enabled;
+  payload.ns_enabled = config.ns_enabled;
+  payload.ns_level = config.ns_level;
+  payload.transient_suppression_enabled = config.transient_suppression_enabled;
+  payload.noise_robust_agc_enabled = config.noise_robust_agc_enabled;
+  payload.pre_amplifier_enabled = config.pre_amplifier_enabled;
+  payload.pre_amplifier_fixed_gain_factor =
+      config.pre_amplifier_fixed_gain_factor;
+  payload.experiments_description_size =
+      static_cast<uint32_t>(config.experiments_description.size());
+  // The configs are only recorded on changes, so the allocation is not on the
+  // per-frame path.
+  std::vector<uint8_t> full_config;
+  binary_aec_dump::WriteFullConfig(config, &full_config);
+  payload.full_config_size = static_cast<uint32_t>(full_config.size());
+
+  RecordRing::Reservation reservation;
+  if (ReserveRecord(RecordType::kConfig,
+                    sizeof(payload) + config.experiments_description.size() +
+                        full_config.size(),
+                    &reservation)) {
+    ring_.Copy(&payload, sizeof(payload), &reservation);
+    ring_.Copy(config.experiments_description.data(),
+               config.experiments_description.size(), &reservation);
+    ring_.Copy(full_config.data(), full_config.size(), &reservation);
+    ring_.Commit(reservation);
+  }
+}
+
+bool BinaryAecDump::ReserveRecord(RecordType type,
+                                  size_t num_bytes,
+                                  RecordRing::Reservation* reservation) {
+  if (recording_stopped_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  // Mark a gap in front of the record, so that the kDropped record is written
+  // where the records are missing.
+  const int64_t num_unmarked_dropped =
+      num_unmarked_dropped_.exchange(0, std::memory_order_relaxed);
+  const size_t marker_size =
+      num_unmarked_dropped > 0
+          ? sizeof(RecordHeader) + sizeof(binary_aec_dump::DroppedPayload)
+          : 0;
+  if (!ring_.Reserve(marker_size + sizeof(RecordHeader) + num_bytes,
+                     reservation)) {
+    num_unmarked_dropped_.fetch_add(num_unmarked_dropped + 1,
+                                    std::memory_order_relaxed);
+    return false;
+  }
+
+  if (marker_size > 0) {
+    const RecordHeader marker_header = {
+        RecordType::kDropped,
+        static_cast<uint32_t>(sizeof(binary_aec_dump::DroppedPayload))};
+    const binary_aec_dump::DroppedPayload dropped = {ring_.num_dropped()};
+    ring_.Copy(&marker_header, sizeof(marker_header), reservation);
+    ring_.Copy(&dropped, sizeof(dropped), reservation);
+  }
+  const RecordHeader header = {type, static_cast<uint32_t>(num_bytes)};
+  ring_.Copy(&header, sizeof(header), reservation);
+  return true;
+}
+
+void BinaryAecDump::WriteRecord(RecordType type,
+                                const void* payload,
+                                size_t num_bytes) {
+  RecordRing::Reservation reservation;
+  if (ReserveRecord(type, num_bytes, &reservation)) {
+    ring_.Copy(payload, num_bytes, &reservation);
+    ring_.Commit(reservation);
+  }
+}
+
+void BinaryAecDump::Run() {
+  while (!stop_.load()) {
+    if (!WriteQueuedRecords()) {
+      wake_up_.Wait(kPollInterval);
+    }
+  }
+  WriteQueuedRecords();
+  if (!file_.Close()) {
+    RTC_LOG(LS_ERROR) << "Cannot write the end of the AecDump file.";
+  }
+}
+
+bool BinaryAecDump::WriteQueuedRecords() {
+  bool records_written = false;
+  while (const size_t record_size = ring_.NextRecordSize()) {
+    for (size_t offset = 0; offset < record_size;) {
+      RecordHeader header;
+      ring_.Read(offset, &header, sizeof(header));
+      uint8_t* payload = AppendRecord(header);
+      if (payload) {
+        ring_.Read(offset + sizeof(header), payload, header.num_bytes);
+      }
+      offset += sizeof(header) + header.num_bytes;
+    }
+    // Release the record before the, possibly slow, file write.
+    ring_.Pop();
+
+    if (file_buffer_.size() >= kFileBatchSize) {
+      FlushFileBuffer();
+    }
+    records_written = true;
+  }
+  FlushFileBuffer();
+  return records_written;
+}
+
+uint8_t* BinaryAecDump::AppendRecord(const RecordHeader& header) {
+  const int64_t record_size = sizeof(header) + header.num_bytes;
+  if (recording_stopped_.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  if (max_log_size_bytes_ != -1 &&
+      log_size_bytes_ + record_size > max_log_size_bytes_) {
+    // Stop the recording, rather than leaving a gap in it.
+    recording_stopped_.store(true, std::memory_order_relaxed);
+    return nullptr;
+  }
+  log_size_bytes_ += record_size;
+  const size_t offset = file_buffer_.size();
+  file_buffer_.resize(offset + record_size);
+  memcpy(&file_buffer_[offset], &header, sizeof(header));
+  return &file_buffer_[offset + sizeof(header)];
+}
+
+void BinaryAecDump::FlushFileBuffer() {
+  if (file_buffer_.empty()) {
+    return;
+  }
+  if (!file_.Write(file_buffer_.data(), file_buffer_.size())) {
+    // Stop the recording, rather than leaving a gap in it.
+    RTC_LOG(LS_ERROR) << "Cannot write the AecDump file, stopping the "
+                         "recording.";
+    recording_stopped_.store(true, std::memory_order_relaxed);
+  }
+  file_buffer_.clear();
+}
+
+absl::Nullable<std::unique_ptr<AecDump>> AecDumpFactory::Create(
+    FileWrapper file,
+    int64_t max_log_size_bytes,
+    absl::Nonnull<TaskQueueBase*> worker_queue) {
+  // The file is written by a dedicated thread of the AecDump rather than on
+  // `worker_queue`, so that the real-time threads never wait for a queue.
+  if (!file.is_open()) {
+    return nullptr;
+  }
+  return std::make_unique<BinaryAecDump>(std::move(file), max_log_size_bytes);
+}
+
+absl::Nullable<std::unique_ptr<AecDump>> AecDumpFactory::Create(
+    absl::string_view file_name,
+    int64_t max_log_size_bytes,
+    absl::Nonnull<TaskQueueBase*> worker_queue) {
+  return Create(FileWrapper::OpenWriteOnly(file_name), max_log_size_bytes,
+                worker_queue);
+}
+
+absl::Nullable<std::unique_ptr<AecDump>> AecDumpFactory::Create(
+    absl::Nonnull<FILE*> handle,
+    int64_t max_log_size_bytes,
+    absl::Nonnull<TaskQueueBase*> worker_queue) {
+  return Create(FileWrapper(handle), max_log_size_bytes, worker_queue);
+}
+
+}  // namespace webrtc
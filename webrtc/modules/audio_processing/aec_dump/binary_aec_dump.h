@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "modules/audio_processing/aec_dump/binary_aec_dump_format.h"
+#include "modules/audio_processing/include/aec_dump.h"
+#include "modules/audio_processing/utility/record_ring.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// AecDump that records in the binary format of binary_aec_dump_format.h. The
+// Write* and Add* methods only copy the data into a preallocated ring buffer,
+// without locks or allocations, and a background thread writes the queued
+// records to the file in large batches. If the ring buffer is full, records
+// are dropped, and a kDropped record marks the gap in the file. If the file
+// cannot be written, the recording stops.
+class BinaryAecDump : public AecDump {
+ public:
+  // Holds about four seconds of 48 kHz stereo capture and render audio.
+  static constexpr size_t kDefaultRingSizeBytes = 1 << 22;
+
+  // `max_log_size_bytes == -1` means that the log size is unlimited. The
+  // recording stops at the first record that does not fit within the limit.
+  BinaryAecDump(FileWrapper file,
+                int64_t max_log_size_bytes,
+                size_t ring_size_bytes = kDefaultRingSizeBytes);
+  BinaryAecDump(const BinaryAecDump&) = delete;
+  BinaryAecDump& operator=(const BinaryAecDump&) = delete;
+  // Writes all queued records and closes the file before returning.
+  ~BinaryAecDump() override;
+
+  void WriteInitMessage(const ProcessingConfig& api_format,
+                        int64_t time_now_ms) override;
+  void AddCaptureStreamInput(const AudioFrameView<const float>& src) override;
+  void AddCaptureStreamOutput(const AudioFrameView<const float>& src) override;
+  void AddCaptureStreamInput(const int16_t* const data,
+                             int num_channels,
+                             int samples_per_channel) override;
+  void AddCaptureStreamOutput(const int16_t* const data,
+                              int num_channels,
+                              int samples_per_channel) override;
+  void AddAudioProcessingState(const AudioProcessingState& state) override;
+  void WriteCaptureStreamMessage() override;
+  void WriteRenderStreamMessage(const int16_t* const data,
+                                int num_channels,
+                                int samples_per_channel) override;
+  void WriteRenderStreamMessage(
+      const AudioFrameView<const float>& src) override;
+  void WriteRuntimeSetting(
+      const AudioProcessing::RuntimeSetting& runtime_setting) override;
+  void WriteConfig(const InternalAPMConfig& config) override;
+
+  // Returns the number of records that did not fit in the ring buffer.
+  int64_t num_dropped_records() const { return ring_.num_dropped(); }
+
+ private:
+  // Reserves a ring record for a record of type `type` with `num_bytes` bytes
+  // of payload, preceded by a kDropped record if records have been dropped
+  // since the last reserved one, and copies the headers into it. Returns false
+  // if the recording has stopped, or if there is no room for the record,
+  // which is then counted as dropped.
+  bool ReserveRecord(binary_aec_dump::RecordType type,
+                     size_t num_bytes,
+                     RecordRing::Reservation* reservation);
+  void WriteRecord(binary_aec_dump::RecordType type,
+                   const void* payload,
+                   size_t num_bytes);
+
+  void Run();
+  // Writes all the committed records. Returns whether any were written.
+  bool WriteQueuedRecords();
+  // Appends the header of a record to `file_buffer_` and returns where its
+  // payload is to be copied, or null if the recording has stopped or the
+  // record exceeds the size limit.
+  uint8_t* AppendRecord(const binary_aec_dump::RecordHeader& header);
+  // Writes `file_buffer_` to the file, and stops the recording if that fails.
+  void FlushFileBuffer();
+
+  // Each ring record holds one or two file records: the record written by a
+  // Write* call, preceded by a kDropped record when there was a gap before it.
+  RecordRing ring_;
+  // Number of dropped records that no kDropped record marks yet.
+  std::atomic<int64_t> num_unmarked_dropped_{0};
+  // Set when the recording has stopped, since the size limit has been reached
+  // or the file could not be written.
+  std::atomic<bool> recording_stopped_{false};
+
+  // Capture stream record being assembled.
+  rtc::RaceChecker capture_race_checker_;
+  binary_aec_dump::CapturePayload capture_payload_
+      RTC_GUARDED_BY(capture_race_checker_);
+  std::vector<uint8_t> capture_input_ RTC_GUARDED_BY(capture_race_checker_);
+  std::vector<uint8_t> capture_output_ RTC_GUARDED_BY(capture_race_checker_);
+
+  // Only accessed by the background thread, after construction.
+  FileWrapper file_;
+  const int64_t max_log_size_bytes_;
+  int64_t log_size_bytes_ = 0;
+  // Records that are written to the file in one batch.
+  std::vector<uint8_t> file_buffer_;
+
+  std::atomic<bool> stop_{false};
+  rtc::Event wake_up_;
+  rtc::PlatformThread thread_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_H_
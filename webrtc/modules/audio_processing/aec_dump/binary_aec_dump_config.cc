@@ -0,0 +1,363 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/binary_aec_dump_config.h"
+
+#include <stddef.h>
+
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "api/audio/audio_processing.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/utility/state_serializer.h"
+
+namespace webrtc {
+namespace binary_aec_dump {
+namespace {
+
+// The fields of the configs are listed once, by the Visit* functions below,
+// which hand every field to a FieldWriter or a FieldReader.
+class FieldWriter {
+ public:
+  explicit FieldWriter(std::vector<uint8_t>* data) : writer_(data) {}
+
+  void operator()(bool& value) { writer_.WriteBool(value); }
+  void operator()(int& value) { writer_.WriteInt(value); }
+  void operator()(size_t& value) { writer_.WriteSize(value); }
+  void operator()(float& value) { writer_.WriteFloat(value); }
+  template <typename Enum,
+            typename = std::enable_if_t<std::is_enum<Enum>::value>>
+  void operator()(Enum& value) {
+    writer_.WriteInt(static_cast<int>(value));
+  }
+
+ private:
+  StateWriter writer_;
+};
+
+class FieldReader {
+ public:
+  explicit FieldReader(rtc::ArrayView<const uint8_t> data) : reader_(data) {}
+
+  void operator()(bool& value) { reader_.ReadBool(&value); }
+  void operator()(int& value) { reader_.ReadInt(&value); }
+  void operator()(size_t& value) {
+    reader_.ReadSize(&value, std::numeric_limits<uint32_t>::max());
+  }
+  void operator()(float& value) { reader_.ReadFloat(&value); }
+  template <typename Enum,
+            typename = std::enable_if_t<std::is_enum<Enum>::value>>
+  void operator()(Enum& value) {
+    int int_value;
+    if (reader_.ReadInt(&int_value)) {
+      value = static_cast<Enum>(int_value);
+    }
+  }
+
+  bool Done() const { return reader_.Done(); }
+
+ private:
+  StateReader reader_;
+};
+
+template <typename Visitor>
+void VisitApmConfig(Visitor& v, AudioProcessing::Config& c) {
+  v(c.pipeline.maximum_internal_processing_rate);
+  v(c.pipeline.multi_channel_render);
+  v(c.pipeline.multi_channel_capture);
+  v(c.pipeline.capture_downmix_method);
+  v(c.pipeline.float_two_band_splitting);
+  v(c.pipeline.fma_three_band_splitting);
+
+  v(c.pre_amplifier.enabled);
+  v(c.pre_amplifier.fixed_gain_factor);
+
+  v(c.capture_level_adjustment.enabled);
+  v(c.capture_level_adjustment.pre_gain_factor);
+  v(c.capture_level_adjustment.post_gain_factor);
+  v(c.capture_level_adjustment.analog_mic_gain_emulation.enabled);
+  v(c.capture_level_adjustment.analog_mic_gain_emulation.initial_level);
+
+  v(c.high_pass_filter.enabled);
+  v(c.high_pass_filter.apply_in_full_band);
+
+  v(c.echo_canceller.enabled);
+  v(c.echo_canceller.mobile_mode);
+  v(c.echo_canceller.export_linear_aec_output);
+  v(c.echo_canceller.enforce_high_pass_filtering);
+  v(c.echo_canceller.capture_channel_worker_threads);
+  v(c.echo_canceller.use_pffft);
+
+  v(c.noise_suppression.enabled);
+  v(c.noise_suppression.level);
+  v(c.noise_suppression.analyze_linear_aec_output_when_available);
+  v(c.noise_suppression.use_pffft);
+
+  v(c.transient_suppression.enabled);
+
+  auto& agc1 = c.gain_controller1;
+  v(agc1.enabled);
+  v(agc1.mode);
+  v(agc1.target_level_dbfs);
+  v(agc1.compression_gain_db);
+  v(agc1.enable_limiter);
+  auto& analog = agc1.analog_gain_controller;
+  v(analog.enabled);
+  v(analog.startup_min_volume);
+  v(analog.clipped_level_min);
+  v(analog.enable_digital_adaptive);
+  v(analog.clipped_level_step);
+  v(analog.clipped_ratio_threshold);
+  v(analog.clipped_wait_frames);
+  auto& predictor = analog.clipping_predictor;
+  v(predictor.enabled);
+  v(predictor.mode);
+  v(predictor.window_length);
+  v(predictor.reference_window_length);
+  v(predictor.reference_window_delay);
+  v(predictor.clipping_threshold);
+  v(predictor.crest_factor_margin);
+  v(predictor.use_predicted_step);
+
+  auto& agc2 = c.gain_controller2;
+  v(agc2.enabled);
+  v(agc2.input_volume_controller.enabled);
+  v(agc2.adaptive_digital.enabled);
+  v(agc2.adaptive_digital.headroom_db);
+  v(agc2.adaptive_digital.max_gain_db);
+  v(agc2.adaptive_digital.initial_gain_db);
+  v(agc2.adaptive_digital.max_gain_change_db_per_second);
+  v(agc2.adaptive_digital.max_output_noise_level_dbfs);
+  v(agc2.fixed_digital.gain_db);
+  v(agc2.quantized_vad);
+  v(agc2.batched_vad);
+
+  v(c.stage_timing.enabled);
+  v(c.stage_timing.report_histograms);
+}
+
+template <typename Visitor>
+void VisitAlignmentMixing(
+    Visitor& v,
+    EchoCanceller3Config::Delay::AlignmentMixing& mixing) {
+  v(mixing.downmix);
+  v(mixing.adaptive_selection);
+  v(mixing.activity_power_threshold);
+  v(mixing.prefer_first_two_channels);
+}
+
+template <typename Visitor>
+void VisitRefinedFilter(
+    Visitor& v,
+    EchoCanceller3Config::Filter::RefinedConfiguration& filter) {
+  v(filter.length_blocks);
+  v(filter.leakage_converged);
+  v(filter.leakage_diverged);
+  v(filter.error_floor);
+  v(filter.error_ceil);
+  v(filter.noise_gate);
+}
+
+template <typename Visitor>
+void VisitCoarseFilter(
+    Visitor& v,
+    EchoCanceller3Config::Filter::CoarseConfiguration& filter) {
+  v(filter.length_blocks);
+  v(filter.rate);
+  v(filter.noise_gate);
+}
+
+template <typename Visitor>
+void VisitTuning(Visitor& v, EchoCanceller3Config::Suppressor::Tuning& tuning) {
+  for (auto* mask : {&tuning.mask_lf, &tuning.mask_hf}) {
+    v(mask->enr_transparent);
+    v(mask->enr_suppress);
+    v(mask->emr_transparent);
+  }
+  v(tuning.max_inc_factor);
+  v(tuning.max_dec_factor_lf);
+}
+
+template <typename Visitor>
+void VisitEchoCanceller3Config(Visitor& v, EchoCanceller3Config& c) {
+  v(c.buffering.excess_render_detection_interval_blocks);
+  v(c.buffering.max_allowed_excess_render_blocks);
+
+  auto& delay = c.delay;
+  v(delay.default_delay);
+  v(delay.down_sampling_factor);
+  v(delay.num_filters);
+  v(delay.delay_headroom_samples);
+  v(delay.hysteresis_limit_blocks);
+  v(delay.fixed_capture_delay_samples);
+  v(delay.delay_estimate_smoothing);
+  v(delay.delay_estimate_smoothing_delay_found);
+  v(delay.delay_candidate_detection_threshold);
+  v(delay.delay_selection_thresholds.initial);
+  v(delay.delay_selection_thresholds.converged);
+  v(delay.use_external_delay_estimator);
+  v(delay.log_warning_on_delay_changes);
+  VisitAlignmentMixing(v, delay.render_alignment_mixing);
+  VisitAlignmentMixing(v, delay.capture_alignment_mixing);
+  v(delay.detect_pre_echo);
+  v(delay.use_fft_matched_filter);
+  v(delay.hierarchical_search);
+
+  auto& filter = c.filter;
+  VisitRefinedFilter(v, filter.refined);
+  VisitCoarseFilter(v, filter.coarse);
+  VisitRefinedFilter(v, filter.refined_initial);
+  VisitCoarseFilter(v, filter.coarse_initial);
+  v(filter.config_change_duration_blocks);
+  v(filter.initial_state_seconds);
+  v(filter.coarse_reset_hangover_blocks);
+  v(filter.conservative_initial_phase);
+  v(filter.enable_coarse_filter_output_usage);
+  v(filter.use_linear_filter);
+  v(filter.high_pass_filter_echo_reference);
+  v(filter.export_linear_aec_output);
+
+  v(c.erle.min);
+  v(c.erle.max_l);
+  v(c.erle.max_h);
+  v(c.erle.onset_detection);
+  v(c.erle.num_sections);
+  v(c.erle.clamp_quality_estimate_to_zero);
+  v(c.erle.clamp_quality_estimate_to_one);
+
+  auto& ep_strength = c.ep_strength;
+  v(ep_strength.default_gain);
+  v(ep_strength.default_len);
+  v(ep_strength.nearend_len);
+  v(ep_strength.echo_can_saturate);
+  v(ep_strength.bounded_erl);
+  v(ep_strength.erle_onset_compensation_in_dominant_nearend);
+  v(ep_strength.use_conservative_tail_frequency_response);
+
+  auto& audibility = c.echo_audibility;
+  v(audibility.low_render_limit);
+  v(audibility.normal_render_limit);
+  v(audibility.floor_power);
+  v(audibility.audibility_threshold_lf);
+  v(audibility.audibility_threshold_mf);
+  v(audibility.audibility_threshold_hf);
+  v(audibility.use_stationarity_properties);
+  v(audibility.use_stationarity_properties_at_init);
+
+  v(c.render_levels.active_render_limit);
+  v(c.render_levels.poor_excitation_render_limit);
+  v(c.render_levels.poor_excitation_render_limit_ds8);
+  v(c.render_levels.render_power_gain_db);
+
+  v(c.echo_removal_control.has_clock_drift);
+  v(c.echo_removal_control.linear_and_stable_echo_path);
+
+  auto& echo_model = c.echo_model;
+  v(echo_model.noise_floor_hold);
+  v(echo_model.min_noise_floor_power);
+  v(echo_model.stationary_gate_slope);
+  v(echo_model.noise_gate_power);
+  v(echo_model.noise_gate_slope);
+  v(echo_model.render_pre_window_size);
+  v(echo_model.render_post_window_size);
+  v(echo_model.model_reverb_in_nonlinear_mode);
+
+  v(c.comfort_noise.noise_floor_dbfs);
+
+  auto& suppressor = c.suppressor;
+  v(suppressor.nearend_average_blocks);
+  VisitTuning(v, suppressor.normal_tuning);
+  VisitTuning(v, suppressor.nearend_tuning);
+  v(suppressor.lf_smoothing_during_initial_phase);
+  v(suppressor.last_permanent_lf_smoothing_band);
+  v(suppressor.last_lf_smoothing_band);
+  v(suppressor.last_lf_band);
+  v(suppressor.first_hf_band);
+  auto& dominant_nearend = suppressor.dominant_nearend_detection;
+  v(dominant_nearend.enr_threshold);
+  v(dominant_nearend.enr_exit_threshold);
+  v(dominant_nearend.snr_threshold);
+  v(dominant_nearend.hold_duration);
+  v(dominant_nearend.trigger_threshold);
+  v(dominant_nearend.use_during_initial_phase);
+  v(dominant_nearend.use_unbounded_echo_spectrum);
+  auto& subband_nearend = suppressor.subband_nearend_detection;
+  v(subband_nearend.nearend_average_blocks);
+  v(subband_nearend.subband1.low);
+  v(subband_nearend.subband1.high);
+  v(subband_nearend.subband2.low);
+  v(subband_nearend.subband2.high);
+  v(subband_nearend.nearend_threshold);
+  v(subband_nearend.snr_threshold);
+  v(suppressor.use_subband_nearend_detection);
+  auto& high_bands = suppressor.high_bands_suppression;
+  v(high_bands.enr_threshold);
+  v(high_bands.max_gain_during_echo);
+  v(high_bands.anti_howling_activation_threshold);
+  v(high_bands.anti_howling_gain);
+  v(suppressor.floor_first_increase);
+  v(suppressor.conservative_hf_suppression);
+
+  auto& multi_channel = c.multi_channel;
+  v(multi_channel.detect_stereo_content);
+  v(multi_channel.stereo_detection_threshold);
+  v(multi_channel.stereo_detection_timeout_threshold_seconds);
+  v(multi_channel.stereo_detection_hysteresis_seconds);
+  v(multi_channel.capture_channel_worker_threads);
+
+  v(c.fft.use_pffft);
+}
+
+template <typename Visitor>
+void VisitOptionalEchoCanceller3Config(
+    Visitor& v,
+    std::optional<EchoCanceller3Config>& config) {
+  bool has_config = config.has_value();
+  v(has_config);
+  if (has_config && !config) {
+    config.emplace();
+  } else if (!has_config) {
+    config = std::nullopt;
+  }
+  if (config) {
+    VisitEchoCanceller3Config(v, *config);
+  }
+}
+
+template <typename Visitor>
+void VisitFullConfig(Visitor& v, InternalAPMConfig& config) {
+  VisitApmConfig(v, config.config);
+  VisitOptionalEchoCanceller3Config(v, config.echo_canceller3_config);
+  VisitOptionalEchoCanceller3Config(
+      v, config.echo_canceller3_multichannel_config);
+}
+
+}  // namespace
+
+void WriteFullConfig(const InternalAPMConfig& config,
+                     std::vector<uint8_t>* data) {
+  // The visitors take mutable configs, so that the fields are only listed
+  // once for writing and reading.
+  InternalAPMConfig copy = config;
+  FieldWriter writer(data);
+  VisitFullConfig(writer, copy);
+}
+
+bool ReadFullConfig(rtc::ArrayView<const uint8_t> data,
+                    InternalAPMConfig* config) {
+  FieldReader reader(data);
+  VisitFullConfig(reader, *config);
+  return reader.Done();
+}
+
+}  // namespace binary_aec_dump
+}  // namespace webrtc
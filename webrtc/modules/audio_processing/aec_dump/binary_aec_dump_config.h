@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_CONFIG_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_CONFIG_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/include/aec_dump.h"
+
+namespace webrtc {
+namespace binary_aec_dump {
+
+// Appends the AudioProcessing config and the echo canceller configs of
+// `config` to `data`, field by field, in the layout of StateWriter.
+void WriteFullConfig(const InternalAPMConfig& config,
+                     std::vector<uint8_t>* data);
+
+// Reads the configs written by WriteFullConfig() into `config`. Returns false
+// if `data` is malformed, in which case `config` may be partially updated.
+bool ReadFullConfig(rtc::ArrayView<const uint8_t> data,
+                    InternalAPMConfig* config);
+
+}  // namespace binary_aec_dump
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_CONFIG_H_
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_FORMAT_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_FORMAT_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+namespace binary_aec_dump {
+
+// Binary alternative to the protobuf aec-dump format of debug.proto. A file
+// starts with a FileHeader, followed by records that each consist of a
+// RecordHeader and `num_bytes` bytes of payload. All values are stored in the
+// byte order of the recording machine, which is given by the FileHeader, and
+// the payloads are laid out as described for each record type below.
+
+constexpr char kMagic[4] = {'A', 'P', 'M', 'B'};
+constexpr uint32_t kVersion = 2;
+// Written as `byte_order` by the recording machine, and read as another value
+// if the byte order of the reading machine differs.
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t reserved;
+};
+static_assert(sizeof(FileHeader) == 16, "");
+
+enum class RecordType : uint32_t {
+  // InitPayload.
+  kInit = 1,
+  // CapturePayload, followed by the input and the output audio.
+  kCapture = 2,
+  // RenderPayload, followed by the audio.
+  kRender = 3,
+  // RuntimeSettingPayload.
+  kRuntimeSetting = 4,
+  // ConfigPayload, followed by `experiments_description_size` characters and
+  // `full_config_size` bytes written by WriteFullConfig().
+  kConfig = 5,
+  // DroppedPayload. Written where records are missing since the recorder
+  // could not keep up, right before the first record that follows them.
+  kDropped = 6,
+};
+
+struct RecordHeader {
+  RecordType type;
+  uint32_t num_bytes;
+};
+static_assert(sizeof(RecordHeader) == 8, "");
+
+struct StreamFormat {
+  int32_t sample_rate_hz;
+  int32_t num_channels;
+};
+
+struct InitPayload {
+  int64_t time_ms;
+  // In the order of ProcessingConfig::StreamName.
+  StreamFormat input;
+  StreamFormat output;
+  StreamFormat reverse_input;
+  StreamFormat reverse_output;
+};
+static_assert(sizeof(InitPayload) == 40, "");
+
+// Layout of the audio of the kCapture and kRender records. Float audio is
+// stored as `num_channels` consecutive channels of `samples_per_channel`
+// samples, and int16 audio as `samples_per_channel` interleaved frames.
+struct AudioLayout {
+  enum Format : int32_t { kNone = 0, kFloat = 1, kInt16 = 2 };
+  Format format;
+  int32_t num_channels;
+  int32_t samples_per_channel;
+
+  int32_t num_bytes() const {
+    return num_channels * samples_per_channel *
+           (format == kFloat ? 4 : format == kInt16 ? 2 : 0);
+  }
+};
+static_assert(sizeof(AudioLayout) == 12, "");
+
+struct CapturePayload {
+  enum Flags : uint32_t {
+    kKeypress = 1 << 0,
+    kHasAppliedInputVolume = 1 << 1,
+  };
+  int32_t delay;
+  int32_t drift;
+  int32_t applied_input_volume;
+  uint32_t flags;
+  AudioLayout input;
+  AudioLayout output;
+};
+static_assert(sizeof(CapturePayload) == 40, "");
+
+struct RenderPayload {
+  AudioLayout audio;
+};
+
+struct RuntimeSettingPayload {
+  // AudioProcessing::RuntimeSetting::Type.
+  int32_t type;
+  // Value of the setting, as given by the getter that matches its type. A
+  // PlayoutAudioDeviceInfo is stored as the id in `int_value` and the maximum
+  // volume in `max_volume`.
+  float float_value;
+  int32_t int_value;
+  int32_t max_volume;
+};
+static_assert(sizeof(RuntimeSettingPayload) == 16, "");
+
+// Fields of InternalAPMConfig. The complete configs are stored after the
+// experiments description, see binary_aec_dump_config.h.
+struct ConfigPayload {
+  uint8_t aec_enabled;
+  uint8_t aec_delay_agnostic_enabled;
+  uint8_t aec_drift_compensation_enabled;
+  uint8_t aec_extended_filter_enabled;
+  int32_t aec_suppression_level;
+  uint8_t aecm_enabled;
+  uint8_t aecm_comfort_noise_enabled;
+  uint8_t agc_enabled;
+  uint8_t agc_limiter_enabled;
+  int32_t aecm_routing_mode;
+  int32_t agc_mode;
+  uint8_t hpf_enabled;
+  uint8_t ns_enabled;
+  uint8_t transient_suppression_enabled;
+  uint8_t noise_robust_agc_enabled;
+  int32_t ns_level;
+  uint8_t pre_amplifier_enabled;
+  uint8_t reserved[3];
+  float pre_amplifier_fixed_gain_factor;
+  uint32_t experiments_description_size;
+  uint32_t full_config_size;
+};
+static_assert(sizeof(ConfigPayload) == 44, "");
+
+struct DroppedPayload {
+  // Total number of records dropped since the start of the recording.
+  int64_t num_dropped_records;
+};
+
+}  // namespace binary_aec_dump
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_FORMAT_H_
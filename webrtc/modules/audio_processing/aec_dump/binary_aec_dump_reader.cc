@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/binary_aec_dump_reader.h"
+
+#include <string.h>
+
+#include <cmath>
+#include <string>
+
+#include "modules/audio_processing/aec_dump/binary_aec_dump_config.h"
+
+namespace webrtc {
+namespace {
+
+using binary_aec_dump::AudioLayout;
+using binary_aec_dump::RecordType;
+
+// Copies the fixed-size part of the payload of `record`, and returns the rest
+// of the payload in `rest`. Returns false if the payload is too short.
+template <typename T>
+bool ReadFixedPart(const BinaryAecDumpReader::Record& record,
+                   RecordType type,
+                   T* fixed,
+                   rtc::ArrayView<const uint8_t>* rest) {
+  if (record.type != type || record.payload.size() < sizeof(T)) {
+    return false;
+  }
+  memcpy(fixed, record.payload.data(), sizeof(T));
+  *rest = record.payload.subview(sizeof(T));
+  return true;
+}
+
+bool ValidLayout(const AudioLayout& layout) {
+  return (layout.format == AudioLayout::kFloat ||
+          layout.format == AudioLayout::kInt16) &&
+         layout.num_channels > 0 && layout.num_channels <= 64 &&
+         layout.samples_per_channel > 0 &&
+         layout.samples_per_channel <= 3840;
+}
+
+bool ValidFormat(const binary_aec_dump::StreamFormat& format) {
+  return format.sample_rate_hz >= 0 && format.sample_rate_hz <= 384000 &&
+         format.num_channels >= 0 && format.num_channels <= 64;
+}
+
+}  // namespace
+
+BinaryAecDumpReader::BinaryAecDumpReader(rtc::ArrayView<const uint8_t> data)
+    : data_(data) {
+  binary_aec_dump::FileHeader header;
+  if (data_.size() < sizeof(header)) {
+    return;
+  }
+  memcpy(&header, data_.data(), sizeof(header));
+  valid_ = memcmp(header.magic, binary_aec_dump::kMagic,
+                  sizeof(header.magic)) == 0 &&
+           header.version == binary_aec_dump::kVersion &&
+           header.byte_order == binary_aec_dump::kByteOrderMark;
+  position_ = sizeof(header);
+}
+
+bool BinaryAecDumpReader::ReadRecord(Record* record) {
+  if (!valid_ || position_ == data_.size()) {
+    return false;
+  }
+  binary_aec_dump::RecordHeader header;
+  if (data_.size() - position_ < sizeof(header)) {
+    truncated_ = true;
+    return false;
+  }
+  memcpy(&header, &data_[position_], sizeof(header));
+  if (data_.size() - position_ - sizeof(header) < header.num_bytes) {
+    truncated_ = true;
+    return false;
+  }
+  record->type = header.type;
+  record->payload = data_.subview(position_ + sizeof(header), header.num_bytes);
+  position_ += sizeof(header) + header.num_bytes;
+  return true;
+}
+
+bool BinaryAecDumpReader::ParseInit(const Record& record,
+                                    binary_aec_dump::InitPayload* init) {
+  rtc::ArrayView<const uint8_t> rest;
+  return ReadFixedPart(record, RecordType::kInit, init, &rest) &&
+         ValidFormat(init->input) && ValidFormat(init->output) &&
+         ValidFormat(init->reverse_input) && ValidFormat(init->reverse_output);
+}
+
+bool BinaryAecDumpReader::ParseCapture(
+    const Record& record,
+    binary_aec_dump::CapturePayload* capture,
+    rtc::ArrayView<const uint8_t>* input,
+    rtc::ArrayView<const uint8_t>* output) {
+  rtc::ArrayView<const uint8_t> audio;
+  if (!ReadFixedPart(record, RecordType::kCapture, capture, &audio) ||
+      !ValidLayout(capture->input) || !ValidLayout(capture->output)) {
+    return false;
+  }
+  const size_t input_size = capture->input.num_bytes();
+  const size_t output_size = capture->output.num_bytes();
+  if (audio.size() != input_size + output_size) {
+    return false;
+  }
+  *input = audio.subview(0, input_size);
+  *output = audio.subview(input_size, output_size);
+  return true;
+}
+
+bool BinaryAecDumpReader::ParseRender(const Record& record,
+                                      binary_aec_dump::RenderPayload* render,
+                                      rtc::ArrayView<const uint8_t>* audio) {
+  return ReadFixedPart(record, RecordType::kRender, render, audio) &&
+         ValidLayout(render->audio) &&
+         audio->size() == static_cast<size_t>(render->audio.num_bytes());
+}
+
+bool BinaryAecDumpReader::ParseRuntimeSetting(
+    const Record& record,
+    AudioProcessing::RuntimeSetting* runtime_setting) {
+  using Setting = AudioProcessing::RuntimeSetting;
+  binary_aec_dump::RuntimeSettingPayload payload;
+  rtc::ArrayView<const uint8_t> rest;
+  if (!ReadFixedPart(record, RecordType::kRuntimeSetting, &payload, &rest)) {
+    return false;
+  }
+  switch (static_cast<Setting::Type>(payload.type)) {
+    case Setting::Type::kCapturePreGain:
+      *runtime_setting = Setting::CreateCapturePreGain(payload.float_value);
+      return true;
+    case Setting::Type::kCaptureCompressionGain: {
+      const int gain_db = static_cast<int>(std::lround(payload.float_value));
+      if (gain_db < 0 || gain_db > 90) {
+        return false;
+      }
+      *runtime_setting = Setting::CreateCompressionGainDb(gain_db);
+      return true;
+    }
+    case Setting::Type::kCaptureFixedPostGain:
+      if (!(payload.float_value >= 0.f && payload.float_value <= 90.f)) {
+        return false;
+      }
+      *runtime_setting =
+          Setting::CreateCaptureFixedPostGain(payload.float_value);
+      return true;
+    case Setting::Type::kPlayoutVolumeChange:
+      *runtime_setting = Setting::CreatePlayoutVolumeChange(payload.int_value);
+      return true;
+    case Setting::Type::kCustomRenderProcessingRuntimeSetting:
+      *runtime_setting = Setting::CreateCustomRenderSetting(payload.float_value);
+      return true;
+    case Setting::Type::kPlayoutAudioDeviceChange:
+      *runtime_setting = Setting::CreatePlayoutAudioDeviceChange(
+          {payload.int_value, payload.max_volume});
+      return true;
+    case Setting::Type::kCapturePostGain:
+      *runtime_setting = Setting::CreateCapturePostGain(payload.float_value);
+      return true;
+    case Setting::Type::kCaptureOutputUsed:
+      *runtime_setting =
+          Setting::CreateCaptureOutputUsedSetting(payload.int_value != 0);
+      return true;
+    case Setting::Type::kNotSpecified:
+      break;
+  }
+  return false;
+}
+
+bool BinaryAecDumpReader::ParseConfig(const Record& record,
+                                      InternalAPMConfig* config) {
+  binary_aec_dump::ConfigPayload payload;
+  rtc::ArrayView<const uint8_t> rest;
+  if (!ReadFixedPart(record, RecordType::kConfig, &payload, &rest) ||
+      rest.size() != static_cast<size_t>(payload.experiments_description_size) +
+                         payload.full_config_size) {
+    return false;
+  }
+  const rtc::ArrayView<const uint8_t> description =
+      rest.subview(0, payload.experiments_description_size);
+  if (!binary_aec_dump::ReadFullConfig(
+          rest.subview(payload.experiments_description_size), config)) {
+    return false;
+  }
+  config->aec_enabled = payload.aec_enabled;
+  config->aec_delay_agnostic_enabled = payload.aec_delay_agnostic_enabled;
+  config->aec_drift_compensation_enabled =
+      payload.aec_drift_compensation_enabled;
+  config->aec_extended_filter_enabled = payload.aec_extended_filter_enabled;
+  config->aec_suppression_level = payload.aec_suppression_level;
+  config->aecm_enabled = payload.aecm_enabled;
+  config->aecm_comfort_noise_enabled = payload.aecm_comfort_noise_enabled;
+  config->aecm_routing_mode = payload.aecm_routing_mode;
+  config->agc_enabled = payload.agc_enabled;
+  config->agc_mode = payload.agc_mode;
+  config->agc_limiter_enabled = payload.agc_limiter_enabled;
+  config->hpf_enabled = payload.hpf_enabled;
+  config->ns_enabled = payload.ns_enabled;
+  config->ns_level = payload.ns_level;
+  config->transient_suppression_enabled = payload.transient_suppression_enabled;
+  config->noise_robust_agc_enabled = payload.noise_robust_agc_enabled;
+  config->pre_amplifier_enabled = payload.pre_amplifier_enabled;
+  config->pre_amplifier_fixed_gain_factor =
+      payload.pre_amplifier_fixed_gain_factor;
+  config->experiments_description.assign(
+      reinterpret_cast<const char*>(description.data()), description.size());
+  return true;
+}
+
+bool BinaryAecDumpReader::ParseDropped(
+    const Record& record,
+    binary_aec_dump::DroppedPayload* dropped) {
+  rtc::ArrayView<const uint8_t> rest;
+  return ReadFixedPart(record, RecordType::kDropped, dropped, &rest);
+}
+
+}  // namespace webrtc
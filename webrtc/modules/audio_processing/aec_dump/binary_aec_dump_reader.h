@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_READER_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "api/audio/audio_processing.h"
+#include "modules/audio_processing/aec_dump/binary_aec_dump_format.h"
+#include "modules/audio_processing/include/aec_dump.h"
+
+namespace webrtc {
+
+// Reads the records of a recording made by BinaryAecDump from memory. The
+// reader does not copy the data, which must outlive it and the records read.
+class BinaryAecDumpReader {
+ public:
+  struct Record {
+    binary_aec_dump::RecordType type;
+    rtc::ArrayView<const uint8_t> payload;
+  };
+
+  explicit BinaryAecDumpReader(rtc::ArrayView<const uint8_t> data);
+
+  // Returns whether the data starts with the file header of a recording of a
+  // supported version, made on a machine with the same byte order.
+  bool valid() const { return valid_; }
+
+  // Reads the next record. Returns false at the end of the data, or if the
+  // rest of the data does not hold a complete record.
+  bool ReadRecord(Record* record);
+
+  // Returns whether the reading stopped at an incomplete record, e.g., since
+  // the recording was interrupted.
+  bool truncated() const { return truncated_; }
+
+  // Decode the payload of a record of the matching type. Return false if the
+  // payload is malformed. The audio is returned in the layout described by
+  // binary_aec_dump::AudioLayout, and is not necessarily aligned.
+  static bool ParseInit(const Record& record,
+                        binary_aec_dump::InitPayload* init);
+  static bool ParseCapture(const Record& record,
+                           binary_aec_dump::CapturePayload* capture,
+                           rtc::ArrayView<const uint8_t>* input,
+                           rtc::ArrayView<const uint8_t>* output);
+  static bool ParseRender(const Record& record,
+                          binary_aec_dump::RenderPayload* render,
+                          rtc::ArrayView<const uint8_t>* audio);
+  static bool ParseRuntimeSetting(
+      const Record& record,
+      AudioProcessing::RuntimeSetting* runtime_setting);
+  static bool ParseConfig(const Record& record, InternalAPMConfig* config);
+  static bool ParseDropped(const Record& record,
+                           binary_aec_dump::DroppedPayload* dropped);
+
+ private:
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t position_ = 0;
+  bool valid_ = false;
+  bool truncated_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_BINARY_AEC_DUMP_READER_H_
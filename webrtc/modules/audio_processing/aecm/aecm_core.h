@@ -18,6 +18,7 @@ extern "C" {
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 }
 #include "modules/audio_processing/aecm/aecm_defines.h"
+#include "rtc_base/system/arch.h"
 
 struct RealFFT;
 
@@ -403,8 +404,53 @@ typedef void (*ResetAdaptiveChannel)(AecmCore* aecm);
 extern ResetAdaptiveChannel WebRtcAecm_ResetAdaptiveChannel;
 
 // For the above function pointers, functions for generic platforms are declared
-// and defined as static in file aecm_core.c, while those for ARM Neon platforms
-// are declared below and defined in file aecm_core_neon.c.
+// below and defined in file aecm_core.cc, so that they can be benchmarked
+// against the optimized versions. Those for ARM Neon platforms are defined in
+// file aecm_core_neon.c, and the x86 versions in aecm_core_sse2.cc and
+// aecm_core_avx2.cc.
+void WebRtcAecm_CalcLinearEnergiesC(AecmCore* aecm,
+                                    const uint16_t* far_spectrum,
+                                    int32_t* echo_est,
+                                    uint32_t* far_energy,
+                                    uint32_t* echo_energy_adapt,
+                                    uint32_t* echo_energy_stored);
+
+void WebRtcAecm_StoreAdaptiveChannelC(AecmCore* aecm,
+                                      const uint16_t* far_spectrum,
+                                      int32_t* echo_est);
+
+void WebRtcAecm_ResetAdaptiveChannelC(AecmCore* aecm);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+void WebRtcAecm_CalcLinearEnergiesSse2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored);
+
+void WebRtcAecm_StoreAdaptiveChannelSse2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est);
+
+void WebRtcAecm_ResetAdaptiveChannelSse2(AecmCore* aecm);
+#endif
+
+void WebRtcAecm_CalcLinearEnergiesAvx2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored);
+
+void WebRtcAecm_StoreAdaptiveChannelAvx2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est);
+
+void WebRtcAecm_ResetAdaptiveChannelAvx2(AecmCore* aecm);
+#endif
+
 #if defined(WEBRTC_HAS_NEON)
 void WebRtcAecm_CalcLinearEnergiesNeon(AecmCore* aecm,
                                        const uint16_t* far_spectrum,
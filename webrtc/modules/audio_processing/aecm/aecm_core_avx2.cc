@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_processing/aecm/aecm_core.h"
+
+// AVX2 versions of the functions of aecm_core.cc that are called through
+// function pointers, bit-exact with the C versions.
+
+namespace webrtc {
+
+namespace {
+
+// Computes the 32-bit products WEBRTC_SPL_MUL_16_U16(a[k], b[k]) of the
+// sixteen signed `a` and unsigned `b` values, as two vectors of eight
+// products in order.
+inline void MultiplySignedUnsigned(__m256i a,
+                                   __m256i b,
+                                   __m256i* low,
+                                   __m256i* high) {
+  const __m256i product_low = _mm256_mullo_epi16(a, b);
+  // The high half of the unsigned product, corrected for negative `a`.
+  const __m256i product_high = _mm256_sub_epi16(
+      _mm256_mulhi_epu16(a, b), _mm256_and_si256(_mm256_srai_epi16(a, 15), b));
+  // The unpacking works within each 128-bit half, so the halves are swapped
+  // back in order afterwards.
+  const __m256i products_0 = _mm256_unpacklo_epi16(product_low, product_high);
+  const __m256i products_1 = _mm256_unpackhi_epi16(product_low, product_high);
+  *low = _mm256_permute2x128_si256(products_0, products_1, 0x20);
+  *high = _mm256_permute2x128_si256(products_0, products_1, 0x31);
+}
+
+inline uint32_t AddLanes(__m256i v256) {
+  __m128i v = _mm_add_epi32(_mm256_castsi256_si128(v256),
+                            _mm256_extracti128_si256(v256, 1));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+}  // namespace
+
+void WebRtcAecm_CalcLinearEnergiesAvx2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i far_energy_v = zero;
+  __m256i echo_adapt_v = zero;
+  __m256i echo_stored_v = zero;
+
+  // The sums wrap around like the 32-bit sums of the C version, and their
+  // order does not matter.
+  for (int i = 0; i < PART_LEN; i += 16) {
+    const __m256i spectrum_v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&far_spectrum[i]));
+    const __m256i stored_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelStored[i]));
+    const __m256i adapt_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelAdapt16[i]));
+
+    far_energy_v = _mm256_add_epi32(far_energy_v,
+                                    _mm256_unpacklo_epi16(spectrum_v, zero));
+    far_energy_v = _mm256_add_epi32(far_energy_v,
+                                    _mm256_unpackhi_epi16(spectrum_v, zero));
+
+    __m256i low, high;
+    MultiplySignedUnsigned(stored_v, spectrum_v, &low, &high);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i]), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i + 8]), high);
+    echo_stored_v =
+        _mm256_add_epi32(echo_stored_v, _mm256_add_epi32(low, high));
+
+    MultiplySignedUnsigned(adapt_v, spectrum_v, &low, &high);
+    echo_adapt_v = _mm256_add_epi32(echo_adapt_v, _mm256_add_epi32(low, high));
+  }
+
+  *far_energy += AddLanes(far_energy_v);
+  *echo_energy_stored += AddLanes(echo_stored_v);
+  *echo_energy_adapt += AddLanes(echo_adapt_v);
+
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+  *echo_energy_stored += (uint32_t)echo_est[PART_LEN];
+  *far_energy += (uint32_t)far_spectrum[PART_LEN];
+  *echo_energy_adapt += aecm->channelAdapt16[PART_LEN] * far_spectrum[PART_LEN];
+}
+
+void WebRtcAecm_StoreAdaptiveChannelAvx2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est) {
+  for (int i = 0; i < PART_LEN; i += 16) {
+    const __m256i spectrum_v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&far_spectrum[i]));
+    const __m256i adapt_v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&aecm->channelAdapt16[i]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&aecm->channelStored[i]),
+                        adapt_v);
+
+    __m256i low, high;
+    MultiplySignedUnsigned(adapt_v, spectrum_v, &low, &high);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i]), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&echo_est[i + 8]), high);
+  }
+  aecm->channelStored[PART_LEN] = aecm->channelAdapt16[PART_LEN];
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+}
+
+void WebRtcAecm_ResetAdaptiveChannelAvx2(AecmCore* aecm) {
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt16[i]),
+                     stored_v);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(&aecm->channelAdapt32[i]),
+        _mm256_slli_epi32(_mm256_cvtepi16_epi32(stored_v), 16));
+  }
+  aecm->channelAdapt16[PART_LEN] = aecm->channelStored[PART_LEN];
+  aecm->channelAdapt32[PART_LEN] = (int32_t)aecm->channelStored[PART_LEN] << 16;
+}
+
+}  // namespace webrtc
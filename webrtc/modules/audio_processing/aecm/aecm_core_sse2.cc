@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_processing/aecm/aecm_core.h"
+
+// SSE2 versions of the functions of aecm_core.cc that are called through
+// function pointers. Unlike the NEON versions, the channels are multiplied as
+// signed values, so that the results are bit-exact with the C versions for all
+// inputs.
+
+namespace webrtc {
+
+namespace {
+
+// Computes the 32-bit products WEBRTC_SPL_MUL_16_U16(a[k], b[k]) of the eight
+// signed `a` and unsigned `b` values, as two vectors of four products.
+inline void MultiplySignedUnsigned(__m128i a,
+                                   __m128i b,
+                                   __m128i* low,
+                                   __m128i* high) {
+  const __m128i product_low = _mm_mullo_epi16(a, b);
+  // The high half of the unsigned product, corrected for negative `a`.
+  const __m128i product_high = _mm_sub_epi16(
+      _mm_mulhi_epu16(a, b), _mm_and_si128(_mm_srai_epi16(a, 15), b));
+  *low = _mm_unpacklo_epi16(product_low, product_high);
+  *high = _mm_unpackhi_epi16(product_low, product_high);
+}
+
+inline uint32_t AddLanes(__m128i v) {
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+}  // namespace
+
+void WebRtcAecm_CalcLinearEnergiesSse2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i far_energy_v = zero;
+  __m128i echo_adapt_v = zero;
+  __m128i echo_stored_v = zero;
+
+  // The sums wrap around like the 32-bit sums of the C version.
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i spectrum_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&far_spectrum[i]));
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    const __m128i adapt_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelAdapt16[i]));
+
+    far_energy_v = _mm_add_epi32(far_energy_v,
+                                 _mm_unpacklo_epi16(spectrum_v, zero));
+    far_energy_v = _mm_add_epi32(far_energy_v,
+                                 _mm_unpackhi_epi16(spectrum_v, zero));
+
+    __m128i low, high;
+    MultiplySignedUnsigned(stored_v, spectrum_v, &low, &high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i]), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i + 4]), high);
+    echo_stored_v = _mm_add_epi32(echo_stored_v, _mm_add_epi32(low, high));
+
+    MultiplySignedUnsigned(adapt_v, spectrum_v, &low, &high);
+    echo_adapt_v = _mm_add_epi32(echo_adapt_v, _mm_add_epi32(low, high));
+  }
+
+  *far_energy += AddLanes(far_energy_v);
+  *echo_energy_stored += AddLanes(echo_stored_v);
+  *echo_energy_adapt += AddLanes(echo_adapt_v);
+
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+  *echo_energy_stored += (uint32_t)echo_est[PART_LEN];
+  *far_energy += (uint32_t)far_spectrum[PART_LEN];
+  *echo_energy_adapt += aecm->channelAdapt16[PART_LEN] * far_spectrum[PART_LEN];
+}
+
+void WebRtcAecm_StoreAdaptiveChannelSse2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est) {
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i spectrum_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&far_spectrum[i]));
+    const __m128i adapt_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelAdapt16[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelStored[i]),
+                     adapt_v);
+
+    __m128i low, high;
+    MultiplySignedUnsigned(adapt_v, spectrum_v, &low, &high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i]), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i + 4]), high);
+  }
+  aecm->channelStored[PART_LEN] = aecm->channelAdapt16[PART_LEN];
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+}
+
+void WebRtcAecm_ResetAdaptiveChannelSse2(AecmCore* aecm) {
+  const __m128i zero = _mm_setzero_si128();
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt16[i]),
+                     stored_v);
+    // Interleaving with zeros below shifts the values left by 16 bits.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt32[i]),
+                     _mm_unpacklo_epi16(zero, stored_v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt32[i + 4]),
+                     _mm_unpackhi_epi16(zero, stored_v));
+  }
+  aecm->channelAdapt16[PART_LEN] = aecm->channelStored[PART_LEN];
+  aecm->channelAdapt32[PART_LEN] = (int32_t)aecm->channelStored[PART_LEN] << 16;
+}
+
+}  // namespace webrtc
@@ -76,6 +76,11 @@ void Agc::Reset() {
   histogram_->Reset();
 }
 
+void Agc::ResetForReuse() {
+  histogram_->Reset();
+  vad_.Reset();
+}
+
 int Agc::set_target_level_dbfs(int level) {
   // TODO(turajs): just some arbitrary sanity check. We can come up with better
   // limits. The upper limit should be chosen such that the risk of clipping is
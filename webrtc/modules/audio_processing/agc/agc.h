@@ -34,6 +34,9 @@ class Agc {
   // otherwise, in which case `error` should be ignored and no action taken.
   virtual bool GetRmsErrorDb(int* error);
   virtual void Reset();
+  // Resets the histogram and the voice activity detector, as in a new
+  // instance.
+  virtual void ResetForReuse();
 
   virtual int set_target_level_dbfs(int level);
   virtual int target_level_dbfs() const;
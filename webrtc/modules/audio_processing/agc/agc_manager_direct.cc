@@ -188,6 +188,15 @@ void MonoAgc::Initialize() {
   is_first_frame_ = true;
 }
 
+void MonoAgc::Reset() {
+  agc_->ResetForReuse();
+  level_ = 0;
+  startup_ = true;
+  recommended_input_volume_ = 0;
+  new_compression_to_set_ = std::nullopt;
+  Initialize();
+}
+
 void MonoAgc::Process(rtc::ArrayView<const int16_t> audio,
                       std::optional<int> rms_error_override) {
   new_compression_to_set_ = std::nullopt;
@@ -516,6 +525,19 @@ void AgcManagerDirect::Initialize() {
   clipping_rate_log_counter_ = 0;
 }
 
+void AgcManagerDirect::Reset() {
+  for (size_t ch = 0; ch < channel_agcs_.size(); ++ch) {
+    channel_agcs_[ch]->Reset();
+    new_compressions_to_set_[ch] = std::nullopt;
+  }
+  recommended_input_volume_ = 0;
+  frames_since_clipped_ = clipped_wait_frames_;
+  if (clipping_predictor_) {
+    clipping_predictor_->Reset();
+  }
+  Initialize();
+}
+
 void AgcManagerDirect::SetupDigitalGainControl(
     GainControl& gain_control) const {
   if (gain_control.set_mode(GainControl::kFixedDigital) != 0) {
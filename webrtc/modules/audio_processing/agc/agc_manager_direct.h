@@ -52,6 +52,11 @@ class AgcManagerDirect final {
 
   void Initialize();
 
+  // Resets the state of the controller, including the recommended input volume
+  // and the clipping predictor, as in a new instance. `Initialize()` only
+  // restarts the volume adaptation.
+  void Reset();
+
   // Configures `gain_control` to work as a fixed digital controller so that the
   // adaptive part is only handled by this gain controller. Must be called if
   // `gain_control` is also used to avoid the side-effects of running two AGCs.
@@ -197,6 +202,8 @@ class MonoAgc {
   MonoAgc& operator=(const MonoAgc&) = delete;
 
   void Initialize();
+  // Resets all the state, as in a new instance.
+  void Reset();
   void HandleCaptureOutputUsedChange(bool capture_output_used);
 
   // Sets the current input volume.
@@ -23,6 +23,7 @@ class MockAgc : public Agc {
   MOCK_METHOD(void, Process, (rtc::ArrayView<const int16_t> audio), (override));
   MOCK_METHOD(bool, GetRmsErrorDb, (int* error), (override));
   MOCK_METHOD(void, Reset, (), (override));
+  MOCK_METHOD(void, ResetForReuse, (), (override));
   MOCK_METHOD(int, set_target_level_dbfs, (int level), (override));
   MOCK_METHOD(int, target_level_dbfs, (), (const, override));
 };
@@ -213,4 +213,32 @@ void AdaptiveDigitalGainController::Process(const FrameInfo& info,
   }
 }
 
+void AdaptiveDigitalGainController::Reset() {
+  gain_applier_.Reset(DbToRatio(config_.initial_gain_db));
+  calls_since_last_gain_log_ = 0;
+  frames_to_gain_increase_allowed_ = adjacent_speech_frames_threshold_;
+  last_gain_db_ = config_.initial_gain_db;
+}
+
+void AdaptiveDigitalGainController::SaveState(StateWriter* writer) const {
+  writer->WriteFloat(last_gain_db_);
+  writer->WriteInt(frames_to_gain_increase_allowed_);
+}
+
+bool AdaptiveDigitalGainController::RestoreState(StateReader* reader) {
+  float gain_db;
+  int frames_to_gain_increase_allowed;
+  if (!reader->ReadFloat(&gain_db) || gain_db < 0.0f ||
+      gain_db > config_.max_gain_db ||
+      !reader->ReadInt(&frames_to_gain_increase_allowed) ||
+      frames_to_gain_increase_allowed < 0 ||
+      frames_to_gain_increase_allowed > adjacent_speech_frames_threshold_) {
+    return false;
+  }
+  last_gain_db_ = gain_db;
+  frames_to_gain_increase_allowed_ = frames_to_gain_increase_allowed;
+  gain_applier_.SetGainFactor(DbToRatio(last_gain_db_));
+  return true;
+}
+
 }  // namespace webrtc
@@ -16,6 +16,7 @@
 #include "api/audio/audio_processing.h"
 #include "api/audio/audio_view.h"
 #include "modules/audio_processing/agc2/gain_applier.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -48,6 +49,13 @@ class AdaptiveDigitalGainController {
   // `frame`. Supports any sample rate supported by APM.
   void Process(const FrameInfo& info, DeinterleavedView<float> frame);
 
+  // Restores the initial gain.
+  void Reset();
+
+  // Saves and restores the applied gain.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   ApmDataDumper* const apm_data_dumper_;
   GainApplier gain_applier_;
@@ -94,6 +94,12 @@ void GainApplier::SetGainFactor(float gain_factor) {
   current_gain_factor_ = gain_factor;
 }
 
+void GainApplier::Reset(float gain_factor) {
+  RTC_DCHECK_GT(gain_factor, 0.f);
+  last_gain_factor_ = gain_factor;
+  current_gain_factor_ = gain_factor;
+}
+
 void GainApplier::Initialize(int samples_per_channel) {
   RTC_DCHECK_GT(samples_per_channel, 0);
   samples_per_channel_ = static_cast<int>(samples_per_channel);
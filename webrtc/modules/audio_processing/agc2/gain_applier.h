@@ -23,6 +23,8 @@ class GainApplier {
 
   void ApplyGain(DeinterleavedView<float> signal);
   void SetGainFactor(float gain_factor);
+  // Sets the gain factor without ramping to it at the next `ApplyGain()` call.
+  void Reset(float gain_factor);
   float GetGainFactor() const { return current_gain_factor_; }
 
   [[deprecated("Use DeinterleavedView<> version")]] void ApplyGain(
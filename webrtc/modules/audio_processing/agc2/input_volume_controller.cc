@@ -168,6 +168,13 @@ void MonoInputVolumeController::Initialize() {
   is_first_frame_ = true;
 }
 
+void MonoInputVolumeController::Reset() {
+  last_recommended_input_volume_ = 0;
+  startup_ = true;
+  recommended_input_volume_ = 0;
+  Initialize();
+}
+
 // A speeh segment is considered active if at least
 // `update_input_volume_wait_frames_` new frames have been processed since the
 // previous update and the ratio of non-silence frames (i.e., frames with a
@@ -407,6 +414,17 @@ void InputVolumeController::Initialize() {
   applied_input_volume_ = std::nullopt;
 }
 
+void InputVolumeController::Reset() {
+  for (auto& controller : channel_controllers_) {
+    controller->Reset();
+  }
+  frames_since_clipped_ = clipped_wait_frames_;
+  if (clipping_predictor_) {
+    clipping_predictor_->Reset();
+  }
+  Initialize();
+}
+
 void InputVolumeController::AnalyzeInputAudio(int applied_input_volume,
                                               const AudioBuffer& audio_buffer) {
   RTC_DCHECK_GE(applied_input_volume, 0);
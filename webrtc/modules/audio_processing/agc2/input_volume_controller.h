@@ -80,6 +80,10 @@ class InputVolumeController final {
   // TODO(webrtc:7494): Integrate initialization into ctor and remove.
   void Initialize();
 
+  // Resets the state of the controller, including the recommended input volume
+  // and the clipping predictor, as in a new initialized instance.
+  void Reset();
+
   // Analyzes `audio_buffer` before `RecommendInputVolume()` is called so tha
   // the analysis can be performed before digital processing operations take
   // place (e.g., echo cancellation). The analysis consists of input clipping
@@ -196,6 +200,8 @@ class MonoInputVolumeController {
       delete;
 
   void Initialize();
+  // Resets all the state, as in a new initialized instance.
+  void Reset();
   void HandleCaptureOutputUsedChange(bool capture_output_used);
 
   // Sets the current input volume.
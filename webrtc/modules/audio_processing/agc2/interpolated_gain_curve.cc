@@ -64,6 +64,13 @@ InterpolatedGainCurve::~InterpolatedGainCurve() {
   }
 }
 
+void InterpolatedGainCurve::ResetStats() const {
+  if (stats_.available) {
+    region_logger_.LogRegionStats(stats_);
+  }
+  stats_ = Stats();
+}
+
 InterpolatedGainCurve::RegionLogger::RegionLogger(
     absl::string_view identity_histogram_name,
     absl::string_view knee_histogram_name,
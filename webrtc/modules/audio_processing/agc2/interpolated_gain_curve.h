@@ -67,6 +67,8 @@ class InterpolatedGainCurve {
   InterpolatedGainCurve& operator=(const InterpolatedGainCurve&) = delete;
 
   Stats get_stats() const { return stats_; }
+  // Logs the region stats, if any, and clears them.
+  void ResetStats() const;
 
   // Given a non-negative input level (linear scale), a scalar factor to apply
   // to a sub-frame is returned.
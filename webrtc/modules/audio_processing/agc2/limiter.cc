@@ -139,6 +139,14 @@ void Limiter::Reset() {
   level_estimator_.Reset();
 }
 
+void Limiter::ResetForReuse() {
+  Reset();
+  interp_gain_curve_.ResetStats();
+  scaling_factors_.fill(0.f);
+  per_sample_scaling_factors_.fill(0.f);
+  last_scaling_factor_ = 1.f;
+}
+
 float Limiter::LastAudioLevel() const {
   return level_estimator_.LastAudioLevel();
 }
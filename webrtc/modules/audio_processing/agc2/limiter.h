@@ -47,6 +47,10 @@ class Limiter {
   // Resets the internal state.
   void Reset();
 
+  // Resets the level estimation, the gain curve stats and the last applied
+  // gain, as in a new limiter.
+  void ResetForReuse();
+
   float LastAudioLevel() const;
 
  private:
@@ -141,6 +141,32 @@ class NoiseFloorEstimator : public NoiseLevelEstimator {
     return noise_rms_dbfs;
   }
 
+  void Reset() override { Initialize(/*sample_rate_hz=*/48000); }
+
+  void SaveState(StateWriter* writer) const override {
+    writer->WriteInt(sample_rate_hz_);
+    writer->WriteBool(first_period_);
+    writer->WriteBool(preliminary_noise_energy_set_);
+    writer->WriteFloat(preliminary_noise_energy_);
+    writer->WriteFloat(noise_energy_);
+    writer->WriteInt(counter_);
+  }
+
+  bool RestoreState(StateReader* reader) override {
+    int sample_rate_hz;
+    if (!reader->ReadInt(&sample_rate_hz) || sample_rate_hz <= 0) {
+      return false;
+    }
+    // A state estimated at another sample rate is replaced at the next
+    // `Analyze()` call.
+    Initialize(sample_rate_hz);
+    return reader->ReadBool(&first_period_) &&
+           reader->ReadBool(&preliminary_noise_energy_set_) &&
+           reader->ReadFloat(&preliminary_noise_energy_) &&
+           reader->ReadFloat(&noise_energy_) && reader->ReadInt(&counter_) &&
+           counter_ >= 0 && counter_ <= kUpdatePeriodNumFrames;
+  }
+
  private:
   void Initialize(int sample_rate_hz) {
     sample_rate_hz_ = sample_rate_hz;
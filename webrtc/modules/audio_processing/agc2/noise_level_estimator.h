@@ -14,6 +14,7 @@
 #include <memory>
 
 #include "api/audio/audio_view.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 class ApmDataDumper;
@@ -25,6 +26,13 @@ class NoiseLevelEstimator {
   // Analyzes a 10 ms `frame`, updates the noise level estimation and returns
   // the value for the latter in dBFS.
   virtual float Analyze(DeinterleavedView<const float> frame) = 0;
+
+  // Resets the estimator to its initial state.
+  virtual void Reset() = 0;
+
+  // Saves and restores the noise level estimate.
+  virtual void SaveState(StateWriter* writer) const = 0;
+  virtual bool RestoreState(StateReader* reader) = 0;
 };
 
 // Creates a noise level estimator based on noise floor detection.
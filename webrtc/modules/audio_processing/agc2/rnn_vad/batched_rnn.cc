@@ -0,0 +1,403 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/batched_rnn.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "third_party/rnnoise/src/rnn_activations.h"
+#include "third_party/rnnoise/src/rnn_vad_weights.h"
+
+namespace webrtc {
+namespace rnn_vad {
+namespace {
+
+using ::rnnoise::kHiddenGruBias;
+using ::rnnoise::kHiddenGruRecurrentWeights;
+using ::rnnoise::kHiddenGruWeights;
+using ::rnnoise::kHiddenLayerOutputSize;
+using ::rnnoise::kInputDenseBias;
+using ::rnnoise::kInputDenseWeights;
+using ::rnnoise::kInputLayerInputSize;
+using ::rnnoise::kInputLayerOutputSize;
+using ::rnnoise::kOutputDenseBias;
+using ::rnnoise::kOutputDenseWeights;
+using ::rnnoise::kOutputLayerOutputSize;
+
+// The number of columns of the matrices is a multiple of the number of lanes
+// processed together by the widest SIMD code.
+constexpr int kLaneAlignment = 8;
+
+int AlignNumLanes(int num_lanes) {
+  return (num_lanes + kLaneAlignment - 1) / kLaneAlignment * kLaneAlignment;
+}
+
+struct ScalarOps {
+  using Vector = float;
+  static constexpr int kNumLanes = 1;
+  static float Zero() { return 0.f; }
+  static float Set(float a) { return a; }
+  static float Load(const float* p) { return *p; }
+  static void Store(float* p, float a) { *p = a; }
+  static float Add(float a, float b) { return a + b; }
+  static float Mul(float a, float b) { return a * b; }
+};
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+struct Sse2Ops {
+  using Vector = __m128;
+  static constexpr int kNumLanes = 4;
+  static __m128 Zero() { return _mm_setzero_ps(); }
+  static __m128 Set(float a) { return _mm_set1_ps(a); }
+  static __m128 Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, __m128 a) { _mm_storeu_ps(p, a); }
+  static __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+  static __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+};
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Separate multiplications and additions are used, rather than fused ones, to
+// keep the results identical to the scalar implementation.
+struct NeonOps {
+  using Vector = float32x4_t;
+  static constexpr int kNumLanes = 4;
+  static float32x4_t Zero() { return vdupq_n_f32(0.f); }
+  static float32x4_t Set(float a) { return vdupq_n_f32(a); }
+  static float32x4_t Load(const float* p) { return vld1q_f32(p); }
+  static void Store(float* p, float32x4_t a) { vst1q_f32(p, a); }
+  static float32x4_t Add(float32x4_t a, float32x4_t b) {
+    return vaddq_f32(a, b);
+  }
+  static float32x4_t Mul(float32x4_t a, float32x4_t b) {
+    return vmulq_f32(a, b);
+  }
+};
+#endif
+
+// Computes two outputs for two vectors of lanes at a time, so that there are
+// four independent accumulators. The terms are added in the same order as in
+// the scalar VectorMath::DotProduct(). An odd last output is computed twice.
+template <typename Ops>
+void ComputeBatchedDotProducts(const float* weights,
+                               int num_outputs,
+                               int num_inputs,
+                               const float* input,
+                               int stride,
+                               int num_lanes,
+                               float* output) {
+  using Vector = typename Ops::Vector;
+  constexpr int kNumLanes = Ops::kNumLanes;
+  RTC_DCHECK_EQ(num_lanes % (2 * kNumLanes), 0);
+  for (int s = 0; s < num_lanes; s += 2 * kNumLanes) {
+    const float* x = &input[s];
+    for (int o = 0; o < num_outputs; o += 2) {
+      const float* w0 = &weights[o * num_inputs];
+      const float* w1 = &weights[std::min(o + 1, num_outputs - 1) * num_inputs];
+      Vector y00 = Ops::Zero();
+      Vector y01 = Ops::Zero();
+      Vector y10 = Ops::Zero();
+      Vector y11 = Ops::Zero();
+      for (int i = 0; i < num_inputs; ++i) {
+        const Vector x0 = Ops::Load(&x[i * stride]);
+        const Vector x1 = Ops::Load(&x[i * stride + kNumLanes]);
+        const Vector a0 = Ops::Set(w0[i]);
+        const Vector a1 = Ops::Set(w1[i]);
+        y00 = Ops::Add(y00, Ops::Mul(a0, x0));
+        y01 = Ops::Add(y01, Ops::Mul(a0, x1));
+        y10 = Ops::Add(y10, Ops::Mul(a1, x0));
+        y11 = Ops::Add(y11, Ops::Mul(a1, x1));
+      }
+      float* y0 = &output[o * stride + s];
+      Ops::Store(y0, y00);
+      Ops::Store(y0 + kNumLanes, y01);
+      if (o + 1 < num_outputs) {
+        Ops::Store(y0 + stride, y10);
+        Ops::Store(y0 + stride + kNumLanes, y11);
+      }
+    }
+  }
+}
+
+void ComputeDotProducts(const AvailableCpuFeatures& cpu_features,
+                        rtc::ArrayView<const float> weights,
+                        int num_outputs,
+                        const float* input,
+                        int stride,
+                        int num_lanes,
+                        float* output) {
+  const int num_inputs = static_cast<int>(weights.size()) / num_outputs;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features.avx2) {
+    ComputeBatchedDotProducts_AVX2(weights.data(), num_outputs, num_inputs,
+                                   input, stride, num_lanes, output);
+    return;
+  }
+#if !defined(WAP_DISABLE_INLINE_SSE)
+  if (cpu_features.sse2) {
+    ComputeBatchedDotProducts<Sse2Ops>(weights.data(), num_outputs,
+                                       num_inputs, input, stride, num_lanes,
+                                       output);
+    return;
+  }
+#endif
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  if (cpu_features.neon) {
+    ComputeBatchedDotProducts<NeonOps>(weights.data(), num_outputs,
+                                       num_inputs, input, stride, num_lanes,
+                                       output);
+    return;
+  }
+#endif
+  ComputeBatchedDotProducts<ScalarOps>(weights.data(), num_outputs, num_inputs,
+                                       input, stride, num_lanes, output);
+}
+
+// Returns `x` with `num_rows` rows of `num_lanes` columns instead of
+// `old_num_lanes`, keeping the existing columns.
+std::vector<float> ResizeMatrix(const std::vector<float>& x,
+                                int num_rows,
+                                int old_num_lanes,
+                                int num_lanes) {
+  std::vector<float> y(num_rows * num_lanes, 0.f);
+  for (int r = 0; r < num_rows && old_num_lanes > 0; ++r) {
+    std::copy(x.begin() + r * old_num_lanes,
+              x.begin() + (r + 1) * old_num_lanes, y.begin() + r * num_lanes);
+  }
+  return y;
+}
+
+}  // namespace
+
+BatchedRnnVad::BatchedRnnVad(const AvailableCpuFeatures& cpu_features)
+    : cpu_features_(cpu_features),
+      input_(kInputLayerInputSize,
+             kInputLayerOutputSize,
+             kInputDenseBias,
+             kInputDenseWeights,
+             ActivationFunction::kTansigApproximated,
+             NoAvailableCpuFeatures(),
+             /*layer_name=*/"FC1"),
+      hidden_(kInputLayerOutputSize,
+              kHiddenLayerOutputSize,
+              kHiddenGruBias,
+              kHiddenGruWeights,
+              kHiddenGruRecurrentWeights,
+              NoAvailableCpuFeatures(),
+              /*layer_name=*/"GRU1"),
+      output_(kHiddenLayerOutputSize,
+              kOutputLayerOutputSize,
+              kOutputDenseBias,
+              kOutputDenseWeights,
+              ActivationFunction::kSigmoidApproximated,
+              NoAvailableCpuFeatures(),
+              /*layer_name=*/"FC2") {
+  static_assert(kFeatureVectorSize == kInputLayerInputSize, "");
+  RTC_DCHECK_EQ(output_.size(), 1);
+}
+
+BatchedRnnVad::~BatchedRnnVad() = default;
+
+int BatchedRnnVad::AddStream() {
+  auto it = std::find(used_.begin(), used_.end(), false);
+  if (it == used_.end()) {
+    const int num_streams = num_lanes_;
+    Resize(AlignNumLanes(std::max(2 * num_lanes_, 1)));
+    it = used_.begin() + num_streams;
+  }
+  const int stream = static_cast<int>(it - used_.begin());
+  used_[stream] = true;
+  inputs_[stream] = Input::kNone;
+  vad_probabilities_[stream] = 0.f;
+  ResetStream(stream);
+  return stream;
+}
+
+void BatchedRnnVad::RemoveStream(int stream) {
+  RTC_DCHECK_LT(stream, num_lanes_);
+  RTC_DCHECK(used_[stream]);
+  used_[stream] = false;
+  inputs_[stream] = Input::kNone;
+}
+
+void BatchedRnnVad::ResetStream(int stream) {
+  RTC_DCHECK_LT(stream, num_lanes_);
+  for (int o = 0; o < hidden_.size(); ++o) {
+    state_[o * num_lanes_ + stream] = 0.f;
+  }
+}
+
+void BatchedRnnVad::ResetStreamForReuse(int stream) {
+  RTC_DCHECK_LT(stream, num_lanes_);
+  RTC_DCHECK(used_[stream]);
+  inputs_[stream] = Input::kNone;
+  vad_probabilities_[stream] = 0.f;
+  ResetStream(stream);
+}
+
+void BatchedRnnVad::SetFeatureVector(
+    int stream,
+    rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
+    bool is_silence) {
+  RTC_DCHECK_LT(stream, num_lanes_);
+  RTC_DCHECK(used_[stream]);
+  inputs_[stream] = is_silence ? Input::kSilence : Input::kFeatures;
+  // The features of silent frames are not computed, so zeros are used to keep
+  // the unused lanes free of garbage.
+  for (int i = 0; i < kFeatureVectorSize; ++i) {
+    feature_vectors_[i * num_lanes_ + stream] =
+        is_silence ? 0.f : feature_vector[i];
+  }
+}
+
+bool BatchedRnnVad::HasFeatureVector(int stream) const {
+  RTC_DCHECK_LT(stream, num_lanes_);
+  return inputs_[stream] != Input::kNone;
+}
+
+void BatchedRnnVad::ComputeVadProbabilities() {
+  // Only the lanes up to the last one with an input are computed.
+  int num_lanes = 0;
+  for (int s = 0; s < num_lanes_; ++s) {
+    if (inputs_[s] != Input::kNone) {
+      num_lanes = s + 1;
+    }
+  }
+  if (num_lanes == 0) {
+    return;
+  }
+  num_lanes = AlignNumLanes(num_lanes);
+  const int stride = num_lanes_;
+  auto dot_products = [&](rtc::ArrayView<const float> weights, int num_outputs,
+                          const std::vector<float>& input,
+                          std::vector<float>& output) {
+    ComputeDotProducts(cpu_features_, weights, num_outputs, input.data(),
+                       stride, num_lanes, output.data());
+  };
+
+  // Input layer.
+  const int num_units = input_.size();
+  dot_products(input_.weights(), num_units, feature_vectors_,
+               input_layer_output_);
+  for (int o = 0; o < num_units; ++o) {
+    float* y = &input_layer_output_[o * stride];
+    for (int s = 0; s < num_lanes; ++s) {
+      y[s] = ::rnnoise::TansigApproximated(input_.bias()[o] + y[s]);
+    }
+  }
+
+  // Hidden layer. The tensors hold the update, reset and output gates in this
+  // order.
+  const int num_hidden_units = hidden_.size();
+  const int stride_weights = hidden_.input_size() * num_hidden_units;
+  const int stride_recurrent_weights = num_hidden_units * num_hidden_units;
+  rtc::ArrayView<const float> bias = hidden_.bias();
+  rtc::ArrayView<const float> weights = hidden_.weights();
+  rtc::ArrayView<const float> recurrent_weights = hidden_.recurrent_weights();
+  // Update gate.
+  dot_products(weights.subview(0, stride_weights), num_hidden_units,
+               input_layer_output_, products_);
+  dot_products(recurrent_weights.subview(0, stride_recurrent_weights),
+               num_hidden_units, state_, recurrent_products_);
+  for (int o = 0; o < num_hidden_units; ++o) {
+    const int k = o * stride;
+    for (int s = 0; s < num_lanes; ++s) {
+      update_[k + s] = ::rnnoise::SigmoidApproximated(
+          bias[o] + products_[k + s] + recurrent_products_[k + s]);
+    }
+  }
+  // Reset gate.
+  dot_products(weights.subview(stride_weights, stride_weights),
+               num_hidden_units, input_layer_output_, products_);
+  dot_products(
+      recurrent_weights.subview(stride_recurrent_weights,
+                                stride_recurrent_weights),
+      num_hidden_units, state_, recurrent_products_);
+  for (int o = 0; o < num_hidden_units; ++o) {
+    const int k = o * stride;
+    for (int s = 0; s < num_lanes; ++s) {
+      reset_x_state_[k + s] =
+          state_[k + s] *
+          ::rnnoise::SigmoidApproximated(bias[num_hidden_units + o] +
+                                         products_[k + s] +
+                                         recurrent_products_[k + s]);
+    }
+  }
+  // Output gate. Only the state of the streams with an input is updated.
+  dot_products(weights.subview(2 * stride_weights, stride_weights),
+               num_hidden_units, input_layer_output_, products_);
+  dot_products(
+      recurrent_weights.subview(2 * stride_recurrent_weights,
+                                stride_recurrent_weights),
+      num_hidden_units, reset_x_state_, recurrent_products_);
+  for (int o = 0; o < num_hidden_units; ++o) {
+    const int k = o * stride;
+    for (int s = 0; s < num_lanes; ++s) {
+      if (inputs_[s] == Input::kFeatures) {
+        const float x = bias[2 * num_hidden_units + o] + products_[k + s] +
+                        recurrent_products_[k + s];
+        state_[k + s] = update_[k + s] * state_[k + s] +
+                        (1.f - update_[k + s]) * std::max(0.f, x);
+      } else if (inputs_[s] == Input::kSilence) {
+        state_[k + s] = 0.f;
+      }
+    }
+  }
+
+  // Output layer.
+  dot_products(output_.weights(), /*num_outputs=*/1, state_, products_);
+  for (int s = 0; s < num_lanes; ++s) {
+    if (inputs_[s] == Input::kFeatures) {
+      vad_probabilities_[s] =
+          ::rnnoise::SigmoidApproximated(output_.bias()[0] + products_[s]);
+    } else if (inputs_[s] == Input::kSilence) {
+      vad_probabilities_[s] = 0.f;
+    }
+    inputs_[s] = Input::kNone;
+  }
+}
+
+float BatchedRnnVad::vad_probability(int stream) const {
+  RTC_DCHECK_LT(stream, num_lanes_);
+  return vad_probabilities_[stream];
+}
+
+void BatchedRnnVad::Resize(int num_lanes) {
+  RTC_DCHECK_GT(num_lanes, num_lanes_);
+  RTC_DCHECK_EQ(num_lanes % kLaneAlignment, 0);
+  const int num_hidden_units = hidden_.size();
+  feature_vectors_ = ResizeMatrix(feature_vectors_, kFeatureVectorSize,
+                                  num_lanes_, num_lanes);
+  state_ = ResizeMatrix(state_, num_hidden_units, num_lanes_, num_lanes);
+  used_.resize(num_lanes, false);
+  inputs_.resize(num_lanes, Input::kNone);
+  vad_probabilities_.resize(num_lanes, 0.f);
+  input_layer_output_.assign(input_.size() * num_lanes, 0.f);
+  update_.assign(num_hidden_units * num_lanes, 0.f);
+  reset_x_state_.assign(num_hidden_units * num_lanes, 0.f);
+  products_.assign(num_hidden_units * num_lanes, 0.f);
+  recurrent_products_.assign(num_hidden_units * num_lanes, 0.f);
+  num_lanes_ = num_lanes;
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
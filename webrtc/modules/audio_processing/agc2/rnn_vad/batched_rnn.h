@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_BATCHED_RNN_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_BATCHED_RNN_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "modules/audio_processing/agc2/rnn_vad/rnn_fc.h"
+#include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Evaluates the network of RnnVad for many independent streams at once. The
+// feature vectors and the GRU states of all the streams are kept in matrices
+// with one column per stream, so that each layer is evaluated as a
+// matrix-matrix product in which every weight is loaded once per group of
+// streams, and the streams fill the SIMD lanes.
+//
+// Without AVX2, the probabilities are bit-exact with those of an RnnVad that
+// uses no CPU features. With AVX2, the multiply-adds are fused and the
+// probabilities differ by rounding.
+class BatchedRnnVad {
+ public:
+  explicit BatchedRnnVad(const AvailableCpuFeatures& cpu_features);
+  BatchedRnnVad(const BatchedRnnVad&) = delete;
+  BatchedRnnVad& operator=(const BatchedRnnVad&) = delete;
+  ~BatchedRnnVad();
+
+  // Adds a stream with a reset state and returns its index. The indices of the
+  // removed streams are reused.
+  int AddStream();
+  void RemoveStream(int stream);
+  // Resets the GRU state of `stream`.
+  void ResetStream(int stream);
+  // Resets the GRU state of `stream` and discards its input and its last
+  // voice probability, as in a new stream.
+  void ResetStreamForReuse(int stream);
+
+  // Sets the input of `stream` for the next ComputeVadProbabilities() call.
+  void SetFeatureVector(
+      int stream,
+      rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
+      bool is_silence);
+  // Returns true if the input of `stream` has been set since the last
+  // ComputeVadProbabilities() call.
+  bool HasFeatureVector(int stream) const;
+
+  // Computes the voice probability of the streams whose input has been set
+  // since the last call, and updates their state like
+  // RnnVad::ComputeVadProbability() does. The state of the other streams is
+  // left untouched.
+  void ComputeVadProbabilities();
+
+  // Returns the voice probability computed for `stream` by the last
+  // ComputeVadProbabilities() call that included it.
+  float vad_probability(int stream) const;
+
+ private:
+  enum class Input : uint8_t { kNone, kFeatures, kSilence };
+
+  // Grows the matrices to hold `num_lanes` columns.
+  void Resize(int num_lanes);
+
+  const AvailableCpuFeatures cpu_features_;
+  // The layers only hold the weights shared by all the streams.
+  const FullyConnectedLayer input_;
+  const GatedRecurrentLayer hidden_;
+  const FullyConnectedLayer output_;
+
+  // Number of columns of the matrices below, a multiple of the number of
+  // streams processed together by the SIMD code.
+  int num_lanes_ = 0;
+  std::vector<bool> used_;
+  std::vector<Input> inputs_;
+  std::vector<float> feature_vectors_;
+  std::vector<float> state_;
+  std::vector<float> vad_probabilities_;
+  // Intermediate results.
+  std::vector<float> input_layer_output_;
+  std::vector<float> update_;
+  std::vector<float> reset_x_state_;
+  std::vector<float> products_;
+  std::vector<float> recurrent_products_;
+};
+
+// Computes `output[o][s] = sum_i weights[o][i] * input[i][s]` for the
+// `num_lanes` columns `s` of `input` and `output`, whose rows are `stride`
+// apart. `num_lanes` must be a multiple of 8. Only for use by BatchedRnnVad.
+void ComputeBatchedDotProducts_AVX2(const float* weights,
+                                    int num_outputs,
+                                    int num_inputs,
+                                    const float* input,
+                                    int stride,
+                                    int num_lanes,
+                                    float* output);
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_BATCHED_RNN_H_
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "modules/audio_processing/agc2/rnn_vad/batched_rnn.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Computes four outputs for eight lanes at a time, so that there are four
+// independent accumulators. The last outputs are computed more than once if
+// their number is not a multiple of four.
+void ComputeBatchedDotProducts_AVX2(const float* weights,
+                                    int num_outputs,
+                                    int num_inputs,
+                                    const float* input,
+                                    int stride,
+                                    int num_lanes,
+                                    float* output) {
+  RTC_DCHECK_EQ(num_lanes % 8, 0);
+  for (int s = 0; s < num_lanes; s += 8) {
+    const float* x = &input[s];
+    for (int o = 0; o < num_outputs; o += 4) {
+      const float* w[4];
+      for (int k = 0; k < 4; ++k) {
+        w[k] = &weights[std::min(o + k, num_outputs - 1) * num_inputs];
+      }
+      __m256 y0 = _mm256_setzero_ps();
+      __m256 y1 = _mm256_setzero_ps();
+      __m256 y2 = _mm256_setzero_ps();
+      __m256 y3 = _mm256_setzero_ps();
+      for (int i = 0; i < num_inputs; ++i) {
+        const __m256 x_i = _mm256_loadu_ps(&x[i * stride]);
+        y0 = _mm256_fmadd_ps(_mm256_set1_ps(w[0][i]), x_i, y0);
+        y1 = _mm256_fmadd_ps(_mm256_set1_ps(w[1][i]), x_i, y1);
+        y2 = _mm256_fmadd_ps(_mm256_set1_ps(w[2][i]), x_i, y2);
+        y3 = _mm256_fmadd_ps(_mm256_set1_ps(w[3][i]), x_i, y3);
+      }
+      const __m256 y[4] = {y0, y1, y2, y3};
+      for (int k = 0; k < 4 && o + k < num_outputs; ++k) {
+        _mm256_storeu_ps(&output[(o + k) * stride + s], y[k]);
+      }
+    }
+  }
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -43,6 +43,7 @@ FeaturesExtractor::~FeaturesExtractor() = default;
 
 void FeaturesExtractor::Reset() {
   pitch_buf_24kHz_.Reset();
+  pitch_estimator_.Reset();
   spectral_features_extractor_.Reset();
   if (use_high_pass_filter_) {
     hpf_.Reset();
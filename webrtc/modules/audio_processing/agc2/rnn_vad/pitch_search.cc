@@ -26,6 +26,10 @@ PitchEstimator::PitchEstimator(const AvailableCpuFeatures& cpu_features)
 
 PitchEstimator::~PitchEstimator() = default;
 
+void PitchEstimator::Reset() {
+  last_pitch_48kHz_ = {};
+}
+
 int PitchEstimator::Estimate(
     rtc::ArrayView<const float, kBufSize24kHz> pitch_buffer) {
   rtc::ArrayView<float, kBufSize12kHz> pitch_buffer_12kHz_view(
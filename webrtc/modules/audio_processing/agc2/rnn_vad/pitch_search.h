@@ -33,6 +33,8 @@ class PitchEstimator {
   ~PitchEstimator();
   // Returns the estimated pitch period at 48 kHz.
   int Estimate(rtc::ArrayView<const float, kBufSize24kHz> pitch_buffer);
+  // Forgets the last estimated pitch.
+  void Reset();
 
  private:
   FRIEND_TEST_ALL_PREFIXES(RnnVadTest, PitchSearchWithinTolerance);
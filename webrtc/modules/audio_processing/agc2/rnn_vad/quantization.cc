@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+namespace {
+
+template <typename T>
+float QuantizeVectorImpl(rtc::ArrayView<const float> x, rtc::ArrayView<T> y) {
+  RTC_DCHECK_GE(y.size(), x.size());
+  float max_abs = 0.f;
+  for (float x_i : x) {
+    max_abs = std::max(max_abs, std::fabs(x_i));
+  }
+  std::fill(y.begin(), y.end(), 0);
+  if (max_abs == 0.f) {
+    return 0.f;
+  }
+  constexpr float kMaxValue = std::numeric_limits<T>::max();
+  const float inverse_scale = kMaxValue / max_abs;
+  for (size_t i = 0; i < x.size(); ++i) {
+    y[i] = static_cast<T>(std::lrint(x[i] * inverse_scale));
+  }
+  return max_abs / kMaxValue;
+}
+
+}  // namespace
+
+float QuantizeVector(rtc::ArrayView<const float> x, rtc::ArrayView<int8_t> y) {
+  return QuantizeVectorImpl(x, y);
+}
+
+float QuantizeVector(rtc::ArrayView<const float> x, rtc::ArrayView<int16_t> y) {
+  return QuantizeVectorImpl(x, y);
+}
+
+void TransposeQuantizedWeights(rtc::ArrayView<const int8_t> weights,
+                               int input_size,
+                               int output_size,
+                               int stride,
+                               rtc::ArrayView<int8_t> transposed_weights) {
+  const int row_size = QuantizedSize(input_size);
+  RTC_DCHECK_EQ(transposed_weights.size(), output_size * row_size);
+  RTC_DCHECK_GE(weights.size(), (input_size - 1) * stride + output_size);
+  std::fill(transposed_weights.begin(), transposed_weights.end(), 0);
+  for (int o = 0; o < output_size; ++o) {
+    for (int i = 0; i < input_size; ++i) {
+      transposed_weights[o * row_size + i] = weights[i * stride + o];
+    }
+  }
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
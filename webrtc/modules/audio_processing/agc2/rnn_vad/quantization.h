@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_QUANTIZATION_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_QUANTIZATION_H_
+
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// The quantized vectors are zero-padded to a multiple of this size, so that
+// the SIMD integer dot products need no scalar tail.
+constexpr int kQuantizedBlockSize = 16;
+
+// Returns `size` rounded up to a multiple of `kQuantizedBlockSize`.
+constexpr int QuantizedSize(int size) {
+  return (size + kQuantizedBlockSize - 1) / kQuantizedBlockSize *
+         kQuantizedBlockSize;
+}
+
+// Quantizes `x` into `y` with a symmetric scale such that the largest
+// magnitude in `x` maps to the largest positive value of `y`, and returns the
+// scale: `x[i]` is approximated by `scale * y[i]`. The values of `y` are
+// symmetric, e.g., in [-127, 127] for 8 bits, and the elements of `y` beyond
+// the size of `x` are set to zero.
+float QuantizeVector(rtc::ArrayView<const float> x, rtc::ArrayView<int8_t> y);
+float QuantizeVector(rtc::ArrayView<const float> x, rtc::ArrayView<int16_t> y);
+
+// Transposes the `input_size` x `output_size` matrix `weights`, whose rows are
+// `stride` apart, into `output_size` zero-padded rows of
+// `QuantizedSize(input_size)` coefficients.
+void TransposeQuantizedWeights(rtc::ArrayView<const int8_t> weights,
+                               int input_size,
+                               int output_size,
+                               int stride,
+                               rtc::ArrayView<int8_t> transposed_weights);
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_QUANTIZATION_H_
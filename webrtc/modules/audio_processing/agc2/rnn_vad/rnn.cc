@@ -37,21 +37,23 @@ static_assert(kOutputLayerOutputSize <= kFullyConnectedLayerMaxUnits, "");
 
 }  // namespace
 
-RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
+RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features, bool quantized)
     : input_(kInputLayerInputSize,
              kInputLayerOutputSize,
              kInputDenseBias,
              kInputDenseWeights,
              ActivationFunction::kTansigApproximated,
              cpu_features,
-             /*layer_name=*/"FC1"),
+             /*layer_name=*/"FC1",
+             quantized),
       hidden_(kInputLayerOutputSize,
               kHiddenLayerOutputSize,
               kHiddenGruBias,
               kHiddenGruWeights,
               kHiddenGruRecurrentWeights,
               cpu_features,
-              /*layer_name=*/"GRU1"),
+              /*layer_name=*/"GRU1",
+              quantized),
       output_(kHiddenLayerOutputSize,
               kOutputLayerOutputSize,
               kOutputDenseBias,
@@ -59,7 +61,8 @@ RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
               ActivationFunction::kSigmoidApproximated,
               // The output layer is just 24x1. The unoptimized code is faster.
               NoAvailableCpuFeatures(),
-              /*layer_name=*/"FC2") {
+              /*layer_name=*/"FC2",
+              quantized) {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_.size(), hidden_.input_size())
       << "The input and the hidden layers sizes do not match.";
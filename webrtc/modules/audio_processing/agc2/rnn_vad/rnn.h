@@ -30,7 +30,11 @@ namespace rnn_vad {
 // detection.
 class RnnVad {
  public:
-  explicit RnnVad(const AvailableCpuFeatures& cpu_features);
+  // If `quantized` is true, the layers run with 8-bit integer weights and
+  // activations. This needs less memory and is faster, but the probabilities
+  // slightly differ from those of the floating point network.
+  explicit RnnVad(const AvailableCpuFeatures& cpu_features,
+                  bool quantized = false);
   RnnVad(const RnnVad&) = delete;
   RnnVad& operator=(const RnnVad&) = delete;
   ~RnnVad();
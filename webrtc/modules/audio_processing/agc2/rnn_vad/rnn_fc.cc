@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <numeric>
 
+#include "modules/audio_processing/agc2/rnn_vad/quantization.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -52,6 +53,17 @@ std::vector<float> PreprocessWeights(rtc::ArrayView<const int8_t> weights,
   return w;
 }
 
+std::vector<int8_t> PreprocessQuantizedWeights(
+    rtc::ArrayView<const int8_t> weights,
+    int output_size) {
+  const int input_size = rtc::CheckedDivExact(
+      rtc::dchecked_cast<int>(weights.size()), output_size);
+  std::vector<int8_t> w(QuantizedSize(input_size) * output_size);
+  TransposeQuantizedWeights(weights, input_size, output_size,
+                            /*stride=*/output_size, w);
+  return w;
+}
+
 rtc::FunctionView<float(float)> GetActivationFunction(
     ActivationFunction activation_function) {
   switch (activation_function) {
@@ -71,11 +83,18 @@ FullyConnectedLayer::FullyConnectedLayer(
     const rtc::ArrayView<const int8_t> weights,
     ActivationFunction activation_function,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    bool quantized)
     : input_size_(input_size),
       output_size_(output_size),
+      quantized_(quantized),
       bias_(GetScaledParams(bias)),
-      weights_(PreprocessWeights(weights, output_size)),
+      weights_(quantized ? std::vector<float>()
+                         : PreprocessWeights(weights, output_size)),
+      quantized_weights_(quantized
+                             ? PreprocessQuantizedWeights(weights, output_size)
+                             : std::vector<int8_t>()),
+      quantized_input_(quantized ? QuantizedSize(input_size) : 0),
       vector_math_(cpu_features),
       activation_function_(GetActivationFunction(activation_function)) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayerMaxUnits)
@@ -83,7 +102,7 @@ FullyConnectedLayer::FullyConnectedLayer(
   RTC_DCHECK_EQ(output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
 }
@@ -92,6 +111,19 @@ FullyConnectedLayer::~FullyConnectedLayer() = default;
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (quantized_) {
+    const int row_size = rtc::dchecked_cast<int>(quantized_input_.size());
+    const float scale =
+        ::rnnoise::kWeightsScale * QuantizeVector(input, quantized_input_);
+    rtc::ArrayView<const int8_t> weights(quantized_weights_);
+    for (int o = 0; o < output_size_; ++o) {
+      output_[o] = activation_function_(
+          bias_[o] + scale * static_cast<float>(vector_math_.DotProduct(
+                                 quantized_input_,
+                                 weights.subview(o * row_size, row_size))));
+    }
+    return;
+  }
   rtc::ArrayView<const float> weights(weights_);
   for (int o = 0; o < output_size_; ++o) {
     output_[o] = activation_function_(
@@ -34,13 +34,18 @@ constexpr int kFullyConnectedLayerMaxUnits = 24;
 class FullyConnectedLayer {
  public:
   // Ctor. `output_size` cannot be greater than `kFullyConnectedLayerMaxUnits`.
+  // If `quantized` is true, the weights are kept as 8-bit integers and the
+  // input is quantized to 16 bits before being multiplied by them. The input
+  // gets more bits than that of the recurrent layer since the input features
+  // of the network have widely different ranges.
   FullyConnectedLayer(int input_size,
                       int output_size,
                       rtc::ArrayView<const int8_t> bias,
                       rtc::ArrayView<const int8_t> weights,
                       ActivationFunction activation_function,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      bool quantized = false);
   FullyConnectedLayer(const FullyConnectedLayer&) = delete;
   FullyConnectedLayer& operator=(const FullyConnectedLayer&) = delete;
   ~FullyConnectedLayer();
@@ -51,6 +56,10 @@ class FullyConnectedLayer {
   const float* data() const { return output_.data(); }
   // Returns the size of the output buffer.
   int size() const { return output_size_; }
+  // Returns the bias terms and the weights, with one row of `input_size()`
+  // weights per output. The weights are empty if the layer is quantized.
+  rtc::ArrayView<const float> bias() const { return bias_; }
+  rtc::ArrayView<const float> weights() const { return weights_; }
 
   // Computes the fully-connected layer output.
   void ComputeOutput(rtc::ArrayView<const float> input);
@@ -58,8 +67,14 @@ class FullyConnectedLayer {
  private:
   const int input_size_;
   const int output_size_;
+  const bool quantized_;
   const std::vector<float> bias_;
+  // Empty if `quantized_` is true.
   const std::vector<float> weights_;
+  // Rows of `QuantizedSize(input_size_)` weights, one per output. Empty if
+  // `quantized_` is false.
+  const std::vector<int8_t> quantized_weights_;
+  std::vector<int16_t> quantized_input_;
   const VectorMath vector_math_;
   rtc::FunctionView<float(float)> activation_function_;
   // Over-allocated array with size equal to `output_size_`.
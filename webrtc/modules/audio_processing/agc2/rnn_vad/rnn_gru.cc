@@ -10,6 +10,7 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
 
+#include "modules/audio_processing/agc2/rnn_vad/quantization.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -43,6 +44,24 @@ std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
   return tensor_dst;
 }
 
+// Like PreprocessGruTensor(), but keeps the weights as 8-bit integers and
+// zero-pads the rows to `QuantizedSize(n)` coefficients.
+std::vector<int8_t> PreprocessQuantizedGruTensor(
+    rtc::ArrayView<const int8_t> tensor_src,
+    int output_size) {
+  const int n = rtc::CheckedDivExact(rtc::dchecked_cast<int>(tensor_src.size()),
+                                     output_size * kNumGruGates);
+  const int stride_dst = QuantizedSize(n) * output_size;
+  std::vector<int8_t> tensor_dst(kNumGruGates * stride_dst);
+  rtc::ArrayView<int8_t> dst(tensor_dst);
+  for (int g = 0; g < kNumGruGates; ++g) {
+    TransposeQuantizedWeights(tensor_src.subview(g * output_size), n,
+                              output_size, kNumGruGates * output_size,
+                              dst.subview(g * stride_dst, stride_dst));
+  }
+  return tensor_dst;
+}
+
 // Computes the output for the update or the reset gate.
 // Operation: `g = sigmoid(W^T∙i + R^T∙s + b)` where
 // - `g`: output gate vector
@@ -128,23 +147,38 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    bool quantized)
     : input_size_(input_size),
       output_size_(output_size),
+      quantized_(quantized),
       bias_(PreprocessGruTensor(bias, output_size)),
-      weights_(PreprocessGruTensor(weights, output_size)),
-      recurrent_weights_(PreprocessGruTensor(recurrent_weights, output_size)),
+      weights_(quantized ? std::vector<float>()
+                         : PreprocessGruTensor(weights, output_size)),
+      recurrent_weights_(quantized
+                             ? std::vector<float>()
+                             : PreprocessGruTensor(recurrent_weights,
+                                                   output_size)),
+      quantized_weights_(
+          quantized ? PreprocessQuantizedGruTensor(weights, output_size)
+                    : std::vector<int8_t>()),
+      quantized_recurrent_weights_(
+          quantized
+              ? PreprocessQuantizedGruTensor(recurrent_weights, output_size)
+              : std::vector<int8_t>()),
+      quantized_input_(quantized ? QuantizedSize(input_size) : 0),
+      quantized_state_(quantized ? QuantizedSize(output_size) : 0),
       vector_math_(cpu_features) {
   RTC_DCHECK_LE(output_size_, kGruLayerMaxUnits)
       << "Insufficient GRU layer over-allocation (" << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_ * output_size_,
-                recurrent_weights_.size())
+                recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
          " size ("
       << layer_name << ").";
@@ -159,6 +193,10 @@ void GatedRecurrentLayer::Reset() {
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (quantized_) {
+    ComputeOutputQuantized(input);
+    return;
+  }
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
@@ -194,5 +232,55 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
                    state);
 }
 
+void GatedRecurrentLayer::ComputeOutputQuantized(
+    rtc::ArrayView<const float> input) {
+  // Same as ComputeOutput(), except that the input and the state are quantized
+  // once per layer and the products with the weights are integer.
+  const int input_row_size = rtc::dchecked_cast<int>(quantized_input_.size());
+  const int state_row_size = rtc::dchecked_cast<int>(quantized_state_.size());
+  const int stride_weights = input_row_size * output_size_;
+  const int stride_recurrent_weights = state_row_size * output_size_;
+  rtc::ArrayView<const int8_t> weights(quantized_weights_);
+  rtc::ArrayView<const int8_t> recurrent_weights(quantized_recurrent_weights_);
+  rtc::ArrayView<float> state(state_.data(), output_size_);
+
+  const float input_scale =
+      ::rnnoise::kWeightsScale * QuantizeVector(input, quantized_input_);
+  float state_scale =
+      ::rnnoise::kWeightsScale * QuantizeVector(state, quantized_state_);
+  // Computes `W^T∙i + R^T∙s + b` for the output `o` of the gate `g`.
+  auto gate_input = [&](int g, int o) {
+    const int32_t x = vector_math_.DotProduct(
+        quantized_input_,
+        weights.subview(g * stride_weights + o * input_row_size,
+                        input_row_size));
+    const int32_t s = vector_math_.DotProduct(
+        quantized_state_,
+        recurrent_weights.subview(
+            g * stride_recurrent_weights + o * state_row_size,
+            state_row_size));
+    return bias_[g * output_size_ + o] + input_scale * static_cast<float>(x) +
+           state_scale * static_cast<float>(s);
+  };
+
+  // Update and reset gates.
+  std::array<float, kGruLayerMaxUnits> update;
+  std::array<float, kGruLayerMaxUnits> reset_x_state;
+  for (int o = 0; o < output_size_; ++o) {
+    update[o] = ::rnnoise::SigmoidApproximated(gate_input(0, o));
+    reset_x_state[o] =
+        state[o] * ::rnnoise::SigmoidApproximated(gate_input(1, o));
+  }
+  // State gate.
+  state_scale =
+      ::rnnoise::kWeightsScale *
+      QuantizeVector({reset_x_state.data(), static_cast<size_t>(output_size_)},
+                     quantized_state_);
+  for (int o = 0; o < output_size_; ++o) {
+    const float x = gate_input(2, o);
+    state[o] = update[o] * state[o] + (1.f - update[o]) * std::max(0.f, x);
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
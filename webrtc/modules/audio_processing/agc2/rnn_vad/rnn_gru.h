@@ -30,13 +30,17 @@ constexpr int kGruLayerMaxUnits = 24;
 class GatedRecurrentLayer {
  public:
   // Ctor. `output_size` cannot be greater than `kGruLayerMaxUnits`.
+  // If `quantized` is true, the weights are kept as 8-bit integers and the
+  // input and the state are quantized to 8 bits before being multiplied by
+  // them.
   GatedRecurrentLayer(int input_size,
                       int output_size,
                       rtc::ArrayView<const int8_t> bias,
                       rtc::ArrayView<const int8_t> weights,
                       rtc::ArrayView<const int8_t> recurrent_weights,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      bool quantized = false);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
   ~GatedRecurrentLayer();
@@ -47,6 +51,15 @@ class GatedRecurrentLayer {
   const float* data() const { return state_.data(); }
   // Returns the size of the output buffer.
   int size() const { return output_size_; }
+  // Returns the bias terms and the weights of the update, reset and output
+  // gates, in this order. Each gate has one row of `input_size()` weights and
+  // one row of `size()` recurrent weights per output. The weights are empty if
+  // the layer is quantized.
+  rtc::ArrayView<const float> bias() const { return bias_; }
+  rtc::ArrayView<const float> weights() const { return weights_; }
+  rtc::ArrayView<const float> recurrent_weights() const {
+    return recurrent_weights_;
+  }
 
   // Resets the GRU state.
   void Reset();
@@ -54,11 +67,22 @@ class GatedRecurrentLayer {
   void ComputeOutput(rtc::ArrayView<const float> input);
 
  private:
+  void ComputeOutputQuantized(rtc::ArrayView<const float> input);
+
   const int input_size_;
   const int output_size_;
+  const bool quantized_;
   const std::vector<float> bias_;
+  // Empty if `quantized_` is true.
   const std::vector<float> weights_;
   const std::vector<float> recurrent_weights_;
+  // Rows of `QuantizedSize(input_size_)` and `QuantizedSize(output_size_)`
+  // weights, respectively, one per gate and output. Empty if `quantized_` is
+  // false.
+  const std::vector<int8_t> quantized_weights_;
+  const std::vector<int8_t> quantized_recurrent_weights_;
+  std::vector<int8_t> quantized_input_;
+  std::vector<int8_t> quantized_state_;
   const VectorMath vector_math_;
   // Over-allocated array with size equal to `output_size_`.
   std::array<float, kGruLayerMaxUnits> state_;
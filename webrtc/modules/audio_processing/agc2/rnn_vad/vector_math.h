@@ -21,6 +21,8 @@
 #include <emmintrin.h>
 #endif
 
+#include <stdint.h>
+
 #include <numeric>
 
 #include "api/array_view.h"
@@ -103,9 +105,129 @@ class VectorMath {
     return std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
   }
 
+  // Computes the exact dot product between two equally sized vectors of 8-bit
+  // integers. The elements of `x` must be in [-127, 127].
+  int32_t DotProduct(rtc::ArrayView<const int8_t> x,
+                     rtc::ArrayView<const int8_t> y) const {
+    RTC_DCHECK_EQ(x.size(), y.size());
+    const int size = rtc::dchecked_cast<int>(x.size());
+    constexpr int kBlockSize = 16;
+    int32_t dot_product = 0;
+    int i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      return DotProductAvx2(x, y);
+    } else if (cpu_features_.sse2) {
+#if !defined(WAP_DISABLE_INLINE_SSE)
+      __m128i accumulator = _mm_setzero_si128();
+      for (; i + kBlockSize <= size; i += kBlockSize) {
+        const __m128i x_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        const __m128i y_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&y[i]));
+        // Sign-extend to 16 bits and multiply-add adjacent pairs.
+        const __m128i x_low = _mm_srai_epi16(_mm_unpacklo_epi8(x_i, x_i), 8);
+        const __m128i x_high = _mm_srai_epi16(_mm_unpackhi_epi8(x_i, x_i), 8);
+        const __m128i y_low = _mm_srai_epi16(_mm_unpacklo_epi8(y_i, y_i), 8);
+        const __m128i y_high = _mm_srai_epi16(_mm_unpackhi_epi8(y_i, y_i), 8);
+        accumulator =
+            _mm_add_epi32(accumulator, _mm_madd_epi16(x_low, y_low));
+        accumulator =
+            _mm_add_epi32(accumulator, _mm_madd_epi16(x_high, y_high));
+      }
+      // Reduce `accumulator` by addition.
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(1, 0, 3, 2)));
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(2, 3, 0, 1)));
+      dot_product = _mm_cvtsi128_si32(accumulator);
+#endif
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      int32x4_t accumulator = vdupq_n_s32(0);
+      for (; i + kBlockSize <= size; i += kBlockSize) {
+        const int8x16_t x_i = vld1q_s8(&x[i]);
+        const int8x16_t y_i = vld1q_s8(&y[i]);
+#if defined(__ARM_FEATURE_DOTPROD)
+        accumulator = vdotq_s32(accumulator, x_i, y_i);
+#else
+        accumulator = vpadalq_s16(
+            accumulator, vmull_s8(vget_low_s8(x_i), vget_low_s8(y_i)));
+        accumulator = vpadalq_s16(
+            accumulator, vmull_s8(vget_high_s8(x_i), vget_high_s8(y_i)));
+#endif
+      }
+      dot_product = vaddvq_s32(accumulator);
+    }
+#endif
+    // Add the result for the last block if incomplete.
+    for (; i < size; ++i) {
+      dot_product += static_cast<int32_t>(x[i]) * y[i];
+    }
+    return dot_product;
+  }
+
+  // Computes the exact dot product between two equally sized vectors of 16-bit
+  // and 8-bit integers. The size must be at most 512.
+  int32_t DotProduct(rtc::ArrayView<const int16_t> x,
+                     rtc::ArrayView<const int8_t> y) const {
+    RTC_DCHECK_EQ(x.size(), y.size());
+    RTC_DCHECK_LE(x.size(), 512);
+    const int size = rtc::dchecked_cast<int>(x.size());
+    constexpr int kBlockSize = 8;
+    int32_t dot_product = 0;
+    int i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      return DotProductAvx2(x, y);
+    } else if (cpu_features_.sse2) {
+#if !defined(WAP_DISABLE_INLINE_SSE)
+      __m128i accumulator = _mm_setzero_si128();
+      for (; i + kBlockSize <= size; i += kBlockSize) {
+        const __m128i x_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        __m128i y_i = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&y[i]));
+        // Sign-extend to 16 bits.
+        y_i = _mm_srai_epi16(_mm_unpacklo_epi8(y_i, y_i), 8);
+        accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(x_i, y_i));
+      }
+      // Reduce `accumulator` by addition.
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(1, 0, 3, 2)));
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(2, 3, 0, 1)));
+      dot_product = _mm_cvtsi128_si32(accumulator);
+#endif
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      int32x4_t accumulator = vdupq_n_s32(0);
+      for (; i + kBlockSize <= size; i += kBlockSize) {
+        const int16x8_t x_i = vld1q_s16(&x[i]);
+        const int16x8_t y_i = vmovl_s8(vld1_s8(&y[i]));
+        accumulator =
+            vmlal_s16(accumulator, vget_low_s16(x_i), vget_low_s16(y_i));
+        accumulator =
+            vmlal_s16(accumulator, vget_high_s16(x_i), vget_high_s16(y_i));
+      }
+      dot_product = vaddvq_s32(accumulator);
+    }
+#endif
+    // Add the result for the last block if incomplete.
+    for (; i < size; ++i) {
+      dot_product += static_cast<int32_t>(x[i]) * y[i];
+    }
+    return dot_product;
+  }
+
  private:
   float DotProductAvx2(rtc::ArrayView<const float> x,
                        rtc::ArrayView<const float> y) const;
+  int32_t DotProductAvx2(rtc::ArrayView<const int8_t> x,
+                         rtc::ArrayView<const int8_t> y) const;
+  int32_t DotProductAvx2(rtc::ArrayView<const int16_t> x,
+                         rtc::ArrayView<const int8_t> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
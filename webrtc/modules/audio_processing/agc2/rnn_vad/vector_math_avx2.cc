@@ -50,5 +50,77 @@ float VectorMath::DotProductAvx2(rtc::ArrayView<const float> x,
   return dot_product;
 }
 
+int32_t VectorMath::DotProductAvx2(rtc::ArrayView<const int8_t> x,
+                                   rtc::ArrayView<const int8_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const int size = rtc::dchecked_cast<int>(x.size());
+  // The unsigned by signed byte products are computed as `|y| * (x * sgn(y))`.
+  // Since `x` is in [-127, 127], the sums of pairs of products cannot saturate
+  // the 16-bit lanes.
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i accumulator = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i x_i =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i]));
+    const __m256i y_i =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&y[i]));
+    const __m256i products =
+        _mm256_maddubs_epi16(_mm256_abs_epi8(y_i), _mm256_sign_epi8(x_i, y_i));
+    accumulator =
+        _mm256_add_epi32(accumulator, _mm256_madd_epi16(products, ones));
+  }
+  __m128i low = _mm_add_epi32(_mm256_extracti128_si256(accumulator, 0),
+                              _mm256_extracti128_si256(accumulator, 1));
+  if (i + 16 <= size) {
+    const __m128i x_i =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+    const __m128i y_i =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&y[i]));
+    const __m128i products =
+        _mm_maddubs_epi16(_mm_abs_epi8(y_i), _mm_sign_epi8(x_i, y_i));
+    low = _mm_add_epi32(
+        low, _mm_madd_epi16(products, _mm256_castsi256_si128(ones)));
+    i += 16;
+  }
+  // Reduce `low` by addition.
+  low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+  low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+  int32_t dot_product = _mm_cvtsi128_si32(low);
+  // Add the result for the last block if incomplete.
+  for (; i < size; ++i) {
+    dot_product += static_cast<int32_t>(x[i]) * y[i];
+  }
+  return dot_product;
+}
+
+int32_t VectorMath::DotProductAvx2(rtc::ArrayView<const int16_t> x,
+                                   rtc::ArrayView<const int8_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const int size = rtc::dchecked_cast<int>(x.size());
+  __m256i accumulator = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m256i x_i =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i]));
+    const __m256i y_i = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&y[i])));
+    accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(x_i, y_i));
+  }
+  // Reduce `accumulator` by addition.
+  __m128i low = _mm_add_epi32(_mm256_extracti128_si256(accumulator, 0),
+                              _mm256_extracti128_si256(accumulator, 1));
+  low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+  low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+  int32_t dot_product = _mm_cvtsi128_si32(low);
+  // Add the result for the last block if incomplete.
+  for (; i < size; ++i) {
+    dot_product += static_cast<int32_t>(x[i]) * y[i];
+  }
+  return dot_product;
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
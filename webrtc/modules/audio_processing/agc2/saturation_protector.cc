@@ -55,6 +55,23 @@ void ResetSaturationProtectorState(float initial_headroom_db,
   state.time_since_push_ms = 0;
 }
 
+void SaveSaturationProtectorState(const SaturationProtectorState& state,
+                                  StateWriter* writer) {
+  writer->WriteFloat(state.headroom_db);
+  state.peak_delay_buffer.SaveState(writer);
+  writer->WriteFloat(state.max_peaks_dbfs);
+  writer->WriteInt(state.time_since_push_ms);
+}
+
+bool RestoreSaturationProtectorState(StateReader* reader,
+                                     SaturationProtectorState& state) {
+  return reader->ReadFloat(&state.headroom_db) &&
+         state.peak_delay_buffer.RestoreState(reader) &&
+         reader->ReadFloat(&state.max_peaks_dbfs) &&
+         reader->ReadInt(&state.time_since_push_ms) &&
+         state.time_since_push_ms >= 0;
+}
+
 // Updates `state` by analyzing the estimated speech level `speech_level_dbfs`
 // and the peak level `peak_dbfs` for an observed frame. `state` must not be
 // modified without calling this function.
@@ -151,6 +168,21 @@ class SaturationProtectorImpl : public SaturationProtector {
     ResetSaturationProtectorState(initial_headroom_db_, reliable_state_);
   }
 
+  void SaveState(StateWriter* writer) const override {
+    writer->WriteInt(num_adjacent_speech_frames_);
+    writer->WriteFloat(headroom_db_);
+    SaveSaturationProtectorState(preliminary_state_, writer);
+    SaveSaturationProtectorState(reliable_state_, writer);
+  }
+
+  bool RestoreState(StateReader* reader) override {
+    return reader->ReadInt(&num_adjacent_speech_frames_) &&
+           num_adjacent_speech_frames_ >= 0 &&
+           reader->ReadFloat(&headroom_db_) &&
+           RestoreSaturationProtectorState(reader, preliminary_state_) &&
+           RestoreSaturationProtectorState(reader, reliable_state_);
+  }
+
  private:
   void DumpDebugData() {
     apm_data_dumper_->DumpRaw(
@@ -13,6 +13,8 @@
 
 #include <memory>
 
+#include "modules/audio_processing/utility/state_serializer.h"
+
 namespace webrtc {
 class ApmDataDumper;
 
@@ -33,6 +35,10 @@ class SaturationProtector {
 
   // Resets the internal state.
   virtual void Reset() = 0;
+
+  // Saves and restores the internal state.
+  virtual void SaveState(StateWriter* writer) const = 0;
+  virtual bool RestoreState(StateReader* reader) = 0;
 };
 
 // Creates a saturation protector that starts at `initial_headroom_db`.
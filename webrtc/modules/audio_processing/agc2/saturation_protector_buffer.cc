@@ -74,4 +74,27 @@ int SaturationProtectorBuffer::FrontIndex() const {
   return rtc::SafeEq(size_, buffer_.size()) ? next_ : 0;
 }
 
+void SaturationProtectorBuffer::SaveState(StateWriter* writer) const {
+  writer->WriteSize(size_);
+  for (int i = 0, i0 = FrontIndex(); i < size_; ++i, ++i0) {
+    writer->WriteFloat(buffer_[i0 % buffer_.size()]);
+  }
+}
+
+bool SaturationProtectorBuffer::RestoreState(StateReader* reader) {
+  size_t size;
+  if (!reader->ReadSize(&size, buffer_.size())) {
+    return false;
+  }
+  Reset();
+  for (size_t i = 0; i < size; ++i) {
+    float v;
+    if (!reader->ReadFloat(&v)) {
+      return false;
+    }
+    PushBack(v);
+  }
+  return true;
+}
+
 }  // namespace webrtc
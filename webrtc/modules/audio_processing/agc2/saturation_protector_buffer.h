@@ -15,6 +15,7 @@
 #include <optional>
 
 #include "modules/audio_processing/agc2/agc2_common.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -45,6 +46,10 @@ class SaturationProtectorBuffer {
   // buffer is empty.
   std::optional<float> Front() const;
 
+  // Saves and restores the values in the buffer.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   int FrontIndex() const;
   // `buffer_` has `size_` elements (up to the size of `buffer_`) and `next_` is
@@ -149,6 +149,40 @@ void SpeechLevelEstimator::ResetLevelEstimatorState(
   state.level_dbfs.denominator = 1.0f;
 }
 
+void SpeechLevelEstimator::SaveState(StateWriter* writer) const {
+  SaveLevelEstimatorState(preliminary_state_, writer);
+  SaveLevelEstimatorState(reliable_state_, writer);
+  writer->WriteFloat(level_dbfs_);
+  writer->WriteBool(is_confident_);
+  writer->WriteInt(num_adjacent_speech_frames_);
+}
+
+bool SpeechLevelEstimator::RestoreState(StateReader* reader) {
+  return RestoreLevelEstimatorState(reader, preliminary_state_) &&
+         RestoreLevelEstimatorState(reader, reliable_state_) &&
+         reader->ReadFloat(&level_dbfs_) && reader->ReadBool(&is_confident_) &&
+         reader->ReadInt(&num_adjacent_speech_frames_) &&
+         num_adjacent_speech_frames_ >= 0;
+}
+
+void SpeechLevelEstimator::SaveLevelEstimatorState(
+    const LevelEstimatorState& state,
+    StateWriter* writer) {
+  writer->WriteInt(state.time_to_confidence_ms);
+  writer->WriteFloat(state.level_dbfs.numerator);
+  writer->WriteFloat(state.level_dbfs.denominator);
+}
+
+bool SpeechLevelEstimator::RestoreLevelEstimatorState(
+    StateReader* reader,
+    LevelEstimatorState& state) {
+  return reader->ReadInt(&state.time_to_confidence_ms) &&
+         state.time_to_confidence_ms >= 0 &&
+         reader->ReadFloat(&state.level_dbfs.numerator) &&
+         reader->ReadFloat(&state.level_dbfs.denominator) &&
+         state.level_dbfs.denominator > 0.f;
+}
+
 void SpeechLevelEstimator::DumpDebugData() const {
   if (!apm_data_dumper_)
     return;
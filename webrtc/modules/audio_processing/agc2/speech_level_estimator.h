@@ -17,6 +17,7 @@
 
 #include "api/audio/audio_processing.h"
 #include "modules/audio_processing/agc2/agc2_common.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 class ApmDataDumper;
@@ -42,6 +43,10 @@ class SpeechLevelEstimator {
 
   void Reset();
 
+  // Saves and restores the level estimates.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   // Part of the level estimator state used for check-pointing and restore ops.
   struct LevelEstimatorState {
@@ -62,6 +67,10 @@ class SpeechLevelEstimator {
   void UpdateIsConfident();
 
   void ResetLevelEstimatorState(LevelEstimatorState& state) const;
+  static void SaveLevelEstimatorState(const LevelEstimatorState& state,
+                                      StateWriter* writer);
+  static bool RestoreLevelEstimatorState(StateReader* reader,
+                                         LevelEstimatorState& state);
 
   void DumpDebugData() const;
 
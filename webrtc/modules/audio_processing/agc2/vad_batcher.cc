@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/vad_batcher.h"
+
+#include <array>
+#include <utility>
+
+#include "api/scoped_refptr.h"
+#include "modules/audio_processing/agc2/rnn_vad/features_extraction.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+class BatchedMonoVad : public VoiceActivityDetectorWrapper::MonoVad {
+ public:
+  BatchedMonoVad(rtc::scoped_refptr<VadBatcher> batcher,
+                 const AvailableCpuFeatures& cpu_features)
+      : batcher_(std::move(batcher)),
+        stream_(batcher_->AddStream()),
+        features_extractor_(cpu_features) {}
+  BatchedMonoVad(const BatchedMonoVad&) = delete;
+  BatchedMonoVad& operator=(const BatchedMonoVad&) = delete;
+  ~BatchedMonoVad() override { batcher_->RemoveStream(stream_); }
+
+  int SampleRateHz() const override { return rnn_vad::kSampleRate24kHz; }
+  void Reset() override { batcher_->ResetStream(stream_); }
+  void ResetForReuse() override {
+    features_extractor_.Reset();
+    batcher_->ResetStreamForReuse(stream_);
+  }
+  float Analyze(MonoView<const float> frame) override {
+    RTC_DCHECK_EQ(frame.size(), rnn_vad::kFrameSize10ms24kHz);
+    std::array<float, rnn_vad::kFeatureVectorSize> feature_vector;
+    const bool is_silence = features_extractor_.CheckSilenceComputeFeatures(
+        /*samples=*/{frame.data(), rnn_vad::kFrameSize10ms24kHz},
+        feature_vector);
+    return batcher_->Queue(stream_, feature_vector, is_silence);
+  }
+
+ private:
+  const rtc::scoped_refptr<VadBatcher> batcher_;
+  const int stream_;
+  rnn_vad::FeaturesExtractor features_extractor_;
+};
+
+}  // namespace
+
+VadBatcher::VadBatcher(const AvailableCpuFeatures& cpu_features)
+    : rnn_vad_(cpu_features) {}
+
+VadBatcher::~VadBatcher() = default;
+
+std::unique_ptr<VoiceActivityDetectorWrapper::MonoVad>
+VadBatcher::CreateMonoVad(const AvailableCpuFeatures& cpu_features) {
+  return std::make_unique<BatchedMonoVad>(rtc::scoped_refptr<VadBatcher>(this),
+                                          cpu_features);
+}
+
+int VadBatcher::AddStream() {
+  MutexLock lock(&mutex_);
+  return rnn_vad_.AddStream();
+}
+
+void VadBatcher::RemoveStream(int stream) {
+  MutexLock lock(&mutex_);
+  rnn_vad_.RemoveStream(stream);
+}
+
+void VadBatcher::ResetStream(int stream) {
+  MutexLock lock(&mutex_);
+  // The queued feature vector predates the reset.
+  if (rnn_vad_.HasFeatureVector(stream)) {
+    rnn_vad_.ComputeVadProbabilities();
+  }
+  rnn_vad_.ResetStream(stream);
+}
+
+void VadBatcher::ResetStreamForReuse(int stream) {
+  MutexLock lock(&mutex_);
+  // The feature vectors queued by the other streams are still evaluated.
+  if (rnn_vad_.HasFeatureVector(stream)) {
+    rnn_vad_.ComputeVadProbabilities();
+  }
+  rnn_vad_.ResetStreamForReuse(stream);
+}
+
+float VadBatcher::Queue(
+    int stream,
+    rtc::ArrayView<const float, rnn_vad::kFeatureVectorSize> feature_vector,
+    bool is_silence) {
+  MutexLock lock(&mutex_);
+  // A new tick has started: evaluate the feature vectors of the previous one.
+  if (rnn_vad_.HasFeatureVector(stream)) {
+    rnn_vad_.ComputeVadProbabilities();
+  }
+  rnn_vad_.SetFeatureVector(stream, feature_vector, is_silence);
+  return rnn_vad_.vad_probability(stream);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_VAD_BATCHER_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_VAD_BATCHER_H_
+
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/ref_counted_base.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/batched_rnn.h"
+#include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "modules/audio_processing/agc2/vad_wrapper.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares a BatchedRnnVad among the voice activity detectors of many AGC2
+// instances, e.g., those of the sessions of an AudioProcessingBatch. Each
+// detector extracts the features of its own frames, and the network is
+// evaluated for all the detectors at once when a detector queues a feature
+// vector while its previous one is still queued, that is, once per 10 ms tick.
+// As a consequence, the speech probabilities are one frame late. Thread-safe.
+class VadBatcher : public rtc::RefCountedNonVirtual<VadBatcher> {
+ public:
+  explicit VadBatcher(const AvailableCpuFeatures& cpu_features);
+  VadBatcher(const VadBatcher&) = delete;
+  VadBatcher& operator=(const VadBatcher&) = delete;
+  ~VadBatcher();
+
+  // Creates a voice activity detector whose network is evaluated by the
+  // batcher. The detector keeps a reference to the batcher.
+  std::unique_ptr<VoiceActivityDetectorWrapper::MonoVad> CreateMonoVad(
+      const AvailableCpuFeatures& cpu_features);
+
+  // Methods used by the detectors. Queue() queues the feature vector of a
+  // frame of `stream`, and returns the latest speech probability of `stream`.
+  int AddStream();
+  void RemoveStream(int stream);
+  void ResetStream(int stream);
+  void ResetStreamForReuse(int stream);
+  float Queue(int stream,
+              rtc::ArrayView<const float, rnn_vad::kFeatureVectorSize>
+                  feature_vector,
+              bool is_silence);
+
+ private:
+  Mutex mutex_;
+  rnn_vad::BatchedRnnVad rnn_vad_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_VAD_BATCHER_H_
@@ -27,14 +27,18 @@ constexpr int kNumFramesPerSecond = 100;
 
 class MonoVadImpl : public VoiceActivityDetectorWrapper::MonoVad {
  public:
-  explicit MonoVadImpl(const AvailableCpuFeatures& cpu_features)
-      : features_extractor_(cpu_features), rnn_vad_(cpu_features) {}
+  MonoVadImpl(const AvailableCpuFeatures& cpu_features, bool quantized)
+      : features_extractor_(cpu_features), rnn_vad_(cpu_features, quantized) {}
   MonoVadImpl(const MonoVadImpl&) = delete;
   MonoVadImpl& operator=(const MonoVadImpl&) = delete;
   ~MonoVadImpl() = default;
 
   int SampleRateHz() const override { return rnn_vad::kSampleRate24kHz; }
   void Reset() override { rnn_vad_.Reset(); }
+  void ResetForReuse() override {
+    features_extractor_.Reset();
+    rnn_vad_.Reset();
+  }
   float Analyze(MonoView<const float> frame) override {
     RTC_DCHECK_EQ(frame.size(), rnn_vad::kFrameSize10ms24kHz);
     std::array<float, rnn_vad::kFeatureVectorSize> feature_vector;
@@ -61,10 +65,12 @@ VoiceActivityDetectorWrapper::VoiceActivityDetectorWrapper(
 VoiceActivityDetectorWrapper::VoiceActivityDetectorWrapper(
     int vad_reset_period_ms,
     const AvailableCpuFeatures& cpu_features,
-    int sample_rate_hz)
-    : VoiceActivityDetectorWrapper(vad_reset_period_ms,
-                                   std::make_unique<MonoVadImpl>(cpu_features),
-                                   sample_rate_hz) {}
+    int sample_rate_hz,
+    bool quantized)
+    : VoiceActivityDetectorWrapper(
+          vad_reset_period_ms,
+          std::make_unique<MonoVadImpl>(cpu_features, quantized),
+          sample_rate_hz) {}
 
 VoiceActivityDetectorWrapper::VoiceActivityDetectorWrapper(
     int vad_reset_period_ms,
@@ -86,6 +92,12 @@ VoiceActivityDetectorWrapper::VoiceActivityDetectorWrapper(
 
 VoiceActivityDetectorWrapper::~VoiceActivityDetectorWrapper() = default;
 
+void VoiceActivityDetectorWrapper::Reset() {
+  time_to_vad_reset_ = vad_reset_period_frames_;
+  vad_->ResetForReuse();
+  resampler_.Reset();
+}
+
 float VoiceActivityDetectorWrapper::Analyze(
     DeinterleavedView<const float> frame) {
   // Periodically reset the VAD.
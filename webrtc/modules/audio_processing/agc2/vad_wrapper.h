@@ -35,6 +35,9 @@ class VoiceActivityDetectorWrapper {
     virtual int SampleRateHz() const = 0;
     // Resets the internal state.
     virtual void Reset() = 0;
+    // Resets the internal state and the features computed from the past
+    // frames, as in a new VAD.
+    virtual void ResetForReuse() = 0;
     // Analyzes an audio frame and returns the speech probability.
     virtual float Analyze(MonoView<const float> frame) = 0;
   };
@@ -45,10 +48,12 @@ class VoiceActivityDetectorWrapper {
 
   // Ctor. `vad_reset_period_ms` indicates the period in milliseconds to call
   // `MonoVad::Reset()`; it must be equal to or greater than the duration of two
-  // frames. Uses `cpu_features` to instantiate the default VAD.
+  // frames. Uses `cpu_features` to instantiate the default VAD, which runs
+  // with 8-bit integer weights and activations if `quantized` is true.
   VoiceActivityDetectorWrapper(int vad_reset_period_ms,
                                const AvailableCpuFeatures& cpu_features,
-                               int sample_rate_hz);
+                               int sample_rate_hz,
+                               bool quantized = false);
   // Ctor. Uses a custom `vad`.
   VoiceActivityDetectorWrapper(int vad_reset_period_ms,
                                std::unique_ptr<MonoVad> vad,
@@ -64,6 +69,9 @@ class VoiceActivityDetectorWrapper {
   // `Initialize()` call.
   float Analyze(DeinterleavedView<const float> frame);
 
+  // Resets the wrapped VAD and the resampler, as in a new wrapper.
+  void Reset();
+
  private:
   const int vad_reset_period_frames_;
   const int frame_size_;
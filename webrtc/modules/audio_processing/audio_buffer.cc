@@ -98,6 +98,33 @@ void AudioBuffer::set_downmixing_by_averaging() {
   downmix_by_averaging_ = true;
 }
 
+void AudioBuffer::set_float_two_band_splitting(bool enabled) {
+  if (num_bands_ == 2) {
+    splitting_filter_.reset(new SplittingFilter(
+        buffer_num_channels_, num_bands_, buffer_num_frames_, enabled));
+  }
+}
+
+void AudioBuffer::set_fma_three_band_splitting(bool enabled) {
+  if (num_bands_ == 3) {
+    splitting_filter_.reset(new SplittingFilter(
+        buffer_num_channels_, num_bands_, buffer_num_frames_,
+        /*float_two_bands=*/false, enabled));
+  }
+}
+
+void AudioBuffer::ResetFilterStates() {
+  for (auto& resampler : input_resamplers_) {
+    resampler->Reset();
+  }
+  for (auto& resampler : output_resamplers_) {
+    resampler->Reset();
+  }
+  if (splitting_filter_) {
+    splitting_filter_->Reset();
+  }
+}
+
 void AudioBuffer::CopyFrom(const float* const* stacked_data,
                            const StreamConfig& stream_config) {
   RTC_DCHECK_EQ(stream_config.num_frames(), input_num_frames_);
@@ -54,6 +54,18 @@ class AudioBuffer {
   // Specify that downmixing should be done by averaging all channels,.
   void set_downmixing_by_averaging();
 
+  // Specify whether the split into two frequency bands, done at 32 kHz, should
+  // use the floating point filter bank rather than the fixed-point one.
+  void set_float_two_band_splitting(bool enabled);
+
+  // Specify whether the split into three frequency bands, done at 48 kHz, may
+  // use the AVX2 kernels with fused multiply-adds.
+  void set_fma_three_band_splitting(bool enabled);
+
+  // Resets the states of the resamplers and of the band-splitting filter, so
+  // that the next frames are processed as by a new buffer.
+  void ResetFilterStates();
+
   // Set the number of channels in the buffer. The specified number of channels
   // cannot be larger than the specified buffer_num_channels. The number is also
   // reset at each call to CopyFrom or InterleaveFrom.
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/include/audio_processing_batch.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/vad_batcher.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/audio_processing_impl.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/trace_event.h"
+#include "system_wrappers/include/denormal_disabler.h"
+
+namespace webrtc {
+
+AudioProcessingBatch::AudioProcessingBatch(
+    const AudioProcessing::Config& config,
+    const StreamConfig& render_config,
+    const StreamConfig& capture_config,
+    size_t num_sessions)
+    : config_(config),
+      render_config_(render_config),
+      capture_config_(capture_config),
+      vad_batcher_(
+          rtc::make_ref_counted<VadBatcher>(GetAvailableCpuFeatures())) {
+  sessions_.reserve(num_sessions);
+  for (size_t i = 0; i < num_sessions; ++i) {
+    AddSession();
+  }
+}
+
+AudioProcessingBatch::~AudioProcessingBatch() = default;
+
+AudioProcessingBatch::SessionId AudioProcessingBatch::AddSession() {
+  auto session = rtc::make_ref_counted<AudioProcessingImpl>(
+      config_, /*capture_post_processor=*/nullptr,
+      /*render_pre_processor=*/nullptr, /*echo_control_factory=*/nullptr,
+      /*echo_detector=*/nullptr, /*capture_analyzer=*/nullptr);
+  session->SetVadBatcher(vad_batcher_);
+
+  // Initialize for the batch formats up front so that the first processed
+  // frame does not trigger a reinitialization.
+  ProcessingConfig processing_config;
+  processing_config.input_stream() = capture_config_;
+  processing_config.output_stream() = capture_config_;
+  processing_config.reverse_input_stream() = render_config_;
+  processing_config.reverse_output_stream() = render_config_;
+  session->Initialize(processing_config);
+  if (shared_render_) {
+    AttachSharedRender(*session);
+  }
+
+  const SessionId session_id = next_session_id_++;
+  sessions_.push_back({session_id, std::move(session)});
+  return session_id;
+}
+
+bool AudioProcessingBatch::RemoveSession(SessionId session_id) {
+  Session* session = FindSession(session_id);
+  if (!session) {
+    return false;
+  }
+  sessions_.erase(sessions_.begin() + (session - sessions_.data()));
+  return true;
+}
+
+std::vector<AudioProcessingBatch::SessionId> AudioProcessingBatch::session_ids()
+    const {
+  std::vector<SessionId> session_ids;
+  session_ids.reserve(sessions_.size());
+  for (const Session& session : sessions_) {
+    session_ids.push_back(session.id);
+  }
+  return session_ids;
+}
+
+AudioProcessing* AudioProcessingBatch::session(SessionId session_id) {
+  Session* session = FindSession(session_id);
+  return session ? session->apm.get() : nullptr;
+}
+
+AudioProcessingBatch::Session* AudioProcessingBatch::FindSession(
+    SessionId session_id) {
+  auto it = std::lower_bound(
+      sessions_.begin(), sessions_.end(), session_id,
+      [](const Session& session, SessionId id) { return session.id < id; });
+  if (it == sessions_.end() || it->id != session_id) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+bool AudioProcessingBatch::FramesMatchSessions(
+    rtc::ArrayView<const Frame> frames) const {
+  if (frames.size() != sessions_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < sessions_.size(); ++i) {
+    if (frames[i].session_id != sessions_[i].id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AudioProcessingBatch::AttachSharedRender(AudioProcessingImpl& session) {
+  if (!shared_render_analyzer_) {
+    shared_render_analyzer_ =
+        session.CreateSharedRenderAnalyzer(&shared_render_audio_);
+  }
+  if (shared_render_analyzer_) {
+    session.SetSharedRenderAnalyzer(shared_render_analyzer_);
+  }
+}
+
+int AudioProcessingBatch::ProcessStreams(rtc::ArrayView<Frame> frames) {
+  TRACE_EVENT0("webrtc", "AudioProcessingBatch::ProcessStreams");
+  if (!FramesMatchSessions(frames)) {
+    return AudioProcessing::kBadParameterError;
+  }
+  if (shared_render_) {
+    for (const Frame& frame : frames) {
+      if (frame.render_audio) {
+        return AudioProcessing::kBadParameterError;
+      }
+    }
+  }
+  DenormalDisabler denormal_disabler;
+  return ProcessSessions(frames, /*shared_render_audio=*/nullptr);
+}
+
+int AudioProcessingBatch::ProcessStreamsWithSharedRender(
+    const int16_t* render_audio,
+    rtc::ArrayView<Frame> frames) {
+  TRACE_EVENT0("webrtc",
+               "AudioProcessingBatch::ProcessStreamsWithSharedRender");
+  if (!render_audio || !FramesMatchSessions(frames)) {
+    return AudioProcessing::kBadParameterError;
+  }
+  for (const Frame& frame : frames) {
+    if (frame.render_audio) {
+      return AudioProcessing::kBadParameterError;
+    }
+  }
+  if (!shared_render_) {
+    shared_render_ = true;
+    for (Session& session : sessions_) {
+      AttachSharedRender(*session.apm);
+    }
+  }
+  DenormalDisabler denormal_disabler;
+
+  if (shared_render_analyzer_) {
+    shared_render_audio_->CopyFrom(render_audio, render_config_);
+    if (shared_render_audio_->num_bands() > 1) {
+      shared_render_audio_->SplitIntoFrequencyBands();
+    }
+    shared_render_analyzer_->AnalyzeRender(*shared_render_audio_);
+  }
+  return ProcessSessions(frames, render_audio);
+}
+
+int AudioProcessingBatch::ProcessSessions(rtc::ArrayView<Frame> frames,
+                                          const int16_t* shared_render_audio) {
+  int first_error = AudioProcessing::kNoError;
+  for (size_t i = 0; i < sessions_.size(); ++i) {
+    Frame& frame = frames[i];
+    frame.error = sessions_[i].apm->ProcessBatchedFrame(
+        render_config_, capture_config_, frame, shared_render_audio);
+    if (first_error == AudioProcessing::kNoError) {
+      first_error = frame.error;
+    }
+  }
+  return first_error;
+}
+
+}  // namespace webrtc
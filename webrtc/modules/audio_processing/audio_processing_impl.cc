@@ -13,17 +13,20 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/base/nullability.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "api/audio/audio_frame.h"
+#include "api/make_ref_counted.h"
 #include "api/task_queue/task_queue_base.h"
 #include "common_audio/audio_converter.h"
 #include "common_audio/include/audio_util.h"
@@ -116,6 +119,45 @@ static const size_t kMaxAllowedValuesOfSamplesPerFrame = 480;
 // reverse and forward call numbers.
 static const size_t kMaxNumFramesToBuffer = 100;
 
+// Identifies and versions the blobs of `SaveConvergedState()`. The identifier
+// is read back swapped on a machine with another byte order.
+constexpr int kConvergedStateIdentifier = 0x41504d53;  // "APMS".
+constexpr int kConvergedStateVersion = 1;
+
+// Writes the state of a submodule, if it is enabled, as a sized section that a
+// reader can skip.
+void WriteSubmoduleState(bool enabled,
+                         rtc::ArrayView<const uint8_t> submodule_state,
+                         StateWriter* writer) {
+  writer->WriteBool(enabled);
+  if (enabled) {
+    writer->WriteSize(submodule_state.size());
+    writer->WriteData(submodule_state);
+  }
+}
+
+// Reads a section written by `WriteSubmoduleState()`. `submodule_state` is left
+// empty if the submodule was not enabled.
+bool ReadSubmoduleState(
+    StateReader* reader,
+    std::optional<rtc::ArrayView<const uint8_t>>* submodule_state) {
+  bool enabled;
+  if (!reader->ReadBool(&enabled)) {
+    return false;
+  }
+  submodule_state->reset();
+  if (enabled) {
+    size_t num_bytes;
+    rtc::ArrayView<const uint8_t> data;
+    if (!reader->ReadSize(&num_bytes, std::numeric_limits<uint32_t>::max()) ||
+        !reader->ReadData(num_bytes, &data)) {
+      return false;
+    }
+    *submodule_state = data;
+  }
+  return true;
+}
+
 void PackRenderAudioBufferForEchoDetector(const AudioBuffer& audio,
                                           std::vector<float>& packed_buffer) {
   packed_buffer.clear();
@@ -304,6 +346,7 @@ int HandleUnsupportedAudioFormats(const float* const* src,
 }
 
 using DownmixMethod = AudioProcessing::Config::Pipeline::DownmixMethod;
+using Stage = AudioProcessingStats::Stage;
 
 void SetDownmixMethod(AudioBuffer& buffer, DownmixMethod method) {
   switch (method) {
@@ -510,24 +553,132 @@ void AudioProcessingImpl::MaybeInitializeRender(
   }
 
   MutexLock lock_capture(&mutex_capture_);
-  InitializeLocked(processing_config);
+  ReinitializeForFormatsLocked(processing_config);
 }
 
 void AudioProcessingImpl::InitializeLocked() {
   UpdateActiveSubmoduleStates();
 
-  const int render_audiobuffer_sample_rate_hz =
-      formats_.api_format.reverse_output_stream().num_frames() == 0
-          ? formats_.render_processing_format.sample_rate_hz()
-          : formats_.api_format.reverse_output_stream().sample_rate_hz();
+  InitializeRenderAudioBuffers();
+  InitializeCaptureAudioBuffers();
+
+  AllocateRenderQueue();
+
+  InitializeGainController1();
+  InitializeHighPassFilter(true);
+  InitializeResidualEchoDetector();
+  InitializeEchoController();
+  InitializeGainController2();
+  InitializeNoiseSuppressor();
+  InitializeAnalyzer();
+  InitializePostProcessor();
+  InitializePreProcessor();
+  InitializeCaptureLevelsAdjuster();
+  InitializeStageTiming();
+
+  if (aec_dump_) {
+    aec_dump_->WriteInitMessage(formats_.api_format, rtc::TimeUTCMillis());
+  }
+}
+
+void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
+  UpdateActiveSubmoduleStates();
+  UpdateFormatsLocked(config, /*preferred_capture_processing_rate=*/0);
+  InitializeLocked();
+}
+
+void AudioProcessingImpl::ReinitializeForFormatsLocked(
+    const ProcessingConfig& config) {
+  if (UpdateActiveSubmoduleStates()) {
+    InitializeLocked(config);
+    return;
+  }
+
+  const ProcessingConfig old_api_format = formats_.api_format;
+  const SubmoduleFormats old_formats = GetSubmoduleFormats();
+
+  // Keep processing at the current rate when the formats no longer require
+  // it, so that a lower output rate does not reset the rate-dependent
+  // submodules.
+  UpdateFormatsLocked(config, old_formats.proc_sample_rate_hz);
+
+  if (formats_.api_format.reverse_input_stream() !=
+          old_api_format.reverse_input_stream() ||
+      formats_.api_format.reverse_output_stream() !=
+          old_api_format.reverse_output_stream() ||
+      formats_.render_processing_format !=
+          old_formats.render_processing_format) {
+    InitializeRenderAudioBuffers();
+  }
+  if (formats_.api_format.input_stream() != old_api_format.input_stream() ||
+      formats_.api_format.output_stream() != old_api_format.output_stream() ||
+      proc_sample_rate_hz() != old_formats.proc_sample_rate_hz) {
+    InitializeCaptureAudioBuffers();
+  }
+
+  const SubmoduleFormats new_formats = GetSubmoduleFormats();
+  const bool proc_format_changed =
+      new_formats.proc_sample_rate_hz != old_formats.proc_sample_rate_hz ||
+      new_formats.num_proc_channels != old_formats.num_proc_channels;
+  const bool fullband_rate_changed =
+      new_formats.proc_fullband_sample_rate_hz !=
+      old_formats.proc_fullband_sample_rate_hz;
+  const bool render_format_changed =
+      new_formats.render_processing_format !=
+      old_formats.render_processing_format;
+  const bool output_channels_changed =
+      new_formats.num_output_channels != old_formats.num_output_channels;
+
+  // The render queues hold audio in the render processing format, for the
+  // capture side submodules that are reinitialized below.
+  if (render_format_changed ||
+      new_formats.proc_sample_rate_hz != old_formats.proc_sample_rate_hz) {
+    AllocateRenderQueue();
+  }
+
+  if (proc_format_changed) {
+    InitializeGainController1();
+  }
+  InitializeHighPassFilter(false);
+  if (fullband_rate_changed || render_format_changed) {
+    InitializeResidualEchoDetector();
+  }
+  // AEC3 processes the mono or multichannel processing format, whereas an
+  // injected echo controller and AECM process all the output channels.
+  if (proc_format_changed || render_format_changed ||
+      (output_channels_changed &&
+       (echo_control_factory_ || config_.echo_canceller.mobile_mode))) {
+    InitializeEchoController();
+  }
+  if (fullband_rate_changed || output_channels_changed) {
+    InitializeGainController2();
+  }
+  if (proc_format_changed) {
+    InitializeNoiseSuppressor();
+  }
+  if (fullband_rate_changed || proc_format_changed) {
+    InitializeAnalyzer();
+    InitializePostProcessor();
+  }
+  if (render_format_changed) {
+    InitializePreProcessor();
+  }
+
+  if (aec_dump_) {
+    aec_dump_->WriteInitMessage(formats_.api_format, rtc::TimeUTCMillis());
+  }
+}
+
+AudioProcessingImpl::SubmoduleFormats AudioProcessingImpl::GetSubmoduleFormats()
+    const {
+  return {proc_sample_rate_hz(), proc_fullband_sample_rate_hz(),
+          num_proc_channels(), num_output_channels(),
+          formats_.render_processing_format};
+}
+
+void AudioProcessingImpl::InitializeRenderAudioBuffers() {
   if (formats_.api_format.reverse_input_stream().num_channels() > 0) {
-    render_.render_audio.reset(new AudioBuffer(
-        formats_.api_format.reverse_input_stream().sample_rate_hz(),
-        formats_.api_format.reverse_input_stream().num_channels(),
-        formats_.render_processing_format.sample_rate_hz(),
-        formats_.render_processing_format.num_channels(),
-        render_audiobuffer_sample_rate_hz,
-        formats_.render_processing_format.num_channels()));
+    render_.render_audio = CreateRenderAudioBuffer();
     if (formats_.api_format.reverse_input_stream() !=
         formats_.api_format.reverse_output_stream()) {
       render_.render_converter = AudioConverter::Create(
@@ -542,7 +693,9 @@ void AudioProcessingImpl::InitializeLocked() {
     render_.render_audio.reset(nullptr);
     render_.render_converter.reset(nullptr);
   }
+}
 
+void AudioProcessingImpl::InitializeCaptureAudioBuffers() {
   capture_.capture_audio.reset(new AudioBuffer(
       formats_.api_format.input_stream().sample_rate_hz(),
       formats_.api_format.input_stream().num_channels(),
@@ -552,6 +705,10 @@ void AudioProcessingImpl::InitializeLocked() {
       formats_.api_format.output_stream().num_channels()));
   SetDownmixMethod(*capture_.capture_audio,
                    config_.pipeline.capture_downmix_method);
+  capture_.capture_audio->set_float_two_band_splitting(
+      config_.pipeline.float_two_band_splitting);
+  capture_.capture_audio->set_fma_three_band_splitting(
+      config_.pipeline.fma_three_band_splitting);
 
   if (capture_nonlocked_.capture_processing_format.sample_rate_hz() <
           formats_.api_format.output_stream().sample_rate_hz() &&
@@ -568,28 +725,11 @@ void AudioProcessingImpl::InitializeLocked() {
   } else {
     capture_.capture_fullband_audio.reset();
   }
-
-  AllocateRenderQueue();
-
-  InitializeGainController1();
-  InitializeHighPassFilter(true);
-  InitializeResidualEchoDetector();
-  InitializeEchoController();
-  InitializeGainController2();
-  InitializeNoiseSuppressor();
-  InitializeAnalyzer();
-  InitializePostProcessor();
-  InitializePreProcessor();
-  InitializeCaptureLevelsAdjuster();
-
-  if (aec_dump_) {
-    aec_dump_->WriteInitMessage(formats_.api_format, rtc::TimeUTCMillis());
-  }
 }
 
-void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
-  UpdateActiveSubmoduleStates();
-
+void AudioProcessingImpl::UpdateFormatsLocked(
+    const ProcessingConfig& config,
+    int preferred_capture_processing_rate) {
   formats_.api_format = config;
 
   // Choose maximum rate to use for the split filtering.
@@ -600,12 +740,22 @@ void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
     max_splitting_rate = config_.pipeline.maximum_internal_processing_rate;
   }
 
+  const bool band_splitting_required =
+      submodule_states_.CaptureMultiBandSubModulesActive() ||
+      submodule_states_.RenderMultiBandSubModulesActive();
   int capture_processing_rate = SuitableProcessRate(
       std::min(formats_.api_format.input_stream().sample_rate_hz(),
                formats_.api_format.output_stream().sample_rate_hz()),
-      max_splitting_rate,
-      submodule_states_.CaptureMultiBandSubModulesActive() ||
-          submodule_states_.RenderMultiBandSubModulesActive());
+      max_splitting_rate, band_splitting_required);
+  // A higher preferred rate is used as long as the input stream is not
+  // upsampled to it.
+  if (preferred_capture_processing_rate > capture_processing_rate &&
+      preferred_capture_processing_rate <=
+          SuitableProcessRate(
+              formats_.api_format.input_stream().sample_rate_hz(),
+              max_splitting_rate, band_splitting_required)) {
+    capture_processing_rate = preferred_capture_processing_rate;
+  }
   RTC_DCHECK_NE(8000, capture_processing_rate);
 
   capture_nonlocked_.capture_processing_format =
@@ -616,9 +766,7 @@ void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
     render_processing_rate = SuitableProcessRate(
         std::min(formats_.api_format.reverse_input_stream().sample_rate_hz(),
                  formats_.api_format.reverse_output_stream().sample_rate_hz()),
-        max_splitting_rate,
-        submodule_states_.CaptureMultiBandSubModulesActive() ||
-            submodule_states_.RenderMultiBandSubModulesActive());
+        max_splitting_rate, band_splitting_required);
   } else {
     render_processing_rate = capture_processing_rate;
   }
@@ -661,8 +809,45 @@ void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
     capture_nonlocked_.split_rate =
         capture_nonlocked_.capture_processing_format.sample_rate_hz();
   }
+}
 
-  InitializeLocked();
+void AudioProcessingImpl::SetVadBatcher(
+    rtc::scoped_refptr<VadBatcher> vad_batcher) {
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  vad_batcher_ = std::move(vad_batcher);
+  if (config_.gain_controller2.batched_vad) {
+    InitializeGainController2();
+  }
+}
+
+rtc::scoped_refptr<SharedRenderAnalyzer>
+AudioProcessingImpl::CreateSharedRenderAnalyzer(
+    std::unique_ptr<AudioBuffer>* render_audio) {
+  RTC_DCHECK(render_audio);
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  if (echo_control_factory_ || !submodules_.echo_controller ||
+      formats_.api_format.reverse_input_stream().num_channels() == 0) {
+    return nullptr;
+  }
+  EchoCanceller3Config config;
+  std::optional<EchoCanceller3Config> multichannel_config;
+  GetEchoCanceller3Configs(&config, &multichannel_config);
+  *render_audio = CreateRenderAudioBuffer();
+  return rtc::make_ref_counted<SharedRenderAnalyzer>(
+      config, multichannel_config, proc_sample_rate_hz(),
+      num_reverse_channels());
+}
+
+void AudioProcessingImpl::SetSharedRenderAnalyzer(
+    rtc::scoped_refptr<SharedRenderAnalyzer> shared_render_analyzer) {
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  shared_render_analyzer_ = std::move(shared_render_analyzer);
+  if (submodules_.echo_controller && !echo_control_factory_) {
+    InitializeEchoController();
+  }
 }
 
 void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
@@ -680,11 +865,18 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.pipeline.maximum_internal_processing_rate !=
           config.pipeline.maximum_internal_processing_rate ||
       config_.pipeline.capture_downmix_method !=
-          config.pipeline.capture_downmix_method;
+          config.pipeline.capture_downmix_method ||
+      config_.pipeline.float_two_band_splitting !=
+          config.pipeline.float_two_band_splitting ||
+      config_.pipeline.fma_three_band_splitting !=
+          config.pipeline.fma_three_band_splitting;
 
   const bool aec_config_changed =
       config_.echo_canceller.enabled != config.echo_canceller.enabled ||
-      config_.echo_canceller.mobile_mode != config.echo_canceller.mobile_mode;
+      config_.echo_canceller.mobile_mode != config.echo_canceller.mobile_mode ||
+      config_.echo_canceller.capture_channel_worker_threads !=
+          config.echo_canceller.capture_channel_worker_threads ||
+      config_.echo_canceller.use_pffft != config.echo_canceller.use_pffft;
 
   const bool agc1_config_changed =
       config_.gain_controller1 != config.gain_controller1;
@@ -694,7 +886,8 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
 
   const bool ns_config_changed =
       config_.noise_suppression.enabled != config.noise_suppression.enabled ||
-      config_.noise_suppression.level != config.noise_suppression.level;
+      config_.noise_suppression.level != config.noise_suppression.level ||
+      config_.noise_suppression.use_pffft != config.noise_suppression.use_pffft;
 
   const bool pre_amplifier_config_changed =
       config_.pre_amplifier.enabled != config.pre_amplifier.enabled ||
@@ -705,6 +898,7 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.capture_level_adjustment != config.capture_level_adjustment;
 
   config_ = config;
+  InitializeStageTiming();
 
   if (aec_config_changed) {
     InitializeEchoController();
@@ -737,9 +931,16 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
 
   // Reinitialization must happen after all submodule configuration to avoid
   // additional reinitializations on the next capture / render processing call.
-  if (pipeline_config_changed) {
+  // A change of the active submodules is applied here too, rather than on the
+  // next capture call, which would discard the render audio queued since and
+  // any converged state restored since.
+  if (pipeline_config_changed || UpdateActiveSubmoduleStates()) {
     InitializeLocked(formats_.api_format);
   }
+
+  // Record every applied config, since the changed fields need not be among
+  // those compared to detect changes.
+  WriteAecDumpConfigMessage(true);
 }
 
 int AudioProcessingImpl::proc_sample_rate_hz() const {
@@ -868,32 +1069,30 @@ void AudioProcessingImpl::MaybeInitializeCapture(
     const StreamConfig& input_config,
     const StreamConfig& output_config) {
   ProcessingConfig processing_config;
-  bool reinitialization_required = false;
+  bool submodule_states_changed = false;
   {
     // Acquire the capture lock in order to access api_format. The lock is
     // released immediately, as we may need to acquire the render lock as part
     // of the conditional reinitialization.
     MutexLock lock_capture(&mutex_capture_);
     processing_config = formats_.api_format;
-    reinitialization_required = UpdateActiveSubmoduleStates();
-  }
-
-  if (processing_config.input_stream() != input_config) {
-    reinitialization_required = true;
+    submodule_states_changed = UpdateActiveSubmoduleStates();
   }
 
-  if (processing_config.output_stream() != output_config) {
-    reinitialization_required = true;
-  }
-
-  if (reinitialization_required) {
+  if (submodule_states_changed ||
+      processing_config.input_stream() != input_config ||
+      processing_config.output_stream() != output_config) {
     MutexLock lock_render(&mutex_render_);
     MutexLock lock_capture(&mutex_capture_);
     // Reread the API format since the render format may have changed.
     processing_config = formats_.api_format;
     processing_config.input_stream() = input_config;
     processing_config.output_stream() = output_config;
-    InitializeLocked(processing_config);
+    if (submodule_states_changed) {
+      InitializeLocked(processing_config);
+    } else {
+      ReinitializeForFormatsLocked(processing_config);
+    }
   }
 }
 
@@ -1067,54 +1266,40 @@ void AudioProcessingImpl::HandleRenderRuntimeSettings() {
   }
 }
 
-void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
+bool AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
   RTC_DCHECK_GE(160, audio->num_frames_per_band());
 
+  // A full queue means that the capture side has not kept up. The frame is
+  // dropped from that queue rather than waiting for the capture lock.
+  bool queue_overrun = false;
   if (submodules_.echo_control_mobile) {
     EchoControlMobileImpl::PackRenderAudioBuffer(audio, num_output_channels(),
                                                  num_reverse_channels(),
                                                  &aecm_render_queue_buffer_);
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
-    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result =
-          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    queue_overrun |=
+        !aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
   }
 
   if (!submodules_.agc_manager && submodules_.gain_control) {
     GainControlImpl::PackRenderAudioBuffer(*audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
-    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    queue_overrun |=
+        !agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
   }
+  return !queue_overrun;
 }
 
-void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
+bool AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
   if (submodules_.echo_detector) {
     PackRenderAudioBufferForEchoDetector(*audio, red_render_queue_buffer_);
     RTC_DCHECK(red_render_signal_queue_);
-    // Insert the samples into the queue.
-    if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    // Insert the samples into the queue. A full queue means that the capture
+    // side has not kept up, and the frame is dropped from it.
+    return red_render_signal_queue_->Insert(&red_render_queue_buffer_);
   }
+  return true;
 }
 
 void AudioProcessingImpl::AllocateRenderQueue() {
@@ -1169,11 +1354,6 @@ void AudioProcessingImpl::AllocateRenderQueue() {
   }
 }
 
-void AudioProcessingImpl::EmptyQueuedRenderAudio() {
-  MutexLock lock_capture(&mutex_capture_);
-  EmptyQueuedRenderAudioLocked();
-}
-
 void AudioProcessingImpl::EmptyQueuedRenderAudioLocked() {
   if (submodules_.echo_control_mobile) {
     RTC_DCHECK(aecm_render_signal_queue_);
@@ -1234,6 +1414,11 @@ int AudioProcessingImpl::ProcessStream(const int16_t* const src,
 }
 
 int AudioProcessingImpl::ProcessCaptureStreamLocked() {
+  StageTimer* const timer =
+      config_.stage_timing.enabled ? &capture_stage_timer_ : nullptr;
+  StageTimer::ScopedTiming capture_timing(timer, Stage::kCapture,
+                                          /*end_frame=*/true);
+
   EmptyQueuedRenderAudioLocked();
   HandleCaptureRuntimeSettings();
   DenormalDisabler denormal_disabler;
@@ -1254,11 +1439,13 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodules_.high_pass_filter &&
       config_.high_pass_filter.apply_in_full_band &&
       !constants_.enforce_split_band_hpf) {
+    StageTimer::ScopedTiming timing(timer, Stage::kHighPassFilter);
     submodules_.high_pass_filter->Process(capture_buffer,
                                           /*use_split_band_data=*/false);
   }
 
   if (submodules_.capture_levels_adjuster) {
+    StageTimer::ScopedTiming timing(timer, Stage::kCaptureLevelsAdjuster);
     if (config_.capture_level_adjustment.analog_mic_gain_emulation.enabled) {
       // When the input volume is emulated, retrieve the volume applied to the
       // input audio and notify that to APM so that the volume is passed to the
@@ -1311,15 +1498,18 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
          capture_.prev_playout_volume >= 0);
     capture_.prev_playout_volume = capture_.playout_volume;
 
+    StageTimer::ScopedTiming timing(timer, Stage::kEchoControllerAnalyze);
     submodules_.echo_controller->AnalyzeCapture(capture_buffer);
   }
 
   if (submodules_.agc_manager) {
+    StageTimer::ScopedTiming timing(timer, Stage::kGainController1);
     submodules_.agc_manager->AnalyzePreProcess(*capture_buffer);
   }
 
   if (submodules_.gain_controller2 &&
       config_.gain_controller2.input_volume_controller.enabled) {
+    StageTimer::ScopedTiming timing(timer, Stage::kGainController2);
     // Expect the volume to be available if the input controller is enabled.
     RTC_DCHECK(capture_.applied_input_volume.has_value());
     if (capture_.applied_input_volume.has_value()) {
@@ -1331,6 +1521,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodule_states_.CaptureMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
+    StageTimer::ScopedTiming timing(timer, Stage::kBandSplitting);
     capture_buffer->SplitIntoFrequencyBands();
   }
 
@@ -1347,11 +1538,13 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodules_.high_pass_filter &&
       (!config_.high_pass_filter.apply_in_full_band ||
        constants_.enforce_split_band_hpf)) {
+    StageTimer::ScopedTiming timing(timer, Stage::kHighPassFilter);
     submodules_.high_pass_filter->Process(capture_buffer,
                                           /*use_split_band_data=*/true);
   }
 
   if (submodules_.gain_control) {
+    StageTimer::ScopedTiming timing(timer, Stage::kGainController1);
     RETURN_ON_ERR(
         submodules_.gain_control->AnalyzeCaptureAudio(*capture_buffer));
   }
@@ -1359,6 +1552,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if ((!config_.noise_suppression.analyze_linear_aec_output_when_available ||
        !linear_aec_buffer || submodules_.echo_control_mobile) &&
       submodules_.noise_suppressor) {
+    StageTimer::ScopedTiming timing(timer, Stage::kNoiseSuppressorAnalyze);
     submodules_.noise_suppressor->Analyze(*capture_buffer);
   }
 
@@ -1370,9 +1564,11 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.noise_suppressor) {
+      StageTimer::ScopedTiming timing(timer, Stage::kNoiseSuppressorProcess);
       submodules_.noise_suppressor->Process(capture_buffer);
     }
 
+    StageTimer::ScopedTiming timing(timer, Stage::kEchoControllerProcess);
     RETURN_ON_ERR(submodules_.echo_control_mobile->ProcessCaptureAudio(
         capture_buffer, stream_delay_ms()));
   } else {
@@ -1383,21 +1579,25 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
         submodules_.echo_controller->SetAudioBufferDelay(stream_delay_ms());
       }
 
+      StageTimer::ScopedTiming timing(timer, Stage::kEchoControllerProcess);
       submodules_.echo_controller->ProcessCapture(
           capture_buffer, linear_aec_buffer, capture_.echo_path_gain_change);
     }
 
     if (config_.noise_suppression.analyze_linear_aec_output_when_available &&
         linear_aec_buffer && submodules_.noise_suppressor) {
+      StageTimer::ScopedTiming timing(timer, Stage::kNoiseSuppressorAnalyze);
       submodules_.noise_suppressor->Analyze(*linear_aec_buffer);
     }
 
     if (submodules_.noise_suppressor) {
+      StageTimer::ScopedTiming timing(timer, Stage::kNoiseSuppressorProcess);
       submodules_.noise_suppressor->Process(capture_buffer);
     }
   }
 
   if (submodules_.agc_manager) {
+    StageTimer::ScopedTiming timing(timer, Stage::kGainController1);
     submodules_.agc_manager->Process(*capture_buffer);
 
     std::optional<int> new_digital_gain =
@@ -1409,6 +1609,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
 
   if (submodules_.gain_control) {
     // TODO(peah): Add reporting from AEC3 whether there is echo.
+    StageTimer::ScopedTiming timing(timer, Stage::kGainController1);
     RETURN_ON_ERR(submodules_.gain_control->ProcessCaptureAudio(
         capture_buffer, /*stream_has_echo*/ false));
   }
@@ -1416,6 +1617,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodule_states_.CaptureMultiBandProcessingPresent() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
+    StageTimer::ScopedTiming timing(timer, Stage::kBandMerging);
     capture_buffer->MergeFrequencyBands();
   }
 
@@ -1443,6 +1645,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.gain_controller2) {
+      StageTimer::ScopedTiming timing(timer, Stage::kGainController2);
       // TODO(bugs.webrtc.org/7494): Let AGC2 detect applied input volume
       // changes.
       submodules_.gain_controller2->Process(
@@ -1494,6 +1697,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
 
   if (submodules_.capture_levels_adjuster) {
+    StageTimer::ScopedTiming timing(timer, Stage::kCaptureLevelsAdjuster);
     submodules_.capture_levels_adjuster->ApplyPostLevelAdjustment(
         *capture_buffer);
 
@@ -1608,8 +1812,8 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
   MaybeInitializeRender(input_config, output_config);
 
   if (aec_dump_) {
-    aec_dump_->WriteRenderStreamMessage(src, input_config.num_frames(),
-                                        input_config.num_channels());
+    aec_dump_->WriteRenderStreamMessage(src, input_config.num_channels(),
+                                        input_config.num_frames());
   }
 
   render_.render_audio->CopyFrom(src, input_config);
@@ -1622,6 +1826,9 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
 }
 
 int AudioProcessingImpl::ProcessRenderStreamLocked() {
+  StageTimer::ScopedTiming render_timing(
+      config_.stage_timing.enabled ? &render_stage_timer_ : nullptr,
+      Stage::kRender, /*end_frame=*/true);
   AudioBuffer* render_buffer = render_.render_audio.get();  // For brevity.
 
   HandleRenderRuntimeSettings();
@@ -1631,7 +1838,8 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
     submodules_.render_pre_processor->Process(render_buffer);
   }
 
-  QueueNonbandedRenderAudio(render_buffer);
+  // A frame dropped from several queues is counted as one overrun.
+  bool queue_overrun = !QueueNonbandedRenderAudio(render_buffer);
 
   if (submodule_states_.RenderMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
@@ -1640,11 +1848,14 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
   }
 
   if (submodule_states_.RenderMultiBandSubModulesActive()) {
-    QueueBandedRenderAudio(render_buffer);
+    queue_overrun |= !QueueBandedRenderAudio(render_buffer);
+  }
+  if (queue_overrun) {
+    render_queue_overruns_.fetch_add(1, std::memory_order_relaxed);
   }
 
   // TODO(peah): Perform the queuing inside QueueRenderAudiuo().
-  if (submodules_.echo_controller) {
+  if (submodules_.echo_controller && !echo_controller_uses_shared_render_) {
     submodules_.echo_controller->AnalyzeRender(render_buffer);
   }
 
@@ -1657,8 +1868,127 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
   return kNoError;
 }
 
+int AudioProcessingImpl::ProcessBatchedFrame(
+    const StreamConfig& render_config,
+    const StreamConfig& capture_config,
+    AudioProcessingBatch::Frame& frame,
+    const int16_t* shared_render_audio) {
+  TRACE_EVENT0("webrtc", "AudioProcessing::ProcessBatchedFrame");
+  RTC_DCHECK(!frame.render_audio || !shared_render_audio);
+  if (!frame.capture_audio) {
+    return kNullPointerError;
+  }
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  DenormalDisabler denormal_disabler;
+
+  ProcessingConfig processing_config = formats_.api_format;
+  int render_error = kNoError;
+  if (frame.render_audio) {
+    render_error = HandleUnsupportedAudioFormats(
+        frame.render_audio, render_config, render_config, frame.render_audio);
+    if (render_error == kNoError) {
+      processing_config.reverse_input_stream() = render_config;
+      processing_config.reverse_output_stream() = render_config;
+    }
+  } else if (shared_render_audio) {
+    processing_config.reverse_input_stream() = render_config;
+    processing_config.reverse_output_stream() = render_config;
+  }
+  RETURN_ON_ERR(HandleUnsupportedAudioFormats(
+      frame.capture_audio, capture_config, capture_config,
+      frame.capture_audio));
+  processing_config.input_stream() = capture_config;
+  processing_config.output_stream() = capture_config;
+
+  if (UpdateActiveSubmoduleStates()) {
+    InitializeLocked(processing_config);
+  } else if (processing_config != formats_.api_format) {
+    ReinitializeForFormatsLocked(processing_config);
+  }
+
+  if (frame.render_audio && render_error == kNoError) {
+    // Hand any pending render audio over to the capture-side submodules first.
+    // This guarantees room in the render queues, so that the render frame of
+    // this batch entry is never dropped.
+    EmptyQueuedRenderAudioLocked();
+
+    if (aec_dump_) {
+      aec_dump_->WriteRenderStreamMessage(frame.render_audio,
+                                          render_config.num_channels(),
+                                          render_config.num_frames());
+    }
+    render_.render_audio->CopyFrom(frame.render_audio, render_config);
+    render_error = ProcessRenderStreamLocked();
+    if (render_error == kNoError &&
+        (submodule_states_.RenderMultiBandProcessingActive() ||
+         submodule_states_.RenderFullBandProcessingActive())) {
+      render_.render_audio->CopyTo(render_config, frame.render_audio);
+    }
+  } else if (shared_render_audio) {
+    EmptyQueuedRenderAudioLocked();
+
+    if (aec_dump_) {
+      aec_dump_->WriteRenderStreamMessage(shared_render_audio,
+                                          render_config.num_channels(),
+                                          render_config.num_frames());
+    }
+    // The echo controller reads the analysis of the shared render analyzer,
+    // so the render frame only needs to be processed here for the other
+    // render-side submodules.
+    const bool render_processing_needed =
+        !echo_controller_uses_shared_render_ ||
+        submodules_.render_pre_processor || submodules_.echo_detector ||
+        submodules_.gain_control || submodules_.echo_control_mobile;
+    if (render_processing_needed) {
+      render_.render_audio->CopyFrom(shared_render_audio, render_config);
+      render_error = ProcessRenderStreamLocked();
+    } else {
+      HandleRenderRuntimeSettings();
+    }
+  }
+
+  if (frame.stream_delay_ms) {
+    set_stream_delay_ms_locked(*frame.stream_delay_ms);
+  }
+  if (frame.applied_input_volume) {
+    set_stream_analog_level_locked(*frame.applied_input_volume);
+  }
+
+  if (aec_dump_) {
+    RecordUnprocessedCaptureStream(frame.capture_audio, capture_config);
+  }
+
+  capture_.capture_audio->CopyFrom(frame.capture_audio, capture_config);
+  if (capture_.capture_fullband_audio) {
+    capture_.capture_fullband_audio->CopyFrom(frame.capture_audio,
+                                              capture_config);
+  }
+  RETURN_ON_ERR(ProcessCaptureStreamLocked());
+  if (submodule_states_.CaptureMultiBandProcessingPresent() ||
+      submodule_states_.CaptureFullBandProcessingActive()) {
+    if (capture_.capture_fullband_audio) {
+      capture_.capture_fullband_audio->CopyTo(capture_config,
+                                              frame.capture_audio);
+    } else {
+      capture_.capture_audio->CopyTo(capture_config, frame.capture_audio);
+    }
+  }
+
+  if (aec_dump_) {
+    RecordProcessedCaptureStream(frame.capture_audio, capture_config);
+  }
+
+  frame.recommended_input_volume = capture_.recommended_input_volume;
+  return render_error;
+}
+
 int AudioProcessingImpl::set_stream_delay_ms(int delay) {
   MutexLock lock(&mutex_capture_);
+  return set_stream_delay_ms_locked(delay);
+}
+
+int AudioProcessingImpl::set_stream_delay_ms_locked(int delay) {
   Error retval = kNoError;
   capture_.was_stream_delay_set = true;
 
@@ -1836,13 +2166,233 @@ void AudioProcessingImpl::DetachAecDump() {
   }
 }
 
+AudioProcessingStats AudioProcessingImpl::GetStatistics() {
+  AudioProcessingStats stats = stats_reporter_.GetStatistics();
+  // The render side counters are read directly, since the reported statistics
+  // are only updated by the capture side, which may be the one lagging behind.
+  if (render_audio_queued_.load(std::memory_order_relaxed)) {
+    stats.render_queue_overruns =
+        render_queue_overruns_.load(std::memory_order_relaxed);
+  }
+  if (stage_timing_enabled_.load(std::memory_order_relaxed)) {
+    stats.stage_timings.emplace();
+    capture_stage_timer_.GetTimings(&*stats.stage_timings);
+    render_stage_timer_.GetTimings(&*stats.stage_timings);
+  }
+  return stats;
+}
+
 AudioProcessing::Config AudioProcessingImpl::GetConfig() const {
   MutexLock lock_render(&mutex_render_);
   MutexLock lock_capture(&mutex_capture_);
   return config_;
 }
 
+void AudioProcessingImpl::SaveConvergedState(std::vector<uint8_t>* state) {
+  RTC_DCHECK(state);
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  state->clear();
+  StateWriter writer(state);
+  writer.WriteInt(kConvergedStateIdentifier);
+  writer.WriteInt(kConvergedStateVersion);
+
+  std::vector<uint8_t> submodule_state;
+  const EchoCanceller3* echo_canceller3 = GetEchoCanceller3();
+  if (echo_canceller3) {
+    StateWriter submodule_writer(&submodule_state);
+    echo_canceller3->SaveState(&submodule_writer);
+  }
+  WriteSubmoduleState(!!echo_canceller3, submodule_state, &writer);
+
+  submodule_state.clear();
+  if (submodules_.noise_suppressor) {
+    StateWriter submodule_writer(&submodule_state);
+    submodules_.noise_suppressor->SaveState(&submodule_writer);
+  }
+  WriteSubmoduleState(!!submodules_.noise_suppressor, submodule_state,
+                      &writer);
+
+  submodule_state.clear();
+  if (submodules_.gain_controller2) {
+    StateWriter submodule_writer(&submodule_state);
+    submodules_.gain_controller2->SaveState(&submodule_writer);
+  }
+  WriteSubmoduleState(!!submodules_.gain_controller2, submodule_state,
+                      &writer);
+}
+
+bool AudioProcessingImpl::RestoreConvergedState(
+    rtc::ArrayView<const uint8_t> state) {
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  return RestoreConvergedStateLocked(state);
+}
+
+bool AudioProcessingImpl::ResetForReuse(
+    const AudioProcessing::Config& config,
+    const ProcessingConfig& processing_config,
+    rtc::ArrayView<const uint8_t> initial_state) {
+  DetachAecDump();
+  MutexLock lock_render(&mutex_render_);
+  MutexLock lock_capture(&mutex_capture_);
+  // The frames published by a shared render analyzer cannot be rewound.
+  if (!(formats_.api_format == processing_config) ||
+      config_ != config ||
+      echo_controller_uses_shared_render_) {
+    return false;
+  }
+
+  // Reset the submodules and discard the audio and settings queued or buffered
+  // by the previous user, then restore the converged state on top.
+  for (AudioBuffer* audio :
+       {capture_.capture_audio.get(), capture_.capture_fullband_audio.get(),
+        capture_.linear_aec_output.get(), render_.render_audio.get()}) {
+    if (audio) {
+      audio->ResetFilterStates();
+    }
+  }
+  if (EchoCanceller3* echo_canceller3 = GetEchoCanceller3()) {
+    echo_canceller3->Reset();
+  }
+  if (submodules_.echo_control_mobile) {
+    submodules_.echo_control_mobile->Initialize(proc_split_sample_rate_hz(),
+                                                num_reverse_channels(),
+                                                num_output_channels());
+  }
+  if (submodules_.noise_suppressor) {
+    submodules_.noise_suppressor->ResetBufferedAudio();
+  }
+  if (submodules_.high_pass_filter) {
+    submodules_.high_pass_filter->Reset();
+  }
+  if (submodules_.agc_manager) {
+    submodules_.agc_manager->Reset();
+    // Restores the compression gain changed by the adaptation.
+    submodules_.agc_manager->SetupDigitalGainControl(
+        *submodules_.gain_control);
+  }
+  if (submodules_.gain_control) {
+    submodules_.gain_control->Reset();
+  }
+  if (submodules_.gain_controller2) {
+    submodules_.gain_controller2->Reset();
+  }
+  InitializeCaptureLevelsAdjuster();
+  InitializeResidualEchoDetector();
+  InitializeAnalyzer();
+  InitializePostProcessor();
+  InitializePreProcessor();
+  if (aecm_render_signal_queue_) {
+    aecm_render_signal_queue_->Clear();
+  }
+  if (agc_render_signal_queue_) {
+    agc_render_signal_queue_->Clear();
+  }
+  if (red_render_signal_queue_) {
+    red_render_signal_queue_->Clear();
+  }
+  capture_runtime_settings_.Clear();
+  render_runtime_settings_.Clear();
+
+  // Restore the stream parameters of a new instance.
+  capture_.was_stream_delay_set = false;
+  capture_nonlocked_.stream_delay_ms = 0;
+  capture_.key_pressed = false;
+  capture_.echo_path_gain_change = false;
+  capture_.prev_pre_adjustment_gain = -1.0f;
+  capture_.playout_volume = -1;
+  capture_.prev_playout_volume = -1;
+  capture_.applied_input_volume.reset();
+  capture_.applied_input_volume_changed = false;
+  capture_.recommended_input_volume.reset();
+  capture_.capture_output_used_last_frame = true;
+  HandleCaptureOutputUsedSetting(/*capture_output_used=*/true);
+  return RestoreConvergedStateLocked(initial_state);
+}
+
+bool AudioProcessingImpl::RestoreConvergedStateLocked(
+    rtc::ArrayView<const uint8_t> state) {
+  // Parse all the sections before restoring anything, so that a malformed
+  // state leaves the submodules untouched.
+  StateReader reader(state);
+  int identifier;
+  int version;
+  std::optional<rtc::ArrayView<const uint8_t>> echo_canceller3_state;
+  std::optional<rtc::ArrayView<const uint8_t>> noise_suppressor_state;
+  std::optional<rtc::ArrayView<const uint8_t>> gain_controller2_state;
+  if (!reader.ReadInt(&identifier) ||
+      identifier != kConvergedStateIdentifier || !reader.ReadInt(&version) ||
+      version != kConvergedStateVersion ||
+      !ReadSubmoduleState(&reader, &echo_canceller3_state) ||
+      !ReadSubmoduleState(&reader, &noise_suppressor_state) ||
+      !ReadSubmoduleState(&reader, &gain_controller2_state) || !reader.Done()) {
+    RTC_LOG(LS_WARNING) << "Malformed or unsupported converged APM state.";
+    return false;
+  }
+
+  // An enabled submodule without a saved state keeps its current state. A
+  // submodule that fails to restore its state is reset, since it may have
+  // been partially restored.
+  bool restored = true;
+  EchoCanceller3* echo_canceller3 = GetEchoCanceller3();
+  if (echo_canceller3) {
+    if (!echo_canceller3_state) {
+      restored = false;
+    } else {
+      StateReader submodule_reader(*echo_canceller3_state);
+      if (!echo_canceller3->RestoreState(&submodule_reader) ||
+          !submodule_reader.Done()) {
+        InitializeEchoController();
+        restored = false;
+      }
+    }
+  }
+
+  if (submodules_.noise_suppressor) {
+    if (!noise_suppressor_state) {
+      restored = false;
+    } else {
+      StateReader submodule_reader(*noise_suppressor_state);
+      if (!submodules_.noise_suppressor->RestoreState(&submodule_reader) ||
+          !submodule_reader.Done()) {
+        InitializeNoiseSuppressor();
+        restored = false;
+      }
+    }
+  }
+
+  if (submodules_.gain_controller2) {
+    if (!gain_controller2_state) {
+      restored = false;
+    } else {
+      StateReader submodule_reader(*gain_controller2_state);
+      if (!submodules_.gain_controller2->RestoreState(&submodule_reader) ||
+          !submodule_reader.Done()) {
+        InitializeGainController2();
+        restored = false;
+      }
+    }
+  }
+
+  if (!restored) {
+    RTC_LOG(LS_WARNING) << "The converged APM state was partially restored.";
+  }
+  return restored;
+}
+
+EchoCanceller3* AudioProcessingImpl::GetEchoCanceller3() const {
+  if (echo_control_factory_ || !submodules_.echo_controller) {
+    return nullptr;
+  }
+  return static_cast<EchoCanceller3*>(submodules_.echo_controller.get());
+}
+
 bool AudioProcessingImpl::UpdateActiveSubmoduleStates() {
+  render_audio_queued_.store(
+      submodules_.echo_control_mobile || submodules_.echo_detector ||
+          (submodules_.gain_control && !submodules_.agc_manager),
+      std::memory_order_relaxed);
   return submodule_states_.Update(
       config_.high_pass_filter.enabled, !!submodules_.echo_control_mobile,
       !!submodules_.noise_suppressor, !!submodules_.gain_control,
@@ -1877,10 +2427,51 @@ void AudioProcessingImpl::InitializeHighPassFilter(bool forced_reset) {
   }
 }
 
+void AudioProcessingImpl::GetEchoCanceller3Configs(
+    EchoCanceller3Config* config,
+    std::optional<EchoCanceller3Config>* multichannel_config) const {
+  *config = EchoCanceller3Config();
+  *multichannel_config = std::nullopt;
+  if (use_setup_specific_default_aec3_config_) {
+    *multichannel_config = EchoCanceller3::CreateDefaultMultichannelConfig();
+  }
+  const size_t num_channel_worker_threads = static_cast<size_t>(
+      std::max(config_.echo_canceller.capture_channel_worker_threads, 0));
+  config->multi_channel.capture_channel_worker_threads =
+      num_channel_worker_threads;
+  config->fft.use_pffft = config_.echo_canceller.use_pffft;
+  if (*multichannel_config) {
+    (*multichannel_config)->multi_channel.capture_channel_worker_threads =
+        num_channel_worker_threads;
+    (*multichannel_config)->fft.use_pffft = config_.echo_canceller.use_pffft;
+  }
+}
+
+std::unique_ptr<AudioBuffer> AudioProcessingImpl::CreateRenderAudioBuffer()
+    const {
+  const int render_audiobuffer_sample_rate_hz =
+      formats_.api_format.reverse_output_stream().num_frames() == 0
+          ? formats_.render_processing_format.sample_rate_hz()
+          : formats_.api_format.reverse_output_stream().sample_rate_hz();
+  auto render_audio = std::make_unique<AudioBuffer>(
+      formats_.api_format.reverse_input_stream().sample_rate_hz(),
+      formats_.api_format.reverse_input_stream().num_channels(),
+      formats_.render_processing_format.sample_rate_hz(),
+      formats_.render_processing_format.num_channels(),
+      render_audiobuffer_sample_rate_hz,
+      formats_.render_processing_format.num_channels());
+  render_audio->set_float_two_band_splitting(
+      config_.pipeline.float_two_band_splitting);
+  render_audio->set_fma_three_band_splitting(
+      config_.pipeline.fma_three_band_splitting);
+  return render_audio;
+}
+
 void AudioProcessingImpl::InitializeEchoController() {
   bool use_echo_controller =
       echo_control_factory_ ||
       (config_.echo_canceller.enabled && !config_.echo_canceller.mobile_mode);
+  echo_controller_uses_shared_render_ = false;
 
   if (use_echo_controller) {
     // Create and activate the echo controller.
@@ -1891,12 +2482,18 @@ void AudioProcessingImpl::InitializeEchoController() {
     } else {
       EchoCanceller3Config config;
       std::optional<EchoCanceller3Config> multichannel_config;
-      if (use_setup_specific_default_aec3_config_) {
-        multichannel_config = EchoCanceller3::CreateDefaultMultichannelConfig();
-      }
-      submodules_.echo_controller = std::make_unique<EchoCanceller3>(
+      GetEchoCanceller3Configs(&config, &multichannel_config);
+      auto echo_canceller3 = std::make_unique<EchoCanceller3>(
           config, multichannel_config, proc_sample_rate_hz(),
           num_reverse_channels(), num_proc_channels());
+      if (shared_render_analyzer_ &&
+          shared_render_analyzer_->IsCompatible(
+              config, multichannel_config, proc_sample_rate_hz(),
+              num_reverse_channels())) {
+        echo_canceller3->SetSharedRenderAnalyzer(shared_render_analyzer_);
+        echo_controller_uses_shared_render_ = true;
+      }
+      submodules_.echo_controller = std::move(echo_canceller3);
     }
 
     // Setup the storage for returning the linear AEC output.
@@ -2039,7 +2636,8 @@ void AudioProcessingImpl::InitializeGainController2() {
   submodules_.gain_controller2 = std::make_unique<GainController2>(
       config_.gain_controller2, input_volume_controller_config,
       proc_fullband_sample_rate_hz(), num_output_channels(),
-      /*use_internal_vad=*/true);
+      /*use_internal_vad=*/true,
+      config_.gain_controller2.batched_vad ? vad_batcher_ : nullptr);
   submodules_.gain_controller2->SetCaptureOutputUsed(
       capture_.capture_output_used);
 }
@@ -2067,6 +2665,7 @@ void AudioProcessingImpl::InitializeNoiseSuppressor() {
 
     NsConfig cfg;
     cfg.target_level = map_level(config_.noise_suppression.level);
+    cfg.use_pffft = config_.noise_suppression.use_pffft;
     submodules_.noise_suppressor = std::make_unique<NoiseSuppressor>(
         cfg, proc_sample_rate_hz(), num_proc_channels());
   }
@@ -2096,6 +2695,15 @@ void AudioProcessingImpl::InitializeCaptureLevelsAdjuster() {
   }
 }
 
+void AudioProcessingImpl::InitializeStageTiming() {
+  stage_timing_enabled_.store(config_.stage_timing.enabled,
+                              std::memory_order_relaxed);
+  capture_stage_timer_.set_report_histograms(
+      config_.stage_timing.report_histograms);
+  render_stage_timer_.set_report_histograms(
+      config_.stage_timing.report_histograms);
+}
+
 void AudioProcessingImpl::InitializeResidualEchoDetector() {
   if (submodules_.echo_detector) {
     submodules_.echo_detector->Initialize(
@@ -2186,6 +2794,13 @@ void AudioProcessingImpl::WriteAecDumpConfigMessage(bool forced) {
   if (!forced && apm_config == apm_config_for_aec_dump_) {
     return;
   }
+  apm_config.config = config_;
+  if (submodules_.echo_controller && !echo_control_factory_) {
+    EchoCanceller3Config echo_canceller3_config;
+    GetEchoCanceller3Configs(&echo_canceller3_config,
+                             &apm_config.echo_canceller3_multichannel_config);
+    apm_config.echo_canceller3_config = echo_canceller3_config;
+  }
   aec_dump_->WriteConfig(apm_config);
   apm_config_for_aec_dump_ = apm_config;
 }
@@ -39,9 +39,11 @@
 #include "modules/audio_processing/high_pass_filter.h"
 #include "modules/audio_processing/include/aec_dump.h"
 #include "modules/audio_processing/include/audio_frame_proxies.h"
+#include "modules/audio_processing/include/audio_processing_batch.h"
 #include "modules/audio_processing/ns/noise_suppressor.h"
 #include "modules/audio_processing/render_queue_item_verifier.h"
 #include "modules/audio_processing/rms_level.h"
+#include "modules/audio_processing/stage_timer.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/swap_queue.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -119,6 +121,53 @@ class AudioProcessingImpl : public AudioProcessing {
                            const StreamConfig& output_config,
                            float* const* dest) override;
 
+  // Method used by AudioProcessingBatch. Processes the render frame of `frame`
+  // (if any) followed by its capture frame, in place, while holding both the
+  // render and capture locks for the whole sequence.
+  // If `shared_render_audio` is set, it is the render frame of this tick that
+  // a shared render analyzer has analyzed, and `frame` has no render frame of
+  // its own.
+  int ProcessBatchedFrame(const StreamConfig& render_config,
+                          const StreamConfig& capture_config,
+                          AudioProcessingBatch::Frame& frame,
+                          const int16_t* shared_render_audio)
+      RTC_LOCKS_EXCLUDED(mutex_render_, mutex_capture_);
+
+  // Method used by AudioProcessingBatch. Sets the batcher that evaluates the
+  // voice activity detector of AGC2 when `Config::GainController2::batched_vad`
+  // is true.
+  void SetVadBatcher(rtc::scoped_refptr<VadBatcher> vad_batcher)
+      RTC_LOCKS_EXCLUDED(mutex_render_, mutex_capture_);
+
+  // Methods used by AudioProcessingBatch. Creates a render analyzer for the
+  // echo canceller of this session, and in `render_audio`, a buffer for its
+  // input in the render processing format of this session. Returns null if
+  // the session does not use AEC3.
+  rtc::scoped_refptr<SharedRenderAnalyzer> CreateSharedRenderAnalyzer(
+      std::unique_ptr<AudioBuffer>* render_audio)
+      RTC_LOCKS_EXCLUDED(mutex_render_, mutex_capture_);
+  // Sets the analyzer that the echo canceller reads its render signal from,
+  // if the echo canceller is AEC3 and compatible with it.
+  void SetSharedRenderAnalyzer(
+      rtc::scoped_refptr<SharedRenderAnalyzer> shared_render_analyzer)
+      RTC_LOCKS_EXCLUDED(mutex_render_, mutex_capture_);
+
+  // Method used by AudioProcessingPool. Returns false if the configuration or
+  // the stream formats differ from `config` and `processing_config`, or if the
+  // echo canceller reads a shared render analyzer. Otherwise, resets the
+  // instance so that it processes as a new one: the AEC3 and the high-pass
+  // filter are reset in place, the buffered audio and the render and runtime
+  // setting queues are cleared, the AGC1, AGC2, AECM, capture levels adjuster,
+  // echo detector and custom processors are reinitialized, and the stream
+  // parameters, e.g., the stream delay and the input volume, are reset. The
+  // AEC3, NS and AGC2 estimates are then restored from `initial_state`, saved
+  // by SaveConvergedState() right after initialization. The metrics are kept.
+  // Any attached AecDump is detached.
+  bool ResetForReuse(const AudioProcessing::Config& config,
+                     const ProcessingConfig& processing_config,
+                     rtc::ArrayView<const uint8_t> initial_state)
+      RTC_LOCKS_EXCLUDED(mutex_render_, mutex_capture_);
+
   // Methods only accessed from APM submodules or
   // from AudioProcessing tests in a single-threaded manner.
   // Hence there is no need for locks in these.
@@ -133,12 +182,13 @@ class AudioProcessingImpl : public AudioProcessing {
   AudioProcessingStats GetStatistics(bool has_remote_tracks) override {
     return GetStatistics();
   }
-  AudioProcessingStats GetStatistics() override {
-    return stats_reporter_.GetStatistics();
-  }
+  AudioProcessingStats GetStatistics() override;
 
   AudioProcessing::Config GetConfig() const override;
 
+  void SaveConvergedState(std::vector<uint8_t>* state) override;
+  bool RestoreConvergedState(rtc::ArrayView<const uint8_t> state) override;
+
  protected:
   // Overridden in a mock.
   virtual void InitializeLocked()
@@ -156,6 +206,8 @@ class AudioProcessingImpl : public AudioProcessing {
   FRIEND_TEST_ALL_PREFIXES(ApmConfiguration, ValidConfigBehavior);
   FRIEND_TEST_ALL_PREFIXES(ApmConfiguration, InValidConfigBehavior);
 
+  int set_stream_delay_ms_locked(int delay)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void set_stream_analog_level_locked(int level)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void UpdateRecommendedInputVolumeLocked()
@@ -249,8 +301,47 @@ class AudioProcessingImpl : public AudioProcessing {
   // the render and capture lock to be acquired.
   void InitializeLocked(const ProcessingConfig& config)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  // Applies a change of the stream formats to `config`. Unlike
+  // InitializeLocked(), only the audio buffers and submodules that depend on
+  // the changed formats are recreated, and the others keep their state. Falls
+  // back to a full initialization if the active submodules have changed.
+  void ReinitializeForFormatsLocked(const ProcessingConfig& config)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  // Sets `formats_` and the capture processing format for `config`. A
+  // `preferred_capture_processing_rate` above the suitable rate is kept if the
+  // input stream supports it.
+  void UpdateFormatsLocked(const ProcessingConfig& config,
+                           int preferred_capture_processing_rate)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  void InitializeRenderAudioBuffers()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  void InitializeCaptureAudioBuffers()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
+  // The formats that the submodules are initialized for.
+  struct SubmoduleFormats {
+    int proc_sample_rate_hz;
+    int proc_fullband_sample_rate_hz;
+    size_t num_proc_channels;
+    size_t num_output_channels;
+    StreamConfig render_processing_format;
+  };
+  SubmoduleFormats GetSubmoduleFormats() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
   void InitializeResidualEchoDetector()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  // Produces the configs of the AEC3 echo canceller.
+  void GetEchoCanceller3Configs(
+      EchoCanceller3Config* config,
+      std::optional<EchoCanceller3Config>* multichannel_config) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  std::unique_ptr<AudioBuffer> CreateRenderAudioBuffer() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  bool RestoreConvergedStateLocked(rtc::ArrayView<const uint8_t> state)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+  // Returns the echo controller if it is the built-in AEC3, and null otherwise.
+  EchoCanceller3* GetEchoCanceller3() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void InitializeEchoController()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
 
@@ -272,6 +363,10 @@ class AudioProcessingImpl : public AudioProcessing {
   // already acquired.
   void InitializePreProcessor() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
+  // Applies the stage timing settings to both the render and capture side.
+  void InitializeStageTiming()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
+
   // Sample rate used for the fullband processing.
   int proc_fullband_sample_rate_hz() const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
@@ -282,14 +377,15 @@ class AudioProcessingImpl : public AudioProcessing {
   void HandleRenderRuntimeSettings()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
-  void EmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
   void EmptyQueuedRenderAudioLocked()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
-  void QueueBandedRenderAudio(AudioBuffer* audio)
+  // Queue the render audio for the capture side. Return false if a queue was
+  // full and the frame was dropped from it.
+  bool QueueBandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
-  void QueueNonbandedRenderAudio(AudioBuffer* audio)
+  bool QueueNonbandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
   // Capture-side exclusive methods possibly running APM in a multi-threaded
@@ -511,6 +607,15 @@ class AudioProcessingImpl : public AudioProcessing {
   InputVolumeStatsReporter recommended_input_volume_stats_reporter_
       RTC_GUARDED_BY(mutex_capture_);
 
+  rtc::scoped_refptr<VadBatcher> vad_batcher_ RTC_GUARDED_BY(mutex_capture_);
+
+  rtc::scoped_refptr<SharedRenderAnalyzer> shared_render_analyzer_
+      RTC_GUARDED_BY(mutex_capture_);
+  // Whether the echo controller reads its render signal from
+  // `shared_render_analyzer_` rather than from the render stream.
+  bool echo_controller_uses_shared_render_ RTC_GUARDED_BY(mutex_render_) =
+      false;
+
   // Lock protection not needed.
   std::unique_ptr<
       SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>>
@@ -520,6 +625,22 @@ class AudioProcessingImpl : public AudioProcessing {
       agc_render_signal_queue_;
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       red_render_signal_queue_;
+  // Number of render frames dropped because a render queue was full. Only
+  // written by the render side, so that it never waits for the capture lock.
+  std::atomic<int64_t> render_queue_overruns_{0};
+  // Whether any submodule consumes queued render audio, which decides if the
+  // overruns are reported. Updated with the capture lock held, and read by
+  // GetStatistics() without locks.
+  std::atomic<bool> render_audio_queued_{false};
+
+  // Execution time statistics of the processing stages, which are only
+  // collected when enabled in the config. The timers are updated with the
+  // capture and render lock held, respectively, while the thread-safe
+  // GetTimings() is called without locks, which is why the enabled state is
+  // mirrored by `stage_timing_enabled_`.
+  StageTimer capture_stage_timer_;
+  StageTimer render_stage_timer_;
+  std::atomic<bool> stage_timing_enabled_{false};
 };
 
 }  // namespace webrtc
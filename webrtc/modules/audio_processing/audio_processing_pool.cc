@@ -0,0 +1,323 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/include/audio_processing_pool.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "modules/audio_processing/audio_processing_impl.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+
+namespace {
+
+// Returns the number of heap bytes in use in the whole process, or 0 if it
+// cannot be measured.
+size_t HeapBytesInUse() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+ProcessingConfig MakeProcessingConfig(const StreamConfig& render_config,
+                                      const StreamConfig& capture_config) {
+  ProcessingConfig processing_config;
+  processing_config.input_stream() = capture_config;
+  processing_config.output_stream() = capture_config;
+  processing_config.reverse_input_stream() = render_config;
+  processing_config.reverse_output_stream() = render_config;
+  return processing_config;
+}
+
+// Configurations that differ only in settings that `Config::ToString()` rounds
+// or omits share a key; their buckets are told apart by comparing them.
+std::string MakeKey(const AudioProcessing::Config& config,
+                    const ProcessingConfig& processing_config) {
+  rtc::StringBuilder key;
+  for (const StreamConfig& stream : processing_config.streams) {
+    key << stream.sample_rate_hz() << "/" << stream.num_channels() << " ";
+  }
+  key << config.ToString();
+  return key.Release();
+}
+
+}  // namespace
+
+class AudioProcessingPool::Core : public std::enable_shared_from_this<Core> {
+ public:
+  explicit Core(size_t max_pooled_instances_per_key)
+      : max_pooled_instances_per_key_(max_pooled_instances_per_key) {}
+
+  void Prewarm(const AudioProcessing::Config& config,
+               const ProcessingConfig& processing_config,
+               size_t num_instances) RTC_LOCKS_EXCLUDED(mutex_);
+  rtc::scoped_refptr<AudioProcessing> Acquire(
+      const AudioProcessing::Config& config,
+      const ProcessingConfig& processing_config) RTC_LOCKS_EXCLUDED(mutex_);
+  Stats GetStats() const RTC_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  struct Bucket;
+  class PooledInstance;
+
+  Bucket& GetBucket(const AudioProcessing::Config& config,
+                    const ProcessingConfig& processing_config)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Creates and initializes an instance for `bucket`. The initial state and
+  // the heap usage of the first instance of a bucket are saved in the bucket.
+  rtc::scoped_refptr<PooledInstance> CreateInstance(Bucket* bucket)
+      RTC_LOCKS_EXCLUDED(mutex_);
+  // Resets `instance`, whose last reference was dropped, and keeps it for the
+  // next acquisition. Returns false if the instance cannot be reused or the
+  // pool is full, in which case the caller frees it.
+  bool TakeBack(PooledInstance* instance) RTC_LOCKS_EXCLUDED(mutex_);
+
+  const size_t max_pooled_instances_per_key_;
+  mutable Mutex mutex_;
+  // Buckets are never removed, so that pointers to them stay valid.
+  std::unordered_multimap<std::string, std::unique_ptr<Bucket>> buckets_
+      RTC_GUARDED_BY(mutex_);
+  size_t num_acquisitions_ RTC_GUARDED_BY(mutex_) = 0;
+  size_t num_hits_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+struct AudioProcessingPool::Core::Bucket {
+  Bucket(const AudioProcessing::Config& config,
+         const ProcessingConfig& processing_config)
+      : config(config), processing_config(processing_config) {}
+
+  const AudioProcessing::Config config;
+  const ProcessingConfig processing_config;
+  // Set under the lock once the first instance of the bucket is created, and
+  // only read afterwards. An instance is handed out only after they are set.
+  bool initialized = false;
+  std::vector<uint8_t> initial_state;
+  // Approximate, see Stats::approximate_pooled_memory_bytes.
+  size_t approximate_instance_heap_bytes = 0;
+  std::vector<rtc::scoped_refptr<PooledInstance>> pooled_instances;
+};
+
+// An instance handed out by the pool. Dropping its last reference hands it
+// back to the pool, if the pool still exists, instead of deleting it. The
+// instance carries its bucket, so that the pool does not have to track the
+// acquired instances.
+class AudioProcessingPool::Core::PooledInstance final
+    : public AudioProcessingImpl {
+ public:
+  PooledInstance(std::weak_ptr<Core> core, Bucket* bucket)
+      : AudioProcessingImpl(bucket->config,
+                            /*capture_post_processor=*/nullptr,
+                            /*render_pre_processor=*/nullptr,
+                            /*echo_control_factory=*/nullptr,
+                            /*echo_detector=*/nullptr,
+                            /*capture_analyzer=*/nullptr),
+        core_(std::move(core)),
+        bucket_(bucket) {}
+  PooledInstance(const PooledInstance&) = delete;
+  PooledInstance& operator=(const PooledInstance&) = delete;
+
+  Bucket* bucket() const { return bucket_; }
+
+  void AddRef() const override { ref_count_.IncRef(); }
+
+  RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == RefCountReleaseStatus::kDroppedLastRef) {
+      PooledInstance* instance = const_cast<PooledInstance*>(this);
+      // Destroying `core` may destroy the pool state, and with it the pooled
+      // instances, including this one, so no member is accessed afterwards.
+      std::shared_ptr<Core> core = core_.lock();
+      if (!core || !core->TakeBack(instance)) {
+        delete instance;
+      }
+    }
+    return status;
+  }
+
+ private:
+  ~PooledInstance() override = default;
+
+  const std::weak_ptr<Core> core_;
+  Bucket* const bucket_;
+  mutable webrtc_impl::RefCounter ref_count_{0};
+};
+
+void AudioProcessingPool::Core::Prewarm(
+    const AudioProcessing::Config& config,
+    const ProcessingConfig& processing_config,
+    size_t num_instances) {
+  num_instances = std::min(num_instances, max_pooled_instances_per_key_);
+  Bucket* bucket;
+  size_t num_pooled_instances;
+  {
+    MutexLock lock(&mutex_);
+    bucket = &GetBucket(config, processing_config);
+    num_pooled_instances = bucket->pooled_instances.size();
+  }
+  for (size_t i = num_pooled_instances; i < num_instances; ++i) {
+    // Declared before the lock, so that an instance that is not pooled here
+    // is handed back after the lock is released.
+    rtc::scoped_refptr<PooledInstance> instance = CreateInstance(bucket);
+    MutexLock lock(&mutex_);
+    if (bucket->pooled_instances.size() >= num_instances) {
+      break;
+    }
+    bucket->pooled_instances.push_back(std::move(instance));
+  }
+}
+
+rtc::scoped_refptr<AudioProcessing> AudioProcessingPool::Core::Acquire(
+    const AudioProcessing::Config& config,
+    const ProcessingConfig& processing_config) {
+  Bucket* bucket;
+  {
+    MutexLock lock(&mutex_);
+    ++num_acquisitions_;
+    bucket = &GetBucket(config, processing_config);
+    if (!bucket->pooled_instances.empty()) {
+      ++num_hits_;
+      rtc::scoped_refptr<PooledInstance> instance =
+          std::move(bucket->pooled_instances.back());
+      bucket->pooled_instances.pop_back();
+      return instance;
+    }
+  }
+  return CreateInstance(bucket);
+}
+
+AudioProcessingPool::Stats AudioProcessingPool::Core::GetStats() const {
+  MutexLock lock(&mutex_);
+  Stats stats;
+  stats.num_acquisitions = num_acquisitions_;
+  stats.num_hits = num_hits_;
+  for (const auto& [key, bucket] : buckets_) {
+    stats.num_pooled_instances += bucket->pooled_instances.size();
+    stats.approximate_pooled_memory_bytes +=
+        bucket->pooled_instances.size() *
+        bucket->approximate_instance_heap_bytes;
+  }
+  return stats;
+}
+
+AudioProcessingPool::Core::Bucket& AudioProcessingPool::Core::GetBucket(
+    const AudioProcessing::Config& config,
+    const ProcessingConfig& processing_config) {
+  std::string key = MakeKey(config, processing_config);
+  auto [begin, end] = buckets_.equal_range(key);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second->config == config &&
+        it->second->processing_config == processing_config) {
+      return *it->second;
+    }
+  }
+  auto bucket = std::make_unique<Bucket>(config, processing_config);
+  Bucket& new_bucket = *bucket;
+  buckets_.emplace(std::move(key), std::move(bucket));
+  return new_bucket;
+}
+
+rtc::scoped_refptr<AudioProcessingPool::Core::PooledInstance>
+AudioProcessingPool::Core::CreateInstance(Bucket* bucket) {
+  const size_t heap_bytes_before = HeapBytesInUse();
+  rtc::scoped_refptr<PooledInstance> instance(
+      new PooledInstance(weak_from_this(), bucket));
+  instance->Initialize(bucket->processing_config);
+  const size_t heap_bytes_after = HeapBytesInUse();
+
+  // The state is saved outside of the lock. Instances created concurrently
+  // for a new bucket may all save it, and the first one to finish sets it.
+  bool initialized;
+  {
+    MutexLock lock(&mutex_);
+    initialized = bucket->initialized;
+  }
+  if (initialized) {
+    return instance;
+  }
+  std::vector<uint8_t> initial_state;
+  instance->SaveConvergedState(&initial_state);
+  MutexLock lock(&mutex_);
+  if (!bucket->initialized) {
+    bucket->initialized = true;
+    bucket->approximate_instance_heap_bytes =
+        heap_bytes_after > heap_bytes_before
+            ? heap_bytes_after - heap_bytes_before
+            : 0;
+    bucket->initial_state = std::move(initial_state);
+  }
+  return instance;
+}
+
+bool AudioProcessingPool::Core::TakeBack(PooledInstance* instance) {
+  TRACE_EVENT0("webrtc", "AudioProcessingPool::TakeBack");
+  Bucket* bucket = instance->bucket();
+  if (!instance->ResetForReuse(bucket->config, bucket->processing_config,
+                               bucket->initial_state)) {
+    return false;
+  }
+  MutexLock lock(&mutex_);
+  if (bucket->pooled_instances.size() >= max_pooled_instances_per_key_) {
+    return false;
+  }
+  bucket->pooled_instances.push_back(
+      rtc::scoped_refptr<PooledInstance>(instance));
+  return true;
+}
+
+AudioProcessingPool::AudioProcessingPool(size_t max_pooled_instances_per_key)
+    : core_(std::make_shared<Core>(max_pooled_instances_per_key)) {}
+
+AudioProcessingPool::~AudioProcessingPool() = default;
+
+void AudioProcessingPool::Prewarm(const AudioProcessing::Config& config,
+                                  const StreamConfig& render_config,
+                                  const StreamConfig& capture_config,
+                                  size_t num_instances) {
+  core_->Prewarm(config, MakeProcessingConfig(render_config, capture_config),
+                 num_instances);
+}
+
+rtc::scoped_refptr<AudioProcessing> AudioProcessingPool::Acquire(
+    const AudioProcessing::Config& config,
+    const StreamConfig& render_config,
+    const StreamConfig& capture_config) {
+  TRACE_EVENT0("webrtc", "AudioProcessingPool::Acquire");
+  return core_->Acquire(config,
+                        MakeProcessingConfig(render_config, capture_config));
+}
+
+void AudioProcessingPool::Release(rtc::scoped_refptr<AudioProcessing> apm) {
+  TRACE_EVENT0("webrtc", "AudioProcessingPool::Release");
+  // The instance goes back to the pool when its last reference is dropped.
+  apm = nullptr;
+}
+
+AudioProcessingPool::Stats AudioProcessingPool::GetStats() const {
+  return core_->GetStats();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/echo_detector/lagged_covariance_estimator.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+constexpr float kAlpha = LaggedCovarianceEstimator::kAlpha;
+constexpr float kOffset = LaggedCovarianceEstimator::kNormalizationOffset;
+
+// Updates the covariances of the lags in [`begin`, `num_lags`) and returns the
+// largest of `max_normalized_cross_correlation` and their normalized
+// covariances.
+float UpdateLaggedCovariances(float scaled_x_deviation,
+                              float x_sigma,
+                              const float* y_deviations,
+                              const float* y_sigmas,
+                              size_t begin,
+                              size_t num_lags,
+                              float max_normalized_cross_correlation,
+                              float* covariances) {
+  for (size_t k = begin; k < num_lags; ++k) {
+    covariances[k] = (1.f - kAlpha) * covariances[k] +
+                     scaled_x_deviation * y_deviations[k];
+    const float normalized_cross_correlation =
+        covariances[k] / (x_sigma * y_sigmas[k] + kOffset);
+    max_normalized_cross_correlation = std::max(
+        max_normalized_cross_correlation, normalized_cross_correlation);
+  }
+  return max_normalized_cross_correlation;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+float UpdateLaggedCovariances_SSE2(float scaled_x_deviation,
+                                   float x_sigma,
+                                   const float* y_deviations,
+                                   const float* y_sigmas,
+                                   size_t num_lags,
+                                   float* covariances) {
+  const __m128 forgetting_factor = _mm_set1_ps(1.f - kAlpha);
+  const __m128 x_deviation = _mm_set1_ps(scaled_x_deviation);
+  const __m128 x_sigma_4 = _mm_set1_ps(x_sigma);
+  const __m128 offset = _mm_set1_ps(kOffset);
+  __m128 max_4 = _mm_setzero_ps();
+  const size_t vector_limit = num_lags & ~size_t{3};
+  for (size_t k = 0; k < vector_limit; k += 4) {
+    const __m128 covariance = _mm_add_ps(
+        _mm_mul_ps(forgetting_factor, _mm_loadu_ps(&covariances[k])),
+        _mm_mul_ps(x_deviation, _mm_loadu_ps(&y_deviations[k])));
+    _mm_storeu_ps(&covariances[k], covariance);
+    const __m128 denominator = _mm_add_ps(
+        _mm_mul_ps(x_sigma_4, _mm_loadu_ps(&y_sigmas[k])), offset);
+    max_4 = _mm_max_ps(max_4, _mm_div_ps(covariance, denominator));
+  }
+  max_4 = _mm_max_ps(max_4, _mm_movehl_ps(max_4, max_4));
+  max_4 = _mm_max_ss(max_4, _mm_shuffle_ps(max_4, max_4, 1));
+  return UpdateLaggedCovariances(scaled_x_deviation, x_sigma, y_deviations,
+                                 y_sigmas, vector_limit, num_lags,
+                                 _mm_cvtss_f32(max_4), covariances);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// On 32-bit ARM, the division is approximated with two Newton-Raphson
+// iterations of the reciprocal and the result is not bit-exact.
+float UpdateLaggedCovariances_NEON(float scaled_x_deviation,
+                                   float x_sigma,
+                                   const float* y_deviations,
+                                   const float* y_sigmas,
+                                   size_t num_lags,
+                                   float* covariances) {
+  const float32x4_t forgetting_factor = vdupq_n_f32(1.f - kAlpha);
+  const float32x4_t x_deviation = vdupq_n_f32(scaled_x_deviation);
+  const float32x4_t x_sigma_4 = vdupq_n_f32(x_sigma);
+  const float32x4_t offset = vdupq_n_f32(kOffset);
+  float32x4_t max_4 = vdupq_n_f32(0.f);
+  const size_t vector_limit = num_lags & ~size_t{3};
+  for (size_t k = 0; k < vector_limit; k += 4) {
+    const float32x4_t covariance = vaddq_f32(
+        vmulq_f32(forgetting_factor, vld1q_f32(&covariances[k])),
+        vmulq_f32(x_deviation, vld1q_f32(&y_deviations[k])));
+    vst1q_f32(&covariances[k], covariance);
+    const float32x4_t denominator =
+        vaddq_f32(vmulq_f32(x_sigma_4, vld1q_f32(&y_sigmas[k])), offset);
+#if defined(WEBRTC_ARCH_ARM64)
+    const float32x4_t normalized_cross_correlation =
+        vdivq_f32(covariance, denominator);
+#else
+    float32x4_t reciprocal = vrecpeq_f32(denominator);
+    reciprocal = vmulq_f32(vrecpsq_f32(denominator, reciprocal), reciprocal);
+    reciprocal = vmulq_f32(vrecpsq_f32(denominator, reciprocal), reciprocal);
+    const float32x4_t normalized_cross_correlation =
+        vmulq_f32(covariance, reciprocal);
+#endif
+    max_4 = vmaxq_f32(max_4, normalized_cross_correlation);
+  }
+  float32x2_t max_2 = vmax_f32(vget_low_f32(max_4), vget_high_f32(max_4));
+  max_2 = vpmax_f32(max_2, max_2);
+  return UpdateLaggedCovariances(scaled_x_deviation, x_sigma, y_deviations,
+                                 y_sigmas, vector_limit, num_lags,
+                                 vget_lane_f32(max_2, 0), covariances);
+}
+#endif
+
+}  // namespace
+
+LaggedCovarianceEstimator::LaggedCovarianceEstimator(size_t num_lags)
+    : LaggedCovarianceEstimator(num_lags,
+                                DetectImplementation(/*allow_fma=*/false)) {}
+
+LaggedCovarianceEstimator::LaggedCovarianceEstimator(
+    size_t num_lags,
+    Implementation implementation)
+    : implementation_(implementation),
+      num_lags_(num_lags),
+      y_deviations_(2 * num_lags, 0.f),
+      y_sigmas_(2 * num_lags, 0.f),
+      covariances_(num_lags, 0.f) {
+  RTC_DCHECK_GT(num_lags, 0);
+}
+
+LaggedCovarianceEstimator::~LaggedCovarianceEstimator() = default;
+
+LaggedCovarianceEstimator::Implementation
+LaggedCovarianceEstimator::DetectImplementation(bool allow_fma) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (allow_fma && GetCPUInfo(kAVX2) != 0) {
+    return Implementation::kAvx2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return Implementation::kSse2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return Implementation::kNeon;
+#else
+  return Implementation::kScalar;
+#endif
+}
+
+void LaggedCovarianceEstimator::Update(float x,
+                                       float x_mean,
+                                       float x_sigma,
+                                       float y,
+                                       float y_mean,
+                                       float y_sigma) {
+  // Store the new value of y as lag 0, in both halves of the history.
+  read_index_ = read_index_ > 0 ? read_index_ - 1 : num_lags_ - 1;
+  const float y_deviation = y - y_mean;
+  y_deviations_[read_index_] = y_deviation;
+  y_deviations_[read_index_ + num_lags_] = y_deviation;
+  y_sigmas_[read_index_] = y_sigma;
+  y_sigmas_[read_index_ + num_lags_] = y_sigma;
+  x_sigma_ = x_sigma;
+
+  const float scaled_x_deviation = kAlpha * (x - x_mean);
+  const float* y_deviations = &y_deviations_[read_index_];
+  const float* y_sigmas = &y_sigmas_[read_index_];
+  float* covariances = covariances_.data();
+  switch (implementation_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+    case Implementation::kAvx2:
+      max_normalized_cross_correlation_ =
+          UpdateLaggedCovariances_AVX2(scaled_x_deviation, x_sigma,
+                                       y_deviations, y_sigmas, num_lags_,
+                                       covariances);
+      break;
+    case Implementation::kSse2:
+      max_normalized_cross_correlation_ =
+          UpdateLaggedCovariances_SSE2(scaled_x_deviation, x_sigma,
+                                       y_deviations, y_sigmas, num_lags_,
+                                       covariances);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Implementation::kNeon:
+      max_normalized_cross_correlation_ =
+          UpdateLaggedCovariances_NEON(scaled_x_deviation, x_sigma,
+                                       y_deviations, y_sigmas, num_lags_,
+                                       covariances);
+      break;
+#endif
+    default:
+      max_normalized_cross_correlation_ = UpdateLaggedCovariances(
+          scaled_x_deviation, x_sigma, y_deviations, y_sigmas, 0, num_lags_,
+          0.f, covariances);
+  }
+  RTC_DCHECK(isfinite(max_normalized_cross_correlation_));
+}
+
+int LaggedCovarianceEstimator::FindBestLag() const {
+  int best_lag = -1;
+  float max_normalized_cross_correlation = 0.f;
+  for (size_t k = 0; k < num_lags_; ++k) {
+    const float normalized_cross_correlation =
+        covariances_[k] / (x_sigma_ * y_sigma(k) + kOffset);
+    if (normalized_cross_correlation > max_normalized_cross_correlation) {
+      max_normalized_cross_correlation = normalized_cross_correlation;
+      best_lag = static_cast<int>(k);
+    }
+  }
+  return best_lag;
+}
+
+void LaggedCovarianceEstimator::Clear() {
+  std::fill(y_deviations_.begin(), y_deviations_.end(), 0.f);
+  std::fill(y_sigmas_.begin(), y_sigmas_.end(), 0.f);
+  std::fill(covariances_.begin(), covariances_.end(), 0.f);
+  x_sigma_ = 0.f;
+  max_normalized_cross_correlation_ = 0.f;
+  read_index_ = 0;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_LAGGED_COVARIANCE_ESTIMATOR_H_
+#define MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_LAGGED_COVARIANCE_ESTIMATOR_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// Iteratively estimates the normalized covariance between a signal x and
+// delayed versions of a signal y, for a range of lags. It is equivalent to one
+// NormalizedCovarianceEstimator per lag, fed with the delayed values of y.
+//
+// The state is kept as a structure of arrays. The history of y is stored twice
+// in a buffer written backwards, so that the values of y for all the lags are
+// contiguous, and the covariances of all the lags are updated in one vectorized
+// sweep that also finds the largest normalized covariance. Except for kAvx2,
+// the results are bit-exact with those of NormalizedCovarianceEstimator.
+class LaggedCovarianceEstimator {
+ public:
+  // Implementation of the sweep. kAvx2 uses fused multiply-adds and differs
+  // from the others by rounding.
+  enum class Implementation { kScalar, kSse2, kAvx2, kNeon };
+
+  // Parameter controlling the adaptation speed, as in
+  // NormalizedCovarianceEstimator.
+  static constexpr float kAlpha = 0.001f;
+  // Added to the normalization, to avoid divisions by zero.
+  static constexpr float kNormalizationOffset = .0001f;
+
+  // Uses the fastest bit-exact implementation available.
+  explicit LaggedCovarianceEstimator(size_t num_lags);
+  LaggedCovarianceEstimator(size_t num_lags, Implementation implementation);
+  LaggedCovarianceEstimator(const LaggedCovarianceEstimator&) = delete;
+  LaggedCovarianceEstimator& operator=(const LaggedCovarianceEstimator&) =
+      delete;
+  ~LaggedCovarianceEstimator();
+
+  // Adds `y` to the history of y as the value of lag 0, and updates the
+  // covariance of `x` with the values of y of all the lags.
+  void Update(float x,
+              float x_mean,
+              float x_sigma,
+              float y,
+              float y_mean,
+              float y_sigma);
+
+  // Returns the largest normalized covariance over all the lags, or zero if
+  // none is positive.
+  float max_normalized_cross_correlation() const {
+    return max_normalized_cross_correlation_;
+  }
+
+  // Returns the first lag at which the largest normalized covariance is
+  // reached, or -1 if none is positive. Slow, intended for logging.
+  int FindBestLag() const;
+
+  float covariance(size_t lag) const { return covariances_[lag]; }
+  // Returns the deviation from its mean of the value of y at `lag`.
+  float y_deviation(size_t lag) const {
+    return y_deviations_[read_index_ + lag];
+  }
+  float y_sigma(size_t lag) const { return y_sigmas_[read_index_ + lag]; }
+
+  // Resets the estimated values and the history of y to zero.
+  void Clear();
+
+  // Returns the fastest implementation available. kAvx2 is only returned if
+  // `allow_fma` is set, since it is not bit-exact with the others.
+  static Implementation DetectImplementation(bool allow_fma);
+
+  Implementation implementation() const { return implementation_; }
+
+ private:
+  const Implementation implementation_;
+  const size_t num_lags_;
+  // Sigma of x in the last update.
+  float x_sigma_ = 0.f;
+  float max_normalized_cross_correlation_ = 0.f;
+  // Index of lag 0 in the history buffers below. The value of lag `k` is at
+  // `read_index_ + k`, and each value is written at two positions
+  // `num_lags_` apart.
+  size_t read_index_ = 0;
+  std::vector<float> y_deviations_;
+  std::vector<float> y_sigmas_;
+  std::vector<float> covariances_;
+};
+
+// Updates the `num_lags` covariances in `covariances` with
+// `scaled_x_deviation * y_deviations[k]` and returns the largest of the
+// normalized covariances, or zero if none is positive. Only for use by
+// LaggedCovarianceEstimator.
+float UpdateLaggedCovariances_AVX2(float scaled_x_deviation,
+                                   float x_sigma,
+                                   const float* y_deviations,
+                                   const float* y_sigmas,
+                                   size_t num_lags,
+                                   float* covariances);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_LAGGED_COVARIANCE_ESTIMATOR_H_
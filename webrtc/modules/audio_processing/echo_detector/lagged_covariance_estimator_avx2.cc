@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "modules/audio_processing/echo_detector/lagged_covariance_estimator.h"
+
+namespace webrtc {
+
+// The multiply-adds are fused, so the results differ by rounding from those of
+// the other implementations.
+float UpdateLaggedCovariances_AVX2(float scaled_x_deviation,
+                                   float x_sigma,
+                                   const float* y_deviations,
+                                   const float* y_sigmas,
+                                   size_t num_lags,
+                                   float* covariances) {
+  constexpr float kForgettingFactor = 1.f - LaggedCovarianceEstimator::kAlpha;
+  constexpr float kOffset = LaggedCovarianceEstimator::kNormalizationOffset;
+  const __m256 forgetting_factor = _mm256_set1_ps(kForgettingFactor);
+  const __m256 x_deviation = _mm256_set1_ps(scaled_x_deviation);
+  const __m256 x_sigma_8 = _mm256_set1_ps(x_sigma);
+  const __m256 offset = _mm256_set1_ps(kOffset);
+  __m256 max_8 = _mm256_setzero_ps();
+  const size_t vector_limit = num_lags & ~size_t{7};
+  for (size_t k = 0; k < vector_limit; k += 8) {
+    const __m256 covariance = _mm256_fmadd_ps(
+        forgetting_factor, _mm256_loadu_ps(&covariances[k]),
+        _mm256_mul_ps(x_deviation, _mm256_loadu_ps(&y_deviations[k])));
+    _mm256_storeu_ps(&covariances[k], covariance);
+    const __m256 denominator =
+        _mm256_fmadd_ps(x_sigma_8, _mm256_loadu_ps(&y_sigmas[k]), offset);
+    max_8 = _mm256_max_ps(max_8, _mm256_div_ps(covariance, denominator));
+  }
+  __m128 max_4 = _mm_max_ps(_mm256_castps256_ps128(max_8),
+                            _mm256_extractf128_ps(max_8, 1));
+  max_4 = _mm_max_ps(max_4, _mm_movehl_ps(max_4, max_4));
+  max_4 = _mm_max_ss(max_4, _mm_shuffle_ps(max_4, max_4, 1));
+  float max_normalized_cross_correlation = _mm_cvtss_f32(max_4);
+  for (size_t k = vector_limit; k < num_lags; ++k) {
+    covariances[k] = kForgettingFactor * covariances[k] +
+                     scaled_x_deviation * y_deviations[k];
+    max_normalized_cross_correlation =
+        std::max(max_normalized_cross_correlation,
+                 covariances[k] / (x_sigma * y_sigmas[k] + kOffset));
+  }
+  return max_normalized_cross_correlation;
+}
+
+}  // namespace webrtc
@@ -348,6 +348,15 @@ void GainControlImpl::Initialize(size_t num_proc_channels, int sample_rate_hz) {
   Configure();
 }
 
+void GainControlImpl::Reset() {
+  RTC_DCHECK(num_proc_channels_);
+  RTC_DCHECK(sample_rate_hz_);
+  analog_capture_level_ = 0;
+  was_analog_level_set_ = false;
+  stream_is_saturated_ = false;
+  Initialize(*num_proc_channels_, *sample_rate_hz_);
+}
+
 int GainControlImpl::Configure() {
   WebRtcAgcConfig config;
   // TODO(ajm): Flip the sign here (since AGC expects a positive value) if we
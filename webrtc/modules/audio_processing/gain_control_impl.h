@@ -39,6 +39,9 @@ class GainControlImpl : public GainControl {
   int ProcessCaptureAudio(AudioBuffer* audio, bool stream_has_echo);
 
   void Initialize(size_t num_proc_channels, int sample_rate_hz);
+  // Resets the gain control for the last initialized format, keeping its
+  // settings, and forgets the analog level set by the user.
+  void Reset();
 
   static void PackRenderAudioBuffer(const AudioBuffer& audio,
                                     std::vector<int16_t>* packed_buffer);
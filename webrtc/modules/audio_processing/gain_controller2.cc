@@ -89,7 +89,8 @@ GainController2::GainController2(
     const InputVolumeControllerConfig& input_volume_controller_config,
     int sample_rate_hz,
     int num_channels,
-    bool use_internal_vad)
+    bool use_internal_vad,
+    rtc::scoped_refptr<VadBatcher> vad_batcher)
     : cpu_features_(GetAllowedCpuFeatures()),
       data_dumper_(instance_count_.fetch_add(1) + 1),
       fixed_gain_applier_(
@@ -107,9 +108,15 @@ GainController2::GainController2(
     // Create dependencies.
     speech_level_estimator_ = std::make_unique<SpeechLevelEstimator>(
         &data_dumper_, config.adaptive_digital, kAdjacentSpeechFramesThreshold);
-    if (use_internal_vad)
+    if (use_internal_vad && vad_batcher) {
       vad_ = std::make_unique<VoiceActivityDetectorWrapper>(
-          kVadResetPeriodMs, cpu_features_, sample_rate_hz);
+          kVadResetPeriodMs, vad_batcher->CreateMonoVad(cpu_features_),
+          sample_rate_hz);
+    } else if (use_internal_vad) {
+      vad_ = std::make_unique<VoiceActivityDetectorWrapper>(
+          kVadResetPeriodMs, cpu_features_, sample_rate_hz,
+          config.quantized_vad);
+    }
   }
 
   if (config.input_volume_controller.enabled) {
@@ -154,6 +161,64 @@ void GainController2::SetFixedGainDb(float gain_db) {
   fixed_gain_applier_.SetGainFactor(gain_factor);
 }
 
+void GainController2::Reset() {
+  fixed_gain_applier_.Reset(fixed_gain_applier_.GetGainFactor());
+  if (noise_level_estimator_) {
+    noise_level_estimator_->Reset();
+  }
+  if (vad_) {
+    vad_->Reset();
+  }
+  if (speech_level_estimator_) {
+    speech_level_estimator_->Reset();
+  }
+  if (input_volume_controller_) {
+    input_volume_controller_->Reset();
+  }
+  if (saturation_protector_) {
+    saturation_protector_->Reset();
+  }
+  if (adaptive_digital_controller_) {
+    adaptive_digital_controller_->Reset();
+  }
+  limiter_.ResetForReuse();
+  calls_since_last_limiter_log_ = 0;
+  recommended_input_volume_ = std::nullopt;
+}
+
+void GainController2::SaveState(StateWriter* writer) const {
+  writer->WriteBool(speech_level_estimator_ != nullptr);
+  if (speech_level_estimator_) {
+    speech_level_estimator_->SaveState(writer);
+  }
+  writer->WriteBool(adaptive_digital_controller_ != nullptr);
+  if (adaptive_digital_controller_) {
+    noise_level_estimator_->SaveState(writer);
+    saturation_protector_->SaveState(writer);
+    adaptive_digital_controller_->SaveState(writer);
+  }
+}
+
+bool GainController2::RestoreState(StateReader* reader) {
+  bool has_speech_level_estimator;
+  if (!reader->ReadBool(&has_speech_level_estimator) ||
+      has_speech_level_estimator != (speech_level_estimator_ != nullptr) ||
+      (speech_level_estimator_ &&
+       !speech_level_estimator_->RestoreState(reader))) {
+    return false;
+  }
+  bool has_adaptive_digital_controller;
+  if (!reader->ReadBool(&has_adaptive_digital_controller) ||
+      has_adaptive_digital_controller !=
+          (adaptive_digital_controller_ != nullptr)) {
+    return false;
+  }
+  return !adaptive_digital_controller_ ||
+         (noise_level_estimator_->RestoreState(reader) &&
+          saturation_protector_->RestoreState(reader) &&
+          adaptive_digital_controller_->RestoreState(reader));
+}
+
 void GainController2::Analyze(int applied_input_volume,
                               const AudioBuffer& audio_buffer) {
   recommended_input_volume_ = std::nullopt;
@@ -16,6 +16,7 @@
 #include <string>
 
 #include "api/audio/audio_processing.h"
+#include "api/scoped_refptr.h"
 #include "modules/audio_processing/agc2/adaptive_digital_gain_controller.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/gain_applier.h"
@@ -24,8 +25,10 @@
 #include "modules/audio_processing/agc2/noise_level_estimator.h"
 #include "modules/audio_processing/agc2/saturation_protector.h"
 #include "modules/audio_processing/agc2/speech_level_estimator.h"
+#include "modules/audio_processing/agc2/vad_batcher.h"
 #include "modules/audio_processing/agc2/vad_wrapper.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -36,13 +39,16 @@ class AudioBuffer;
 class GainController2 {
  public:
   // Ctor. If `use_internal_vad` is true, an internal voice activity
-  // detector is used for digital adaptive gain.
+  // detector is used for digital adaptive gain. If `vad_batcher` is not null,
+  // the network of the internal detector is evaluated by `vad_batcher`
+  // together with those of the other AGC2 instances registered with it.
   GainController2(
       const AudioProcessing::Config::GainController2& config,
       const InputVolumeController::Config& input_volume_controller_config,
       int sample_rate_hz,
       int num_channels,
-      bool use_internal_vad);
+      bool use_internal_vad,
+      rtc::scoped_refptr<VadBatcher> vad_batcher = nullptr);
   GainController2(const GainController2&) = delete;
   GainController2& operator=(const GainController2&) = delete;
   ~GainController2();
@@ -50,6 +56,10 @@ class GainController2 {
   // Sets the fixed digital gain.
   void SetFixedGainDb(float gain_db);
 
+  // Resets all the submodules in place, as in a new gain controller with the
+  // current fixed digital gain.
+  void Reset();
+
   // Updates the input volume controller about whether the capture output is
   // used or not.
   void SetCaptureOutputUsed(bool capture_output_used);
@@ -81,6 +91,15 @@ class GainController2 {
     return recommended_input_volume_;
   }
 
+  // Saves the speech level, noise level and headroom estimates and the
+  // adaptive digital gain, and restores a state saved by a gain controller
+  // with the same submodules enabled. The state of the input volume
+  // controller, of the VAD and of the limiter is not saved. Returns false if
+  // the state does not match, in which case the gain controller may be left
+  // partially restored.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   static std::atomic<int> instance_count_;
   const AvailableCpuFeatures cpu_features_;
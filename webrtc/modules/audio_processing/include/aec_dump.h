@@ -18,6 +18,7 @@
 
 #include "absl/base/attributes.h"
 #include "api/audio/audio_processing.h"
+#include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
 
 namespace webrtc {
@@ -53,6 +54,14 @@ struct InternalAPMConfig {
   bool pre_amplifier_enabled = false;
   float pre_amplifier_fixed_gain_factor = 1.f;
   std::string experiments_description = "";
+
+  // The complete configuration, and the configs given to the built-in echo
+  // canceller if it is in use, so that a recording can be replayed with the
+  // same settings. They are not compared by operator==, since they only change
+  // with ApplyConfig(), which always records the configuration.
+  AudioProcessing::Config config;
+  std::optional<EchoCanceller3Config> echo_canceller3_config;
+  std::optional<EchoCanceller3Config> echo_canceller3_multichannel_config;
 };
 
 // An interface for recording configuration and input/output streams
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_PROCESSING_BATCH_H_
+#define MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_PROCESSING_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/audio_processing.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+class AudioBuffer;
+class AudioProcessingImpl;
+class SharedRenderAnalyzer;
+class VadBatcher;
+
+// Owns a set of independent APM sessions sharing the same configuration and
+// stream formats, and processes one 10 ms render/capture frame pair for every
+// session in a single call.
+//
+// Compared to calling ProcessReverseStream() and ProcessStream() separately on
+// N AudioProcessing instances, the batch acquires the render and capture locks
+// of each session once per tick instead of once per call, enables the
+// denormal disabler once for the whole sweep and calls the sessions without
+// virtual dispatch. Sessions are
+// kept in a contiguous array and processed in order, so that the render and
+// capture state of a session are hot in cache when its capture frame runs.
+// The state of each session stays in its own submodules: the batch does not
+// interleave the AEC3, noise suppressor or AGC2 state of the sessions into
+// cross-session arrays, so the sessions are processed one after the other.
+//
+// Sessions are identified by a SessionId, which stays valid until the session
+// is removed and is never given to another session.
+//
+// If `AudioProcessing::Config::GainController2::batched_vad` is set, the
+// voice activity detectors of AGC2 in all the sessions share a VadBatcher,
+// which evaluates their networks together once per tick.
+//
+// When all the sessions render the same signal, e.g., the mix of a conference,
+// ProcessStreamsWithSharedRender() analyzes it once per tick for the AEC3
+// echo cancellers of all the sessions, instead of once per session.
+//
+// The class is not thread-safe: ProcessStreams(), AddSession() and
+// RemoveSession() must be called from the same thread. The per-session
+// AudioProcessing interfaces returned by session() keep the usual APM
+// threading guarantees.
+class RTC_EXPORT AudioProcessingBatch {
+ public:
+  // Per-session input and output of a batched 10 ms tick. Audio is interleaved
+  // int16 and processed in place, in the formats given to the constructor.
+  using SessionId = uint64_t;
+
+  struct Frame {
+    // Session that processes the frame. Set by the caller, see
+    // ProcessStreams().
+    SessionId session_id = 0;
+    // Render frame to analyze before the capture frame. Null if the session
+    // has no render audio for this tick.
+    int16_t* render_audio = nullptr;
+    // Capture frame to process. If null, the frame of the session is skipped
+    // and `error` is set to kNullPointerError.
+    int16_t* capture_audio = nullptr;
+    // Optional stream parameters applied before processing the capture frame,
+    // equivalent to set_stream_delay_ms() and set_stream_analog_level().
+    std::optional<int> stream_delay_ms;
+    std::optional<int> applied_input_volume;
+
+    // Outputs.
+    int error = AudioProcessing::kNoError;
+    std::optional<int> recommended_input_volume;
+  };
+
+  // Creates `num_sessions` sessions configured with `config` and initialized
+  // for the given render and capture formats.
+  AudioProcessingBatch(const AudioProcessing::Config& config,
+                       const StreamConfig& render_config,
+                       const StreamConfig& capture_config,
+                       size_t num_sessions);
+  AudioProcessingBatch(const AudioProcessingBatch&) = delete;
+  AudioProcessingBatch& operator=(const AudioProcessingBatch&) = delete;
+  ~AudioProcessingBatch();
+
+  // Adds a new session and returns its id.
+  SessionId AddSession();
+
+  // Removes the session `session_id`. The ids of the other sessions are not
+  // affected. Returns false if there is no such session.
+  bool RemoveSession(SessionId session_id);
+
+  size_t num_sessions() const { return sessions_.size(); }
+
+  // Returns the ids of the sessions, in processing order.
+  std::vector<SessionId> session_ids() const;
+
+  // Gives access to a session, e.g., to apply a session-specific config or to
+  // read its statistics. Returns null if there is no such session.
+  AudioProcessing* session(SessionId session_id);
+
+  // Processes one frame pair for each session. `frames` must have exactly
+  // num_sessions() entries, with entry i for the i-th session of
+  // session_ids(), as given by `Frame::session_id`; otherwise
+  // kBadParameterError is returned. Returns kNoError if all sessions
+  // succeeded, otherwise the error of the first failing session. The
+  // per-session result is stored in `Frame::error`.
+  int ProcessStreams(rtc::ArrayView<Frame> frames);
+
+  // As ProcessStreams(), but with one render frame, `render_audio`, for all
+  // the sessions, which is not modified. The render analysis of AEC3 is shared
+  // by all the sessions with the same echo canceller settings as the first
+  // session. The `render_audio` of the entries of `frames` must be null.
+  // Once this has been called, the sessions keep reading their echo reference
+  // from the shared analysis, and ProcessStreams() returns kBadParameterError
+  // for entries with render audio.
+  int ProcessStreamsWithSharedRender(const int16_t* render_audio,
+                                     rtc::ArrayView<Frame> frames);
+
+  const StreamConfig& render_config() const { return render_config_; }
+  const StreamConfig& capture_config() const { return capture_config_; }
+
+ private:
+  struct Session {
+    SessionId id;
+    rtc::scoped_refptr<AudioProcessingImpl> apm;
+  };
+
+  // Returns the session `session_id`, or null if there is none.
+  Session* FindSession(SessionId session_id);
+  // Returns true if `frames` matches the sessions one to one.
+  bool FramesMatchSessions(rtc::ArrayView<const Frame> frames) const;
+  // Attaches `session` to the shared render analyzer, which is created from
+  // the session if there is none yet.
+  void AttachSharedRender(AudioProcessingImpl& session);
+  int ProcessSessions(rtc::ArrayView<Frame> frames,
+                      const int16_t* shared_render_audio);
+
+  const AudioProcessing::Config config_;
+  const StreamConfig render_config_;
+  const StreamConfig capture_config_;
+  const rtc::scoped_refptr<VadBatcher> vad_batcher_;
+  // Sorted by id, since ids are increasing and removals keep the order.
+  std::vector<Session> sessions_;
+  SessionId next_session_id_ = 0;
+  bool shared_render_ = false;
+  rtc::scoped_refptr<SharedRenderAnalyzer> shared_render_analyzer_;
+  std::unique_ptr<AudioBuffer> shared_render_audio_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_PROCESSING_BATCH_H_
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_PROCESSING_POOL_H_
+#define MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_PROCESSING_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/audio/audio_processing.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Keeps fully initialized AudioProcessing instances per configuration and
+// stream formats, so that a call can get an instance without allocating and
+// initializing the submodules, which is costly when many calls are set up at
+// once.
+//
+// Acquire() hands out a pooled instance if there is one, and otherwise creates
+// a new one. An acquired instance goes back to the pool when its last
+// reference is dropped: its state is reset in place so that it processes as a
+// new instance, and it is kept for the next Acquire() with the same key, up to
+// `max_pooled_instances_per_key` instances. An instance is freed instead if the
+// pool is full or destroyed, or if its configuration or stream formats have
+// changed since it was acquired.
+//
+// The class is thread-safe. Instances are created, saved and reset outside of
+// the pool lock, so acquisitions of pooled instances are not delayed by them.
+// Acquired instances may outlive the pool.
+class RTC_EXPORT AudioProcessingPool {
+ public:
+  struct Stats {
+    // Number of Acquire() calls, and of those that got a pooled instance.
+    size_t num_acquisitions = 0;
+    size_t num_hits = 0;
+    // Number of instances kept in the pool.
+    size_t num_pooled_instances = 0;
+    // Rough estimate of the heap usage of the pooled instances, for monitoring
+    // only. It is the growth of the process heap, as reported by glibc, while
+    // the first instance of each key is created, so allocations made
+    // concurrently by other threads are counted as well, and memory that
+    // the allocator had already reserved may be missed. It is 0 where glibc
+    // does not report the heap usage.
+    size_t approximate_pooled_memory_bytes = 0;
+
+    float hit_rate() const {
+      return num_acquisitions > 0
+                 ? static_cast<float>(num_hits) / num_acquisitions
+                 : 0.0f;
+    }
+  };
+
+  explicit AudioProcessingPool(size_t max_pooled_instances_per_key);
+  AudioProcessingPool(const AudioProcessingPool&) = delete;
+  AudioProcessingPool& operator=(const AudioProcessingPool&) = delete;
+  ~AudioProcessingPool();
+
+  // Creates instances for `config` and the given render and capture formats
+  // until the pool keeps `num_instances` of them, or the maximum per key.
+  void Prewarm(const AudioProcessing::Config& config,
+               const StreamConfig& render_config,
+               const StreamConfig& capture_config,
+               size_t num_instances);
+
+  // Returns an instance configured with `config` and initialized for the given
+  // render and capture formats.
+  rtc::scoped_refptr<AudioProcessing> Acquire(
+      const AudioProcessing::Config& config,
+      const StreamConfig& render_config,
+      const StreamConfig& capture_config);
+
+  // Drops a reference to an instance returned by Acquire() of this pool. The
+  // instance goes back to the pool once the other references, if any, are
+  // dropped as well.
+  void Release(rtc::scoped_refptr<AudioProcessing> apm);
+
+  Stats GetStats() const;
+
+ private:
+  // The pooled instances and the statistics. The acquired instances only hold
+  // a weak reference to it, so that they can outlive the pool.
+  class Core;
+
+  const std::shared_ptr<Core> core_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_PROCESSING_POOL_H_
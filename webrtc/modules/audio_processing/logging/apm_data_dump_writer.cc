@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/logging/apm_data_dump_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "api/units/time_delta.h"
+#include "common_audio/wav_file.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Size of the stdio buffer of the raw files, which sets the size of the
+// batches in which the files are written.
+constexpr size_t kRawFileBufferSize = 1 << 18;
+
+// Interval at which the background thread looks for queued data.
+constexpr TimeDelta kPollInterval = TimeDelta::Millis(10);
+
+}  // namespace
+
+struct ApmDataDumpWriter::File {
+  ~File() {
+    if (raw_file) {
+      fclose(raw_file);
+    }
+  }
+
+  FILE* raw_file = nullptr;
+  std::unique_ptr<char[]> raw_file_buffer;
+  std::unique_ptr<WavWriter> wav_file;
+};
+
+ApmDataDumpWriter::ApmDataDumpWriter(size_t ring_size_bytes)
+    : ring_(ring_size_bytes) {
+  thread_ = rtc::PlatformThread::SpawnJoinable([this] { Run(); },
+                                               "apm_data_dump_writer");
+}
+
+ApmDataDumpWriter::~ApmDataDumpWriter() {
+  stop_.store(true);
+  wake_up_.Set();
+  thread_.Finalize();
+}
+
+int ApmDataDumpWriter::RegisterFile(absl::string_view filename,
+                                    Format format,
+                                    int sample_rate_hz,
+                                    int num_channels) {
+  MutexLock lock(&mutex_);
+  registered_files_.push_back(
+      {std::string(filename), format, sample_rate_hz, num_channels});
+  return static_cast<int>(registered_files_.size()) - 1;
+}
+
+bool ApmDataDumpWriter::Write(int handle, const void* data, size_t num_bytes) {
+  const int32_t record_handle = handle;
+  RecordRing::Reservation reservation;
+  if (!ring_.Reserve(sizeof(record_handle) + num_bytes, &reservation)) {
+    return false;
+  }
+  ring_.Copy(&record_handle, sizeof(record_handle), &reservation);
+  ring_.Copy(data, num_bytes, &reservation);
+  ring_.Commit(reservation);
+  return true;
+}
+
+void ApmDataDumpWriter::Run() {
+  while (!stop_.load()) {
+    if (!WriteQueuedRecords()) {
+      wake_up_.Wait(kPollInterval);
+    }
+  }
+  WriteQueuedRecords();
+  files_.clear();
+}
+
+bool ApmDataDumpWriter::WriteQueuedRecords() {
+  bool records_written = false;
+  while (const size_t record_size = ring_.NextRecordSize()) {
+    int32_t handle;
+    ring_.Read(0, &handle, sizeof(handle));
+    record_buffer_.resize(record_size - sizeof(handle));
+    ring_.Read(sizeof(handle), record_buffer_.data(), record_buffer_.size());
+    // Release the record before the, possibly slow, file write.
+    ring_.Pop();
+
+    File* file = GetFile(handle);
+    if (file->raw_file) {
+      fwrite(record_buffer_.data(), 1, record_buffer_.size(), file->raw_file);
+    } else if (file->wav_file) {
+      file->wav_file->WriteSamples(
+          reinterpret_cast<const float*>(record_buffer_.data()),
+          record_buffer_.size() / sizeof(float));
+    }
+    records_written = true;
+  }
+  return records_written;
+}
+
+ApmDataDumpWriter::File* ApmDataDumpWriter::GetFile(int handle) {
+  RTC_DCHECK_GE(handle, 0);
+  if (static_cast<size_t>(handle) >= files_.size()) {
+    files_.resize(handle + 1);
+  }
+  std::unique_ptr<File>& file = files_[handle];
+  if (!file) {
+    FileInfo info;
+    {
+      MutexLock lock(&mutex_);
+      RTC_DCHECK_LT(handle, registered_files_.size());
+      info = registered_files_[handle];
+    }
+    file = std::make_unique<File>();
+    if (info.format == Format::kRaw) {
+      file->raw_file = fopen(info.filename.c_str(), "wb");
+      RTC_CHECK(file->raw_file) << "Cannot write to " << info.filename << ".";
+      file->raw_file_buffer.reset(new char[kRawFileBufferSize]);
+      setvbuf(file->raw_file, file->raw_file_buffer.get(), _IOFBF,
+              kRawFileBufferSize);
+    } else {
+      file->wav_file = std::make_unique<WavWriter>(
+          info.filename, info.sample_rate_hz, info.num_channels,
+          WavFile::SampleFormat::kFloat);
+    }
+  }
+  return file.get();
+}
+
+}  // namespace webrtc
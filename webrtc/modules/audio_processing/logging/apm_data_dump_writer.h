@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_LOGGING_APM_DATA_DUMP_WRITER_H_
+#define MODULES_AUDIO_PROCESSING_LOGGING_APM_DATA_DUMP_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "modules/audio_processing/utility/record_ring.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Writes the data dumped by ApmDataDumper to files on a background thread.
+// Write() only copies the data into a preallocated ring buffer, which is
+// shared by any number of writing threads without locks, and the background
+// thread writes the queued data to the files in large batches.
+class ApmDataDumpWriter {
+ public:
+  enum class Format { kRaw, kWavFloat };
+
+  explicit ApmDataDumpWriter(size_t ring_size_bytes);
+  ApmDataDumpWriter(const ApmDataDumpWriter&) = delete;
+  ApmDataDumpWriter& operator=(const ApmDataDumpWriter&) = delete;
+  // Writes all queued data before returning.
+  ~ApmDataDumpWriter();
+
+  // Registers a file to write to and returns its handle. The file is created
+  // by the background thread. Takes a lock, so it should only be called once
+  // per file.
+  int RegisterFile(absl::string_view filename,
+                   Format format,
+                   int sample_rate_hz,
+                   int num_channels);
+
+  // Queues `num_bytes` bytes of `data` to be written to the file `handle`.
+  // Never blocks. Returns false, and counts the call as dropped, if there is
+  // no room for the data in the ring buffer.
+  bool Write(int handle, const void* data, size_t num_bytes);
+
+  // Returns the number of dropped Write() calls.
+  int64_t num_dropped() const { return ring_.num_dropped(); }
+
+ private:
+  struct File;
+
+  void Run();
+  // Writes all the committed records. Returns whether any were written.
+  bool WriteQueuedRecords();
+  File* GetFile(int handle);
+
+  // Each record holds the handle of its file, followed by the data.
+  RecordRing ring_;
+
+  Mutex mutex_;
+  struct FileInfo {
+    std::string filename;
+    Format format;
+    int sample_rate_hz;
+    int num_channels;
+  };
+  std::vector<FileInfo> registered_files_ RTC_GUARDED_BY(mutex_);
+
+  // Only accessed by the background thread.
+  std::vector<std::unique_ptr<File>> files_;
+  std::vector<uint8_t> record_buffer_;
+
+  std::atomic<bool> stop_{false};
+  rtc::Event wake_up_;
+  rtc::PlatformThread thread_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_LOGGING_APM_DATA_DUMP_WRITER_H_
@@ -63,31 +63,98 @@ ApmDataDumper::~ApmDataDumper() = default;
 bool ApmDataDumper::recording_activated_ = false;
 std::optional<int> ApmDataDumper::dump_set_to_use_;
 char ApmDataDumper::output_dir_[] = "";
+ApmDataDumpWriter* ApmDataDumper::async_writer_ = nullptr;
 
-FILE* ApmDataDumper::GetRawFile(absl::string_view name) {
-  std::string filename = FormFileName(output_dir_, name, instance_index_,
-                                      recording_set_index_, ".dat");
-  auto& f = raw_files_[filename];
-  if (!f) {
-    f.reset(fopen(filename.c_str(), "wb"));
-    RTC_CHECK(f.get()) << "Cannot write to " << filename << ".";
+void ApmDataDumper::SetAsyncWriting(size_t ring_size_bytes) {
+  static std::unique_ptr<ApmDataDumpWriter> writer;
+  async_writer_ = nullptr;
+  writer.reset();
+  if (ring_size_bytes > 0) {
+    writer = std::make_unique<ApmDataDumpWriter>(ring_size_bytes);
+    async_writer_ = writer.get();
   }
-  return f.get();
 }
 
-WavWriter* ApmDataDumper::GetWavFile(absl::string_view name,
-                                     int sample_rate_hz,
-                                     int num_channels,
-                                     WavFile::SampleFormat format) {
-  std::string filename = FormFileName(output_dir_, name, instance_index_,
-                                      recording_set_index_, ".wav");
-  auto& f = wav_files_[filename];
-  if (!f) {
-    f.reset(
-        new WavWriter(filename.c_str(), sample_rate_hz, num_channels, format));
+void ApmDataDumper::WriteRaw(absl::string_view name,
+                             const void* data,
+                             size_t num_bytes) {
+  Output* output = GetRawOutput(name);
+  if (output->async_handle >= 0) {
+    RTC_DCHECK(async_writer_);
+    async_writer_->Write(output->async_handle, data, num_bytes);
+  } else {
+    fwrite(data, 1, num_bytes, output->raw_file.get());
   }
-  return f.get();
 }
+
+void ApmDataDumper::WriteWav(absl::string_view name,
+                             const float* v,
+                             size_t v_length,
+                             int sample_rate_hz,
+                             int num_channels) {
+  Output* output = GetWavOutput(name, sample_rate_hz, num_channels);
+  if (output->async_handle >= 0) {
+    RTC_DCHECK(async_writer_);
+    async_writer_->Write(output->async_handle, v, v_length * sizeof(v[0]));
+  } else {
+    output->wav_file->WriteSamples(v, v_length);
+  }
+}
+
+ApmDataDumper::Output* ApmDataDumper::GetRawOutput(absl::string_view name) {
+  Output* output = raw_output_cache_.Find(name);
+  if (output) {
+    return output;
+  }
+  auto it = raw_outputs_.find(name);
+  if (it != raw_outputs_.end()) {
+    output = &it->second;
+  } else {
+    output = &raw_outputs_[std::string(name)];
+    output->name = std::string(name);
+    std::string filename = FormFileName(output_dir_, name, instance_index_,
+                                        recording_set_index_, ".dat");
+    if (async_writer_) {
+      output->async_handle = async_writer_->RegisterFile(
+          filename, ApmDataDumpWriter::Format::kRaw, 0, 0);
+    } else {
+      output->raw_file.reset(fopen(filename.c_str(), "wb"));
+      RTC_CHECK(output->raw_file.get()) << "Cannot write to " << filename << ".";
+    }
+  }
+  raw_output_cache_.Insert(name, output);
+  return output;
+}
+
+ApmDataDumper::Output* ApmDataDumper::GetWavOutput(absl::string_view name,
+                                                   int sample_rate_hz,
+                                                   int num_channels) {
+  Output* output = wav_output_cache_.Find(name);
+  if (output) {
+    return output;
+  }
+  auto it = wav_outputs_.find(name);
+  if (it != wav_outputs_.end()) {
+    output = &it->second;
+  } else {
+    output = &wav_outputs_[std::string(name)];
+    output->name = std::string(name);
+    std::string filename = FormFileName(output_dir_, name, instance_index_,
+                                        recording_set_index_, ".wav");
+    if (async_writer_) {
+      output->async_handle = async_writer_->RegisterFile(
+          filename, ApmDataDumpWriter::Format::kWavFloat, sample_rate_hz,
+          num_channels);
+    } else {
+      output->wav_file = std::make_unique<WavWriter>(
+          filename, sample_rate_hz, num_channels, WavFile::SampleFormat::kFloat);
+    }
+  }
+  wav_output_cache_.Insert(name, output);
+  return output;
+}
+#else
+void ApmDataDumper::SetAsyncWriting(size_t ring_size_bytes) {}
 #endif
 
 }  // namespace webrtc
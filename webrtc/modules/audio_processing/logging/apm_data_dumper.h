@@ -15,9 +15,12 @@
 #include <stdio.h>
 
 #if WEBRTC_APM_DEBUG_DUMP == 1
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #endif
 
 #include <optional>
@@ -26,6 +29,7 @@
 #include "api/array_view.h"
 #if WEBRTC_APM_DEBUG_DUMP == 1
 #include "common_audio/wav_file.h"
+#include "modules/audio_processing/logging/apm_data_dump_writer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/string_utils.h"
 #endif
@@ -96,11 +100,34 @@ class ApmDataDumper {
 #endif
   }
 
+  // Makes the dump calls of all instances copy the data into a preallocated
+  // ring buffer of `ring_size_bytes` bytes, from which a background thread
+  // writes it to the files. Dump calls that find the ring full are dropped and
+  // counted. A zero size returns to writing the files synchronously, once all
+  // pending data has been written. Must be called before any data is dumped,
+  // or be followed by InitiateNewSetOfRecordings() on all instances, and not
+  // while any instance is dumping data.
+  static void SetAsyncWriting(size_t ring_size_bytes);
+
+  // Returns the number of dump calls dropped by the asynchronous writing since
+  // it was enabled.
+  static int64_t NumDroppedAsyncDumps() {
+#if WEBRTC_APM_DEBUG_DUMP == 1
+    return async_writer_ ? async_writer_->num_dropped() : 0;
+#else
+    return 0;
+#endif
+  }
+
   // Reinitializes the data dumping such that new versions
   // of all files being dumped to are created.
   void InitiateNewSetOfRecordings() {
 #if WEBRTC_APM_DEBUG_DUMP == 1
     ++recording_set_index_;
+    raw_output_cache_.Clear();
+    wav_output_cache_.Clear();
+    raw_outputs_.clear();
+    wav_outputs_.clear();
 #endif
   }
 
@@ -114,8 +141,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(&v, sizeof(v), 1, file);
+      WriteRaw(name, &v, sizeof(v));
     }
 #endif
   }
@@ -129,8 +155,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(v, sizeof(v[0]), v_length, file);
+      WriteRaw(name, v, v_length * sizeof(v[0]));
     }
 #endif
   }
@@ -156,8 +181,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(&v, sizeof(v), 1, file);
+      WriteRaw(name, &v, sizeof(v));
     }
 #endif
   }
@@ -171,8 +195,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(v, sizeof(v[0]), v_length, file);
+      WriteRaw(name, v, v_length * sizeof(v[0]));
     }
 #endif
   }
@@ -210,10 +233,12 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      for (size_t k = 0; k < v_length; ++k) {
-        int16_t value = static_cast<int16_t>(v[k]);
-        fwrite(&value, sizeof(value), 1, file);
+      // Store the values as int16_t, converting them in chunks.
+      int16_t values[64];
+      for (size_t k = 0; k < v_length; k += std::size(values)) {
+        const size_t chunk = std::min(v_length - k, std::size(values));
+        std::copy(v + k, v + k + chunk, values);
+        WriteRaw(name, values, chunk * sizeof(values[0]));
       }
     }
 #endif
@@ -240,8 +265,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(&v, sizeof(v), 1, file);
+      WriteRaw(name, &v, sizeof(v));
     }
 #endif
   }
@@ -255,8 +279,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(v, sizeof(v[0]), v_length, file);
+      WriteRaw(name, v, v_length * sizeof(v[0]));
     }
 #endif
   }
@@ -282,8 +305,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(&v, sizeof(v), 1, file);
+      WriteRaw(name, &v, sizeof(v));
     }
 #endif
   }
@@ -297,8 +319,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(v, sizeof(v[0]), v_length, file);
+      WriteRaw(name, v, v_length * sizeof(v[0]));
     }
 #endif
   }
@@ -311,8 +332,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(&v, sizeof(v), 1, file);
+      WriteRaw(name, &v, sizeof(v));
     }
 #endif
   }
@@ -326,8 +346,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      FILE* file = GetRawFile(name);
-      fwrite(v, sizeof(v[0]), v_length, file);
+      WriteRaw(name, v, v_length * sizeof(v[0]));
     }
 #endif
   }
@@ -367,9 +386,7 @@ class ApmDataDumper {
       return;
 
     if (recording_activated_) {
-      WavWriter* file = GetWavFile(name, sample_rate_hz, num_channels,
-                                   WavFile::SampleFormat::kFloat);
-      file->WriteSamples(v, v_length);
+      WriteWav(name, v, v_length, sample_rate_hz, num_channels);
     }
 #endif
   }
@@ -391,21 +408,69 @@ class ApmDataDumper {
 
  private:
 #if WEBRTC_APM_DEBUG_DUMP == 1
+  // Destination of the data dumped under one name.
+  struct Output {
+    std::string name;
+    // Handle of the file in the asynchronous writer, if used.
+    int async_handle = -1;
+    std::unique_ptr<FILE, RawFileCloseFunctor> raw_file;
+    std::unique_ptr<WavWriter> wav_file;
+  };
+
+  // Small direct-mapped cache from the address of a name to its output. As the
+  // names are mostly string literals, this avoids hashing the name strings on
+  // every dump call. The name is compared on each hit, so that names stored in
+  // reused memory are handled correctly.
+  class OutputCache {
+   public:
+    Output* Find(absl::string_view name) const {
+      const Entry& e = entries_[Index(name.data())];
+      return e.data == name.data() && e.output && e.output->name == name
+                 ? e.output
+                 : nullptr;
+    }
+    void Insert(absl::string_view name, Output* output) {
+      entries_[Index(name.data())] = {name.data(), output};
+    }
+    void Clear() { entries_.fill({}); }
+
+   private:
+    struct Entry {
+      const char* data = nullptr;
+      Output* output = nullptr;
+    };
+    static size_t Index(const char* p) {
+      return (reinterpret_cast<uintptr_t>(p) >> 3) % kSize;
+    }
+    static constexpr size_t kSize = 64;
+    std::array<Entry, kSize> entries_;
+  };
+
+  void WriteRaw(absl::string_view name, const void* data, size_t num_bytes);
+  void WriteWav(absl::string_view name,
+                const float* v,
+                size_t v_length,
+                int sample_rate_hz,
+                int num_channels);
+  Output* GetRawOutput(absl::string_view name);
+  Output* GetWavOutput(absl::string_view name,
+                       int sample_rate_hz,
+                       int num_channels);
+
   static bool recording_activated_;
   static std::optional<int> dump_set_to_use_;
   static constexpr size_t kOutputDirMaxLength = 1024;
   static char output_dir_[kOutputDirMaxLength];
+  static ApmDataDumpWriter* async_writer_;
   const int instance_index_;
   int recording_set_index_ = 0;
-  std::unordered_map<std::string, std::unique_ptr<FILE, RawFileCloseFunctor>>
-      raw_files_;
-  std::unordered_map<std::string, std::unique_ptr<WavWriter>> wav_files_;
-
-  FILE* GetRawFile(absl::string_view name);
-  WavWriter* GetWavFile(absl::string_view name,
-                        int sample_rate_hz,
-                        int num_channels,
-                        WavFile::SampleFormat format);
+  // Outputs by name. The transparent comparator lets a cache miss look a name
+  // up without allocating a key, so that only the first dump of a name
+  // allocates.
+  std::map<std::string, Output, std::less<>> raw_outputs_;
+  std::map<std::string, Output, std::less<>> wav_outputs_;
+  OutputCache raw_output_cache_;
+  OutputCache wav_output_cache_;
 #endif
 };
 
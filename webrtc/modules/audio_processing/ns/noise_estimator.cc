@@ -192,4 +192,26 @@ void NoiseEstimator::PostUpdate(
   }
 }
 
+void NoiseEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteFloat(white_noise_level_);
+  writer->WriteFloat(pink_noise_numerator_);
+  writer->WriteFloat(pink_noise_exp_);
+  writer->WriteFloats(prev_noise_spectrum_);
+  writer->WriteFloats(conservative_noise_spectrum_);
+  writer->WriteFloats(parametric_noise_spectrum_);
+  writer->WriteFloats(noise_spectrum_);
+  quantile_noise_estimator_.SaveState(writer);
+}
+
+bool NoiseEstimator::RestoreState(StateReader* reader) {
+  return reader->ReadFloat(&white_noise_level_) &&
+         reader->ReadFloat(&pink_noise_numerator_) &&
+         reader->ReadFloat(&pink_noise_exp_) &&
+         reader->ReadFloats(prev_noise_spectrum_) &&
+         reader->ReadFloats(conservative_noise_spectrum_) &&
+         reader->ReadFloats(parametric_noise_spectrum_) &&
+         reader->ReadFloats(noise_spectrum_) &&
+         quantile_noise_estimator_.RestoreState(reader);
+}
+
 }  // namespace webrtc
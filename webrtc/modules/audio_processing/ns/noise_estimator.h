@@ -17,6 +17,7 @@
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/quantile_noise_estimator.h"
 #include "modules/audio_processing/ns/suppression_params.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -60,6 +61,10 @@ class NoiseEstimator {
     return conservative_noise_spectrum_;
   }
 
+  // Saves and restores the estimator state.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   const SuppressionParams& suppression_params_;
   float white_noise_level_ = 0.f;
@@ -259,6 +259,7 @@ NoiseSuppressor::NoiseSuppressor(const NsConfig& config,
     : num_bands_(NumBandsForRate(sample_rate_hz)),
       num_channels_(num_channels),
       suppression_params_(config.target_level),
+      fft_(NrFft::SelectImplementation(config.use_pffft)),
       filter_bank_states_heap_(NumChannelsOnHeap(num_channels_)),
       upper_band_gains_heap_(NumChannelsOnHeap(num_channels_)),
       energies_before_filtering_heap_(NumChannelsOnHeap(num_channels_)),
@@ -553,4 +554,44 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
   }
 }
 
+void NoiseSuppressor::SaveState(StateWriter* writer) const {
+  writer->WriteInt(num_analyzed_frames_);
+  writer->WriteSize(num_channels_);
+  for (const auto& ch : channels_) {
+    ch->noise_estimator.SaveState(writer);
+    ch->speech_probability_estimator.SaveState(writer);
+    ch->wiener_filter.SaveState(writer);
+    writer->WriteFloats(ch->prev_analysis_signal_spectrum);
+  }
+}
+
+bool NoiseSuppressor::RestoreState(StateReader* reader) {
+  int num_analyzed_frames;
+  if (!reader->ReadInt(&num_analyzed_frames) || num_analyzed_frames < -1 ||
+      !reader->ReadExpectedSize(num_channels_)) {
+    return false;
+  }
+  num_analyzed_frames_ = num_analyzed_frames;
+  for (auto& ch : channels_) {
+    if (!ch->noise_estimator.RestoreState(reader) ||
+        !ch->speech_probability_estimator.RestoreState(reader) ||
+        !ch->wiener_filter.RestoreState(reader) ||
+        !reader->ReadFloats(ch->prev_analysis_signal_spectrum)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void NoiseSuppressor::ResetBufferedAudio() {
+  for (auto& ch : channels_) {
+    ch->analyze_analysis_memory.fill(0.f);
+    ch->process_analysis_memory.fill(0.f);
+    ch->process_synthesis_memory.fill(0.f);
+    for (auto& d : ch->process_delay_memory) {
+      d.fill(0.f);
+    }
+  }
+}
+
 }  // namespace webrtc
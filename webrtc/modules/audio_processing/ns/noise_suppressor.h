@@ -22,6 +22,7 @@
 #include "modules/audio_processing/ns/ns_fft.h"
 #include "modules/audio_processing/ns/speech_probability_estimator.h"
 #include "modules/audio_processing/ns/wiener_filter.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -49,6 +50,17 @@ class NoiseSuppressor {
     capture_output_used_ = capture_output_used;
   }
 
+  // Saves the noise and speech estimates, and restores estimates saved by a
+  // noise suppressor with the same number of channels. The estimates do not
+  // depend on the sample rate. Returns false if the state does not match, in
+  // which case the noise suppressor may be left partially restored.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
+  // Zeroes the overlap and delay memories of the filter banks, as in a new
+  // noise suppressor. The estimates are kept.
+  void ResetBufferedAudio();
+
  private:
   const size_t num_bands_;
   const size_t num_channels_;
@@ -17,6 +17,9 @@ namespace webrtc {
 struct NsConfig {
   enum class SuppressionLevel { k6dB, k12dB, k18dB, k21dB };
   SuppressionLevel target_level = SuppressionLevel::k12dB;
+  // Computes the transforms with the SIMD optimized PFFFT library instead of
+  // the Ooura FFT, when available. The output differs by rounding errors only.
+  bool use_pffft = false;
 };
 
 }  // namespace webrtc
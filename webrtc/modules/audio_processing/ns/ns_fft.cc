@@ -10,11 +10,26 @@
 
 #include "modules/audio_processing/ns/ns_fft.h"
 
+#include <algorithm>
+
 #include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 
-NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
+NrFft::NrFft() : NrFft(Implementation::kOoura) {}
+
+NrFft::NrFft(Implementation implementation) : implementation_(implementation) {
+  if (implementation_ == Implementation::kPffft) {
+    RTC_DCHECK(Pffft::IsSimdEnabled());
+    pffft_ = std::make_unique<Pffft>(kFftSize, Pffft::FftType::kReal);
+    pffft_buffer_ = pffft_->CreateBuffer();
+    return;
+  }
+
+  bit_reversal_state_.resize(kFftSize / 2);
+  tables_.resize(kFftSize / 2);
+
   // Initialize WebRtc_rdt (setting (bit_reversal_state_[0] to 0 triggers
   // initialization)
   bit_reversal_state_[0] = 0.f;
@@ -24,9 +39,33 @@ NrFft::NrFft() : bit_reversal_state_(kFftSize / 2), tables_(kFftSize / 2) {
               tables_.data());
 }
 
+NrFft::Implementation NrFft::SelectImplementation(bool use_pffft) {
+  return use_pffft && Pffft::IsSimdEnabled() ? Implementation::kPffft
+                                             : Implementation::kOoura;
+}
+
 void NrFft::Fft(rtc::ArrayView<float, kFftSize> time_data,
                 rtc::ArrayView<float, kFftSize> real,
                 rtc::ArrayView<float, kFftSize> imag) {
+  if (pffft_) {
+    rtc::ArrayView<float> buffer = pffft_buffer_->GetView();
+    std::copy(time_data.begin(), time_data.end(), buffer.begin());
+    pffft_->ForwardTransform(*pffft_buffer_, pffft_buffer_.get(),
+                             /*ordered=*/true);
+
+    // The ordered output is packed as in the Ooura FFT, but with the opposite
+    // sign convention for the imaginary part.
+    real[0] = buffer[0];
+    imag[0] = 0;
+    real[kFftSizeBy2Plus1 - 1] = buffer[1];
+    imag[kFftSizeBy2Plus1 - 1] = 0;
+    for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
+      real[i] = buffer[2 * i];
+      imag[i] = -buffer[2 * i + 1];
+    }
+    return;
+  }
+
   WebRtc_rdft(kFftSize, 1, time_data.data(), bit_reversal_state_.data(),
               tables_.data());
 
@@ -45,6 +84,26 @@ void NrFft::Fft(rtc::ArrayView<float, kFftSize> time_data,
 void NrFft::Ifft(rtc::ArrayView<const float> real,
                  rtc::ArrayView<const float> imag,
                  rtc::ArrayView<float> time_data) {
+  if (pffft_) {
+    rtc::ArrayView<float> buffer = pffft_buffer_->GetView();
+    buffer[0] = real[0];
+    buffer[1] = real[kFftSizeBy2Plus1 - 1];
+    for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
+      buffer[2 * i] = real[i];
+      buffer[2 * i + 1] = -imag[i];
+    }
+    pffft_->BackwardTransform(*pffft_buffer_, pffft_buffer_.get(),
+                              /*ordered=*/true);
+
+    // The unnormalized PFFFT inverse is scaled by kFftSize, i.e., twice as
+    // much as the Ooura inverse.
+    constexpr float kScaling = 1.f / kFftSize;
+    for (size_t i = 0; i < kFftSize; ++i) {
+      time_data[i] = buffer[i] * kScaling;
+    }
+    return;
+  }
+
   time_data[0] = real[0];
   time_data[1] = real[kFftSizeBy2Plus1 - 1];
   for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
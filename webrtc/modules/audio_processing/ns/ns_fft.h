@@ -11,17 +11,29 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/ns/ns_common.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 
 namespace webrtc {
 
 // Wrapper class providing 256 point FFT functionality.
 class NrFft {
  public:
+  // Transform implementation. kOoura is the reference implementation. kPffft
+  // uses the SIMD optimized PFFFT library (SSE on x86, NEON on ARM) and is only
+  // available when PFFFT is built with SIMD support. The results of the two
+  // implementations differ by rounding errors only: the largest deviation of
+  // the spectra, and of the inverse transforms, is below 1e-6 relative to the
+  // peak magnitude.
+  enum class Implementation { kOoura, kPffft };
+
+  // Uses the Ooura implementation.
   NrFft();
+  explicit NrFft(Implementation implementation);
   NrFft(const NrFft&) = delete;
   NrFft& operator=(const NrFft&) = delete;
 
@@ -35,9 +47,19 @@ class NrFft {
             rtc::ArrayView<const float> imag,
             rtc::ArrayView<float> time_data);
 
+  // Returns kPffft if `use_pffft` is set and PFFFT is available, and kOoura
+  // otherwise.
+  static Implementation SelectImplementation(bool use_pffft);
+
+  Implementation implementation() const { return implementation_; }
+
  private:
+  const Implementation implementation_;
+  // Only the state of the implementation in use is allocated.
   std::vector<size_t> bit_reversal_state_;
   std::vector<float> tables_;
+  std::unique_ptr<Pffft> pffft_;
+  std::unique_ptr<Pffft::FloatBuffer> pffft_buffer_;
 };
 
 }  // namespace webrtc
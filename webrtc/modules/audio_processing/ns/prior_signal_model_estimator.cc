@@ -168,4 +168,22 @@ void PriorSignalModelEstimator::Update(const Histograms& histograms) {
   }
 }
 
+void PriorSignalModelEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteFloat(prior_model_.lrt);
+  writer->WriteFloat(prior_model_.flatness_threshold);
+  writer->WriteFloat(prior_model_.template_diff_threshold);
+  writer->WriteFloat(prior_model_.lrt_weighting);
+  writer->WriteFloat(prior_model_.flatness_weighting);
+  writer->WriteFloat(prior_model_.difference_weighting);
+}
+
+bool PriorSignalModelEstimator::RestoreState(StateReader* reader) {
+  return reader->ReadFloat(&prior_model_.lrt) &&
+         reader->ReadFloat(&prior_model_.flatness_threshold) &&
+         reader->ReadFloat(&prior_model_.template_diff_threshold) &&
+         reader->ReadFloat(&prior_model_.lrt_weighting) &&
+         reader->ReadFloat(&prior_model_.flatness_weighting) &&
+         reader->ReadFloat(&prior_model_.difference_weighting);
+}
+
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 
 #include "modules/audio_processing/ns/histograms.h"
 #include "modules/audio_processing/ns/prior_signal_model.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -30,6 +31,10 @@ class PriorSignalModelEstimator {
   // Returns the estimated model.
   const PriorSignalModel& get_prior_model() const { return prior_model_; }
 
+  // Saves and restores the estimated model.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   PriorSignalModel prior_model_;
 };
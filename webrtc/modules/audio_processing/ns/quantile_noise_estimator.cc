@@ -85,4 +85,30 @@ void QuantileNoiseEstimator::Estimate(
   std::copy(quantile_.begin(), quantile_.end(), noise_spectrum.begin());
 }
 
+void QuantileNoiseEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteFloats(density_);
+  writer->WriteFloats(log_quantile_);
+  writer->WriteFloats(quantile_);
+  writer->WriteInts(counter_);
+  writer->WriteInt(num_updates_);
+}
+
+bool QuantileNoiseEstimator::RestoreState(StateReader* reader) {
+  std::array<int, kSimult> counter;
+  int num_updates;
+  if (!reader->ReadFloats(density_) || !reader->ReadFloats(log_quantile_) ||
+      !reader->ReadFloats(quantile_) || !reader->ReadInts(counter) ||
+      !reader->ReadInt(&num_updates) || num_updates < 1) {
+    return false;
+  }
+  for (int c : counter) {
+    if (c < 0 || c > kLongStartupPhaseBlocks) {
+      return false;
+    }
+  }
+  counter_ = counter;
+  num_updates_ = num_updates;
+  return true;
+}
+
 }  // namespace webrtc
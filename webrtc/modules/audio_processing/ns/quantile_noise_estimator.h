@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/ns/ns_common.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -33,6 +34,10 @@ class QuantileNoiseEstimator {
   void Estimate(rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
                 rtc::ArrayView<float, kFftSizeBy2Plus1> noise_spectrum);
 
+  // Saves and restores the estimator state.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   std::array<float, kSimult * kFftSizeBy2Plus1> density_;
   std::array<float, kSimult * kFftSizeBy2Plus1> log_quantile_;
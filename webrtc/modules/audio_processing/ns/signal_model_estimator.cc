@@ -172,4 +172,26 @@ void SignalModelEstimator::Update(
   UpdateSpectralLrt(prior_snr, post_snr, features_.avg_log_lrt, &features_.lrt);
 }
 
+void SignalModelEstimator::SaveState(StateWriter* writer) const {
+  writer->WriteFloat(diff_normalization_);
+  writer->WriteFloat(signal_energy_sum_);
+  prior_model_estimator_.SaveState(writer);
+  writer->WriteFloat(features_.lrt);
+  writer->WriteFloat(features_.spectral_diff);
+  writer->WriteFloat(features_.spectral_flatness);
+  writer->WriteFloats(features_.avg_log_lrt);
+}
+
+bool SignalModelEstimator::RestoreState(StateReader* reader) {
+  histograms_.Clear();
+  histogram_analysis_counter_ = kFeatureUpdateWindowSize;
+  return reader->ReadFloat(&diff_normalization_) &&
+         reader->ReadFloat(&signal_energy_sum_) &&
+         prior_model_estimator_.RestoreState(reader) &&
+         reader->ReadFloat(&features_.lrt) &&
+         reader->ReadFloat(&features_.spectral_diff) &&
+         reader->ReadFloat(&features_.spectral_flatness) &&
+         reader->ReadFloats(features_.avg_log_lrt);
+}
+
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 #include "modules/audio_processing/ns/prior_signal_model.h"
 #include "modules/audio_processing/ns/prior_signal_model_estimator.h"
 #include "modules/audio_processing/ns/signal_model.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -44,6 +45,11 @@ class SignalModelEstimator {
   }
   const SignalModel& get_model() { return features_; }
 
+  // Saves and restores the estimated models. The histograms are not saved,
+  // and restart the collection for the next update of the prior model.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   float diff_normalization_ = 0.f;
   float signal_energy_sum_ = 0.f;
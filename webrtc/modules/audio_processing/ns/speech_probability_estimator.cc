@@ -101,4 +101,16 @@ void SpeechProbabilityEstimator::Update(
   }
 }
 
+void SpeechProbabilityEstimator::SaveState(StateWriter* writer) const {
+  signal_model_estimator_.SaveState(writer);
+  writer->WriteFloat(prior_speech_prob_);
+  writer->WriteFloats(speech_probability_);
+}
+
+bool SpeechProbabilityEstimator::RestoreState(StateReader* reader) {
+  return signal_model_estimator_.RestoreState(reader) &&
+         reader->ReadFloat(&prior_speech_prob_) &&
+         reader->ReadFloats(speech_probability_);
+}
+
 }  // namespace webrtc
@@ -16,6 +16,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/signal_model_estimator.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -40,6 +41,10 @@ class SpeechProbabilityEstimator {
   float get_prior_probability() const { return prior_speech_prob_; }
   rtc::ArrayView<const float> get_probability() { return speech_probability_; }
 
+  // Saves and restores the estimator state.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   SignalModelEstimator signal_model_estimator_;
   float prior_speech_prob_ = .5f;
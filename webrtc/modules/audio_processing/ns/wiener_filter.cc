@@ -118,4 +118,16 @@ float WienerFilter::ComputeOverallScalingFactor(
          (1.f - prior_speech_probability) * scale_factor2;
 }
 
+void WienerFilter::SaveState(StateWriter* writer) const {
+  writer->WriteFloats(spectrum_prev_process_);
+  writer->WriteFloats(initial_spectral_estimate_);
+  writer->WriteFloats(filter_);
+}
+
+bool WienerFilter::RestoreState(StateReader* reader) {
+  return reader->ReadFloats(spectrum_prev_process_) &&
+         reader->ReadFloats(initial_spectral_estimate_) &&
+         reader->ReadFloats(filter_);
+}
+
 }  // namespace webrtc
@@ -16,6 +16,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/suppression_params.h"
+#include "modules/audio_processing/utility/state_serializer.h"
 
 namespace webrtc {
 
@@ -45,6 +46,10 @@ class WienerFilter {
     return filter_;
   }
 
+  // Saves and restores the filter state.
+  void SaveState(StateWriter* writer) const;
+  bool RestoreState(StateReader* reader);
+
  private:
   const SuppressionParams& suppression_params_;
   std::array<float, kFftSizeBy2Plus1> spectrum_prev_process_;
@@ -42,13 +42,11 @@ namespace webrtc {
 
 std::atomic<int> ResidualEchoDetector::instance_count_(0);
 
-ResidualEchoDetector::ResidualEchoDetector()
+ResidualEchoDetector::ResidualEchoDetector(bool allow_fma)
     : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       render_buffer_(kRenderBufferSize),
-      render_power_(kLookbackFrames),
-      render_power_mean_(kLookbackFrames),
-      render_power_std_dev_(kLookbackFrames),
-      covariances_(kLookbackFrames),
+      covariances_(kLookbackFrames,
+                   LaggedCovarianceEstimator::DetectImplementation(allow_fma)),
       recent_likelihood_max_(kAggregationBufferSize) {}
 
 ResidualEchoDetector::~ResidualEchoDetector() = default;
@@ -96,63 +94,42 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
     // TODO(ivoc): Include how often this happens in APM stats.
     return;
   }
-  // Update the render statistics, and store the statistics in circular buffers.
+  // Update the render statistics.
   render_statistics_.Update(*buffered_render_power);
-  RTC_DCHECK_LT(next_insertion_index_, kLookbackFrames);
-  render_power_[next_insertion_index_] = *buffered_render_power;
-  render_power_mean_[next_insertion_index_] = render_statistics_.mean();
-  render_power_std_dev_[next_insertion_index_] =
-      render_statistics_.std_deviation();
-
-  // Get the next capture value, update capture statistics and add the relevant
-  // values to the buffers.
+
+  // Get the next capture value and update capture statistics.
   const float capture_power = Power(capture_audio);
   capture_statistics_.Update(capture_power);
   const float capture_mean = capture_statistics_.mean();
   const float capture_std_deviation = capture_statistics_.std_deviation();
 
-  // Update the covariance values and determine the new echo likelihood.
-  echo_likelihood_ = 0.f;
-  size_t read_index = next_insertion_index_;
-
-  int best_delay = -1;
-  for (size_t delay = 0; delay < covariances_.size(); ++delay) {
-    RTC_DCHECK_LT(read_index, render_power_.size());
-    covariances_[delay].Update(capture_power, capture_mean,
-                               capture_std_deviation, render_power_[read_index],
-                               render_power_mean_[read_index],
-                               render_power_std_dev_[read_index]);
-    read_index = read_index > 0 ? read_index - 1 : kLookbackFrames - 1;
-
-    if (covariances_[delay].normalized_cross_correlation() > echo_likelihood_) {
-      echo_likelihood_ = covariances_[delay].normalized_cross_correlation();
-      best_delay = static_cast<int>(delay);
-    }
-  }
+  // Update the covariance values of all the delays and determine the new echo
+  // likelihood.
+  covariances_.Update(capture_power, capture_mean, capture_std_deviation,
+                      *buffered_render_power, render_statistics_.mean(),
+                      render_statistics_.std_deviation());
+  echo_likelihood_ = covariances_.max_normalized_cross_correlation();
   // This is a temporary log message to help find the underlying cause for echo
   // likelihoods > 1.0.
   // TODO(ivoc): Remove once the issue is resolved.
   if (echo_likelihood_ > 1.1f) {
     // Make sure we don't spam the log.
+    const int best_delay =
+        log_counter_ < 5 ? covariances_.FindBestLag() : -1;
     if (log_counter_ < 5 && best_delay != -1) {
-      size_t read_index = kLookbackFrames + next_insertion_index_ - best_delay;
-      if (read_index >= kLookbackFrames) {
-        read_index -= kLookbackFrames;
-      }
-      RTC_DCHECK_LT(read_index, render_power_.size());
       RTC_LOG_F(LS_ERROR) << "Echo detector internal state: {"
                              "Echo likelihood: "
                           << echo_likelihood_ << ", Best Delay: " << best_delay
                           << ", Covariance: "
-                          << covariances_[best_delay].covariance()
+                          << covariances_.covariance(best_delay)
                           << ", Last capture power: " << capture_power
                           << ", Capture mean: " << capture_mean
                           << ", Capture_standard deviation: "
-                          << capture_std_deviation << ", Last render power: "
-                          << render_power_[read_index]
-                          << ", Render mean: " << render_power_mean_[read_index]
+                          << capture_std_deviation
+                          << ", Render power deviation from mean: "
+                          << covariances_.y_deviation(best_delay)
                           << ", Render standard deviation: "
-                          << render_power_std_dev_[read_index]
+                          << covariances_.y_sigma(best_delay)
                           << ", Reliability: " << reliability_ << "}";
       log_counter_++;
     }
@@ -170,11 +147,6 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
 
   // Update the buffer of recent likelihood values.
   recent_likelihood_max_.Update(echo_likelihood_);
-
-  // Update the next insertion index.
-  next_insertion_index_ = next_insertion_index_ < (kLookbackFrames - 1)
-                              ? next_insertion_index_ + 1
-                              : 0;
 }
 
 void ResidualEchoDetector::Initialize(int /*capture_sample_rate_hz*/,
@@ -182,17 +154,11 @@ void ResidualEchoDetector::Initialize(int /*capture_sample_rate_hz*/,
                                       int /*render_sample_rate_hz*/,
                                       int /*num_render_channels*/) {
   render_buffer_.Clear();
-  std::fill(render_power_.begin(), render_power_.end(), 0.f);
-  std::fill(render_power_mean_.begin(), render_power_mean_.end(), 0.f);
-  std::fill(render_power_std_dev_.begin(), render_power_std_dev_.end(), 0.f);
   render_statistics_.Clear();
   capture_statistics_.Clear();
   recent_likelihood_max_.Clear();
-  for (auto& cov : covariances_) {
-    cov.Clear();
-  }
+  covariances_.Clear();
   echo_likelihood_ = 0.f;
-  next_insertion_index_ = 0;
   reliability_ = 0.f;
 }
 
@@ -17,9 +17,9 @@
 #include "api/array_view.h"
 #include "api/audio/audio_processing.h"
 #include "modules/audio_processing/echo_detector/circular_buffer.h"
+#include "modules/audio_processing/echo_detector/lagged_covariance_estimator.h"
 #include "modules/audio_processing/echo_detector/mean_variance_estimator.h"
 #include "modules/audio_processing/echo_detector/moving_max.h"
-#include "modules/audio_processing/echo_detector/normalized_covariance_estimator.h"
 
 namespace webrtc {
 
@@ -28,7 +28,10 @@ class AudioBuffer;
 
 class ResidualEchoDetector : public EchoDetector {
  public:
-  ResidualEchoDetector();
+  // With `allow_fma`, the lag covariances may be updated with fused
+  // multiply-adds when AVX2 is available. This is faster, but not bit-exact
+  // with the default.
+  explicit ResidualEchoDetector(bool allow_fma = false);
   ~ResidualEchoDetector() override;
 
   // This function should be called while holding the render lock.
@@ -64,16 +67,9 @@ class ResidualEchoDetector : public EchoDetector {
   // situation.
   size_t frames_since_zero_buffer_size_ = 0;
 
-  // Circular buffers containing delayed versions of the power, mean and
-  // standard deviation, for calculating the delayed covariance values.
-  std::vector<float> render_power_;
-  std::vector<float> render_power_mean_;
-  std::vector<float> render_power_std_dev_;
-  // Covariance estimates for different delay values.
-  std::vector<NormalizedCovarianceEstimator> covariances_;
-  // Index where next element should be inserted in all of the above circular
-  // buffers.
-  size_t next_insertion_index_ = 0;
+  // Covariance estimates between the capture power and the delayed render
+  // power, for all the delay values.
+  LaggedCovarianceEstimator covariances_;
 
   MeanVarianceEstimator render_statistics_;
   MeanVarianceEstimator capture_statistics_;
@@ -10,6 +10,7 @@
 
 #include "modules/audio_processing/splitting_filter.h"
 
+#include <algorithm>
 #include <array>
 
 #include "api/array_view.h"
@@ -27,15 +28,34 @@ constexpr size_t kTwoBandFilterSamplesPerFrame = 320;
 
 SplittingFilter::SplittingFilter(size_t num_channels,
                                  size_t num_bands,
-                                 size_t num_frames)
+                                 size_t num_frames,
+                                 bool float_two_bands,
+                                 bool fma_three_bands)
     : num_bands_(num_bands),
-      two_bands_states_(num_bands_ == 2 ? num_channels : 0),
-      three_band_filter_banks_(num_bands_ == 3 ? num_channels : 0) {
+      two_bands_states_(num_bands_ == 2 && !float_two_bands ? num_channels : 0),
+      three_band_filter_banks_(
+          num_bands_ == 3 ? num_channels : 0,
+          ThreeBandFilterBank(
+              ThreeBandFilterBank::DetectImplementation(fma_three_bands))) {
   RTC_CHECK(num_bands_ == 2 || num_bands_ == 3);
+  if (num_bands_ == 2 && float_two_bands) {
+    two_band_filter_bank_ = std::make_unique<TwoBandFilterBank>(num_channels);
+  }
 }
 
 SplittingFilter::~SplittingFilter() = default;
 
+void SplittingFilter::Reset() {
+  std::fill(two_bands_states_.begin(), two_bands_states_.end(),
+            TwoBandsStates());
+  if (two_band_filter_bank_) {
+    two_band_filter_bank_->Reset();
+  }
+  for (ThreeBandFilterBank& filter_bank : three_band_filter_banks_) {
+    filter_bank.Reset();
+  }
+}
+
 void SplittingFilter::Analysis(const ChannelBuffer<float>* data,
                                ChannelBuffer<float>* bands) {
   RTC_DCHECK_EQ(num_bands_, bands->num_bands());
@@ -64,6 +84,10 @@ void SplittingFilter::Synthesis(const ChannelBuffer<float>* bands,
 
 void SplittingFilter::TwoBandsAnalysis(const ChannelBuffer<float>* data,
                                        ChannelBuffer<float>* bands) {
+  if (two_band_filter_bank_) {
+    two_band_filter_bank_->Analysis(*data, bands);
+    return;
+  }
   RTC_DCHECK_EQ(two_bands_states_.size(), data->num_channels());
   RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
 
@@ -82,6 +106,10 @@ void SplittingFilter::TwoBandsAnalysis(const ChannelBuffer<float>* data,
 
 void SplittingFilter::TwoBandsSynthesis(const ChannelBuffer<float>* bands,
                                         ChannelBuffer<float>* data) {
+  if (two_band_filter_bank_) {
+    two_band_filter_bank_->Synthesis(*bands, data);
+    return;
+  }
   RTC_DCHECK_LE(data->num_channels(), two_bands_states_.size());
   RTC_DCHECK_EQ(data->num_frames(), kTwoBandFilterSamplesPerFrame);
   for (size_t i = 0; i < data->num_channels(); ++i) {
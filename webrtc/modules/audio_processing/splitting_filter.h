@@ -17,6 +17,7 @@
 
 #include "common_audio/channel_buffer.h"
 #include "modules/audio_processing/three_band_filter_bank.h"
+#include "modules/audio_processing/two_band_filter_bank.h"
 
 namespace webrtc {
 
@@ -42,14 +43,26 @@ struct TwoBandsStates {
 // to merge these bands again. The input and output signals are contained in
 // ChannelBuffers and for the different bands an array of ChannelBuffers is
 // used.
+//
+// With `float_two_bands` set, the two-band split is done by the floating point
+// TwoBandFilterBank instead of the fixed-point QMF filter bank. With
+// `fma_three_bands` set, the three-band split may use the AVX2 kernels with
+// fused multiply-adds, which are not bit-exact with the default ones.
 class SplittingFilter {
  public:
-  SplittingFilter(size_t num_channels, size_t num_bands, size_t num_frames);
+  SplittingFilter(size_t num_channels,
+                  size_t num_bands,
+                  size_t num_frames,
+                  bool float_two_bands = false,
+                  bool fma_three_bands = false);
   ~SplittingFilter();
 
   void Analysis(const ChannelBuffer<float>* data, ChannelBuffer<float>* bands);
   void Synthesis(const ChannelBuffer<float>* bands, ChannelBuffer<float>* data);
 
+  // Zeroes the filter states, as in a new splitting filter.
+  void Reset();
+
  private:
   // Two-band analysis and synthesis work for 640 samples or less.
   void TwoBandsAnalysis(const ChannelBuffer<float>* data,
@@ -64,6 +77,7 @@ class SplittingFilter {
 
   const size_t num_bands_;
   std::vector<TwoBandsStates> two_bands_states_;
+  std::unique_ptr<TwoBandFilterBank> two_band_filter_bank_;
   std::vector<ThreeBandFilterBank> three_band_filter_banks_;
 };
 
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/stage_timer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+
+constexpr const char* kStageNames[] = {
+    "Capture",
+    "HighPassFilter",
+    "CaptureLevelsAdjuster",
+    "BandSplitting",
+    "EchoControllerAnalyze",
+    "EchoControllerProcess",
+    "NoiseSuppressorAnalyze",
+    "NoiseSuppressorProcess",
+    "GainController1",
+    "GainController2",
+    "BandMerging",
+    "Render"};
+static_assert(std::size(kStageNames) == AudioProcessingStats::kNumStages,
+              "A name is required for each stage");
+
+// Returns the bucket of a logarithmic histogram with four buckets per octave.
+int ToBucket(int64_t duration_ns, int num_buckets) {
+  if (duration_ns < 4) {
+    return std::max<int>(0, duration_ns);
+  }
+  int octave = 2;
+  while ((duration_ns >> (octave + 1)) != 0) {
+    ++octave;
+  }
+  const int sub_bucket = (duration_ns >> (octave - 2)) & 3;
+  return std::min(4 * octave + sub_bucket, num_buckets - 1);
+}
+
+// Returns the upper limit of a bucket returned by ToBucket().
+int64_t BucketUpperLimit(int bucket) {
+  if (bucket < 4) {
+    return bucket + 1;
+  }
+  const int octave = bucket / 4;
+  const int sub_bucket = bucket % 4;
+  return int64_t{4 + sub_bucket + 1} << (octave - 2);
+}
+
+}  // namespace
+
+StageTimer::StageTimer() = default;
+
+void StageTimer::EndFrame() {
+  for (size_t index = 0; index < aggregates_.size(); ++index) {
+    if ((active_mask_ & (1u << index)) == 0) {
+      continue;
+    }
+    const int64_t duration_ns = frame_ns_[index];
+    frame_ns_[index] = 0;
+
+    Aggregate& a = aggregates_[index];
+    a.min_ns =
+        a.num_frames == 0 ? duration_ns : std::min(a.min_ns, duration_ns);
+    a.max_ns = std::max(a.max_ns, duration_ns);
+    a.sum_ns += duration_ns;
+    ++a.histogram[ToBucket(duration_ns, kNumBuckets)];
+    if (++a.num_frames == kFramesPerInterval) {
+      Publish(static_cast<Stage>(index));
+    }
+  }
+  active_mask_ = 0;
+}
+
+void StageTimer::Publish(Stage stage) {
+  Aggregate& a = aggregates_[static_cast<size_t>(stage)];
+  RTC_DCHECK_GT(a.num_frames, 0);
+
+  StageTiming timing;
+  timing.num_frames = a.num_frames;
+  timing.min_ns = a.min_ns;
+  timing.mean_ns = a.sum_ns / a.num_frames;
+  const int rank = (a.num_frames * 99 + 99) / 100;
+  int count = 0;
+  int bucket = 0;
+  while ((count += a.histogram[bucket]) < rank) {
+    ++bucket;
+  }
+  timing.p99_ns = std::min(BucketUpperLimit(bucket), a.max_ns);
+  a = Aggregate();
+
+  if (report_histograms_) {
+    const std::string prefix = std::string("WebRTC.Audio.Apm.StageTime.") +
+                               kStageNames[static_cast<size_t>(stage)];
+    RTC_HISTOGRAM_COUNTS_SPARSE_100000(prefix + ".MeanUs",
+                                       timing.mean_ns / 1000);
+    RTC_HISTOGRAM_COUNTS_SPARSE_100000(prefix + ".P99Us", timing.p99_ns / 1000);
+  }
+
+  MutexLock lock(&mutex_);
+  published_[static_cast<size_t>(stage)] = timing;
+}
+
+void StageTimer::GetTimings(
+    std::array<StageTiming, AudioProcessingStats::kNumStages>* timings) const {
+  MutexLock lock(&mutex_);
+  for (size_t k = 0; k < published_.size(); ++k) {
+    if (published_[k].num_frames > 0) {
+      (*timings)[k] = published_[k];
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_STAGE_TIMER_H_
+#define MODULES_AUDIO_PROCESSING_STAGE_TIMER_H_
+
+#include <stdint.h>
+
+#include <array>
+
+#include "api/audio/audio_processing_statistics.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+// Aggregates the execution time of the APM processing stages into per-frame
+// min/mean/99th percentile statistics. The time measured for a stage within a
+// frame is accumulated by AddTime(), and is committed by EndFrame(). Apart from
+// GetTimings(), which can be called from any thread, the methods must be
+// called from a single thread.
+class StageTimer {
+ public:
+  using Stage = AudioProcessingStats::Stage;
+  using StageTiming = AudioProcessingStats::StageTiming;
+
+  // Number of frames over which the statistics of a stage are aggregated.
+  static constexpr int kFramesPerInterval = 1000;
+
+  // Measures the time from construction to destruction and adds it to a stage
+  // of `timer`. With `end_frame` set, the frame is ended afterwards. Does
+  // nothing if `timer` is null.
+  class ScopedTiming {
+   public:
+    ScopedTiming(StageTimer* timer, Stage stage, bool end_frame = false)
+        : timer_(timer),
+          stage_(stage),
+          end_frame_(end_frame),
+          start_ns_(timer ? rtc::TimeNanos() : 0) {}
+    ScopedTiming(const ScopedTiming&) = delete;
+    ScopedTiming& operator=(const ScopedTiming&) = delete;
+    ~ScopedTiming() {
+      if (timer_) {
+        timer_->AddTime(stage_, rtc::TimeNanos() - start_ns_);
+        if (end_frame_) {
+          timer_->EndFrame();
+        }
+      }
+    }
+
+   private:
+    StageTimer* const timer_;
+    const Stage stage_;
+    const bool end_frame_;
+    const int64_t start_ns_;
+  };
+
+  StageTimer();
+  StageTimer(const StageTimer&) = delete;
+  StageTimer& operator=(const StageTimer&) = delete;
+
+  // Sets whether the statistics are also exported as UMA histograms.
+  void set_report_histograms(bool report_histograms) {
+    report_histograms_ = report_histograms;
+  }
+
+  // Adds `duration_ns` to the time spent in `stage` during the current frame.
+  void AddTime(Stage stage, int64_t duration_ns) {
+    frame_ns_[static_cast<size_t>(stage)] += duration_ns;
+    active_mask_ |= 1u << static_cast<int>(stage);
+  }
+
+  // Commits the times of the stages that were active during the current
+  // frame.
+  void EndFrame();
+
+  // Copies the statistics of the stages with a completed interval into
+  // `timings`.
+  void GetTimings(
+      std::array<StageTiming, AudioProcessingStats::kNumStages>* timings) const;
+
+ private:
+  // Logarithmic histogram with four buckets per octave of nanoseconds.
+  static constexpr int kNumBuckets = 4 * 40;
+
+  struct Aggregate {
+    int num_frames = 0;
+    int64_t min_ns = 0;
+    int64_t max_ns = 0;
+    int64_t sum_ns = 0;
+    std::array<int, kNumBuckets> histogram = {};
+  };
+
+  void Publish(Stage stage);
+
+  bool report_histograms_ = false;
+  std::array<int64_t, AudioProcessingStats::kNumStages> frame_ns_ = {};
+  uint32_t active_mask_ = 0;
+  std::array<Aggregate, AudioProcessingStats::kNumStages> aggregates_;
+
+  mutable Mutex mutex_;
+  std::array<StageTiming, AudioProcessingStats::kNumStages> published_
+      RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_STAGE_TIMER_H_
@@ -32,9 +32,21 @@
 
 #include "modules/audio_processing/three_band_filter_bank.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
 #include <array>
 
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 namespace {
@@ -100,69 +112,184 @@ const float kDctModulation[ThreeBandFilterBank::kNumNonZeroFilters][kDctSize] =
      {1.f, -2.f, 1.f},
      {1.73205077f, 0.f, -1.73205077f}};
 
-// Filters the input signal `in` with the filter `filter` using a shift by
-// `in_shift`, taking into account the previous state.
-void FilterCore(
-    rtc::ArrayView<const float, kFilterSize> filter,
-    rtc::ArrayView<const float, ThreeBandFilterBank::kSplitBandSize> in,
-    const int in_shift,
-    rtc::ArrayView<float, ThreeBandFilterBank::kSplitBandSize> out,
-    rtc::ArrayView<float, kMemorySize> state) {
-  constexpr int kMaxInShift = (kStride - 1);
-  RTC_DCHECK_GE(in_shift, 0);
-  RTC_DCHECK_LE(in_shift, kMaxInShift);
-  std::fill(out.begin(), out.end(), 0.f);
-
-  for (int k = 0; k < in_shift; ++k) {
-    for (int i = 0, j = kMemorySize + k - in_shift; i < kFilterSize;
-         ++i, j -= kStride) {
-      out[k] += state[j] * filter[i];
-    }
+// Returns the index of the filter used for the downsampled signal `index` and
+// the shift `in_shift`, or -1 for the filters that are zero.
+int FilterIndex(int index, int in_shift) {
+  const int i = index + in_shift * kSubSampling;
+  if (i == kZeroFilterIndex1 || i == kZeroFilterIndex2) {
+    return -1;
   }
+  return i < kZeroFilterIndex1 ? i : (i < kZeroFilterIndex2 ? i - 1 : i - 2);
+}
 
-  for (int k = in_shift, shift = 0; k < kFilterSize * kStride; ++k, ++shift) {
-    RTC_DCHECK_GE(shift, 0);
-    const int loop_limit = std::min(kFilterSize, 1 + (shift >> kStrideLog2));
-    for (int i = 0, j = shift; i < loop_limit; ++i, j -= kStride) {
-      out[k] += in[j] * filter[i];
-    }
-    for (int i = loop_limit, j = kMemorySize + shift - loop_limit * kStride;
-         i < kFilterSize; ++i, j -= kStride) {
-      out[k] += state[j] * filter[i];
-    }
+// The filter kernels below operate on a filter input `in` which holds the
+// `kMemorySize` samples of the filter state followed by the
+// `kSplitBandSize` samples of the current frame. Filtering with a shift by
+// `in_shift` gives the output sample
+//   y[k] = sum_i filter[i] * in[kMemorySize - in_shift + k - kStride * i],
+// with the terms accumulated in increasing order of i, starting from zero.
+// The kernels vectorize over k and are templated on the vector operations, so
+// that the implementations using them compute the exact same values.
+
+// Filters `in` and adds the output, modulated for each band, to `out`.
+template <typename Ops>
+void AnalysisFilter(const float* in,
+                    const float* filter,
+                    int in_shift,
+                    const float* dct_modulation,
+                    float* const* out) {
+  using Vector = typename Ops::Vector;
+  const Vector h0 = Ops::Set(filter[0]);
+  const Vector h1 = Ops::Set(filter[1]);
+  const Vector h2 = Ops::Set(filter[2]);
+  const Vector h3 = Ops::Set(filter[3]);
+  const Vector d0 = Ops::Set(dct_modulation[0]);
+  const Vector d1 = Ops::Set(dct_modulation[1]);
+  const Vector d2 = Ops::Set(dct_modulation[2]);
+  const float* x = in + kMemorySize - in_shift;
+  for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize;
+       k += Ops::kNumLanes) {
+    Vector y = Ops::Zero();
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k), h0));
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k - kStride), h1));
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k - 2 * kStride), h2));
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k - 3 * kStride), h3));
+    Ops::Store(out[0] + k, Ops::Add(Ops::Load(out[0] + k), Ops::Mul(d0, y)));
+    Ops::Store(out[1] + k, Ops::Add(Ops::Load(out[1] + k), Ops::Mul(d1, y)));
+    Ops::Store(out[2] + k, Ops::Add(Ops::Load(out[2] + k), Ops::Mul(d2, y)));
   }
+}
 
-  for (int k = kFilterSize * kStride, shift = kFilterSize * kStride - in_shift;
-       k < ThreeBandFilterBank::kSplitBandSize; ++k, ++shift) {
-    for (int i = 0, j = shift; i < kFilterSize; ++i, j -= kStride) {
-      out[k] += in[j] * filter[i];
-    }
+// Modulates and sums the bands in `in` into `out`.
+template <typename Ops>
+void SynthesisModulation(const float* const* in,
+                         const float* dct_modulation,
+                         float* out) {
+  using Vector = typename Ops::Vector;
+  const Vector d0 = Ops::Set(dct_modulation[0]);
+  const Vector d1 = Ops::Set(dct_modulation[1]);
+  const Vector d2 = Ops::Set(dct_modulation[2]);
+  for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize;
+       k += Ops::kNumLanes) {
+    Vector y = Ops::Zero();
+    y = Ops::Add(y, Ops::Mul(d0, Ops::Load(in[0] + k)));
+    y = Ops::Add(y, Ops::Mul(d1, Ops::Load(in[1] + k)));
+    y = Ops::Add(y, Ops::Mul(d2, Ops::Load(in[2] + k)));
+    Ops::Store(out + k, y);
   }
+}
 
-  // Update current state.
-  std::copy(in.begin() + ThreeBandFilterBank::kSplitBandSize - kMemorySize,
-            in.end(), state.begin());
+// Filters `in` and adds the output, scaled for the upsampling, to `out`.
+template <typename Ops>
+void SynthesisFilter(const float* in,
+                     const float* filter,
+                     int in_shift,
+                     float* out) {
+  using Vector = typename Ops::Vector;
+  const Vector h0 = Ops::Set(filter[0]);
+  const Vector h1 = Ops::Set(filter[1]);
+  const Vector h2 = Ops::Set(filter[2]);
+  const Vector h3 = Ops::Set(filter[3]);
+  const Vector scaling = Ops::Set(static_cast<float>(kSubSampling));
+  const float* x = in + kMemorySize - in_shift;
+  for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize;
+       k += Ops::kNumLanes) {
+    Vector y = Ops::Zero();
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k), h0));
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k - kStride), h1));
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k - 2 * kStride), h2));
+    y = Ops::Add(y, Ops::Mul(Ops::Load(x + k - 3 * kStride), h3));
+    Ops::Store(out + k, Ops::Add(Ops::Load(out + k), Ops::Mul(scaling, y)));
+  }
 }
 
+struct ScalarOps {
+  using Vector = float;
+  static constexpr int kNumLanes = 1;
+  static float Zero() { return 0.f; }
+  static float Set(float a) { return a; }
+  static float Load(const float* p) { return *p; }
+  static void Store(float* p, float a) { *p = a; }
+  static float Add(float a, float b) { return a + b; }
+  static float Mul(float a, float b) { return a * b; }
+};
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+struct Sse2Ops {
+  using Vector = __m128;
+  static constexpr int kNumLanes = 4;
+  static __m128 Zero() { return _mm_setzero_ps(); }
+  static __m128 Set(float a) { return _mm_set1_ps(a); }
+  static __m128 Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, __m128 a) { _mm_storeu_ps(p, a); }
+  static __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+  static __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+};
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Separate multiplications and additions are used, rather than fused ones, to
+// keep the results identical to the other implementations.
+struct NeonOps {
+  using Vector = float32x4_t;
+  static constexpr int kNumLanes = 4;
+  static float32x4_t Zero() { return vdupq_n_f32(0.f); }
+  static float32x4_t Set(float a) { return vdupq_n_f32(a); }
+  static float32x4_t Load(const float* p) { return vld1q_f32(p); }
+  static void Store(float* p, float32x4_t a) { vst1q_f32(p, a); }
+  static float32x4_t Add(float32x4_t a, float32x4_t b) {
+    return vaddq_f32(a, b);
+  }
+  static float32x4_t Mul(float32x4_t a, float32x4_t b) {
+    return vmulq_f32(a, b);
+  }
+};
+#endif
+
+static_assert(ThreeBandFilterBank::kSplitBandSize % 8 == 0,
+              "The kernels require a band size that is a multiple of 8");
+
 }  // namespace
 
 // Because the low-pass filter prototype has half bandwidth it is possible to
 // use a DCT to shift it in both directions at the same time, to the center
 // frequencies [1 / 12, 3 / 12, 5 / 12].
-ThreeBandFilterBank::ThreeBandFilterBank() {
-  RTC_DCHECK_EQ(state_analysis_.size(), kNumNonZeroFilters);
-  RTC_DCHECK_EQ(state_synthesis_.size(), kNumNonZeroFilters);
-  for (int k = 0; k < kNumNonZeroFilters; ++k) {
-    RTC_DCHECK_EQ(state_analysis_[k].size(), kMemorySize);
-    RTC_DCHECK_EQ(state_synthesis_[k].size(), kMemorySize);
-
-    state_analysis_[k].fill(0.f);
-    state_synthesis_[k].fill(0.f);
-  }
+ThreeBandFilterBank::ThreeBandFilterBank()
+    : ThreeBandFilterBank(DetectImplementation(/*allow_fma=*/false)) {}
+
+ThreeBandFilterBank::ThreeBandFilterBank(Implementation implementation)
+    : implementation_(implementation) {
+  Reset();
 }
 
 ThreeBandFilterBank::~ThreeBandFilterBank() = default;
 
+void ThreeBandFilterBank::Reset() {
+  for (auto& state : state_analysis_) {
+    state.fill(0.f);
+  }
+  for (auto& state : state_synthesis_) {
+    state.fill(0.f);
+  }
+}
+
+ThreeBandFilterBank::Implementation
+ThreeBandFilterBank::DetectImplementation(bool allow_fma) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (allow_fma && GetCPUInfo(kAVX2) != 0) {
+    return Implementation::kAvx2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return Implementation::kSse2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return Implementation::kNeon;
+#else
+  return Implementation::kScalar;
+#endif
+}
+
 // The analysis can be separated in these steps:
 //   1. Serial to parallel downsampling by a factor of `kNumBands`.
 //   2. Filtering of `kSparsity` different delayed signals with polyphase
@@ -174,49 +301,60 @@ void ThreeBandFilterBank::Analysis(
     rtc::ArrayView<const rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
         out) {
   // Initialize the output to zero.
+  std::array<float*, ThreeBandFilterBank::kNumBands> out_bands;
   for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
     RTC_DCHECK_EQ(out[band].size(), kSplitBandSize);
     std::fill(out[band].begin(), out[band].end(), 0);
+    out_bands[band] = out[band].data();
   }
 
   for (int downsampling_index = 0; downsampling_index < kSubSampling;
        ++downsampling_index) {
-    // Downsample to form the filter input.
-    std::array<float, kSplitBandSize> in_subsampled;
+    // Downsample to form the filter input, preceded by the filter state.
+    std::array<float, kMemorySize + kSplitBandSize> in_subsampled;
+    std::array<float, kMemorySize>& state = state_analysis_[downsampling_index];
+    std::copy(state.begin(), state.end(), in_subsampled.begin());
     for (int k = 0; k < kSplitBandSize; ++k) {
-      in_subsampled[k] =
+      in_subsampled[kMemorySize + k] =
           in[(kSubSampling - 1) - downsampling_index + kSubSampling * k];
     }
 
     for (int in_shift = 0; in_shift < kStride; ++in_shift) {
       // Choose filter, skip zero filters.
-      const int index = downsampling_index + in_shift * kSubSampling;
-      if (index == kZeroFilterIndex1 || index == kZeroFilterIndex2) {
+      const int filter_index = FilterIndex(downsampling_index, in_shift);
+      if (filter_index < 0) {
         continue;
       }
-      const int filter_index =
-          index < kZeroFilterIndex1
-              ? index
-              : (index < kZeroFilterIndex2 ? index - 1 : index - 2);
-
-      rtc::ArrayView<const float, kFilterSize> filter(
-          kFilterCoeffs[filter_index]);
-      rtc::ArrayView<const float, kDctSize> dct_modulation(
-          kDctModulation[filter_index]);
-      rtc::ArrayView<float, kMemorySize> state(state_analysis_[filter_index]);
-
-      // Filter.
-      std::array<float, kSplitBandSize> out_subsampled;
-      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
-
-      // Band and modulate the output.
-      for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-        float* out_band = out[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          out_band[n] += dct_modulation[band] * out_subsampled[n];
-        }
+
+      // Filter, band and modulate the output.
+      const float* filter = kFilterCoeffs[filter_index];
+      const float* dct_modulation = kDctModulation[filter_index];
+      switch (implementation_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+        case Implementation::kAvx2:
+          ThreeBandAnalysisFilter_AVX2(in_subsampled.data(), filter, in_shift,
+                                       dct_modulation, out_bands.data());
+          break;
+        case Implementation::kSse2:
+          AnalysisFilter<Sse2Ops>(in_subsampled.data(), filter, in_shift,
+                                  dct_modulation, out_bands.data());
+          break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+        case Implementation::kNeon:
+          AnalysisFilter<NeonOps>(in_subsampled.data(), filter, in_shift,
+                                  dct_modulation, out_bands.data());
+          break;
+#endif
+        default:
+          AnalysisFilter<ScalarOps>(in_subsampled.data(), filter, in_shift,
+                                    dct_modulation, out_bands.data());
       }
     }
+
+    // Update current state.
+    std::copy(in_subsampled.end() - kMemorySize, in_subsampled.end(),
+              state.begin());
   }
 }
 
@@ -230,47 +368,71 @@ void ThreeBandFilterBank::Synthesis(
     rtc::ArrayView<const rtc::ArrayView<float>, ThreeBandFilterBank::kNumBands>
         in,
     rtc::ArrayView<float, kFullBandSize> out) {
-  std::fill(out.begin(), out.end(), 0);
+  std::array<const float*, ThreeBandFilterBank::kNumBands> in_bands;
+  for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
+    RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
+    in_bands[band] = in[band].data();
+  }
+
   for (int upsampling_index = 0; upsampling_index < kSubSampling;
        ++upsampling_index) {
+    std::array<float, kSplitBandSize> out_subsampled;
+    out_subsampled.fill(0.f);
     for (int in_shift = 0; in_shift < kStride; ++in_shift) {
       // Choose filter, skip zero filters.
-      const int index = upsampling_index + in_shift * kSubSampling;
-      if (index == kZeroFilterIndex1 || index == kZeroFilterIndex2) {
+      const int filter_index = FilterIndex(upsampling_index, in_shift);
+      if (filter_index < 0) {
         continue;
       }
-      const int filter_index =
-          index < kZeroFilterIndex1
-              ? index
-              : (index < kZeroFilterIndex2 ? index - 1 : index - 2);
-
-      rtc::ArrayView<const float, kFilterSize> filter(
-          kFilterCoeffs[filter_index]);
-      rtc::ArrayView<const float, kDctSize> dct_modulation(
-          kDctModulation[filter_index]);
-      rtc::ArrayView<float, kMemorySize> state(state_synthesis_[filter_index]);
-
-      // Prepare filter input by modulating the banded input.
-      std::array<float, kSplitBandSize> in_subsampled;
-      std::fill(in_subsampled.begin(), in_subsampled.end(), 0.f);
-      for (int band = 0; band < ThreeBandFilterBank::kNumBands; ++band) {
-        RTC_DCHECK_EQ(in[band].size(), kSplitBandSize);
-        const float* in_band = in[band].data();
-        for (int n = 0; n < kSplitBandSize; ++n) {
-          in_subsampled[n] += dct_modulation[band] * in_band[n];
-        }
+
+      // Prepare filter input by modulating the banded input, preceded by the
+      // filter state.
+      std::array<float, kMemorySize + kSplitBandSize> in_subsampled;
+      std::array<float, kMemorySize>& state = state_synthesis_[filter_index];
+      std::copy(state.begin(), state.end(), in_subsampled.begin());
+
+      // Modulate and filter.
+      const float* filter = kFilterCoeffs[filter_index];
+      const float* dct_modulation = kDctModulation[filter_index];
+      float* modulated = &in_subsampled[kMemorySize];
+      switch (implementation_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+        case Implementation::kAvx2:
+          ThreeBandSynthesisModulation_AVX2(in_bands.data(), dct_modulation,
+                                            modulated);
+          ThreeBandSynthesisFilter_AVX2(in_subsampled.data(), filter, in_shift,
+                                        out_subsampled.data());
+          break;
+        case Implementation::kSse2:
+          SynthesisModulation<Sse2Ops>(in_bands.data(), dct_modulation,
+                                       modulated);
+          SynthesisFilter<Sse2Ops>(in_subsampled.data(), filter, in_shift,
+                                   out_subsampled.data());
+          break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+        case Implementation::kNeon:
+          SynthesisModulation<NeonOps>(in_bands.data(), dct_modulation,
+                                       modulated);
+          SynthesisFilter<NeonOps>(in_subsampled.data(), filter, in_shift,
+                                   out_subsampled.data());
+          break;
+#endif
+        default:
+          SynthesisModulation<ScalarOps>(in_bands.data(), dct_modulation,
+                                         modulated);
+          SynthesisFilter<ScalarOps>(in_subsampled.data(), filter, in_shift,
+                                     out_subsampled.data());
       }
 
-      // Filter.
-      std::array<float, kSplitBandSize> out_subsampled;
-      FilterCore(filter, in_subsampled, in_shift, out_subsampled, state);
+      // Update current state.
+      std::copy(in_subsampled.end() - kMemorySize, in_subsampled.end(),
+                state.begin());
+    }
 
-      // Upsample.
-      constexpr float kUpsamplingScaling = kSubSampling;
-      for (int k = 0; k < kSplitBandSize; ++k) {
-        out[upsampling_index + kSubSampling * k] +=
-            kUpsamplingScaling * out_subsampled[k];
-      }
+    // Upsample.
+    for (int k = 0; k < kSplitBandSize; ++k) {
+      out[upsampling_index + kSubSampling * k] = out_subsampled[k];
     }
   }
 }
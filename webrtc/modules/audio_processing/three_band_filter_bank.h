@@ -52,7 +52,14 @@ class ThreeBandFilterBank final {
   static const int kNumNonZeroFilters =
       kSparsity * ThreeBandFilterBank::kNumBands - kNumZeroFilters;
 
+  // Implementation of the filtering. kScalar, kSse2 and kNeon are bit-exact
+  // with each other, while kAvx2 uses fused multiply-adds and differs from them
+  // by rounding.
+  enum class Implementation { kScalar, kSse2, kAvx2, kNeon };
+
+  // Uses the fastest bit-exact implementation available.
   ThreeBandFilterBank();
+  explicit ThreeBandFilterBank(Implementation implementation);
   ~ThreeBandFilterBank();
 
   // Splits `in` of size kFullBandSize into 3 downsampled frequency bands in
@@ -65,13 +72,39 @@ class ThreeBandFilterBank final {
   void Synthesis(rtc::ArrayView<const rtc::ArrayView<float>, kNumBands> in,
                  rtc::ArrayView<float, kFullBandSize> out);
 
+  // Returns the fastest implementation available. kAvx2 is only returned if
+  // `allow_fma` is set, since it is not bit-exact with the others.
+  static Implementation DetectImplementation(bool allow_fma);
+
+  Implementation implementation() const { return implementation_; }
+
+  // Zeroes the filter states, as in a new filter bank.
+  void Reset();
+
  private:
-  std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
-      state_analysis_;
+  Implementation implementation_;
+  // The analysis filters share their input within each downsampled signal, so
+  // one state is kept per downsampled signal.
+  std::array<std::array<float, kMemorySize>, kNumBands> state_analysis_;
   std::array<std::array<float, kMemorySize>, kNumNonZeroFilters>
       state_synthesis_;
 };
 
+// AVX2 versions of the filter kernels of ThreeBandFilterBank. Only for use by
+// ThreeBandFilterBank.
+void ThreeBandAnalysisFilter_AVX2(const float* in,
+                                  const float* filter,
+                                  int in_shift,
+                                  const float* dct_modulation,
+                                  float* const* out);
+void ThreeBandSynthesisModulation_AVX2(const float* const* in,
+                                       const float* dct_modulation,
+                                       float* out);
+void ThreeBandSynthesisFilter_AVX2(const float* in,
+                                   const float* filter,
+                                   int in_shift,
+                                   float* out);
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_H_
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/three_band_filter_bank.h"
+
+namespace webrtc {
+namespace {
+
+static_assert(ThreeBandFilterBank::kSplitBandSize % 8 == 0,
+              "The kernels require a band size that is a multiple of 8");
+
+// Unlike the other implementations, fused multiply-adds are used, so the
+// results differ from theirs by rounding.
+__m256 Filter(const float* x, const __m256* h) {
+  __m256 y = _mm256_mul_ps(_mm256_loadu_ps(x), h[0]);
+  y = _mm256_fmadd_ps(_mm256_loadu_ps(x - kStride), h[1], y);
+  y = _mm256_fmadd_ps(_mm256_loadu_ps(x - 2 * kStride), h[2], y);
+  y = _mm256_fmadd_ps(_mm256_loadu_ps(x - 3 * kStride), h[3], y);
+  return y;
+}
+
+void LoadFilter(const float* filter, __m256* h) {
+  for (int i = 0; i < kFilterSize; ++i) {
+    h[i] = _mm256_set1_ps(filter[i]);
+  }
+}
+
+}  // namespace
+
+void ThreeBandAnalysisFilter_AVX2(const float* in,
+                                  const float* filter,
+                                  int in_shift,
+                                  const float* dct_modulation,
+                                  float* const* out) {
+  __m256 h[kFilterSize];
+  LoadFilter(filter, h);
+  const __m256 d0 = _mm256_set1_ps(dct_modulation[0]);
+  const __m256 d1 = _mm256_set1_ps(dct_modulation[1]);
+  const __m256 d2 = _mm256_set1_ps(dct_modulation[2]);
+  const float* x = in + kMemorySize - in_shift;
+  for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 8) {
+    const __m256 y = Filter(x + k, h);
+    _mm256_storeu_ps(out[0] + k,
+                     _mm256_fmadd_ps(d0, y, _mm256_loadu_ps(out[0] + k)));
+    _mm256_storeu_ps(out[1] + k,
+                     _mm256_fmadd_ps(d1, y, _mm256_loadu_ps(out[1] + k)));
+    _mm256_storeu_ps(out[2] + k,
+                     _mm256_fmadd_ps(d2, y, _mm256_loadu_ps(out[2] + k)));
+  }
+}
+
+void ThreeBandSynthesisModulation_AVX2(const float* const* in,
+                                       const float* dct_modulation,
+                                       float* out) {
+  const __m256 d0 = _mm256_set1_ps(dct_modulation[0]);
+  const __m256 d1 = _mm256_set1_ps(dct_modulation[1]);
+  const __m256 d2 = _mm256_set1_ps(dct_modulation[2]);
+  for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 8) {
+    __m256 y = _mm256_mul_ps(d0, _mm256_loadu_ps(in[0] + k));
+    y = _mm256_fmadd_ps(d1, _mm256_loadu_ps(in[1] + k), y);
+    y = _mm256_fmadd_ps(d2, _mm256_loadu_ps(in[2] + k), y);
+    _mm256_storeu_ps(out + k, y);
+  }
+}
+
+void ThreeBandSynthesisFilter_AVX2(const float* in,
+                                   const float* filter,
+                                   int in_shift,
+                                   float* out) {
+  __m256 h[kFilterSize];
+  LoadFilter(filter, h);
+  const __m256 scaling = _mm256_set1_ps(ThreeBandFilterBank::kNumBands);
+  const float* x = in + kMemorySize - in_shift;
+  for (int k = 0; k < ThreeBandFilterBank::kSplitBandSize; k += 8) {
+    const __m256 y = Filter(x + k, h);
+    _mm256_storeu_ps(out + k,
+                     _mm256_fmadd_ps(scaling, y, _mm256_loadu_ps(out + k)));
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,289 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/two_band_filter_bank.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+// Coefficients of the allpass sections, as in splitting_filter.c.
+constexpr float kAllPassCoefficients1[3] = {6418.f / 65536.f,
+                                            36982.f / 65536.f,
+                                            57261.f / 65536.f};
+constexpr float kAllPassCoefficients2[3] = {21333.f / 65536.f,
+                                            49062.f / 65536.f,
+                                            63010.f / 65536.f};
+
+constexpr size_t kNumSections = 3;
+constexpr size_t kNumStates = kNumSections + 1;
+constexpr size_t kLaneAlignment = 4;
+
+size_t NumLanes(size_t num_channels) {
+  return (2 * num_channels + kLaneAlignment - 1) / kLaneAlignment *
+         kLaneAlignment;
+}
+
+// Each section computes y[n] = x[n-1] + a * (x[n] - y[n-1]). The state holds
+// the previous input of the first section followed by the previous outputs of
+// the three sections. The rows of lanes of all the arrays are `stride` apart,
+// and the first `num_lanes` lanes are filtered.
+void FilterAllPassCascades(const float* coefficients,
+                           size_t stride,
+                           size_t num_lanes,
+                           size_t num_samples,
+                           float* state,
+                           float* data) {
+  for (size_t n = 0; n < num_samples; ++n) {
+    float* x = &data[n * stride];
+    for (size_t k = 0; k < num_lanes; ++k) {
+      float input = x[k];
+      for (size_t s = 0; s < kNumSections; ++s) {
+        const float output =
+            state[s * stride + k] +
+            coefficients[s * stride + k] * (input - state[(s + 1) * stride + k]);
+        state[s * stride + k] = input;
+        input = output;
+      }
+      state[kNumSections * stride + k] = input;
+      x[k] = input;
+    }
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+void FilterAllPassCascades_SSE2(const float* coefficients,
+                                size_t stride,
+                                size_t num_lanes,
+                                size_t num_samples,
+                                float* state,
+                                float* data) {
+  for (size_t k = 0; k < num_lanes; k += 4) {
+    const __m128 a0 = _mm_loadu_ps(&coefficients[k]);
+    const __m128 a1 = _mm_loadu_ps(&coefficients[stride + k]);
+    const __m128 a2 = _mm_loadu_ps(&coefficients[2 * stride + k]);
+    __m128 s0 = _mm_loadu_ps(&state[k]);
+    __m128 s1 = _mm_loadu_ps(&state[stride + k]);
+    __m128 s2 = _mm_loadu_ps(&state[2 * stride + k]);
+    __m128 s3 = _mm_loadu_ps(&state[3 * stride + k]);
+    for (size_t n = 0; n < num_samples; ++n) {
+      float* x = &data[n * stride + k];
+      const __m128 x0 = _mm_loadu_ps(x);
+      const __m128 y0 = _mm_add_ps(s0, _mm_mul_ps(a0, _mm_sub_ps(x0, s1)));
+      const __m128 y1 = _mm_add_ps(s1, _mm_mul_ps(a1, _mm_sub_ps(y0, s2)));
+      const __m128 y2 = _mm_add_ps(s2, _mm_mul_ps(a2, _mm_sub_ps(y1, s3)));
+      s0 = x0;
+      s1 = y0;
+      s2 = y1;
+      s3 = y2;
+      _mm_storeu_ps(x, y2);
+    }
+    _mm_storeu_ps(&state[k], s0);
+    _mm_storeu_ps(&state[stride + k], s1);
+    _mm_storeu_ps(&state[2 * stride + k], s2);
+    _mm_storeu_ps(&state[3 * stride + k], s3);
+  }
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void FilterAllPassCascades_NEON(const float* coefficients,
+                                size_t stride,
+                                size_t num_lanes,
+                                size_t num_samples,
+                                float* state,
+                                float* data) {
+  for (size_t k = 0; k < num_lanes; k += 4) {
+    const float32x4_t a0 = vld1q_f32(&coefficients[k]);
+    const float32x4_t a1 = vld1q_f32(&coefficients[stride + k]);
+    const float32x4_t a2 = vld1q_f32(&coefficients[2 * stride + k]);
+    float32x4_t s0 = vld1q_f32(&state[k]);
+    float32x4_t s1 = vld1q_f32(&state[stride + k]);
+    float32x4_t s2 = vld1q_f32(&state[2 * stride + k]);
+    float32x4_t s3 = vld1q_f32(&state[3 * stride + k]);
+    for (size_t n = 0; n < num_samples; ++n) {
+      float* x = &data[n * stride + k];
+      const float32x4_t x0 = vld1q_f32(x);
+      const float32x4_t y0 = vmlaq_f32(s0, a0, vsubq_f32(x0, s1));
+      const float32x4_t y1 = vmlaq_f32(s1, a1, vsubq_f32(y0, s2));
+      const float32x4_t y2 = vmlaq_f32(s2, a2, vsubq_f32(y1, s3));
+      s0 = x0;
+      s1 = y0;
+      s2 = y1;
+      s3 = y2;
+      vst1q_f32(x, y2);
+    }
+    vst1q_f32(&state[k], s0);
+    vst1q_f32(&state[stride + k], s1);
+    vst1q_f32(&state[2 * stride + k], s2);
+    vst1q_f32(&state[3 * stride + k], s3);
+  }
+}
+#endif
+
+}  // namespace
+
+TwoBandFilterBank::AllPassCascades::AllPassCascades(
+    size_t num_lanes,
+    const float* first_branch_coefficients,
+    const float* second_branch_coefficients)
+    : coefficients(kNumSections * num_lanes), state(kNumStates * num_lanes) {
+  for (size_t s = 0; s < kNumSections; ++s) {
+    for (size_t k = 0; k < num_lanes; k += 2) {
+      coefficients[s * num_lanes + k] = first_branch_coefficients[s];
+      coefficients[s * num_lanes + k + 1] = second_branch_coefficients[s];
+    }
+  }
+}
+
+TwoBandFilterBank::TwoBandFilterBank(size_t num_channels)
+    : TwoBandFilterBank(num_channels, DetectImplementation()) {}
+
+TwoBandFilterBank::TwoBandFilterBank(size_t num_channels,
+                                     Implementation implementation)
+    : implementation_(implementation),
+      max_num_lanes_(NumLanes(num_channels)),
+      analysis_(max_num_lanes_, kAllPassCoefficients1, kAllPassCoefficients2),
+      synthesis_(max_num_lanes_, kAllPassCoefficients2, kAllPassCoefficients1),
+      branches_(kSplitBandSize * max_num_lanes_, 0.f) {}
+
+TwoBandFilterBank::~TwoBandFilterBank() = default;
+
+void TwoBandFilterBank::Reset() {
+  std::fill(analysis_.state.begin(), analysis_.state.end(), 0.f);
+  std::fill(synthesis_.state.begin(), synthesis_.state.end(), 0.f);
+}
+
+TwoBandFilterBank::Implementation TwoBandFilterBank::DetectImplementation() {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  if (GetCPUInfo(kAVX2) != 0) {
+    return Implementation::kAvx2;
+  }
+  if (GetCPUInfo(kSSE2) != 0) {
+    return Implementation::kSse2;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return Implementation::kNeon;
+#else
+  return Implementation::kScalar;
+#endif
+}
+
+void TwoBandFilterBank::Analysis(const ChannelBuffer<float>& data,
+                                 ChannelBuffer<float>* bands) {
+  RTC_DCHECK_EQ(data.num_frames(), kFullBandSize);
+  RTC_DCHECK_EQ(bands->num_bands(), kNumBands);
+  RTC_DCHECK_LE(data.num_channels(), bands->num_channels());
+  const size_t num_channels = data.num_channels();
+  const size_t num_lanes = NumLanes(num_channels);
+  RTC_DCHECK_LE(num_lanes, max_num_lanes_);
+
+  // The first branch takes the odd samples and the second the even ones.
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    const float* x = data.channels()[ch];
+    float* branches = &branches_[2 * ch];
+    for (size_t n = 0; n < kSplitBandSize; ++n) {
+      branches[n * max_num_lanes_] = x[2 * n + 1];
+      branches[n * max_num_lanes_ + 1] = x[2 * n];
+    }
+  }
+
+  Filter(num_lanes, &analysis_);
+
+  // The bands are the half sum and half difference of the branches.
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    const float* branches = &branches_[2 * ch];
+    float* low_band = bands->channels(0)[ch];
+    float* high_band = bands->channels(1)[ch];
+    for (size_t n = 0; n < kSplitBandSize; ++n) {
+      const float b0 = branches[n * max_num_lanes_];
+      const float b1 = branches[n * max_num_lanes_ + 1];
+      low_band[n] = 0.5f * (b0 + b1);
+      high_band[n] = 0.5f * (b0 - b1);
+    }
+  }
+}
+
+void TwoBandFilterBank::Synthesis(const ChannelBuffer<float>& bands,
+                                  ChannelBuffer<float>* data) {
+  RTC_DCHECK_EQ(data->num_frames(), kFullBandSize);
+  RTC_DCHECK_EQ(bands.num_bands(), kNumBands);
+  RTC_DCHECK_LE(data->num_channels(), bands.num_channels());
+  const size_t num_channels = data->num_channels();
+  const size_t num_lanes = NumLanes(num_channels);
+  RTC_DCHECK_LE(num_lanes, max_num_lanes_);
+
+  // The first branch takes the sum of the bands and the second the
+  // difference.
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    const float* low_band = bands.channels(0)[ch];
+    const float* high_band = bands.channels(1)[ch];
+    float* branches = &branches_[2 * ch];
+    for (size_t n = 0; n < kSplitBandSize; ++n) {
+      branches[n * max_num_lanes_] = low_band[n] + high_band[n];
+      branches[n * max_num_lanes_ + 1] = low_band[n] - high_band[n];
+    }
+  }
+
+  Filter(num_lanes, &synthesis_);
+
+  // The branches are the odd and even output samples, respectively.
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    const float* branches = &branches_[2 * ch];
+    float* y = data->channels()[ch];
+    for (size_t n = 0; n < kSplitBandSize; ++n) {
+      y[2 * n] = branches[n * max_num_lanes_ + 1];
+      y[2 * n + 1] = branches[n * max_num_lanes_];
+    }
+  }
+}
+
+void TwoBandFilterBank::Filter(size_t num_lanes, AllPassCascades* cascades) {
+  const float* a = cascades->coefficients.data();
+  float* state = cascades->state.data();
+  switch (implementation_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+    case Implementation::kAvx2:
+      FilterAllPassCascades_AVX2(a, max_num_lanes_, num_lanes, kSplitBandSize,
+                                 state, branches_.data());
+      break;
+    case Implementation::kSse2:
+      FilterAllPassCascades_SSE2(a, max_num_lanes_, num_lanes, kSplitBandSize,
+                                 state, branches_.data());
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Implementation::kNeon:
+      FilterAllPassCascades_NEON(a, max_num_lanes_, num_lanes, kSplitBandSize,
+                                 state, branches_.data());
+      break;
+#endif
+    default:
+      FilterAllPassCascades(a, max_num_lanes_, num_lanes, kSplitBandSize, state,
+                            branches_.data());
+  }
+}
+
+}  // namespace webrtc
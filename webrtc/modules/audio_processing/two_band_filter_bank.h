@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_TWO_BAND_FILTER_BANK_H_
+#define MODULES_AUDIO_PROCESSING_TWO_BAND_FILTER_BANK_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "common_audio/channel_buffer.h"
+
+namespace webrtc {
+
+// Floating point version of the two-band QMF filter bank implemented by
+// WebRtcSpl_AnalysisQMF() and WebRtcSpl_SynthesisQMF(). The full band signal
+// is split into two bands, and merged again, by a polyphase pair of cascades of
+// three first order allpass filters. Unlike the fixed-point version, the
+// signals are not quantized to 16 bits.
+//
+// The allpass cascades of all the channels are run together: the two
+// polyphase branches of each channel are placed in adjacent lanes of the SIMD
+// registers.
+class TwoBandFilterBank {
+ public:
+  enum class Implementation { kScalar, kSse2, kAvx2, kNeon };
+
+  static constexpr size_t kNumBands = 2;
+  static constexpr size_t kFullBandSize = 320;
+  static constexpr size_t kSplitBandSize = kFullBandSize / kNumBands;
+
+  // Uses the fastest implementation available.
+  explicit TwoBandFilterBank(size_t num_channels);
+  TwoBandFilterBank(size_t num_channels, Implementation implementation);
+  TwoBandFilterBank(const TwoBandFilterBank&) = delete;
+  TwoBandFilterBank& operator=(const TwoBandFilterBank&) = delete;
+  ~TwoBandFilterBank();
+
+  // Splits the channels of `data` into the two bands of `bands`.
+  void Analysis(const ChannelBuffer<float>& data, ChannelBuffer<float>* bands);
+
+  // Merges the two bands of the channels of `bands` into `data`. Only the
+  // channels of `data` are merged.
+  void Synthesis(const ChannelBuffer<float>& bands, ChannelBuffer<float>* data);
+
+  // Returns the fastest implementation available.
+  static Implementation DetectImplementation();
+
+  Implementation implementation() const { return implementation_; }
+
+  // Zeroes the filter states, as in a new filter bank.
+  void Reset();
+
+ private:
+  // Allpass cascades of one direction. The even and odd lanes hold the first
+  // and second polyphase branch of each channel, respectively.
+  struct AllPassCascades {
+    AllPassCascades(size_t num_lanes,
+                    const float* first_branch_coefficients,
+                    const float* second_branch_coefficients);
+    // Coefficients of the three sections, one row of lanes per section.
+    std::vector<float> coefficients;
+    // Input and output of the three sections in the previous sample, one row
+    // of lanes per signal.
+    std::vector<float> state;
+  };
+
+  void Filter(size_t num_lanes, AllPassCascades* cascades);
+
+  const Implementation implementation_;
+  const size_t max_num_lanes_;
+  AllPassCascades analysis_;
+  AllPassCascades synthesis_;
+  // Lane-interleaved signals of the polyphase branches.
+  std::vector<float> branches_;
+};
+
+// Runs the allpass cascades of TwoBandFilterBank on the first `num_lanes`
+// lanes of the interleaved signals in `data`, in place. The rows of lanes are
+// `stride` apart and `num_lanes` must be a multiple of 4. Only for use by
+// TwoBandFilterBank.
+void FilterAllPassCascades_AVX2(const float* coefficients,
+                                size_t stride,
+                                size_t num_lanes,
+                                size_t num_samples,
+                                float* state,
+                                float* data);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_TWO_BAND_FILTER_BANK_H_
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/two_band_filter_bank.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Vector operations on 8 or 4 lanes.
+template <size_t kNumLanes>
+struct Lanes;
+
+template <>
+struct Lanes<8> {
+  using Vector = __m256;
+  static __m256 Load(const float* p) { return _mm256_loadu_ps(p); }
+  static void Store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+  // Returns s + a * (x - y).
+  static __m256 Section(__m256 s, __m256 a, __m256 x, __m256 y) {
+    return _mm256_fmadd_ps(a, _mm256_sub_ps(x, y), s);
+  }
+};
+
+template <>
+struct Lanes<4> {
+  using Vector = __m128;
+  static __m128 Load(const float* p) { return _mm_loadu_ps(p); }
+  static void Store(float* p, __m128 v) { _mm_storeu_ps(p, v); }
+  static __m128 Section(__m128 s, __m128 a, __m128 x, __m128 y) {
+    return _mm_fmadd_ps(a, _mm_sub_ps(x, y), s);
+  }
+};
+
+template <size_t kNumLanes>
+void FilterLanes(const float* coefficients,
+                 size_t stride,
+                 size_t num_samples,
+                 float* state,
+                 float* data) {
+  using L = Lanes<kNumLanes>;
+  using Vector = typename L::Vector;
+  const Vector a0 = L::Load(&coefficients[0]);
+  const Vector a1 = L::Load(&coefficients[stride]);
+  const Vector a2 = L::Load(&coefficients[2 * stride]);
+  Vector s0 = L::Load(&state[0]);
+  Vector s1 = L::Load(&state[stride]);
+  Vector s2 = L::Load(&state[2 * stride]);
+  Vector s3 = L::Load(&state[3 * stride]);
+  for (size_t n = 0; n < num_samples; ++n) {
+    float* x = &data[n * stride];
+    const Vector x0 = L::Load(x);
+    const Vector y0 = L::Section(s0, a0, x0, s1);
+    const Vector y1 = L::Section(s1, a1, y0, s2);
+    const Vector y2 = L::Section(s2, a2, y1, s3);
+    s0 = x0;
+    s1 = y0;
+    s2 = y1;
+    s3 = y2;
+    L::Store(x, y2);
+  }
+  L::Store(&state[0], s0);
+  L::Store(&state[stride], s1);
+  L::Store(&state[2 * stride], s2);
+  L::Store(&state[3 * stride], s3);
+}
+
+}  // namespace
+
+void FilterAllPassCascades_AVX2(const float* coefficients,
+                                size_t stride,
+                                size_t num_lanes,
+                                size_t num_samples,
+                                float* state,
+                                float* data) {
+  RTC_DCHECK_EQ(num_lanes % 4, 0);
+  size_t k = 0;
+  for (; k + 8 <= num_lanes; k += 8) {
+    FilterLanes<8>(&coefficients[k], stride, num_samples, &state[k], &data[k]);
+  }
+  if (k < num_lanes) {
+    FilterLanes<4>(&coefficients[k], stride, num_samples, &state[k], &data[k]);
+  }
+}
+
+}  // namespace webrtc
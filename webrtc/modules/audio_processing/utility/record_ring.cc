@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/record_ring.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RecordRing::RecordRing(size_t size_bytes)
+    : num_slots_(std::max<size_t>(size_bytes / kSlotSize, 1)),
+      ring_(new uint8_t[num_slots_ * kSlotSize]),
+      record_sizes_(new std::atomic<uint32_t>[num_slots_]) {
+  // Touch the ring up front, so that the producers do not page fault on it.
+  memset(ring_.get(), 0, num_slots_ * kSlotSize);
+  for (size_t k = 0; k < num_slots_; ++k) {
+    record_sizes_[k].store(0, std::memory_order_relaxed);
+  }
+}
+
+RecordRing::~RecordRing() = default;
+
+bool RecordRing::Reserve(size_t num_bytes, Reservation* reservation) {
+  RTC_DCHECK_GT(num_bytes, 0);
+  const size_t num_record_slots = NumSlots(num_bytes);
+
+  // Reserve the slots for the record, unless the ring lacks room for it.
+  uint64_t slot = write_slot_.load(std::memory_order_relaxed);
+  do {
+    if (slot + num_record_slots - read_slot_.load(std::memory_order_acquire) >
+        num_slots_) {
+      num_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!write_slot_.compare_exchange_weak(slot, slot + num_record_slots,
+                                              std::memory_order_relaxed));
+
+  reservation->first_slot = slot;
+  reservation->num_bytes = static_cast<uint32_t>(num_bytes);
+  reservation->position = slot * kSlotSize;
+  return true;
+}
+
+void RecordRing::Copy(const void* data,
+                      size_t num_bytes,
+                      Reservation* reservation) {
+  RTC_DCHECK_LE(reservation->position + num_bytes,
+                reservation->first_slot * kSlotSize + reservation->num_bytes);
+  CopyToRing(reservation->position, data, num_bytes);
+  reservation->position += num_bytes;
+}
+
+void RecordRing::Commit(const Reservation& reservation) {
+  record_sizes_[reservation.first_slot % num_slots_].store(
+      reservation.num_bytes, std::memory_order_release);
+}
+
+size_t RecordRing::NextRecordSize() const {
+  const uint64_t slot = read_slot_.load(std::memory_order_relaxed);
+  return record_sizes_[slot % num_slots_].load(std::memory_order_acquire);
+}
+
+void RecordRing::Read(size_t offset, void* data, size_t num_bytes) const {
+  const uint64_t slot = read_slot_.load(std::memory_order_relaxed);
+  RTC_DCHECK_LE(offset + num_bytes, NextRecordSize());
+  CopyFromRing(slot * kSlotSize + offset, data, num_bytes);
+}
+
+void RecordRing::Pop() {
+  const uint64_t slot = read_slot_.load(std::memory_order_relaxed);
+  std::atomic<uint32_t>& record_size = record_sizes_[slot % num_slots_];
+  const size_t num_bytes = record_size.load(std::memory_order_relaxed);
+  RTC_DCHECK_GT(num_bytes, 0);
+  record_size.store(0, std::memory_order_relaxed);
+  read_slot_.store(slot + NumSlots(num_bytes), std::memory_order_release);
+}
+
+void RecordRing::CopyToRing(uint64_t position,
+                            const void* data,
+                            size_t num_bytes) {
+  const size_t ring_size = num_slots_ * kSlotSize;
+  const size_t offset = position % ring_size;
+  const size_t chunk = std::min(num_bytes, ring_size - offset);
+  memcpy(&ring_[offset], data, chunk);
+  memcpy(&ring_[0], static_cast<const uint8_t*>(data) + chunk,
+         num_bytes - chunk);
+}
+
+void RecordRing::CopyFromRing(uint64_t position,
+                              void* data,
+                              size_t num_bytes) const {
+  const size_t ring_size = num_slots_ * kSlotSize;
+  const size_t offset = position % ring_size;
+  const size_t chunk = std::min(num_bytes, ring_size - offset);
+  memcpy(data, &ring_[offset], chunk);
+  memcpy(static_cast<uint8_t*>(data) + chunk, &ring_[0], num_bytes - chunk);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_RECORD_RING_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_RECORD_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace webrtc {
+
+// Queue of variable-size records in a preallocated ring buffer, for any number
+// of producer threads and a single consumer thread. Producers never lock or
+// allocate: a record is reserved, filled in and committed, and if there is no
+// room for it, it is dropped instead. Records are consumed in the order in
+// which they were reserved, so the consumer waits for a reserved record until
+// it is committed.
+class RecordRing {
+ public:
+  // The ring is divided into slots, and each record occupies a run of
+  // consecutive slots.
+  static constexpr size_t kSlotSize = 64;
+
+  struct Reservation {
+    uint64_t first_slot;
+    uint32_t num_bytes;
+    // Ring position at which the next bytes of the record are to be copied.
+    uint64_t position;
+  };
+
+  explicit RecordRing(size_t size_bytes);
+  RecordRing(const RecordRing&) = delete;
+  RecordRing& operator=(const RecordRing&) = delete;
+  ~RecordRing();
+
+  // Producer side. Reserves a record of `num_bytes` bytes, which must be
+  // positive. Returns false, and counts the record as dropped, if there is no
+  // room for it.
+  bool Reserve(size_t num_bytes, Reservation* reservation);
+  // Copies `num_bytes` of `data` to the record, after the bytes copied so far.
+  void Copy(const void* data, size_t num_bytes, Reservation* reservation);
+  // Hands the record over to the consumer, once all its bytes are copied.
+  void Commit(const Reservation& reservation);
+
+  // Consumer side. Returns the size of the oldest record, or 0 if it is not
+  // committed yet.
+  size_t NextRecordSize() const;
+  // Copies `num_bytes` bytes at `offset` of the oldest record to `data`.
+  void Read(size_t offset, void* data, size_t num_bytes) const;
+  // Removes the oldest record, which makes room for new ones.
+  void Pop();
+
+  // Returns the number of records dropped so far.
+  int64_t num_dropped() const {
+    return num_dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static size_t NumSlots(size_t num_bytes) {
+    return (num_bytes + kSlotSize - 1) / kSlotSize;
+  }
+  void CopyToRing(uint64_t position, const void* data, size_t num_bytes);
+  void CopyFromRing(uint64_t position, void* data, size_t num_bytes) const;
+
+  const size_t num_slots_;
+  const std::unique_ptr<uint8_t[]> ring_;
+  // Size in bytes of the committed record starting at each slot, or zero if no
+  // committed record starts at the slot.
+  const std::unique_ptr<std::atomic<uint32_t>[]> record_sizes_;
+  // Monotonic slot counters. Slots before `write_slot_` are reserved by
+  // producers, and slots before `read_slot_` are free again.
+  std::atomic<uint64_t> write_slot_{0};
+  std::atomic<uint64_t> read_slot_{0};
+  std::atomic<int64_t> num_dropped_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_RECORD_RING_H_
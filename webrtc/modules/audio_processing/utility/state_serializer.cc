@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/state_serializer.h"
+
+#include <string.h>
+
+#include <cmath>
+#include <limits>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+StateWriter::StateWriter(std::vector<uint8_t>* data) : data_(data) {
+  RTC_DCHECK(data_);
+}
+
+void StateWriter::WriteBool(bool value) {
+  const uint8_t byte = value ? 1 : 0;
+  Append(&byte, sizeof(byte));
+}
+
+void StateWriter::WriteInt(int value) {
+  const int32_t value32 = value;
+  Append(&value32, sizeof(value32));
+}
+
+void StateWriter::WriteSize(size_t value) {
+  RTC_DCHECK_LE(value, std::numeric_limits<uint32_t>::max());
+  const uint32_t value32 = static_cast<uint32_t>(value);
+  Append(&value32, sizeof(value32));
+}
+
+void StateWriter::WriteFloat(float value) {
+  Append(&value, sizeof(value));
+}
+
+void StateWriter::WriteFloats(rtc::ArrayView<const float> values) {
+  Append(values.data(), values.size() * sizeof(float));
+}
+
+void StateWriter::WriteInts(rtc::ArrayView<const int> values) {
+  for (int value : values) {
+    WriteInt(value);
+  }
+}
+
+void StateWriter::WriteData(rtc::ArrayView<const uint8_t> data) {
+  Append(data.data(), data.size());
+}
+
+void StateWriter::Append(const void* data, size_t num_bytes) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  data_->insert(data_->end(), bytes, bytes + num_bytes);
+}
+
+StateReader::StateReader(rtc::ArrayView<const uint8_t> data) : data_(data) {}
+
+bool StateReader::ReadBool(bool* value) {
+  uint8_t byte;
+  if (!Consume(&byte, sizeof(byte)) || byte > 1) {
+    ok_ = false;
+    return false;
+  }
+  *value = byte == 1;
+  return true;
+}
+
+bool StateReader::ReadInt(int* value) {
+  int32_t value32;
+  if (!Consume(&value32, sizeof(value32))) {
+    return false;
+  }
+  *value = value32;
+  return true;
+}
+
+bool StateReader::ReadSize(size_t* value, size_t max_size) {
+  uint32_t value32;
+  if (!Consume(&value32, sizeof(value32)) || value32 > max_size) {
+    ok_ = false;
+    return false;
+  }
+  *value = value32;
+  return true;
+}
+
+bool StateReader::ReadFloat(float* value) {
+  float read_value;
+  if (!Consume(&read_value, sizeof(read_value)) || !std::isfinite(read_value)) {
+    ok_ = false;
+    return false;
+  }
+  *value = read_value;
+  return true;
+}
+
+bool StateReader::ReadFloats(rtc::ArrayView<float> values) {
+  const size_t num_bytes = values.size() * sizeof(float);
+  if (!ok_ || data_.size() - position_ < num_bytes) {
+    ok_ = false;
+    return false;
+  }
+  const uint8_t* source = &data_[position_];
+  for (size_t k = 0; k < values.size(); ++k) {
+    float value;
+    memcpy(&value, source + k * sizeof(float), sizeof(float));
+    if (!std::isfinite(value)) {
+      ok_ = false;
+      return false;
+    }
+  }
+  memcpy(values.data(), source, num_bytes);
+  position_ += num_bytes;
+  return true;
+}
+
+bool StateReader::ReadInts(rtc::ArrayView<int> values) {
+  if (!ok_ || (data_.size() - position_) / sizeof(int32_t) < values.size()) {
+    ok_ = false;
+    return false;
+  }
+  for (int& value : values) {
+    ReadInt(&value);
+  }
+  return true;
+}
+
+bool StateReader::ReadData(size_t num_bytes,
+                           rtc::ArrayView<const uint8_t>* data) {
+  if (!ok_ || data_.size() - position_ < num_bytes) {
+    ok_ = false;
+    return false;
+  }
+  *data = data_.subview(position_, num_bytes);
+  position_ += num_bytes;
+  return true;
+}
+
+bool StateReader::ReadExpectedSize(size_t expected_size) {
+  size_t size;
+  if (!ReadSize(&size, std::numeric_limits<uint32_t>::max()) ||
+      size != expected_size) {
+    ok_ = false;
+    return false;
+  }
+  return true;
+}
+
+bool StateReader::Consume(void* data, size_t num_bytes) {
+  if (!ok_ || data_.size() - position_ < num_bytes) {
+    ok_ = false;
+    return false;
+  }
+  memcpy(data, &data_[position_], num_bytes);
+  position_ += num_bytes;
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_STATE_SERIALIZER_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_STATE_SERIALIZER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Appends the values of the state of a submodule to a byte vector, in the byte
+// order of the machine. Sizes and counters are stored as 32-bit integers.
+class StateWriter {
+ public:
+  explicit StateWriter(std::vector<uint8_t>* data);
+  StateWriter(const StateWriter&) = delete;
+  StateWriter& operator=(const StateWriter&) = delete;
+
+  void WriteBool(bool value);
+  void WriteInt(int value);
+  void WriteSize(size_t value);
+  void WriteFloat(float value);
+  void WriteFloats(rtc::ArrayView<const float> values);
+  void WriteInts(rtc::ArrayView<const int> values);
+
+  // Appends `data` as is, e.g., a nested state written by another writer.
+  void WriteData(rtc::ArrayView<const uint8_t> data);
+
+ private:
+  void Append(const void* data, size_t num_bytes);
+
+  std::vector<uint8_t>* const data_;
+};
+
+// Reads the values written by a StateWriter. The Read* methods return false if
+// the data ends before the value, or if the value is out of range: booleans
+// must be 0 or 1, sizes must not exceed `max_size`, and floats must be finite.
+// A failed read leaves the destination unchanged, and fails all later reads.
+class StateReader {
+ public:
+  explicit StateReader(rtc::ArrayView<const uint8_t> data);
+  StateReader(const StateReader&) = delete;
+  StateReader& operator=(const StateReader&) = delete;
+
+  bool ReadBool(bool* value);
+  bool ReadInt(int* value);
+  bool ReadSize(size_t* value, size_t max_size);
+  bool ReadFloat(float* value);
+  bool ReadFloats(rtc::ArrayView<float> values);
+  bool ReadInts(rtc::ArrayView<int> values);
+
+  // Returns a view of the next `num_bytes` bytes in `data`, e.g., to read a
+  // nested state with another reader.
+  bool ReadData(size_t num_bytes, rtc::ArrayView<const uint8_t>* data);
+
+  // Reads a size and returns whether it equals `expected_size`. Used for the
+  // dimensions that a restored state must agree with.
+  bool ReadExpectedSize(size_t expected_size);
+
+  // Returns whether all the data has been read without errors.
+  bool Done() const { return ok_ && position_ == data_.size(); }
+
+ private:
+  bool Consume(void* data, size_t num_bytes);
+
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t position_ = 0;
+  bool ok_ = true;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_STATE_SERIALIZER_H_
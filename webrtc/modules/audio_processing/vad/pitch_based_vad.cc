@@ -59,6 +59,11 @@ PitchBasedVad::PitchBasedVad()
 
 PitchBasedVad::~PitchBasedVad() {}
 
+void PitchBasedVad::Reset() {
+  p_prior_ = kInitialPriorProbability;
+  circular_buffer_->Reset();
+}
+
 int PitchBasedVad::VoicingProbability(const AudioFeatures& features,
                                       double* p_combined) {
   double p;
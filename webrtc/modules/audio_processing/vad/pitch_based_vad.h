@@ -37,6 +37,9 @@ class PitchBasedVad {
   //               with the given values. The result are returned in `p`.
   int VoicingProbability(const AudioFeatures& features, double* p_combined);
 
+  // Resets the prior probability and its history.
+  void Reset();
+
  private:
   int UpdatePrior(double p);
 
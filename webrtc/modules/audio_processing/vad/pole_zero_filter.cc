@@ -63,6 +63,11 @@ static float FilterArPast(const T* past,
   return sum;
 }
 
+void PoleZeroFilter::Reset() {
+  memset(past_input_, 0, sizeof(past_input_));
+  memset(past_output_, 0, sizeof(past_output_));
+}
+
 int PoleZeroFilter::Filter(const int16_t* in,
                            size_t num_input_samples,
                            float* output) {
@@ -27,6 +27,9 @@ class PoleZeroFilter {
 
   int Filter(const int16_t* in, size_t num_input_samples, float* output);
 
+  // Clears the past input and output samples.
+  void Reset();
+
  private:
   PoleZeroFilter(const float* numerator_coefficients,
                  size_t order_numerator,
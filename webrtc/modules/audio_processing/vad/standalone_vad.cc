@@ -55,6 +55,13 @@ int StandaloneVad::AddAudio(const int16_t* data, size_t length) {
   return 0;
 }
 
+void StandaloneVad::Reset() {
+  int err = WebRtcVad_Init(vad_);
+  err |= WebRtcVad_set_mode(vad_, mode_);
+  RTC_CHECK_EQ(err, 0);
+  index_ = 0;
+}
+
 int StandaloneVad::GetActivity(double* p, size_t length_p) {
   if (index_ == 0)
     return -1;
@@ -45,6 +45,9 @@ class StandaloneVad {
   // Expecting 10 ms of 16 kHz audio to be pushed in.
   int AddAudio(const int16_t* data, size_t length);
 
+  // Discards the buffered audio and resets the VAD, keeping its mode.
+  void Reset();
+
   // Set aggressiveness of VAD, 0 is the least aggressive and 3 is the most
   // aggressive mode. Returns -1 if the input is less than 0 or larger than 3,
   // otherwise 0 is returned.
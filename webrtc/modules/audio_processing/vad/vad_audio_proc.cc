@@ -69,6 +69,16 @@ VadAudioProc::VadAudioProc()
 
 VadAudioProc::~VadAudioProc() {}
 
+void VadAudioProc::Reset() {
+  memset(audio_buffer_, 0, sizeof(audio_buffer_));
+  num_buffer_samples_ = kNumPastSignalSamples;
+  log_old_gain_ = -2;
+  old_lag_ = 50;
+  high_pass_filter_->Reset();
+  WebRtcIsac_InitPreFilterbank(pre_filter_handle_.get());
+  WebRtcIsac_InitPitchAnalysis(pitch_analysis_handle_.get());
+}
+
 void VadAudioProc::ResetBuffer() {
   memcpy(audio_buffer_, &audio_buffer_[kNumSamplesToProcess],
          sizeof(audio_buffer_[0]) * kNumPastSignalSamples);
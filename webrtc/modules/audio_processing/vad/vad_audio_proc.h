@@ -35,6 +35,9 @@ class VadAudioProc {
                       size_t length,
                       AudioFeatures* audio_features);
 
+  // Resets the buffered audio and the filter states.
+  void Reset();
+
   static constexpr size_t kDftSize = 512;
 
  private:
@@ -31,6 +31,18 @@ VoiceActivityDetector::VoiceActivityDetector()
 
 VoiceActivityDetector::~VoiceActivityDetector() = default;
 
+void VoiceActivityDetector::Reset() {
+  chunkwise_voice_probabilities_.clear();
+  chunkwise_rms_.clear();
+  last_voice_probability_ = kDefaultVoiceValue;
+  // Like in a new detector, the resampler is set up again by the next chunk
+  // that needs resampling.
+  RTC_CHECK_EQ(resampler_.Reset(kSampleRateHz, kSampleRateHz, kNumChannels), 0);
+  audio_processing_.Reset();
+  standalone_vad_->Reset();
+  pitch_based_vad_.Reset();
+}
+
 // Because ISAC has a different chunk length, it updates
 // `chunkwise_voice_probabilities_` and `chunkwise_rms_` when there is new data.
 // Otherwise it clears them.
@@ -37,6 +37,9 @@ class VoiceActivityDetector {
   // `sample_rate_hz`.
   void ProcessChunk(const int16_t* audio, size_t length, int sample_rate_hz);
 
+  // Resets the detector to its initial state.
+  void Reset();
+
   // Returns a vector of voice probabilities for each chunk. It can be empty for
   // some chunks, but it catches up afterwards returning multiple values at
   // once.